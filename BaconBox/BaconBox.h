@@ -93,6 +93,7 @@
 #include <BaconBox/Display/TileMap/TileLayer.h>
 #include <BaconBox/Display/TileMap/ObjectLayer.h>
 #include <BaconBox/Display/TileMap/Tileset.h>
+#include <BaconBox/Display/TileMap/TileAnimation.h>
 #include <BaconBox/Display/TileMap/LineObject.h>
 #include <BaconBox/Display/TileMap/PolygonObject.h>
 #include <BaconBox/Display/TileMap/RectangleObject.h>
@@ -104,6 +105,7 @@
 #include <BaconBox/Helper/Base64.h>
 #include <BaconBox/Helper/Compression.h>
 #include <BaconBox/Helper/Stopwatch.h>
+#include <BaconBox/Helper/Profiler.h>
 #include <BaconBox/Display/Text/Font.h>
 #include <BaconBox/Display/Text/Text.h>
 #include <BaconBox/Helper/Parser.h>
@@ -114,8 +116,10 @@
 #include <BaconBox/Audio/SoundFX.h>
 #include <BaconBox/Helper/Timer.h>
 #include <BaconBox/Emitter/SpriteEmitter.h>
+#include <BaconBox/Emitter/BatchedParticleEmitter.h>
 #include <BaconBox/Helper/SpriteFactory.h>
 #include <BaconBox/Helper/ShapeFactory.h>
+#include <BaconBox/Helper/VertexHelper.h>
 #include <BaconBox/Input/InputManager.h>
 #include <BaconBox/Helper/Serialization/DefaultSerializer.h>
 #include <BaconBox/Helper/Serialization/JsonSerializer.h>
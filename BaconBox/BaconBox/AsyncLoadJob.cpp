@@ -0,0 +1,9 @@
+#include "BaconBox/AsyncLoadJob.h"
+
+namespace BaconBox {
+	AsyncLoadJob::AsyncLoadJob() {
+	}
+
+	AsyncLoadJob::~AsyncLoadJob() {
+	}
+}
@@ -0,0 +1,55 @@
+/**
+ * @file
+ */
+#ifndef RB_ASYNC_LOAD_JOB_H
+#define RB_ASYNC_LOAD_JOB_H
+
+namespace BaconBox {
+	/**
+	 * Resource loaded in two steps: the slow part (reading and decoding files)
+	 * is done on a worker thread, then the resource is finished on the main
+	 * thread. Derive from it to load custom resources with
+	 * ResourceManager::loadAsync().
+	 * @see BaconBox::ResourceManager::loadAsync()
+	 */
+	class AsyncLoadJob {
+	public:
+		/**
+		 * Default constructor.
+		 */
+		AsyncLoadJob();
+
+		/**
+		 * Destructor.
+		 */
+		virtual ~AsyncLoadJob();
+
+		/**
+		 * Reads and decodes the resource. Called on a worker thread, so it
+		 * must not use the graphic driver, the audio engines or the resource
+		 * manager's getters. Loading textures through the resource manager is
+		 * allowed, their upload is done by the main thread.
+		 */
+		virtual void load() = 0;
+
+		/**
+		 * Finishes loading the resource. Called on the main thread after
+		 * load(), during the time the engine gives to asynchronous loads each
+		 * frame.
+		 * @return True if the resource was loaded, false if not.
+		 */
+		virtual bool finish() = 0;
+	private:
+		/**
+		 * Private undefined copy constructor.
+		 */
+		AsyncLoadJob(const AsyncLoadJob &src);
+
+		/**
+		 * Private undefined assignment operator.
+		 */
+		AsyncLoadJob &operator=(const AsyncLoadJob &src);
+	};
+}
+
+#endif // RB_ASYNC_LOAD_JOB_H
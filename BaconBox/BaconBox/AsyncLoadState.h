@@ -0,0 +1,30 @@
+/**
+ * @file
+ */
+#ifndef RB_ASYNC_LOAD_STATE_H
+#define RB_ASYNC_LOAD_STATE_H
+
+#include "BaconBox/Helper/SafeEnum.h"
+
+namespace BaconBox {
+	/**
+	 * Enum type representing where an asynchronous load is at.
+	 * @see BaconBox::ResourceManager::getAsyncLoadState()
+	 */
+	struct AsyncLoadStateDef {
+		enum type {
+			/// The resource is waiting to be loaded or being loaded.
+			PENDING,
+			/// The resource was loaded.
+			LOADED,
+			/// The resource could not be loaded.
+			FAILED
+		};
+	};
+	typedef SafeEnum<AsyncLoadStateDef> AsyncLoadState;
+
+	/// Identifies an asynchronous load.
+	typedef unsigned int AsyncLoadHandle;
+}
+
+#endif // RB_ASYNC_LOAD_STATE_H
@@ -0,0 +1,298 @@
+#include "BaconBox/AsyncLoader.h"
+
+#include <algorithm>
+
+#include "BaconBox/AsyncLoadJob.h"
+#include "BaconBox/ResourceManager.h"
+#include "BaconBox/Console.h"
+
+#ifdef RB_WIN32
+#include <windows.h>
+#else
+#include <sys/time.h>
+#endif
+
+namespace BaconBox {
+	const double AsyncLoader::DEFAULT_TIME_BUDGET = 0.004;
+
+	AsyncLoader &AsyncLoader::getInstance() {
+		static AsyncLoader instance;
+		return instance;
+	}
+
+	bool AsyncLoader::isMainThread() const {
+#ifdef RB_THREADS
+		return pthread_equal(pthread_self(), mainThread) != 0;
+#else
+		return true;
+#endif
+	}
+
+#ifdef RB_THREADS
+	void *AsyncLoader::work(void *loader) {
+		AsyncLoader &self = *static_cast<AsyncLoader *>(loader);
+		MutexLock lock(self.mutex);
+
+		while (!self.stopping) {
+			if (self.queued.empty()) {
+				self.jobQueued.wait(self.mutex);
+
+			} else {
+				Entry entry = self.queued.front();
+				self.queued.pop_front();
+
+				// The job is loaded without holding the lock so the other
+				// workers and the main thread aren't blocked.
+				self.mutex.unlock();
+				entry.job->load();
+				self.mutex.lock();
+
+				self.loaded.push_back(entry);
+			}
+		}
+
+		return NULL;
+	}
+#endif
+
+	AsyncLoader::AsyncLoader() : mutex(), jobQueued(), texturesUploaded(),
+		queued(), loaded(), uploads(), pending(), failed(), nextHandle(1u),
+		nbRequested(0u), nbFinished(0u), timeBudget(DEFAULT_TIME_BUDGET),
+		stopping(false)
+#ifdef RB_THREADS
+		, mainThread(pthread_self()), workers()
+#endif
+	{
+	}
+
+	AsyncLoader::~AsyncLoader() {
+		stop();
+	}
+
+	AsyncLoadHandle AsyncLoader::add(AsyncLoadJob *job) {
+		MutexLock lock(mutex);
+
+#ifdef RB_THREADS
+
+		// The workers are only started when they are first needed.
+		while (workers.size() < NB_WORKERS) {
+			pthread_t worker;
+
+			if (pthread_create(&worker, NULL, &AsyncLoader::work, this) == 0) {
+				workers.push_back(worker);
+
+			} else {
+				Console::println("Can't start an asynchronous loading thread, the remaining loads are done on the main thread.");
+				break;
+			}
+		}
+
+#endif
+
+		// The progress starts over when nothing was pending.
+		if (pending.empty()) {
+			nbRequested = 0u;
+			nbFinished = 0u;
+		}
+
+		Entry entry;
+		entry.handle = nextHandle++;
+		entry.job = job;
+		queued.push_back(entry);
+		pending.insert(entry.handle);
+		++nbRequested;
+		jobQueued.signal();
+
+		return entry.handle;
+	}
+
+	AsyncLoadState AsyncLoader::getState(AsyncLoadHandle handle) {
+		MutexLock lock(mutex);
+
+		if (pending.find(handle) != pending.end()) {
+			return AsyncLoadState::PENDING;
+
+		} else if (failed.erase(handle)) {
+			// The failure is only reported once, so the failed handles don't
+			// pile up.
+			return AsyncLoadState::FAILED;
+
+		} else {
+			return AsyncLoadState::LOADED;
+		}
+	}
+
+	float AsyncLoader::getProgress() {
+		MutexLock lock(mutex);
+		return (nbRequested > 0u) ? (static_cast<float>(nbFinished) / static_cast<float>(nbRequested)) : (1.0f);
+	}
+
+	unsigned int AsyncLoader::getNbPending() {
+		MutexLock lock(mutex);
+		return static_cast<unsigned int>(pending.size());
+	}
+
+	void AsyncLoader::update() {
+		// The budget is measured with the system's clock, the time helper
+		// might be a virtual clock that doesn't move during the update.
+		double end = getRealTime() + timeBudget;
+		bool working = true;
+
+		// At least one upload or job is done each frame, even if it takes
+		// longer than the budget.
+		while (working) {
+			TextureUpload *upload = NULL;
+			Entry entry;
+			entry.job = NULL;
+			bool needsLoading = false;
+
+			{
+				MutexLock lock(mutex);
+
+				if (!uploads.empty()) {
+					upload = uploads.front();
+					uploads.pop_front();
+
+				} else if (!loaded.empty()) {
+					entry = loaded.front();
+					loaded.pop_front();
+
+				} else if (!queued.empty()) {
+#ifdef RB_THREADS
+
+					// Without workers, the jobs are loaded here.
+					if (workers.empty()) {
+						entry = queued.front();
+						queued.pop_front();
+						needsLoading = true;
+					}
+
+#else
+					entry = queued.front();
+					queued.pop_front();
+					needsLoading = true;
+#endif
+				}
+			}
+
+			if (upload) {
+				TextureInformation *result = ResourceManager::addTexture(*upload->key, upload->pixMap, upload->overwrite);
+
+				MutexLock lock(mutex);
+				upload->result = result;
+				upload->done = true;
+				texturesUploaded.broadcast();
+
+			} else if (entry.job) {
+				if (needsLoading) {
+					entry.job->load();
+				}
+
+				bool result = entry.job->finish();
+				delete entry.job;
+
+				MutexLock lock(mutex);
+				pending.erase(entry.handle);
+
+				if (!result) {
+					failed.insert(entry.handle);
+				}
+
+				++nbFinished;
+
+			} else {
+				working = false;
+			}
+
+			if (working) {
+				working = getRealTime() < end;
+			}
+		}
+	}
+
+	TextureInformation *AsyncLoader::uploadTexture(const std::string &key,
+	                                               PixMap *pixMap,
+	                                               bool overwrite) {
+		TextureUpload upload;
+		upload.key = &key;
+		upload.pixMap = pixMap;
+		upload.overwrite = overwrite;
+		upload.result = NULL;
+		upload.done = false;
+
+		MutexLock lock(mutex);
+
+		if (!stopping) {
+			uploads.push_back(&upload);
+
+			while (!upload.done && !stopping) {
+				texturesUploaded.wait(mutex);
+			}
+
+			// The loader stopped before the main thread got to the upload.
+			if (!upload.done) {
+				uploads.erase(std::find(uploads.begin(), uploads.end(), &upload));
+			}
+		}
+
+		return upload.result;
+	}
+
+	void AsyncLoader::stop() {
+#ifdef RB_THREADS
+		{
+			MutexLock lock(mutex);
+			stopping = true;
+			jobQueued.broadcast();
+			texturesUploaded.broadcast();
+		}
+
+		for (std::vector<pthread_t>::iterator i = workers.begin();
+		     i != workers.end(); ++i) {
+			pthread_join(*i, NULL);
+		}
+
+		workers.clear();
+#endif
+
+		MutexLock lock(mutex);
+
+		for (EntryQueue::iterator i = queued.begin(); i != queued.end(); ++i) {
+			delete i->job;
+		}
+
+		for (EntryQueue::iterator i = loaded.begin(); i != loaded.end(); ++i) {
+			delete i->job;
+		}
+
+		queued.clear();
+		loaded.clear();
+		uploads.clear();
+
+		// The cancelled loads are reported as failed.
+		failed.insert(pending.begin(), pending.end());
+		pending.clear();
+		nbRequested = 0u;
+		nbFinished = 0u;
+		stopping = false;
+	}
+
+	double AsyncLoader::getRealTime() {
+#ifdef RB_WIN32
+		static LARGE_INTEGER frequency;
+
+		if (!frequency.QuadPart) {
+			QueryPerformanceFrequency(&frequency);
+		}
+
+		LARGE_INTEGER currentTime;
+		QueryPerformanceCounter(&currentTime);
+		return static_cast<double>(currentTime.QuadPart) / static_cast<double>(frequency.QuadPart);
+#else
+		timeval currentTime;
+		gettimeofday(&currentTime, 0);
+		return static_cast<double>(currentTime.tv_sec) +
+		       static_cast<double>(currentTime.tv_usec) / 1000000.0;
+#endif
+	}
+}
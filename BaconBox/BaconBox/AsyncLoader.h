@@ -0,0 +1,217 @@
+/**
+ * @file
+ */
+#ifndef RB_ASYNC_LOADER_H
+#define RB_ASYNC_LOADER_H
+
+#include <string>
+#include <deque>
+#include <set>
+#include <vector>
+
+#include "BaconBox/PlatformFlagger.h"
+#include "BaconBox/AsyncLoadState.h"
+#include "BaconBox/Helper/Mutex.h"
+
+namespace BaconBox {
+	class AsyncLoadJob;
+	class PixMap;
+	struct TextureInformation;
+
+	/**
+	 * Runs the asynchronous loads of the resource manager. The jobs are loaded
+	 * by a pool of worker threads and finished on the main thread, a few at a
+	 * time each frame. Without threads (when RB_THREADS isn't defined), the
+	 * jobs are entirely loaded on the main thread, within the same time
+	 * budget. Used through the resource manager.
+	 * @see BaconBox::ResourceManager::loadAsync()
+	 */
+	class AsyncLoader {
+		friend class ResourceManager;
+	public:
+		/// Number of worker threads.
+		static const unsigned int NB_WORKERS = 2u;
+
+		/// Default time given to the loads each frame (in seconds).
+		static const double DEFAULT_TIME_BUDGET;
+
+		/**
+		 * Gets the loader's instance. Must be called from the main thread the
+		 * first time.
+		 * @return Reference to the loader's instance.
+		 */
+		static AsyncLoader &getInstance();
+
+		/**
+		 * Checks whether or not the caller is on the main thread.
+		 * @return True if the caller is on the thread that created the
+		 * loader.
+		 */
+		bool isMainThread() const;
+	private:
+		/// Job to load and its handle.
+		struct Entry {
+			/// Handle identifying the load.
+			AsyncLoadHandle handle;
+
+			/// Job loading the resource.
+			AsyncLoadJob *job;
+		};
+
+		/// Texture upload requested by a worker thread.
+		struct TextureUpload {
+			/// Key of the texture.
+			const std::string *key;
+
+			/// Pixels of the texture.
+			PixMap *pixMap;
+
+			/// Whether or not an existing texture with the same key is replaced.
+			bool overwrite;
+
+			/// Texture created by the main thread.
+			TextureInformation *result;
+
+			/// Set once the main thread has created the texture.
+			bool done;
+		};
+
+		/// Type used to contain the jobs.
+		typedef std::deque<Entry> EntryQueue;
+
+		/// Protects everything shared with the worker threads.
+		Mutex mutex;
+
+		/// Signaled when jobs are queued or when the loader stops.
+		Condition jobQueued;
+
+		/// Signaled when the main thread has done texture uploads.
+		Condition texturesUploaded;
+
+		/// Jobs waiting to be loaded.
+		EntryQueue queued;
+
+		/// Jobs loaded, waiting to be finished on the main thread.
+		EntryQueue loaded;
+
+		/// Texture uploads waiting for the main thread.
+		std::deque<TextureUpload *> uploads;
+
+		/// Handles of the loads not finished yet.
+		std::set<AsyncLoadHandle> pending;
+
+		/// Handles of the loads that failed and weren't reported yet.
+		std::set<AsyncLoadHandle> failed;
+
+		/// Handle given to the next load.
+		AsyncLoadHandle nextHandle;
+
+		/// Number of loads requested since nothing was pending.
+		unsigned int nbRequested;
+
+		/// Number of loads finished since nothing was pending.
+		unsigned int nbFinished;
+
+		/// Time given to the loads each frame (in seconds).
+		double timeBudget;
+
+		/// Set when the loader is stopping its worker threads.
+		bool stopping;
+
+#ifdef RB_THREADS
+		/// Thread that created the loader.
+		pthread_t mainThread;
+
+		/// Worker threads, started with the first load.
+		std::vector<pthread_t> workers;
+
+		/**
+		 * Loop run by the worker threads.
+		 * @param loader Pointer to the loader.
+		 * @return Always NULL.
+		 */
+		static void *work(void *loader);
+#endif
+
+		/**
+		 * Default constructor.
+		 */
+		AsyncLoader();
+
+		/**
+		 * Destructor.
+		 */
+		~AsyncLoader();
+
+		/**
+		 * Queues a job to load.
+		 * @param job Job to load, the loader takes its ownership.
+		 * @return Handle identifying the load.
+		 */
+		AsyncLoadHandle add(AsyncLoadJob *job);
+
+		/**
+		 * Gets where a load is at. A failed load is only reported as FAILED
+		 * once, its handle is forgotten afterwards.
+		 * @param handle Handle of the load.
+		 * @return State of the load.
+		 */
+		AsyncLoadState getState(AsyncLoadHandle handle);
+
+		/**
+		 * Gets the ratio of the loads finished since nothing was pending.
+		 * @return Value between 0 and 1, 1 if nothing is pending.
+		 */
+		float getProgress();
+
+		/**
+		 * Gets the number of loads not finished yet.
+		 * @return Number of pending loads.
+		 */
+		unsigned int getNbPending();
+
+		/**
+		 * Does the texture uploads requested by the worker threads and
+		 * finishes the loaded jobs until the time budget is spent. Called
+		 * from the main thread.
+		 */
+		void update();
+
+		/**
+		 * Has the main thread create a texture and waits for it. Called from
+		 * a worker thread.
+		 * @param key Key of the texture.
+		 * @param pixMap Pixels of the texture.
+		 * @param overwrite Whether or not an existing texture with the same
+		 * key is replaced.
+		 * @return Texture created, NULL if the loader is stopping.
+		 */
+		TextureInformation *uploadTexture(const std::string &key,
+		                                  PixMap *pixMap, bool overwrite);
+
+		/**
+		 * Stops the worker threads and deletes the jobs not finished. Their
+		 * loads are reported as failed.
+		 */
+		void stop();
+
+		/**
+		 * Gets the time from the system's clock. Unlike the time helper, it
+		 * moves during a frame and isn't affected by a virtual clock.
+		 * @return Time elapsed since an arbitrary point (in seconds).
+		 */
+		static double getRealTime();
+
+		/**
+		 * Private undefined copy constructor.
+		 */
+		AsyncLoader(const AsyncLoader &src);
+
+		/**
+		 * Private undefined assignment operator.
+		 */
+		AsyncLoader &operator=(const AsyncLoader &src);
+	};
+}
+
+#endif // RB_ASYNC_LOADER_H
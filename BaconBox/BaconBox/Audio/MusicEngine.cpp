@@ -50,3 +50,12 @@ MusicEngine::MusicEngine(): AudioEngine(), musicVolume(Sound::MAX_VOLUME),
 
 MusicEngine::~MusicEngine() {
 }
+
+bool MusicEngine::readMusic(const std::string&, std::vector<char>&) {
+	return true;
+}
+
+MusicInfo* MusicEngine::loadMusicFromMemory(const std::string& filePath,
+                                            std::vector<char>&) {
+	return loadMusic(filePath);
+}
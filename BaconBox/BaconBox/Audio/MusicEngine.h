@@ -6,6 +6,7 @@
 #define RB_MUSIC_ENGINE_H
 
 #include <string>
+#include <vector>
 
 #include "BaconBox/Audio/MusicParameters.h"
 #include "BaconBox/Audio/AudioEngine.h"
@@ -102,6 +103,28 @@ namespace BaconBox {
 		 */
 		virtual MusicInfo* loadMusic(const MusicParameters& params) = 0;
 
+		/**
+		 * Reads a music file in memory. Called on a worker thread by the
+		 * asynchronous loads, so it must not use the audio device. By
+		 * default, nothing is read and loadMusicFromMemory() loads the file.
+		 * @param filePath Path to the music file to read.
+		 * @param fileContent Set to the file's content.
+		 * @return False if the file couldn't be read, true if not.
+		 */
+		virtual bool readMusic(const std::string& filePath,
+		                       std::vector<char>& fileContent);
+
+		/**
+		 * Loads music data read by readMusic(). Called on the main thread.
+		 * @param filePath Path to the music file.
+		 * @param fileContent File's content read by readMusic(). Can be
+		 * taken by the engine.
+		 * @return Pointer to the music data loaded, NULL if the music couldn't
+		 * be loaded.
+		 */
+		virtual MusicInfo* loadMusicFromMemory(const std::string& filePath,
+		                                       std::vector<char>& fileContent);
+
 		/**
 		 * Unloads music data.
 		 * @param music Music data that needs to be unloaded. Delete must not be
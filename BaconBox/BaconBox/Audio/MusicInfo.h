@@ -12,6 +12,8 @@
 #endif
 
 #ifdef RB_SDL
+#include <vector>
+
 #include <SDL2/SDL_mixer.h>
 //#include <SDL/SDL_mixer.h>
 
@@ -30,6 +32,10 @@ namespace BaconBox {
 #endif
 #ifdef RB_SDL
 		Mix_Music* music;
+
+		/// Content of the music's file when it was read in memory, the mixer
+		/// streams the music from it.
+		std::vector<char> fileContent;
 #endif
 	};
 }
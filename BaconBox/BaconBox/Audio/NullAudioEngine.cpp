@@ -6,6 +6,7 @@
 #include "BaconBox/Audio/MusicInfo.h"
 #include "BaconBox/Audio/NullAudio.h"
 #include "BaconBox/ResourceManager.h"
+#include "BaconBox/Helper/Profiler.h"
 
 using namespace BaconBox;
 
@@ -82,6 +83,8 @@ NullAudioEngine::~NullAudioEngine() {
 }
 
 void NullAudioEngine::update() {
+	RB_PROFILE_ZONE("NullAudioEngine::update");
+
 	// For each sound (music or sound effect).
 	std::list<NullAudio*>::iterator i = audios.begin();
 	while(i != audios.end()) {
@@ -16,10 +16,12 @@
 
 #include "BaconBox/Audio/SoundFX.h"
 #include "BaconBox/Audio/SoundInfo.h"
+#include "BaconBox/Audio/SoundData.h"
 #include "BaconBox/Audio/NullAudio.h"
 #include "BaconBox/Audio/OpenAL/OpenALSoundFX.h"
 
 #include "BaconBox/ResourceManager.h"
+#include "BaconBox/Helper/Profiler.h"
 
 namespace BaconBox {
 	int OpenALEngine::openALToBaconBoxVolume(float openALVolume) {
@@ -180,6 +182,8 @@ namespace BaconBox {
 	}
 
 	void OpenALEngine::update() {
+		RB_PROFILE_ZONE("OpenALEngine::update");
+
 		{
 			// We delete the sources of stopped sounds that must not survive.
 			ALint state;
@@ -226,30 +230,39 @@ namespace BaconBox {
 	}
 
 	SoundInfo *OpenALEngine::loadSound(const std::string &filePath) {
-		SoundInfo *newSnd = NULL;
-
-		ALenum format;
-		ALsizei bufferSize, freq;
-		char *bufferData;
+		SoundData data(filePath);
 		// We load the wav file.
-		OpenALEngine::loadWav(filePath, bufferData, bufferSize, format,
-		                      freq);
+		OpenALEngine::loadWav(filePath, data.samples, data.nbBytes,
+		                      data.format, data.frequency);
+		return loadDecodedSound(data);
+	}
+
+	SoundInfo *OpenALEngine::loadSound(const SoundParameters &params) {
+		return loadSound(params.path);
+	}
+
+	SoundData *OpenALEngine::decodeSound(const std::string &filePath) {
+		SoundData *result = new SoundData(filePath);
+		OpenALEngine::loadWav(filePath, result->samples, result->nbBytes,
+		                      result->format, result->frequency);
+		return result;
+	}
+
+	SoundInfo *OpenALEngine::loadDecodedSound(SoundData &data) {
+		SoundInfo *newSnd = NULL;
 
 		// We check that the buffer was loaded correctly.
-		if (bufferData) {
+		if (data.samples) {
 			newSnd = new SoundInfo();
 			alGenBuffers(1, &(newSnd->bufferId));
-			alBufferData(newSnd->bufferId, format, bufferData, bufferSize,
-			             freq);
+			// OpenAL copies the samples, so the decoded sound keeps them.
+			alBufferData(newSnd->bufferId, data.format, data.samples,
+			             data.nbBytes, data.frequency);
 		}
 
 		return newSnd;
 	}
 
-	SoundInfo *OpenALEngine::loadSound(const SoundParameters &params) {
-		return loadSound(params.path);
-	}
-
 	bool OpenALEngine::unloadSound(SoundInfo *sound) {
 		// We release the buffer name.
 		alDeleteBuffers(1, &sound->bufferId);
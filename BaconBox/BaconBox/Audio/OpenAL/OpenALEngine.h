@@ -22,6 +22,7 @@ namespace BaconBox {
 	class OpenALSoundFX;
 	class NullAudio;
 	struct SoundInfo;
+	struct SoundData;
 	/**
 	 * Audio engine using OpenAL to play the sounds.
 	 * @ingroup Audio
@@ -109,6 +110,23 @@ namespace BaconBox {
 		 */
 		SoundInfo *loadSound(const SoundParameters &params);
 
+		/**
+		 * Reads the samples of a wav file. Doesn't use OpenAL, so it can be
+		 * called on a worker thread.
+		 * @param filePath Path to the sound effect's wav file.
+		 * @return Decoded sound effect, without samples if the file couldn't
+		 * be read.
+		 */
+		SoundData *decodeSound(const std::string &filePath);
+
+		/**
+		 * Gives samples read by decodeSound() to an OpenAL buffer.
+		 * @param data Decoded sound effect.
+		 * @return Pointer to the loaded sound effect. Null if the file
+		 * couldn't be read.
+		 */
+		SoundInfo *loadDecodedSound(SoundData &data);
+
 		/**
 		 * Unloads sound data. Called by the resource loader either by demand
 		 * of the user or when it is unloading everything before unloading the
@@ -8,6 +8,7 @@
 
 #include "BaconBox/ResourceManager.h"
 #include "BaconBox/Audio/SoundInfo.h"
+#include "BaconBox/Audio/SoundData.h"
 #include "BaconBox/Audio/MusicInfo.h"
 #include "BaconBox/Audio/AudioState.h"
 #include "BaconBox/Audio/NullAudio.h"
@@ -15,6 +16,8 @@
 
 #include "BaconBox/Audio/SDL/SDLMixerBackgroundMusic.h"
 #include "BaconBox/Audio/SDL/SDLMixerSoundFX.h"
+#include "BaconBox/Helper/Profiler.h"
+#include "BaconBox/Helper/ResourcePathHandler.h"
 
 namespace BaconBox {
 	SDLMixerEngine *SDLMixerEngine::instance = NULL;
@@ -158,6 +161,8 @@ namespace BaconBox {
 	}
 
 	void SDLMixerEngine::update() {
+		RB_PROFILE_ZONE("SDLMixerEngine::update");
+
 		// We update the pause/resume fading.
 		if (SDL_GetTicks() > lastFadeTick + NB_TICKS_PER_FADE) {
 			lastFadeTick += NB_TICKS_PER_FADE;
@@ -211,6 +216,85 @@ namespace BaconBox {
 		return loadSound(params.path);
 	}
 
+	SoundData *SDLMixerEngine::decodeSound(const std::string &filePath) {
+		SoundData *result = new SoundData(filePath);
+		SDL_AudioSpec wavSpec;
+		Uint8 *wavSamples = NULL;
+		Uint32 wavNbBytes = 0;
+
+		// We read the file, then we decode it if it is a wav file.
+		if (ResourcePathHandler::readFile(filePath, result->fileContent) &&
+		    !result->fileContent.empty() &&
+		    SDL_LoadWAV_RW(SDL_RWFromConstMem(&result->fileContent[0],
+		                                      static_cast<int>(result->fileContent.size())),
+		                   1, &wavSpec, &wavSamples, &wavNbBytes)) {
+			int frequency = 0, nbChannels = 0;
+			Uint16 format = 0;
+			SDL_AudioCVT converter;
+
+			// We convert the samples to the format the audio was opened with.
+			if (Mix_QuerySpec(&frequency, &format, &nbChannels) &&
+			    SDL_BuildAudioCVT(&converter, wavSpec.format, wavSpec.channels,
+			                      wavSpec.freq, format,
+			                      static_cast<Uint8>(nbChannels),
+			                      frequency) >= 0) {
+				converter.len = static_cast<int>(wavNbBytes);
+				converter.buf = static_cast<Uint8 *>(SDL_malloc(wavNbBytes * converter.len_mult));
+
+				if (converter.buf) {
+					SDL_memcpy(converter.buf, wavSamples, wavNbBytes);
+
+					if (SDL_ConvertAudio(&converter) == 0) {
+						result->samples = converter.buf;
+						result->nbBytes = static_cast<Uint32>(converter.len_cvt);
+						// The file's content isn't needed anymore.
+						std::vector<char>().swap(result->fileContent);
+
+					} else {
+						SDL_free(converter.buf);
+					}
+				}
+			}
+
+			SDL_FreeWAV(wavSamples);
+		}
+
+		return result;
+	}
+
+	SoundInfo *SDLMixerEngine::loadDecodedSound(SoundData &data) {
+		SoundInfo *result = new SoundInfo();
+		result->data = NULL;
+
+		if (data.samples) {
+			result->data = Mix_QuickLoad_RAW(data.samples, data.nbBytes);
+
+			// The chunk takes the samples, Mix_FreeChunk() frees them.
+			if (result->data) {
+				result->data->allocated = 1;
+				data.samples = NULL;
+			}
+
+		} else if (!data.fileContent.empty()) {
+			// The mixer decodes the formats other than wav itself.
+			result->data = Mix_LoadWAV_RW(SDL_RWFromConstMem(&data.fileContent[0],
+			                                                 static_cast<int>(data.fileContent.size())),
+			                              1);
+		}
+
+		// We make sure the sound file is correctly loaded.
+		if (!result->data) {
+			// We delete the resulting sound info.
+			delete result;
+			result = NULL;
+			Console::println("Unable to load sound effect: " + data.filePath);
+			Console::println(" with SDL_mixer error: " + std::string(Mix_GetError()));
+			Console::printTrace();
+		}
+
+		return result;
+	}
+
 	bool SDLMixerEngine::unloadSound(SoundInfo *sound) {
 		if (sound && sound->data) {
 			Mix_FreeChunk(sound->data);
@@ -246,6 +330,37 @@ namespace BaconBox {
 		return loadMusic(params.filePath);
 	}
 
+	bool SDLMixerEngine::readMusic(const std::string &filePath,
+	                               std::vector<char> &fileContent) {
+		return ResourcePathHandler::readFile(filePath, fileContent);
+	}
+
+	MusicInfo *SDLMixerEngine::loadMusicFromMemory(const std::string &filePath,
+	                                               std::vector<char> &fileContent) {
+		MusicInfo *result = new MusicInfo();
+		result->music = NULL;
+
+		// The mixer streams the music from the file's content, so the music
+		// data keeps it.
+		result->fileContent.swap(fileContent);
+
+		if (!result->fileContent.empty()) {
+			result->music = Mix_LoadMUS_RW(SDL_RWFromConstMem(&result->fileContent[0],
+			                                                  static_cast<int>(result->fileContent.size())),
+			                               1);
+		}
+
+		if (!result->music) {
+			delete result;
+			result = NULL;
+			Console::println("Unable to load music file: " + filePath);
+			Console::println(" with the SDL_mixer error: " + std::string(Mix_GetError()));
+			Console::printTrace();
+		}
+
+		return result;
+	}
+
 	bool SDLMixerEngine::unloadMusic(MusicInfo *music) {
 		if (music && music->music) {
 			Mix_FreeMusic(music->music);
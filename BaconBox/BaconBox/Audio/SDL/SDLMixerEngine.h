@@ -10,6 +10,8 @@
 #include <stdint.h>
 
 #include <list>
+#include <string>
+#include <vector>
 
 #include <SDL2/SDL_mixer.h>
 
@@ -22,6 +24,7 @@ namespace BaconBox {
 	class SDLMixerBackgroundMusic;
 	class SDLMixerSoundFX;
 	class Sound;
+	struct SoundData;
 	/**
 	 * Audio engine implementation to play sounds and music with SDL_mixer.
 	 * @ingroup Audio
@@ -175,6 +178,22 @@ namespace BaconBox {
 		 */
 		SoundInfo *loadSound(const SoundParameters &params);
 
+		/**
+		 * Reads a sound file and converts its samples to the mixer's format.
+		 * Only wav files are decoded, the mixer decodes the other formats on
+		 * the main thread. Called on a worker thread.
+		 * @param filePath Path to the sound file to decode.
+		 * @return Decoded sound.
+		 */
+		SoundData *decodeSound(const std::string &filePath);
+
+		/**
+		 * Loads sound data decoded by decodeSound().
+		 * @param data Decoded sound, the sound data takes its samples.
+		 * @return Pointer to the sound data loaded.
+		 */
+		SoundInfo *loadDecodedSound(SoundData &data);
+
 		/**
 		 * Unloads sound data.
 		 * @param sound Sound data that needs to be unloaded. Delete must not be
@@ -199,6 +218,24 @@ namespace BaconBox {
 		 */
 		MusicInfo *loadMusic(const MusicParameters &params);
 
+		/**
+		 * Reads a music file in memory. Called on a worker thread.
+		 * @param filePath Path to the music file to read.
+		 * @param fileContent Set to the file's content.
+		 * @return False if the file couldn't be read, true if not.
+		 */
+		bool readMusic(const std::string &filePath,
+		               std::vector<char> &fileContent);
+
+		/**
+		 * Loads music data from a file's content read by readMusic().
+		 * @param filePath Path to the music file.
+		 * @param fileContent File's content, the music data takes it.
+		 * @return Pointer to the music data loaded.
+		 */
+		MusicInfo *loadMusicFromMemory(const std::string &filePath,
+		                               std::vector<char> &fileContent);
+
 		/**
 		 * Unloads music data.
 		 * @param music Music data that needs to be unloaded. Delete must not be
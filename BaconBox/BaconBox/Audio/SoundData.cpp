@@ -0,0 +1,23 @@
+#include "BaconBox/Audio/SoundData.h"
+
+namespace BaconBox {
+	SoundData::SoundData(const std::string &newFilePath) :
+		filePath(newFilePath)
+#ifdef RB_OPENAL
+		, samples(NULL), nbBytes(0), format(AL_FORMAT_MONO16), frequency(0)
+#endif
+#ifdef RB_SDL
+		, samples(NULL), nbBytes(0), fileContent()
+#endif
+	{
+	}
+
+	SoundData::~SoundData() {
+#ifdef RB_OPENAL
+		delete [] samples;
+#endif
+#ifdef RB_SDL
+		SDL_free(samples);
+#endif
+	}
+}
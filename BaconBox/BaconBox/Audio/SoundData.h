@@ -0,0 +1,74 @@
+/**
+ * @file
+ * @ingroup Audio
+ */
+#ifndef RB_SOUND_DATA_H
+#define RB_SOUND_DATA_H
+
+#include "BaconBox/Audio/SoundInfo.h"
+
+#include <string>
+#include <vector>
+
+namespace BaconBox {
+	/**
+	 * Sound effect read and decoded in memory by a worker thread, waiting for
+	 * the sound engine to load it on the main thread. Contains
+	 * platform-specific data, like SoundInfo.
+	 * @ingroup Audio
+	 * @see BaconBox::SoundEngine::decodeSound()
+	 */
+	struct SoundData {
+		/**
+		 * Parameterized constructor. Nothing is read yet.
+		 * @param newFilePath Path to the sound effect's file.
+		 */
+		explicit SoundData(const std::string &newFilePath);
+
+		/**
+		 * Destructor. Frees the samples that weren't given to the sound
+		 * engine.
+		 */
+		~SoundData();
+
+		/// Path to the sound effect's file.
+		std::string filePath;
+#ifdef RB_OPENAL
+		/// PCM samples read from the wav file, NULL if they couldn't be read.
+		char *samples;
+
+		/// Size of the samples (in bytes).
+		ALsizei nbBytes;
+
+		/// OpenAL format of the samples.
+		ALenum format;
+
+		/// Sample rate (in hertz).
+		ALsizei frequency;
+#endif
+#ifdef RB_SDL
+		/// Samples converted to the mixer's format, allocated with
+		/// SDL_malloc(). NULL if the file isn't a wav file, the mixer then
+		/// decodes the file's content on the main thread.
+		Uint8 *samples;
+
+		/// Size of the samples (in bytes).
+		Uint32 nbBytes;
+
+		/// Content of the sound effect's file, empty once it is decoded.
+		std::vector<char> fileContent;
+#endif
+	private:
+		/**
+		 * Private undefined copy constructor, the samples can't be shared.
+		 */
+		SoundData(const SoundData &src);
+
+		/**
+		 * Private undefined assignment operator.
+		 */
+		SoundData &operator=(const SoundData &src);
+	};
+}
+
+#endif // RB_SOUND_DATA_H
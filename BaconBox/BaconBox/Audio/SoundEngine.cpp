@@ -1,6 +1,7 @@
 #include "BaconBox/Audio/SoundEngine.h"
 #include "BaconBox/Audio/SoundFX.h"
 #include "BaconBox/Audio/SoundInfo.h"
+#include "BaconBox/Audio/SoundData.h"
 
 using namespace BaconBox;
 
@@ -50,3 +51,11 @@ SoundEngine::SoundEngine(): AudioEngine(), soundVolume(Sound::MAX_VOLUME),
 
 SoundEngine::~SoundEngine() {
 }
+
+SoundData* SoundEngine::decodeSound(const std::string& filePath) {
+	return new SoundData(filePath);
+}
+
+SoundInfo* SoundEngine::loadDecodedSound(SoundData& data) {
+	return loadSound(data.filePath);
+}
@@ -13,6 +13,7 @@
 namespace BaconBox {
 	class SoundFX;
 	struct SoundInfo;
+	struct SoundData;
 	/**
 	 * Abstract class for sound engines. Audio engine implementations for sound
 	 * effects must inherit from this class and implement the required abstract
@@ -103,6 +104,25 @@ namespace BaconBox {
 		 */
 		virtual SoundInfo* loadSound(const SoundParameters& params) = 0;
 
+		/**
+		 * Reads and decodes a sound file in memory. Called on a worker thread
+		 * by the asynchronous loads, so it must not use the audio device. By
+		 * default, nothing is read and loadDecodedSound() loads the file.
+		 * @param filePath Path to the sound file to decode.
+		 * @return Decoded sound, to give to loadDecodedSound(). The caller is
+		 * responsible for deleting it.
+		 */
+		virtual SoundData* decodeSound(const std::string& filePath);
+
+		/**
+		 * Loads sound data decoded by decodeSound(). Called on the main
+		 * thread.
+		 * @param data Decoded sound. Its samples can be taken by the engine.
+		 * @return Pointer to the sound data loaded, NULL if the sound couldn't
+		 * be loaded.
+		 */
+		virtual SoundInfo* loadDecodedSound(SoundData& data);
+
 		/**
 		 * Unloads sound data.
 		 * @param sound Sound data that needs to be unloaded. Delete must not be
@@ -9,6 +9,7 @@
 #include "BaconBox/Audio/NullAudio.h"
 
 #include "BaconBox/Console.h"
+#include "BaconBox/Helper/Profiler.h"
 
 namespace BaconBox {
 	BackgroundMusic* RBAudioPlayerEngine::getBackgroundMusic(std::string const &key,
@@ -42,6 +43,8 @@ namespace BaconBox {
 	}
 	
 	void RBAudioPlayerEngine::update() {
+		RB_PROFILE_ZONE("RBAudioPlayerEngine::update");
+
 		for (std::list<BackgroundMusic*>::iterator i = managedMusics.begin();
 			 i != managedMusics.end(); i++) {
 			// If the music is at stopped, we delete it.
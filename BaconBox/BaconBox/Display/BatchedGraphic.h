@@ -84,7 +84,12 @@ namespace BaconBox {
 
 			// We update the colors in the batch.
 			if (this->getVertices().batch && !this->getVertices().vertices) {
-				std::fill_n(this->getVertices().batch->colors.begin() + this->getVertices().begin, this->getVertices().getNbVertices(), newColor);
+				for (BatchVertexArray::iterator i = this->getVertices().batch->batchVertices.begin() + this->getVertices().begin;
+				     i != this->getVertices().batch->batchVertices.begin() + this->getVertices().begin + this->getVertices().getNbVertices(); ++i) {
+					i->color = newColor;
+				}
+
+				this->getVertices().batch->markVerticesDirty(this->getVertices().begin, this->getVertices().getNbVertices());
 			}
 		}
 
@@ -94,9 +99,14 @@ namespace BaconBox {
 		void refreshTextureCoordinates() {
 			// We update the texture coordinates in the batch.
 			if (this->getVertices().batch && !this->getVertices().vertices) {
-				std::copy(this->getCurrentTextureCoordinates().begin(),
-				          this->getCurrentTextureCoordinates().end(),
-				          this->getVertices().batch->textureCoordinates.begin() + this->getVertices().begin);
+				BatchVertexArray::iterator vertex = this->getVertices().batch->batchVertices.begin() + this->getVertices().begin;
+
+				for (TextureCoordinates::const_iterator i = this->getCurrentTextureCoordinates().begin();
+				     i != this->getCurrentTextureCoordinates().end(); ++i, ++vertex) {
+					vertex->textureCoordinate = *i;
+				}
+
+				this->getVertices().batch->markVerticesDirty(this->getVertices().begin, this->getVertices().getNbVertices());
 			}
 		}
 
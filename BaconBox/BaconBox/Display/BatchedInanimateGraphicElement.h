@@ -207,7 +207,7 @@ namespace BaconBox {
 
 			// We check if we have to initialize the texture coordinates.
 			if (this->getTextureInformation()) {
-				loadTextureCoordinates(this->getVertices(), newTextureOffset);
+				this->loadTextureCoordinates(this->getVertices(), newTextureOffset);
 			}
 
 			this->refreshTextureCoordinates();
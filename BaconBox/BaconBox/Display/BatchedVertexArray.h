@@ -72,6 +72,8 @@ namespace BaconBox {
 		 */
 		Iterator getBegin() {
 			if (batch) {
+				// The vertices might be modified through the iterator.
+				batch->markPositionsDirty(begin, nbVertices);
 				return batch->vertices.getBegin() + begin;
 
 			} else if (vertices) {
@@ -105,6 +107,8 @@ namespace BaconBox {
 		 */
 		Iterator getEnd() {
 			if (batch) {
+				// The vertices might be modified through the iterator.
+				batch->markPositionsDirty(begin, nbVertices);
 				return batch->vertices.getBegin() + begin + nbVertices;
 
 			} else if (vertices) {
@@ -138,6 +142,8 @@ namespace BaconBox {
 		 */
 		ReverseIterator getReverseBegin() {
 			if (batch) {
+				// The vertices might be modified through the iterator.
+				batch->markPositionsDirty(begin, nbVertices);
 				return batch->vertices.getReverseBegin() + (batch->vertices.getNbVertices() - begin - nbVertices);
 
 			} else if (vertices) {
@@ -172,6 +178,8 @@ namespace BaconBox {
 		 */
 		ReverseIterator getReverseEnd() {
 			if (batch) {
+				// The vertices might be modified through the iterator.
+				batch->markPositionsDirty(begin, nbVertices);
 				return batch->vertices.getReverseBegin() + (batch->vertices.getNbVertices() - begin);
 
 			} else if (vertices) {
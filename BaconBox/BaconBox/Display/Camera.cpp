@@ -238,6 +238,11 @@ namespace BaconBox {
 		}
 	}
 
+	const AxisAlignedBoundingBox Camera::getViewBoundingBox() const {
+		return AxisAlignedBoundingBox(getVertices().getMinimumXY() + offset,
+		                              getVertices().getSize());
+	}
+
 	void Camera::render() {
 		GraphicDriver::getInstance().prepareScene(*this->getVertices().getBegin() + offset, getAngle(), getScaling(), backgroundColor);
 	}
@@ -239,6 +239,14 @@ namespace BaconBox {
 		 */
 		bool collideInside(Collidable *collidable);
 
+		/**
+		 * Gets the area of the world the camera currently shows, taking into
+		 * account its angle, its zoom factor and its shaking.
+		 * @return Axis aligned bounding box containing everything visible
+		 * through the camera.
+		 */
+		const AxisAlignedBoundingBox getViewBoundingBox() const;
+
 	private:
 		/// Background color for the camera.
 		Color backgroundColor;
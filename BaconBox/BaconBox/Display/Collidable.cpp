@@ -9,7 +9,7 @@
 
 namespace BaconBox {
 	const float Collidable::NO_MAX_VELOCITY = -1.0f;
-	const float OVERLAP_BIAS = 4.0f;
+	const float Collidable::OVERLAP_BIAS = 4.0f;
 	FlagSet<Side> initAllSides();
 
 	const FlagSet<Side> Collidable::ALL_SIDES = initAllSides();
@@ -21,6 +21,12 @@ namespace BaconBox {
 		/// Value used to represent an infinite maximum velocity.
 		static const float NO_MAX_VELOCITY;
 
+		/**
+		 * Number of pixels a body can already overlap another body and still
+		 * be separated from it when colliding.
+		 */
+		static const float OVERLAP_BIAS;
+
 		/// Flag set will all flags raised.
 		static const FlagSet<Side> ALL_SIDES;
 
@@ -0,0 +1,13 @@
+#include "BaconBox/Display/Driver/BatchVertex.h"
+
+namespace BaconBox {
+	BatchVertex::BatchVertex() : position(), textureCoordinate(),
+		color(Color::WHITE) {
+	}
+
+	BatchVertex::BatchVertex(const Vector2 &newPosition,
+	                         const Vector2 &newTextureCoordinate,
+	                         const Color &newColor) : position(newPosition),
+		textureCoordinate(newTextureCoordinate), color(newColor) {
+	}
+}
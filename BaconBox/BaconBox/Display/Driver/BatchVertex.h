@@ -0,0 +1,49 @@
+/**
+ * @file
+ * @ingroup Display
+ */
+#ifndef RB_BATCH_VERTEX_H
+#define RB_BATCH_VERTEX_H
+
+#include <vector>
+
+#include "BaconBox/Vector2.h"
+#include "BaconBox/Display/Color.h"
+
+namespace BaconBox {
+	/**
+	 * Vertex of a render batch. Its position, texture coordinate and color
+	 * are interleaved so everything needed to draw the vertex is read from
+	 * the same place in memory.
+	 * @ingroup Display
+	 */
+	struct BatchVertex {
+		/**
+		 * Default constructor.
+		 */
+		BatchVertex();
+
+		/**
+		 * Parameterized constructor.
+		 * @param newPosition Position of the vertex.
+		 * @param newTextureCoordinate Texture coordinate of the vertex.
+		 * @param newColor Color of the vertex.
+		 */
+		BatchVertex(const Vector2 &newPosition,
+		            const Vector2 &newTextureCoordinate,
+		            const Color &newColor);
+
+		/// Position of the vertex.
+		Vector2 position;
+
+		/// Texture coordinate of the vertex.
+		Vector2 textureCoordinate;
+
+		/// Color of the vertex, packed as 4 unsigned bytes (RGBA).
+		Color color;
+	};
+
+	typedef std::vector<BatchVertex> BatchVertexArray;
+}
+
+#endif // RB_BATCH_VERTEX_H
@@ -0,0 +1,309 @@
+#include "BaconBox/Display/Driver/DeferredGraphicDriver.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "BaconBox/Display/TextureInformation.h"
+
+namespace BaconBox {
+	DeferredGraphicDriver::Command::Command(int newLayer,
+	                                        const TextureInformation *newTextureInformation,
+	                                        unsigned int newTextureOrder,
+	                                        VertexArray::SizeType newBegin,
+	                                        VertexArray::SizeType newNbVertices,
+	                                        const Color &newColor) :
+		layer(newLayer), textureInformation(newTextureInformation),
+		textureOrder(newTextureOrder), begin(newBegin), nbVertices(newNbVertices), color(newColor) {
+	}
+
+	bool DeferredGraphicDriver::Command::operator<(const Command &other) const {
+		return layer < other.layer ||
+		       (layer == other.layer && textureOrder < other.textureOrder);
+	}
+
+	void DeferredGraphicDriver::drawShapeWithTextureAndColor(const VertexArray &vertices,
+	                                                         const TextureInformation *textureInformation,
+	                                                         const TextureCoordinates &textureCoordinates,
+	                                                         const Color &color) {
+		// Shapes that would not be drawn by the driver are not queued.
+		if (color.getAlpha() > 0u && textureInformation &&
+		    vertices.getNbVertices() >= 3) {
+			// We number the textures in the order they are first queued.
+			TextureOrderMap::iterator found = textureOrders.insert(std::make_pair(textureInformation, static_cast<unsigned int>(textureOrders.size()))).first;
+
+			commands.push_back(Command(currentLayer, textureInformation,
+			                           found->second,
+			                           queuedVertices.getNbVertices(),
+			                           vertices.getNbVertices(), color));
+
+			queuedVertices.insert(queuedVertices.getEnd(),
+			                      vertices.getBegin(), vertices.getEnd());
+
+			// We make sure there is exactly one texture coordinate per vertex.
+			if (textureCoordinates.size() >= vertices.getNbVertices()) {
+				queuedTextureCoordinates.insert(queuedTextureCoordinates.end(),
+				                                textureCoordinates.begin(),
+				                                textureCoordinates.begin() + vertices.getNbVertices());
+
+			} else {
+				queuedTextureCoordinates.insert(queuedTextureCoordinates.end(),
+				                                textureCoordinates.begin(),
+				                                textureCoordinates.end());
+				queuedTextureCoordinates.resize(queuedVertices.getNbVertices());
+			}
+
+			++nbQueuedShapes;
+		}
+	}
+
+	void DeferredGraphicDriver::drawShapeWithTexture(const VertexArray &vertices,
+	                                                 const TextureInformation *textureInformation,
+	                                                 const TextureCoordinates &textureCoordinates) {
+		drawShapeWithTextureAndColor(vertices, textureInformation,
+		                             textureCoordinates, Color::WHITE);
+	}
+
+	void DeferredGraphicDriver::drawShapeWithColor(const VertexArray &vertices,
+	                                               const Color &color) {
+		flush();
+		driver.drawShapeWithColor(vertices, color);
+	}
+
+	void DeferredGraphicDriver::drawMaskShapeWithTextureAndColor(const VertexArray &vertices,
+	                                                             const TextureInformation *textureInformation,
+	                                                             const TextureCoordinates &textureCoordinates,
+	                                                             const Color &color) {
+		flush();
+		driver.drawMaskShapeWithTextureAndColor(vertices, textureInformation,
+		                                        textureCoordinates, color);
+	}
+
+	void DeferredGraphicDriver::drawMaskShapeWithTexture(const VertexArray &vertices,
+	                                                     const TextureInformation *textureInformation,
+	                                                     const TextureCoordinates &textureCoordinates) {
+		flush();
+		driver.drawMaskShapeWithTexture(vertices, textureInformation,
+		                                textureCoordinates);
+	}
+
+	void DeferredGraphicDriver::drawMaskedShapeWithTextureAndColor(const VertexArray &vertices,
+	                                                               const TextureInformation *textureInformation,
+	                                                               const TextureCoordinates &textureCoordinates,
+	                                                               const Color &color,
+	                                                               bool invertedMask) {
+		flush();
+		driver.drawMaskedShapeWithTextureAndColor(vertices, textureInformation,
+		                                          textureCoordinates, color,
+		                                          invertedMask);
+	}
+
+	void DeferredGraphicDriver::unmaskShape(const VertexArray &vertices) {
+		flush();
+		driver.unmaskShape(vertices);
+	}
+
+	void DeferredGraphicDriver::drawBatchWithTextureAndColor(const BatchVertexArray &vertices,
+	                                                         const TextureInformation *textureInformation,
+	                                                         const IndiceArray &indices,
+	                                                         const IndiceArrayList &indiceList,
+	                                                         VertexBuffer *vertexBuffer) {
+		flush();
+		driver.drawBatchWithTextureAndColor(vertices, textureInformation,
+		                                    indices, indiceList, vertexBuffer);
+	}
+
+	void DeferredGraphicDriver::drawBatchWithTexture(const BatchVertexArray &vertices,
+	                                                 const TextureInformation *textureInformation,
+	                                                 const IndiceArray &indices,
+	                                                 const IndiceArrayList &indiceList,
+	                                                 VertexBuffer *vertexBuffer) {
+		flush();
+		driver.drawBatchWithTexture(vertices, textureInformation, indices,
+		                            indiceList, vertexBuffer);
+	}
+
+	void DeferredGraphicDriver::drawMaskBatchWithTextureAndColor(const BatchVertexArray &vertices,
+	                                                             const TextureInformation *textureInformation,
+	                                                             const IndiceArray &indices,
+	                                                             const IndiceArrayList &indiceList,
+	                                                             VertexBuffer *vertexBuffer) {
+		flush();
+		driver.drawMaskBatchWithTextureAndColor(vertices, textureInformation,
+		                                        indices, indiceList,
+		                                        vertexBuffer);
+	}
+
+	void DeferredGraphicDriver::drawMaskedBatchWithTextureAndColor(const BatchVertexArray &vertices,
+	                                                               const TextureInformation *textureInformation,
+	                                                               const IndiceArray &indices,
+	                                                               const IndiceArrayList &indiceList,
+	                                                               bool invertedMask,
+	                                                               VertexBuffer *vertexBuffer) {
+		flush();
+		driver.drawMaskedBatchWithTextureAndColor(vertices, textureInformation,
+		                                          indices, indiceList,
+		                                          invertedMask, vertexBuffer);
+	}
+
+	void DeferredGraphicDriver::unmaskBatch(const BatchVertexArray &vertices,
+	                                        const IndiceArray &indices,
+	                                        const IndiceArrayList &indiceList,
+	                                        VertexBuffer *vertexBuffer) {
+		flush();
+		driver.unmaskBatch(vertices, indices, indiceList, vertexBuffer);
+	}
+
+	void DeferredGraphicDriver::prepareScene(const Vector2 &position,
+	                                         float angle, const Vector2 &zoom,
+	                                         const Color &backgroundColor) {
+		flush();
+		nbQueuedShapes = 0;
+		nbFlushedBatches = 0;
+		driver.prepareScene(position, angle, zoom, backgroundColor);
+	}
+
+	void DeferredGraphicDriver::initializeGraphicDriver() {
+		flush();
+		driver.initializeGraphicDriver();
+	}
+
+	void DeferredGraphicDriver::pushMatrix() {
+		flush();
+		driver.pushMatrix();
+	}
+
+	void DeferredGraphicDriver::translate(const Vector2 &translation) {
+		flush();
+		driver.translate(translation);
+	}
+
+	void DeferredGraphicDriver::loadIdentity() {
+		flush();
+		driver.loadIdentity();
+	}
+
+	void DeferredGraphicDriver::popMatrix() {
+		flush();
+		driver.popMatrix();
+	}
+
+	TextureInformation *DeferredGraphicDriver::loadTexture(PixMap *pixMap) {
+		return driver.loadTexture(pixMap);
+	}
+
+	void DeferredGraphicDriver::deleteTexture(TextureInformation *textureInfo) {
+		// The queued shapes might still use the texture.
+		flush();
+		driver.deleteTexture(textureInfo);
+	}
+
+	void DeferredGraphicDriver::updateTexture(TextureInformation *textureInfo,
+	                                          const PixMap &subPixMap,
+	                                          unsigned int xOffset,
+	                                          unsigned int yOffset) {
+		// The queued shapes must be drawn with the texture's old content.
+		flush();
+		driver.updateTexture(textureInfo, subPixMap, xOffset, yOffset);
+	}
+
+	VertexBuffer *DeferredGraphicDriver::createVertexBuffer(VertexBufferUsage usage) {
+		return driver.createVertexBuffer(usage);
+	}
+
+	void DeferredGraphicDriver::deleteVertexBuffer(VertexBuffer *vertexBuffer) {
+		driver.deleteVertexBuffer(vertexBuffer);
+	}
+
+	void DeferredGraphicDriver::setCurrentLayer(int z) {
+		currentLayer = z;
+	}
+
+	void DeferredGraphicDriver::finalizeScene() {
+		flush();
+		driver.finalizeScene();
+	}
+
+	void DeferredGraphicDriver::flush() {
+		if (!commands.empty()) {
+			// We sort the commands by layer and then by texture, shapes that
+			// are equivalent keep their submission order.
+			std::stable_sort(commands.begin(), commands.end());
+
+			CommandList::const_iterator first = commands.begin();
+
+			for (CommandList::const_iterator i = commands.begin() + 1;
+			     i != commands.end(); ++i) {
+				if (i->textureInformation != first->textureInformation) {
+					flushRun(first, i);
+					first = i;
+				}
+			}
+
+			flushRun(first, commands.end());
+
+			commands.clear();
+			textureOrders.clear();
+			queuedVertices.clear();
+			queuedTextureCoordinates.clear();
+		}
+	}
+
+	unsigned int DeferredGraphicDriver::getNbQueuedShapes() const {
+		return nbQueuedShapes;
+	}
+
+	unsigned int DeferredGraphicDriver::getNbFlushedBatches() const {
+		return nbFlushedBatches;
+	}
+
+	void DeferredGraphicDriver::flushRun(CommandList::const_iterator first,
+	                                     CommandList::const_iterator last) {
+		static const VertexArray::SizeType MAX_NB_INDICES = static_cast<VertexArray::SizeType>(std::numeric_limits<IndiceArray::value_type>::max());
+
+		batchVertices.clear();
+		batchIndices.clear();
+		batchIndiceList.clear();
+
+		batchIndiceList.push_back(std::make_pair(0, 0));
+
+		for (CommandList::const_iterator i = first; i != last; ++i) {
+			VertexArray::SizeType begin = batchVertices.size();
+
+			// We start a new segment when the indices would overflow.
+			if (begin + i->nbVertices > batchIndiceList.back().first + MAX_NB_INDICES) {
+				batchIndiceList.push_back(std::make_pair(begin, batchIndices.size()));
+			}
+
+			for (VertexArray::SizeType j = i->begin; j < i->begin + i->nbVertices; ++j) {
+				batchVertices.push_back(BatchVertex(queuedVertices[j],
+				                                    queuedTextureCoordinates[j],
+				                                    i->color));
+			}
+
+			// We add the indices for each of the shape's triangles.
+			IndiceArray::value_type indiceIterator = static_cast<IndiceArray::value_type>(begin - batchIndiceList.back().first);
+			IndiceArray::value_type nbTriangles = static_cast<IndiceArray::value_type>(i->nbVertices - 2);
+
+			for (IndiceArray::value_type j = 0; j < nbTriangles; ++j) {
+				batchIndices.push_back(indiceIterator + j);
+				batchIndices.push_back(indiceIterator + j + 1);
+				batchIndices.push_back(indiceIterator + j + 2);
+			}
+		}
+
+		driver.drawBatchWithTextureAndColor(batchVertices,
+		                                    first->textureInformation,
+		                                    batchIndices, batchIndiceList);
+		++nbFlushedBatches;
+	}
+
+	DeferredGraphicDriver::DeferredGraphicDriver(GraphicDriver &newDriver) :
+		GraphicDriver(), driver(newDriver), commands(), textureOrders(), queuedVertices(),
+		queuedTextureCoordinates(), batchVertices(), batchIndices(),
+		batchIndiceList(), currentLayer(0), nbQueuedShapes(0),
+		nbFlushedBatches(0) {
+	}
+
+	DeferredGraphicDriver::~DeferredGraphicDriver() {
+	}
+}
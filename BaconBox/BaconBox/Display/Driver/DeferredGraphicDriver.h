@@ -0,0 +1,371 @@
+/**
+ * @file
+ * @ingroup GraphicDrivers
+ */
+#ifndef RB_DEFERRED_GRAPHIC_DRIVER_H
+#define RB_DEFERRED_GRAPHIC_DRIVER_H
+
+#include <vector>
+#include <map>
+
+#include "BaconBox/Display/Driver/GraphicDriver.h"
+#include "BaconBox/Display/StandardVertexArray.h"
+#include "BaconBox/Display/Color.h"
+
+namespace BaconBox {
+	/**
+	 * Graphic driver that defers the textured shapes' draw calls. The shapes
+	 * are collected in a queue, sorted by layer and then by texture and
+	 * flushed to the wrapped driver as merged batches. Any other call
+	 * (masks, batches, matrix operations, etc.) flushes the queue first, so
+	 * the rendering order between layers is preserved. Shapes on the same
+	 * layer have no guaranteed order relative to each other.
+	 * @ingroup GraphicDrivers
+	 */
+	class DeferredGraphicDriver : public GraphicDriver {
+		friend class Engine;
+	public:
+		/**
+		 * Draw a colored and textured shape with the given vertices, texture
+		 * coordinate, rendering informations (colors array and texture) and
+		 * number of vertices. Color information will blend with the texture
+		 * (and background if alpha is not at max value of 255).
+		 * @param vertices Vertices to draw.
+		 * @param textureInformation Pointer to the texture information.
+		 * @param textureCoordinates Texture coordinates in the texture to
+		 * draw.
+		 * @param color Color to render.
+		 */
+		void drawShapeWithTextureAndColor(const VertexArray &vertices,
+		                                  const TextureInformation *textureInformation,
+		                                  const TextureCoordinates &textureCoordinates,
+		                                  const Color &color);
+
+		/**
+		 * Draw a textured shape with the given vertices, texture coordinate,
+		 * rendering informations (colors array and textureID) and number of
+		 * vertices.
+		 * @param vertices Vertices to draw.
+		 * @param textureInformation Pointer to the texture information.
+		 * @param textureCoordinates Texture coordinates in the texture to
+		 * draw.
+		 */
+		void drawShapeWithTexture(const VertexArray &vertices,
+		                          const TextureInformation *textureInformation,
+		                          const TextureCoordinates &textureCoordinates);
+
+		/**
+		 * Draws a colored shape.
+		 * @param vertices Vertices to draw.
+		 * @param color Color to render.
+		 */
+		void drawShapeWithColor(const VertexArray &vertices,
+		                        const Color &color);
+
+		/**
+		 * Draws the alpha component of the given vertices and texture to the
+		 * alpha component of the frame buffer, so the next call to any
+		 * "drawMaskedShape..." functions can use the given mask as its inverted
+		 * alpha value. This version of the function will also use the alpha
+		 * component of the shape's color (in addition to the texture alpha
+		 * component).
+		 * @param vertices Vertices to draw.
+		 * @param textureInformation Pointer to the texture information.
+		 * @param textureCoordinates Texture coordinates in the texture to
+		 * draw.
+		 * @param color Color to render.
+		 */
+		void drawMaskShapeWithTextureAndColor(const VertexArray &vertices,
+		                                      const TextureInformation *textureInformation,
+		                                      const TextureCoordinates &textureCoordinates,
+		                                      const Color &color);
+
+		/**
+		 * Draw the alpha component of the given vertices and texture to the
+		 * alpha component of the frame buffer, so the next call to any
+		 * "drawMaskedShape..." functions can use the given mask as its
+		 * inverted alpha value.
+		 * @param vertices Vertices to draw.
+		 * @param textureInformation Pointer to the texture information.
+		 * @param textureCoordinates Texture coordinates in the texture to
+		 * draw.
+		 */
+		void drawMaskShapeWithTexture(const VertexArray &vertices,
+		                              const TextureInformation *textureInformation,
+		                              const TextureCoordinates &textureCoordinates);
+
+		/**
+		 * Draw the giver shape masked by using a blend between the alpha
+		 * component of the shape and the inversed alpha component
+		 * of the color buffer. So if a mask has been rendered with any
+		 * "drawMaskShape..." function, the given shape will appear through
+		 * the transparent part of the mask.
+		 * This version of the function render with a texture and a color.
+		 * @param vertices Array of vertices to draw. They have to be like this:
+		 * [x1, y1, x2, y2, x3, y3, ...]. The order must be clockwise.
+		 * @param textureInformation Pointer to the texture information.
+		 * @param textureCoordinates Texture coordinates in the texture to
+		 * draw.
+		 * @param color Color to render.
+		 * @param invertedMask If true, the mask effect will be inverted.
+		 */
+		void drawMaskedShapeWithTextureAndColor(const VertexArray &vertices,
+		                                        const TextureInformation *textureInformation,
+		                                        const TextureCoordinates &textureCoordinates,
+		                                        const Color &color,
+		                                        bool invertedMask = false);
+
+		/**
+		 * Reset the alpha channel to it's original state after a call
+		 * to any "drawMask..." function.
+		 * @param vertices Vertices to draw.
+		 */
+		void unmaskShape(const VertexArray &vertices);
+
+		void drawBatchWithTextureAndColor(const BatchVertexArray &vertices,
+		                                  const TextureInformation *textureInformation,
+		                                  const IndiceArray &indices,
+		                                  const IndiceArrayList &indiceList,
+		                                  VertexBuffer *vertexBuffer = NULL);
+
+		void drawBatchWithTexture(const BatchVertexArray &vertices,
+		                          const TextureInformation *textureInformation,
+		                          const IndiceArray &indices,
+		                          const IndiceArrayList &indiceList,
+		                          VertexBuffer *vertexBuffer = NULL);
+
+		void drawMaskBatchWithTextureAndColor(const BatchVertexArray &vertices,
+		                                      const TextureInformation *textureInformation,
+		                                      const IndiceArray &indices,
+		                                      const IndiceArrayList &indiceList,
+		                                      VertexBuffer *vertexBuffer = NULL);
+
+		void drawMaskedBatchWithTextureAndColor(const BatchVertexArray &vertices,
+		                                        const TextureInformation *textureInformation,
+		                                        const IndiceArray &indices,
+		                                        const IndiceArrayList &indiceList,
+		                                        bool invertedMask,
+		                                        VertexBuffer *vertexBuffer = NULL);
+
+		void unmaskBatch(const BatchVertexArray &vertices,
+		                 const IndiceArray &indices,
+		                 const IndiceArrayList &indiceList,
+		                 VertexBuffer *vertexBuffer = NULL);
+
+		/**
+		 * Prepare the scene before rendering object.
+		 * It clear the draw buffer and reset the transformation matrix with the given
+		 * parameters.
+		 * @param position Shift the matrix using this 2D vector.
+		 * @param angle Apply a rotation to the matrix in degree.
+		 * @param zoom Apply a scale factor to the matrix. 1 is unchanged, less than 1 zoom out,
+		 * more than 1 zoom in.
+		 * @param backgroundColor The scene's background color.
+		 */
+		void prepareScene(const Vector2 &position, float angle,
+		                  const Vector2 &zoom, const Color &backgroundColor);
+
+
+		void initializeGraphicDriver();
+
+		/**
+		 * Pushes the current matrix on the stack.
+		 */
+		void pushMatrix();
+
+		/**
+		 * Applies a translation on the current matrix.
+		 * @param translation 2D translation to apply.
+		 */
+		void translate(const Vector2 &translation);
+
+		/**
+		 * Loads the identity matrix as the current matrix.
+		 */
+		void loadIdentity();
+
+		/**
+		 * Pops the current matrix from the stack.
+		 */
+		void popMatrix();
+
+		/**
+		 * Load a texture into graphic memory.
+		 * @param pixMap A pixmap object containing the buffer the driver must load.
+		 */
+		TextureInformation *loadTexture(PixMap *pixMap);
+
+		/**
+		 * Remove a texture from graphic memory
+		 */
+		void deleteTexture(TextureInformation *textureInfo);
+
+		/**
+		 * Replaces a part of a texture already in graphic memory.
+		 * @param textureInfo Texture to update.
+		 * @param subPixMap Pixels to copy in the texture.
+		 * @param xOffset Horizontal position in the texture where the pixels
+		 * are copied.
+		 * @param yOffset Vertical position in the texture where the pixels
+		 * are copied.
+		 */
+		void updateTexture(TextureInformation *textureInfo,
+		                   const PixMap &subPixMap, unsigned int xOffset,
+		                   unsigned int yOffset);
+
+		/**
+		 * Creates a vertex buffer with the wrapped driver.
+		 * @param usage How often the buffer's content is expected to change.
+		 * @return Pointer to the new vertex buffer, NULL if the wrapped
+		 * driver does not support vertex buffers.
+		 */
+		VertexBuffer *createVertexBuffer(VertexBufferUsage usage);
+
+		/**
+		 * Deletes a vertex buffer with the wrapped driver.
+		 * @param vertexBuffer Vertex buffer to delete.
+		 */
+		void deleteVertexBuffer(VertexBuffer *vertexBuffer);
+
+		/**
+		 * Sets the z layer of the bodies about to be rendered. The queued
+		 * shapes are only reordered within the same layer.
+		 * @param z Z coordinate of the bodies about to be rendered.
+		 */
+		void setCurrentLayer(int z);
+
+		/**
+		 * Flushes the queued shapes. Called once all the bodies of the scene
+		 * have been rendered.
+		 */
+		void finalizeScene();
+
+		/**
+		 * Draws all the queued shapes with the wrapped driver and empties
+		 * the queue.
+		 */
+		void flush();
+
+		/**
+		 * Gets the number of shapes queued during the last flushes since the
+		 * last call to prepareScene.
+		 * @return Number of shapes submitted during the current frame.
+		 */
+		unsigned int getNbQueuedShapes() const;
+
+		/**
+		 * Gets the number of merged draw calls sent to the wrapped driver
+		 * since the last call to prepareScene.
+		 * @return Number of batches drawn during the current frame.
+		 */
+		unsigned int getNbFlushedBatches() const;
+	private:
+		/**
+		 * Shape waiting in the queue.
+		 */
+		struct Command {
+			/**
+			 * Parameterized constructor.
+			 * @param newLayer Layer the shape is on.
+			 * @param newTextureInformation Texture to draw the shape with.
+			 * @param newTextureOrder Order in which the texture was first
+			 * queued.
+			 * @param newBegin Index of the shape's first vertex in the queue.
+			 * @param newNbVertices Number of vertices the shape has.
+			 * @param newColor Color to draw the shape with.
+			 */
+			Command(int newLayer,
+			        const TextureInformation *newTextureInformation,
+			        unsigned int newTextureOrder,
+			        VertexArray::SizeType newBegin,
+			        VertexArray::SizeType newNbVertices,
+			        const Color &newColor);
+
+			/**
+			 * Compares commands by layer and then by the order in which their
+			 * texture was first queued, so the order doesn't depend on where
+			 * the textures are in memory.
+			 * @param other Command to compare with.
+			 * @return True if the command must be drawn before the other.
+			 */
+			bool operator<(const Command &other) const;
+
+			/// Layer the shape is on.
+			int layer;
+
+			/// Texture to draw the shape with.
+			const TextureInformation *textureInformation;
+
+			/// Order in which the texture was first queued since the last flush.
+			unsigned int textureOrder;
+
+			/// Index of the shape's first vertex in the queue's arrays.
+			VertexArray::SizeType begin;
+
+			/// Number of vertices the shape has.
+			VertexArray::SizeType nbVertices;
+
+			/// Color to draw the shape with.
+			Color color;
+		};
+
+		typedef std::vector<Command> CommandList;
+
+		typedef std::map<const TextureInformation *, unsigned int> TextureOrderMap;
+
+		/**
+		 * Parameterized constructor.
+		 * @param newDriver Driver to send the merged draw calls to. The
+		 * deferred driver does not take ownership of it.
+		 */
+		explicit DeferredGraphicDriver(GraphicDriver &newDriver);
+
+		/**
+		 * Destructor.
+		 */
+		~DeferredGraphicDriver();
+
+		/**
+		 * Draws a run of commands that use the same texture as one batch.
+		 * @param first First command of the run.
+		 * @param last Command following the last command of the run.
+		 */
+		void flushRun(CommandList::const_iterator first,
+		              CommandList::const_iterator last);
+
+		/// Driver the merged draw calls are sent to.
+		GraphicDriver &driver;
+
+		/// Shapes waiting to be drawn.
+		CommandList commands;
+
+		/// Order in which the queued shapes' textures were first queued.
+		TextureOrderMap textureOrders;
+
+		/// Vertices of the queued shapes.
+		StandardVertexArray queuedVertices;
+
+		/// Texture coordinates of the queued shapes.
+		TextureCoordinates queuedTextureCoordinates;
+
+		/// Vertices of the batch being flushed.
+		BatchVertexArray batchVertices;
+
+		/// Indices of the batch being flushed.
+		IndiceArray batchIndices;
+
+		/// Segments of the batch being flushed.
+		IndiceArrayList batchIndiceList;
+
+		/// Layer of the bodies currently being rendered.
+		int currentLayer;
+
+		/// Number of shapes queued since the last call to prepareScene.
+		unsigned int nbQueuedShapes;
+
+		/// Number of batches flushed since the last call to prepareScene.
+		unsigned int nbFlushedBatches;
+	};
+}
+
+#endif // RB_DEFERRED_GRAPHIC_DRIVER_H
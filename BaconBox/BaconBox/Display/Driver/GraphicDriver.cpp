@@ -1,12 +1,29 @@
 #include "BaconBox/Display/Driver/GraphicDriver.h"
 
 #include "BaconBox/Engine.h"
+#include "BaconBox/Display/Driver/VertexBuffer.h"
 
 namespace BaconBox {
 	GraphicDriver &GraphicDriver::getInstance() {
 		return Engine::getGraphicDriver();
 	}
 
+	VertexBuffer *GraphicDriver::createVertexBuffer(VertexBufferUsage) {
+		return NULL;
+	}
+
+	void GraphicDriver::deleteVertexBuffer(VertexBuffer *vertexBuffer) {
+		if (vertexBuffer) {
+			delete vertexBuffer;
+		}
+	}
+
+	void GraphicDriver::setCurrentLayer(int) {
+	}
+
+	void GraphicDriver::finalizeScene() {
+	}
+
 	GraphicDriver::GraphicDriver() {
 	}
 
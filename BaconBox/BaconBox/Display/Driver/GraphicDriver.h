@@ -5,14 +5,17 @@
 #ifndef RB_GRAPHIC_DRIVER_H
 #define RB_GRAPHIC_DRIVER_H
 
+#include "BaconBox/Display/Driver/BatchVertex.h"
 #include "BaconBox/Display/Driver/ColorArray.h"
 #include "BaconBox/Display/Driver/IndiceArray.h"
+#include "BaconBox/Display/Driver/VertexBufferUsage.h"
 
 #include "BaconBox/Display/TextureCoordinates.h"
 
 namespace BaconBox {
 	class VertexArray;
 	struct TextureInformation;
+	struct VertexBuffer;
 	class Color;
 	class PixMap;
 	/**
@@ -128,37 +131,35 @@ namespace BaconBox {
 		 */
 		virtual void unmaskShape(const VertexArray &vertices) = 0;
 
-		virtual void drawBatchWithTextureAndColor(const VertexArray &vertices,
+		virtual void drawBatchWithTextureAndColor(const BatchVertexArray &vertices,
 		                                          const TextureInformation *textureInformation,
-		                                          const TextureCoordinates &textureCoordinates,
 												  const IndiceArray &indices,
 												  const IndiceArrayList &indiceList,
-												  const ColorArray &colors) = 0;
+												  VertexBuffer *vertexBuffer = NULL) = 0;
 
-		virtual void drawBatchWithTexture(const VertexArray &vertices,
+		virtual void drawBatchWithTexture(const BatchVertexArray &vertices,
 		                                  const TextureInformation *textureInformation,
-		                                  const TextureCoordinates &textureCoordinates,
 										  const IndiceArray &indices,
-										  const IndiceArrayList &indiceList) = 0;
+										  const IndiceArrayList &indiceList,
+										  VertexBuffer *vertexBuffer = NULL) = 0;
 
-		virtual void drawMaskBatchWithTextureAndColor(const VertexArray &vertices,
+		virtual void drawMaskBatchWithTextureAndColor(const BatchVertexArray &vertices,
 		                                              const TextureInformation *textureInformation,
-		                                              const TextureCoordinates &textureCoordinates,
 													  const IndiceArray &indices,
 													  const IndiceArrayList &indiceList,
-		                                              const ColorArray &colors) = 0;
+		                                              VertexBuffer *vertexBuffer = NULL) = 0;
 
-		virtual void drawMaskedBatchWithTextureAndColor(const VertexArray &vertices,
+		virtual void drawMaskedBatchWithTextureAndColor(const BatchVertexArray &vertices,
 		                                                const TextureInformation *textureInformation,
-		                                                const TextureCoordinates &textureCoordinates,
 														const IndiceArray &indices,
 														const IndiceArrayList &indiceList,
-		                                                const ColorArray &colors,
-		                                                bool invertedMask) = 0;
+		                                                bool invertedMask,
+		                                                VertexBuffer *vertexBuffer = NULL) = 0;
 
-		virtual void unmaskBatch(const VertexArray &vertices,
+		virtual void unmaskBatch(const BatchVertexArray &vertices,
 								 const IndiceArray &indices,
-								 const IndiceArrayList &indiceList) = 0;
+								 const IndiceArrayList &indiceList,
+								 VertexBuffer *vertexBuffer = NULL) = 0;
 
 		/**
 		 * Prepare the scene before rendering object.
@@ -208,6 +209,53 @@ namespace BaconBox {
          *  Remove a texture from graphic memory
          */
         virtual void deleteTexture(TextureInformation * textureInfo) = 0;
+
+		/**
+		 * Replaces a part of a texture already in graphic memory.
+		 * @param textureInfo Texture to update.
+		 * @param subPixMap Pixels to copy in the texture. Must have the same
+		 * color format as the texture.
+		 * @param xOffset Horizontal position in the texture where the pixels
+		 * are copied.
+		 * @param yOffset Vertical position in the texture where the pixels
+		 * are copied.
+		 */
+		virtual void updateTexture(TextureInformation *textureInfo,
+		                           const PixMap &subPixMap,
+		                           unsigned int xOffset,
+		                           unsigned int yOffset) = 0;
+
+		/**
+		 * Creates a buffer in graphic memory used to render a batch. Batches
+		 * given a vertex buffer only upload their modified vertices. Returns
+		 * NULL by default, in which case batches are sent from client memory
+		 * every time they are drawn.
+		 * @param usage How often the buffer's content is expected to change.
+		 * @return Pointer to the new vertex buffer, NULL if the driver does
+		 * not support vertex buffers.
+		 */
+		virtual VertexBuffer *createVertexBuffer(VertexBufferUsage usage);
+
+		/**
+		 * Removes a vertex buffer from graphic memory.
+		 * @param vertexBuffer Vertex buffer created by createVertexBuffer.
+		 */
+		virtual void deleteVertexBuffer(VertexBuffer *vertexBuffer);
+
+		/**
+		 * Sets the z layer of the bodies about to be rendered. Drivers that
+		 * defer their draw calls use it to know which draw calls can be
+		 * reordered. Does nothing by default.
+		 * @param z Z coordinate of the bodies about to be rendered.
+		 */
+		virtual void setCurrentLayer(int z);
+
+		/**
+		 * Called once everything in the scene has been rendered. Drivers that
+		 * defer their draw calls must draw everything left. Does nothing by
+		 * default.
+		 */
+		virtual void finalizeScene();
 	protected:
 		/**
 		 * Default constructor.
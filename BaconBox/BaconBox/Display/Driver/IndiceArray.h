@@ -7,10 +7,25 @@
 #include <vector>
 #include <list>
 
+#include "BaconBox/PlatformFlagger.h"
 #include "BaconBox/Display/StandardVertexArray.h"
 
 namespace BaconBox {
+#ifdef RB_OPENGLES
+	/// OpenGL ES only guarantees 16 bit indices.
 	typedef std::vector<unsigned short> IndiceArray;
+#else
+	/// With 32 bit indices, a batch never needs to be split in segments.
+	typedef std::vector<unsigned int> IndiceArray;
+#endif
+
+	/**
+	 * Segments of a batch's indices, each segment is a pair containing the
+	 * index of its first vertex and the position of its first indice. The
+	 * indices of a segment are relative to its first vertex. There is only
+	 * more than one segment when the batch has more vertices than the
+	 * indices can address.
+	 */
 	typedef std::list<std::pair<StandardVertexArray::SizeType, IndiceArray::size_type> > IndiceArrayList;
 }
 
@@ -1,5 +1,9 @@
 #include "BaconBox/Display/Driver/NullGraphicDriver.h"
 
+#include "BaconBox/Display/PixMap.h"
+#include "BaconBox/Display/TextureInformation.h"
+#include "BaconBox/Helper/MathHelper.h"
+
 namespace BaconBox {
 	NullGraphicDriver &NullGraphicDriver::getInstance() {
 		static NullGraphicDriver instance;
@@ -42,45 +46,43 @@ namespace BaconBox {
 	void NullGraphicDriver::unmaskShape(const VertexArray &) {
 	}
 
-	void NullGraphicDriver::drawBatchWithTextureAndColor(const VertexArray &,
+	void NullGraphicDriver::drawBatchWithTextureAndColor(const BatchVertexArray &,
 	                                                     const TextureInformation *,
-	                                                     const TextureCoordinates &,
 	                                                     const IndiceArray &,
 	                                                     const IndiceArrayList &,
-	                                                     const ColorArray &) {
+	                                                     VertexBuffer *) {
 	}
 
-	void NullGraphicDriver::drawBatchWithTexture(const VertexArray &,
+	void NullGraphicDriver::drawBatchWithTexture(const BatchVertexArray &,
 	                                             const TextureInformation *,
-	                                             const TextureCoordinates &,
 	                                             const IndiceArray &,
-	                                             const IndiceArrayList &) {
+	                                             const IndiceArrayList &,
+	                                             VertexBuffer *) {
 	}
 
-	void NullGraphicDriver::drawMaskBatchWithTextureAndColor(const VertexArray &,
+	void NullGraphicDriver::drawMaskBatchWithTextureAndColor(const BatchVertexArray &,
 	                                                         const TextureInformation *,
-	                                                         const TextureCoordinates &,
 	                                                         const IndiceArray &,
 	                                                         const IndiceArrayList &,
-	                                                         const ColorArray &) {
+	                                                         VertexBuffer *) {
 	}
 
-	void NullGraphicDriver::drawMaskedBatchWithTextureAndColor(const VertexArray &,
+	void NullGraphicDriver::drawMaskedBatchWithTextureAndColor(const BatchVertexArray &,
 	                                                           const TextureInformation *,
-	                                                           const TextureCoordinates &,
 	                                                           const IndiceArray &,
 	                                                           const IndiceArrayList &,
-	                                                           const ColorArray &,
-	                                                           bool) {
+	                                                           bool,
+	                                                           VertexBuffer *) {
 	}
     
     void NullGraphicDriver::deleteTexture(TextureInformation * textureInfo){
         
     }
 
-	void NullGraphicDriver::unmaskBatch(const VertexArray &,
+	void NullGraphicDriver::unmaskBatch(const BatchVertexArray &,
 	                                    const IndiceArray &,
-	                                    const IndiceArrayList &) {
+	                                    const IndiceArrayList &,
+	                                    VertexBuffer *) {
 	}
 
 	void NullGraphicDriver::prepareScene(const Vector2 &, float,
@@ -103,8 +105,21 @@ namespace BaconBox {
 	void NullGraphicDriver::popMatrix() {
 	}
 
-	TextureInformation *NullGraphicDriver::loadTexture(PixMap *) {
-		return NULL;
+	TextureInformation *NullGraphicDriver::loadTexture(PixMap *pixMap) {
+		// Nothing is uploaded, but the texture's sizes are kept so the
+		// tilesets and the sprites can still be built from it.
+		TextureInformation *texInfo = new TextureInformation();
+		texInfo->imageWidth = pixMap->getWidth();
+		texInfo->imageHeight = pixMap->getHeight();
+		texInfo->poweredWidth = MathHelper::nextPowerOf2(pixMap->getWidth());
+		texInfo->poweredHeight = MathHelper::nextPowerOf2(pixMap->getHeight());
+		texInfo->colorFormat = pixMap->getColorFormat();
+		return texInfo;
+	}
+
+	void NullGraphicDriver::updateTexture(TextureInformation *,
+	                                      const PixMap &, unsigned int,
+	                                      unsigned int) {
 	}
 
 	NullGraphicDriver::NullGraphicDriver() {
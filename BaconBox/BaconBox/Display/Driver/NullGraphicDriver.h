@@ -13,6 +13,7 @@ namespace BaconBox {
 	 * @ingroup GraphicDrivers
 	 */
 	class NullGraphicDriver : public GraphicDriver {
+		friend class Engine;
 	public:
 		/**
 		 * Gets the null graphic driver instance.
@@ -117,37 +118,35 @@ namespace BaconBox {
 		 */
 		void unmaskShape(const VertexArray &vertices);
 
-		void drawBatchWithTextureAndColor(const VertexArray &vertices,
+		void drawBatchWithTextureAndColor(const BatchVertexArray &vertices,
 		                                  const TextureInformation *textureInformation,
-		                                  const TextureCoordinates &textureCoordinates,
 		                                  const IndiceArray &indices,
 		                                  const IndiceArrayList &indiceList,
-		                                  const ColorArray &colors);
+		                                  VertexBuffer *vertexBuffer = NULL);
 
-		void drawBatchWithTexture(const VertexArray &vertices,
+		void drawBatchWithTexture(const BatchVertexArray &vertices,
 		                          const TextureInformation *textureInformation,
-		                          const TextureCoordinates &textureCoordinates,
 		                          const IndiceArray &indices,
-		                          const IndiceArrayList &indiceList);
+		                          const IndiceArrayList &indiceList,
+		                          VertexBuffer *vertexBuffer = NULL);
 
-		void drawMaskBatchWithTextureAndColor(const VertexArray &vertices,
+		void drawMaskBatchWithTextureAndColor(const BatchVertexArray &vertices,
 		                                      const TextureInformation *textureInformation,
-		                                      const TextureCoordinates &textureCoordinates,
 		                                      const IndiceArray &indices,
 		                                      const IndiceArrayList &indiceList,
-		                                      const ColorArray &colors);
+		                                      VertexBuffer *vertexBuffer = NULL);
 
-		void drawMaskedBatchWithTextureAndColor(const VertexArray &vertices,
+		void drawMaskedBatchWithTextureAndColor(const BatchVertexArray &vertices,
 		                                        const TextureInformation *textureInformation,
-		                                        const TextureCoordinates &textureCoordinates,
 		                                        const IndiceArray &indices,
 		                                        const IndiceArrayList &indiceList,
-		                                        const ColorArray &colors,
-		                                        bool invertedMask);
+		                                        bool invertedMask,
+		                                        VertexBuffer *vertexBuffer = NULL);
 
-		void unmaskBatch(const VertexArray &vertices,
+		void unmaskBatch(const BatchVertexArray &vertices,
 		                 const IndiceArray &indices,
-		                 const IndiceArrayList &indiceList);
+		                 const IndiceArrayList &indiceList,
+		                 VertexBuffer *vertexBuffer = NULL);
 
 		/**
 		 * Prepare the scene before rendering object.
@@ -187,8 +186,10 @@ namespace BaconBox {
 		void popMatrix();
 
 		/**
-		 * Load a texture into graphic memory.
+		 * Creates the information of a texture without loading it in graphic
+		 * memory, only its sizes and color format are kept.
 		 * @param pixMap A pixmap object containing the buffer the driver must load.
+		 * @return Pointer to the new texture information.
 		 */
 		TextureInformation *loadTexture(PixMap *pixMap);
         
@@ -197,6 +198,19 @@ namespace BaconBox {
          *  Remove a texture from graphic memory
          */
         void deleteTexture(TextureInformation * textureInfo);
+
+		/**
+		 * Replaces a part of a texture already in graphic memory.
+		 * @param textureInfo Texture to update.
+		 * @param subPixMap Pixels to copy in the texture.
+		 * @param xOffset Horizontal position in the texture where the pixels
+		 * are copied.
+		 * @param yOffset Vertical position in the texture where the pixels
+		 * are copied.
+		 */
+		void updateTexture(TextureInformation *textureInfo,
+		                   const PixMap &subPixMap, unsigned int xOffset,
+		                   unsigned int yOffset);
         
 	private:
 		/**
@@ -1,5 +1,8 @@
 #include "BaconBox/Display/Driver/OpenGL/OpenGLDriver.h"
 
+// The fixed pipeline isn't available in OpenGL ES 2.0.
+#ifndef RB_OPENGLES2
+
 #include <stdint.h>
 
 #include "BaconBox/PlatformFlagger.h"
@@ -13,80 +16,86 @@
 
 #define GET_PTR(vertices) reinterpret_cast<const GLfloat *>(&(*vertices.getBegin()))
 #define GET_TEX_PTR(textureCoordinates) reinterpret_cast<const GLfloat *>(&(*textureCoordinates.begin()))
-#define GET_PTR_BATCH(vertices, adjustment) reinterpret_cast<const GLfloat *>(&(*(vertices.getBegin() + adjustment)))
 #define GET_TEX_PTR_BATCH(textureCoordinates, adjustment) reinterpret_cast<const GLfloat *>(&(*(textureCoordinates.begin() + adjustment)))
+#define GET_BUFFER_OFFSET(offset) reinterpret_cast<const GLvoid *>(offset)
+#define BATCH_POSITION_OFFSET 0
+#define BATCH_TEXTURE_COORDINATE_OFFSET sizeof(Vector2)
+#define BATCH_COLOR_OFFSET (sizeof(Vector2) + sizeof(Vector2))
+
+#ifdef RB_OPENGLES
+#define RB_GL_FUNC_ADD GL_FUNC_ADD_OES
+#define RB_GL_MIN GL_MIN_EXT
+#define RB_GL_MAX GL_MAX_EXT
+#else
+#define RB_GL_FUNC_ADD GL_FUNC_ADD
+#define RB_GL_MIN GL_MIN
+#define RB_GL_MAX GL_MAX
+#endif
 
 namespace BaconBox {
+	OpenGLDriver::StateStatistics::StateStatistics() : issuedCalls(0),
+		elidedCalls(0), drawCalls(0), uploadedBytes(0) {
+	}
+
+	OpenGLDriver::RenderState::RenderState() : boundTexture(0),
+		textureEnabled(false), blendEnabled(false), blendSourceRgb(GL_ONE),
+		blendDestinationRgb(GL_ZERO), blendSourceAlpha(GL_ONE),
+		blendDestinationAlpha(GL_ZERO), blendEquationRgb(RB_GL_FUNC_ADD),
+		blendEquationAlpha(RB_GL_FUNC_ADD), vertexArrayEnabled(false),
+		textureCoordinateArrayEnabled(false), colorArrayEnabled(false),
+		arrayBuffer(0), elementBuffer(0), vertexPointer(NULL),
+		textureCoordinatePointer(NULL), colorPointer(NULL),
+		vertexPointerBuffer(0), textureCoordinatePointerBuffer(0),
+		colorPointerBuffer(0), vertexStride(0), textureCoordinateStride(0),
+		colorStride(0), color(Color::WHITE), colorKnown(true) {
+	}
+
 	void OpenGLDriver::drawShapeWithTextureAndColor(const VertexArray &vertices,
 	                                                const TextureInformation *textureInformation,
 	                                                const TextureCoordinates &textureCoordinates,
 	                                                const Color &color) {
-		if (color.getAlpha() > 0u) {
-			glColor4ub(color.getRed(), color.getGreen(), color.getBlue(),
-			           color.getAlpha());
+		// We make sure the texture information is valid.
+		if (color.getAlpha() > 0u && textureInformation) {
+			bindVertexBuffer(NULL);
+			setColor(color);
+
+			bindTexture(textureInformation->textureId);
+			setTextureEnabled(true);
+			setBlendEnabled(true);
+			setBlendEquation(RB_GL_FUNC_ADD, RB_GL_FUNC_ADD);
+			setBlendFunction(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ZERO, GL_ONE);
 
-			drawShapeWithTexture(vertices, textureInformation,
-			                     textureCoordinates);
+			setVertexPointer(GET_PTR(vertices));
+			setTextureCoordinatePointer(GET_TEX_PTR(textureCoordinates));
+			setClientState(GL_COLOR_ARRAY, renderState.colorArrayEnabled, false);
 
-			glColor4ub(Color::WHITE.getRed(), Color::WHITE.getGreen(),
-			           Color::WHITE.getBlue(), Color::WHITE.getAlpha());
+			drawArrays(vertices);
 		}
 	}
 
 	void OpenGLDriver::drawShapeWithTexture(const VertexArray &vertices,
 	                                        const TextureInformation *textureInformation,
 	                                        const TextureCoordinates &textureCoordinates) {
-		// We make sure the texture information is valid.
-		if (textureInformation) {
-			glBindTexture(GL_TEXTURE_2D, textureInformation->textureId);
-
-			glEnable(GL_TEXTURE_2D);
-			glEnable(GL_BLEND);
-#ifdef RB_OPENGLES
-			glBlendFuncSeparateOES(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ZERO, GL_ONE);
-#else
-			glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ZERO, GL_ONE);
-#endif
-
-			glVertexPointer(2, GL_FLOAT, 0, GET_PTR(vertices));
-			glEnableClientState(GL_VERTEX_ARRAY);
-
-			glTexCoordPointer(2, GL_FLOAT, 0, GET_TEX_PTR(textureCoordinates));
-			glEnableClientState(GL_TEXTURE_COORD_ARRAY);
-
-			glDrawArrays(GL_TRIANGLE_STRIP, 0, vertices.getNbVertices());
-
-			glDisableClientState(GL_VERTEX_ARRAY);
-			glDisableClientState(GL_TEXTURE_COORD_ARRAY);
-			glDisable(GL_BLEND);
-			glDisable(GL_TEXTURE_2D);
-
-		}
+		drawShapeWithTextureAndColor(vertices, textureInformation,
+		                             textureCoordinates, Color::WHITE);
 	}
 
 	void OpenGLDriver::drawShapeWithColor(const VertexArray &vertices,
 	                                      const Color &color) {
 		if (color.getAlpha() > 0u) {
-			glColor4ub(color.getRed(), color.getGreen(), color.getBlue(),
-			           color.getAlpha());
-
-			glVertexPointer(2, GL_FLOAT, 0, GET_PTR(vertices));
-			glEnable(GL_BLEND);
-
-#ifdef RB_OPENGLES
-			glBlendFuncSeparateOES(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ZERO, GL_ONE);
-#else
-			glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ZERO, GL_ONE);
-#endif
-			glEnableClientState(GL_VERTEX_ARRAY);
+			bindVertexBuffer(NULL);
+			setColor(color);
 
-			glDrawArrays(GL_TRIANGLE_STRIP, 0, vertices.getNbVertices());
+			setTextureEnabled(false);
+			setBlendEnabled(true);
+			setBlendEquation(RB_GL_FUNC_ADD, RB_GL_FUNC_ADD);
+			setBlendFunction(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ZERO, GL_ONE);
 
-			glDisableClientState(GL_VERTEX_ARRAY);
-			glDisable(GL_BLEND);
+			setVertexPointer(GET_PTR(vertices));
+			setClientState(GL_TEXTURE_COORD_ARRAY, renderState.textureCoordinateArrayEnabled, false);
+			setClientState(GL_COLOR_ARRAY, renderState.colorArrayEnabled, false);
 
-			glColor4ub(Color::WHITE.getRed(), Color::WHITE.getGreen(),
-			           Color::WHITE.getBlue(), Color::WHITE.getAlpha());
+			drawArrays(vertices);
 		}
 	}
 
@@ -94,48 +103,30 @@ namespace BaconBox {
 	                                                    const TextureInformation *textureInformation,
 	                                                    const TextureCoordinates &textureCoordinates,
 	                                                    const Color &color) {
-		if (color.getAlpha() > 0u) {
-			glColor4ub(color.getRed(), color.getGreen(), color.getBlue(),
-			           color.getAlpha());
+		// We make sure the texture information is valid.
+		if (color.getAlpha() > 0u && textureInformation) {
+			bindVertexBuffer(NULL);
+			setColor(color);
+
+			bindTexture(textureInformation->textureId);
+			setTextureEnabled(true);
+			setBlendEnabled(true);
+			setBlendEquation(RB_GL_FUNC_ADD, RB_GL_FUNC_ADD);
+			setBlendFunction(GL_ZERO, GL_ONE, GL_ZERO, GL_SRC_ALPHA);
 
-			drawMaskShapeWithTexture(vertices, textureInformation,
-			                         textureCoordinates);
+			setVertexPointer(GET_PTR(vertices));
+			setTextureCoordinatePointer(GET_TEX_PTR(textureCoordinates));
+			setClientState(GL_COLOR_ARRAY, renderState.colorArrayEnabled, false);
 
-			glColor4ub(Color::WHITE.getRed(), Color::WHITE.getGreen(),
-			           Color::WHITE.getBlue(), Color::WHITE.getAlpha());
+			drawArrays(vertices);
 		}
 	}
 
 	void OpenGLDriver::drawMaskShapeWithTexture(const VertexArray &vertices,
 	                                            const TextureInformation *textureInformation,
 	                                            const TextureCoordinates &textureCoordinates) {
-		// We make sure the texture information is valid.
-		if (textureInformation) {
-			glBindTexture(GL_TEXTURE_2D, textureInformation->textureId);
-
-			glEnable(GL_TEXTURE_2D);
-			glEnable(GL_BLEND);
-
-#ifdef RB_OPENGLES
-			glBlendFuncSeparateOES(GL_ZERO, GL_ONE, GL_ZERO, GL_SRC_ALPHA);
-#else
-			glBlendFuncSeparate(GL_ZERO, GL_ONE, GL_ZERO, GL_SRC_ALPHA);
-#endif
-
-			glVertexPointer(2, GL_FLOAT, 0, GET_PTR(vertices));
-			glEnableClientState(GL_VERTEX_ARRAY);
-
-			glTexCoordPointer(2, GL_FLOAT, 0, GET_TEX_PTR(textureCoordinates));
-			glEnableClientState(GL_TEXTURE_COORD_ARRAY);
-
-			glDrawArrays(GL_TRIANGLE_STRIP, 0, vertices.getNbVertices());
-
-			glDisableClientState(GL_VERTEX_ARRAY);
-			glDisableClientState(GL_TEXTURE_COORD_ARRAY);
-
-			glDisable(GL_BLEND);
-			glDisable(GL_TEXTURE_2D);
-		}
+		drawMaskShapeWithTextureAndColor(vertices, textureInformation,
+		                                 textureCoordinates, Color::WHITE);
 	}
 
 	void OpenGLDriver::drawMaskedShapeWithTextureAndColor(const VertexArray &vertices,
@@ -145,357 +136,223 @@ namespace BaconBox {
 	                                                      bool invertedMask) {
 		if (color.getAlpha() > 0u) {
 			if (textureInformation) {
-
-				glEnable(GL_BLEND);
+				bindVertexBuffer(NULL);
+				setBlendEnabled(true);
+				setVertexPointer(GET_PTR(vertices));
+				setClientState(GL_COLOR_ARRAY, renderState.colorArrayEnabled, false);
 
 				if (invertedMask) {
 					//First render, if are drawing an invered mask, we must prepare the alpha buffer.
-					glDisable(GL_TEXTURE_2D);
-#ifdef RB_OPENGLES
-					glBlendEquationSeparateOES(GL_FUNC_ADD_OES, GL_FUNC_ADD_OES);
-					glBlendFuncSeparateOES(GL_ZERO, GL_ONE, GL_ONE_MINUS_DST_ALPHA, GL_ZERO);
-#else
-					glBlendEquationSeparate(GL_FUNC_ADD, GL_FUNC_ADD);
-					glBlendFuncSeparate(GL_ZERO, GL_ONE, GL_ONE_MINUS_DST_ALPHA, GL_ZERO);
-#endif
-
-					glColor4ub(Color::WHITE.getRed(), Color::WHITE.getGreen(),
-					           Color::WHITE.getBlue(), Color::WHITE.getAlpha());
-
-					glVertexPointer(2, GL_FLOAT, 0, GET_PTR(vertices));
-					glEnableClientState(GL_VERTEX_ARRAY);
-
-					glDrawArrays(GL_TRIANGLE_STRIP, 0, vertices.getNbVertices());
+					setTextureEnabled(false);
+					setClientState(GL_TEXTURE_COORD_ARRAY, renderState.textureCoordinateArrayEnabled, false);
+					setBlendEquation(RB_GL_FUNC_ADD, RB_GL_FUNC_ADD);
+					setBlendFunction(GL_ZERO, GL_ONE, GL_ONE_MINUS_DST_ALPHA, GL_ZERO);
+					setColor(Color::WHITE);
 
+					drawArrays(vertices);
 				}
 
-				glBindTexture(GL_TEXTURE_2D, textureInformation->textureId);
+				bindTexture(textureInformation->textureId);
+				setTextureEnabled(true);
+				setTextureCoordinatePointer(GET_TEX_PTR(textureCoordinates));
 
-				glEnable(GL_TEXTURE_2D);
 				//Second render (we must use the minimum alpha between the source and destination and let the RGB component unchanged).
-#ifdef RB_OPENGLES
-				glBlendEquationSeparateOES(GL_FUNC_ADD_OES, GL_MIN_EXT);
-#else
-				glBlendEquationSeparate(GL_FUNC_ADD, GL_MIN);
-#endif
-				glBlendFunc(GL_ZERO, GL_ONE);
-
-				glVertexPointer(2, GL_FLOAT, 0, GET_PTR(vertices));
-				glEnableClientState(GL_VERTEX_ARRAY);
-
-				glTexCoordPointer(2, GL_FLOAT, 0, GET_TEX_PTR(textureCoordinates));
-				glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+				setBlendEquation(RB_GL_FUNC_ADD, RB_GL_MIN);
+				setBlendFunction(GL_ZERO, GL_ONE, GL_ZERO, GL_ONE);
 
-				glDrawArrays(GL_TRIANGLE_STRIP, 0, vertices.getNbVertices());
+				drawArrays(vertices);
 
 				// Third render, we must render the color according to the buffer alpha channel,
-				glColor4ub(color.getRed(), color.getGreen(), color.getBlue(),
-				           color.getAlpha());
-
-
-#ifdef RB_OPENGLES
-				glBlendEquationOES(GL_FUNC_ADD_OES);
-#else
-				glBlendEquation(GL_FUNC_ADD);
-#endif
-				glBlendFunc(GL_DST_ALPHA, GL_ONE_MINUS_DST_ALPHA);
-
-
-				glDrawArrays(GL_TRIANGLE_STRIP, 0, vertices.getNbVertices());
-
+				setColor(color);
+				setBlendEquation(RB_GL_FUNC_ADD, RB_GL_FUNC_ADD);
+				setBlendFunction(GL_DST_ALPHA, GL_ONE_MINUS_DST_ALPHA, GL_DST_ALPHA, GL_ONE_MINUS_DST_ALPHA);
 
+				drawArrays(vertices);
 
 				//Fourth render, we must reset the alpha channel and leave the RGB channels unchanged.
-				glDisable(GL_TEXTURE_2D);
-#ifdef RB_OPENGLES
-				glBlendFuncSeparateOES(GL_ZERO, GL_ONE, GL_ONE, GL_ZERO);
-#else
-				glBlendFuncSeparate(GL_ZERO, GL_ONE, GL_ONE, GL_ZERO);
-#endif
-				glColor4ub(Color::WHITE.getRed(), Color::WHITE.getGreen(),
-				           Color::WHITE.getBlue(), Color::WHITE.getAlpha());
-
-				glDrawArrays(GL_TRIANGLE_STRIP, 0, vertices.getNbVertices());
-
+				setTextureEnabled(false);
+				setBlendFunction(GL_ZERO, GL_ONE, GL_ONE, GL_ZERO);
+				setColor(Color::WHITE);
 
-				glDisableClientState(GL_VERTEX_ARRAY);
-				glDisableClientState(GL_TEXTURE_COORD_ARRAY);
-				glDisable(GL_BLEND);
+				drawArrays(vertices);
 			}
 		}
 	}
 
 	void OpenGLDriver::unmaskShape(const VertexArray &vertices) {
-		glEnable(GL_BLEND);
-		glVertexPointer(2, GL_FLOAT, 0, GET_PTR(vertices));
-		glEnableClientState(GL_VERTEX_ARRAY);
-
-#ifdef RB_OPENGLES
-		glBlendFuncSeparateOES(GL_ZERO, GL_ONE, GL_ONE, GL_ONE);
-#else
-		glBlendFuncSeparate(GL_ZERO, GL_ONE, GL_ONE, GL_ONE);
-#endif
-		glColor4ub(Color::WHITE.getRed(), Color::WHITE.getGreen(),
-		           Color::WHITE.getBlue(), Color::WHITE.getAlpha());
-
-
-
-		glDrawArrays(GL_TRIANGLE_STRIP, 0, vertices.getNbVertices());
-
-		glDisableClientState(GL_VERTEX_ARRAY);
-		glDisable(GL_BLEND);
+		bindVertexBuffer(NULL);
+		setTextureEnabled(false);
+		setBlendEnabled(true);
+		setBlendEquation(RB_GL_FUNC_ADD, RB_GL_FUNC_ADD);
+		setBlendFunction(GL_ZERO, GL_ONE, GL_ONE, GL_ONE);
+		setColor(Color::WHITE);
+
+		setVertexPointer(GET_PTR(vertices));
+		setClientState(GL_TEXTURE_COORD_ARRAY, renderState.textureCoordinateArrayEnabled, false);
+		setClientState(GL_COLOR_ARRAY, renderState.colorArrayEnabled, false);
+
+		drawArrays(vertices);
 	}
 
-	void OpenGLDriver::drawBatchWithTextureAndColor(const VertexArray &vertices,
+	void OpenGLDriver::drawBatchWithTextureAndColor(const BatchVertexArray &vertices,
 	                                                const TextureInformation *textureInformation,
-	                                                const TextureCoordinates &textureCoordinates,
 	                                                const IndiceArray &indices,
 	                                                const IndiceArrayList &indiceList,
-	                                                const ColorArray &colors) {
-		for (IndiceArrayList::const_iterator i = indiceList.begin();
-		     i != indiceList.end(); ++i) {
-			glEnableClientState(GL_COLOR_ARRAY);
-			glColorPointer(4,
-			               GL_UNSIGNED_BYTE,
-			               0,
-			               GET_TEX_PTR_BATCH(colors, i->first));
-
-			glBindTexture(GL_TEXTURE_2D, textureInformation->textureId);
-
-			glEnable(GL_TEXTURE_2D);
-			glEnable(GL_BLEND);
-
-#ifdef RB_OPENGLES
-			glBlendFuncSeparateOES(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ZERO, GL_ONE);
-#else
-			glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ZERO, GL_ONE);
-#endif
-
-			glEnableClientState(GL_VERTEX_ARRAY);
-			glEnableClientState(GL_TEXTURE_COORD_ARRAY);
-
-			glVertexPointer(2, GL_FLOAT, 0, GET_PTR_BATCH(vertices, i->first));
-			glTexCoordPointer(2, GL_FLOAT, 0, GET_TEX_PTR_BATCH(textureCoordinates, i->first));
+	                                                VertexBuffer *vertexBuffer) {
+		uploadVertexBuffer(vertexBuffer, vertices, indices);
 
-			if (i == --indiceList.end()) {
-				glDrawElements(GL_TRIANGLE_STRIP, indices.size() - i->second, GL_UNSIGNED_SHORT, GET_TEX_PTR_BATCH(indices, i->second));
+		bindTexture(textureInformation->textureId);
+		setTextureEnabled(true);
+		setBlendEnabled(true);
+		setBlendEquation(RB_GL_FUNC_ADD, RB_GL_FUNC_ADD);
+		setBlendFunction(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ZERO, GL_ONE);
 
-			} else {
-				glDrawElements(GL_TRIANGLE_STRIP, (++IndiceArrayList::const_iterator(i))->second - i->second, GL_UNSIGNED_SHORT, GET_TEX_PTR_BATCH(indices, i->second));
-			}
+		for (IndiceArrayList::const_iterator i = indiceList.begin();
+		     i != indiceList.end(); ++i) {
+			setBatchPointers(vertices, true, true, vertexBuffer, i->first);
 
-			glDisable(GL_BLEND);
-			glDisable(GL_TEXTURE_2D);
-			glDisableClientState(GL_VERTEX_ARRAY);
-			glDisableClientState(GL_TEXTURE_COORD_ARRAY);
-			glDisableClientState(GL_COLOR_ARRAY);
+			drawElements(indices, indiceList, i);
 		}
 	}
 
-	void OpenGLDriver::drawBatchWithTexture(const VertexArray &vertices,
+	void OpenGLDriver::drawBatchWithTexture(const BatchVertexArray &vertices,
 	                                        const TextureInformation *textureInformation,
-	                                        const TextureCoordinates &textureCoordinates,
 	                                        const IndiceArray &indices,
-	                                        const IndiceArrayList &indiceList) {
+	                                        const IndiceArrayList &indiceList,
+	                                        VertexBuffer *vertexBuffer) {
+		uploadVertexBuffer(vertexBuffer, vertices, indices);
+
+		setColor(Color::WHITE);
+		bindTexture(textureInformation->textureId);
+		setTextureEnabled(true);
+		setBlendEnabled(true);
+		setBlendEquation(RB_GL_FUNC_ADD, RB_GL_FUNC_ADD);
+		setBlendFunction(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ZERO, GL_ONE);
+		setClientState(GL_COLOR_ARRAY, renderState.colorArrayEnabled, false);
+
 		for (IndiceArrayList::const_iterator i = indiceList.begin();
 		     i != indiceList.end(); ++i) {
-			glBindTexture(GL_TEXTURE_2D, textureInformation->textureId);
-
-			glEnable(GL_TEXTURE_2D);
-			glEnable(GL_BLEND);
-
-#ifdef RB_OPENGLES
-			glBlendFuncSeparateOES(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ZERO, GL_ONE);
-#else
-			glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ZERO, GL_ONE);
-#endif
-
-			glEnableClientState(GL_VERTEX_ARRAY);
-			glEnableClientState(GL_TEXTURE_COORD_ARRAY);
-
-			glVertexPointer(2, GL_FLOAT, 0, GET_PTR_BATCH(vertices, i->first));
-			glTexCoordPointer(2, GL_FLOAT, 0, GET_TEX_PTR_BATCH(textureCoordinates, i->first));
-
-			if (i == --indiceList.end()) {
-				glDrawElements(GL_TRIANGLE_STRIP, indices.size() - i->second, GL_UNSIGNED_SHORT, GET_TEX_PTR_BATCH(indices, i->second));
-
-			} else {
-				glDrawElements(GL_TRIANGLE_STRIP, (++IndiceArrayList::const_iterator(i))->second - i->second, GL_UNSIGNED_SHORT, GET_TEX_PTR_BATCH(indices, i->second));
-			}
+			setBatchPointers(vertices, true, false, vertexBuffer, i->first);
 
-			glDisable(GL_BLEND);
-			glDisable(GL_TEXTURE_2D);
-			glDisableClientState(GL_VERTEX_ARRAY);
-			glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+			drawElements(indices, indiceList, i);
 		}
 	}
 
-	void OpenGLDriver::drawMaskBatchWithTextureAndColor(const VertexArray &vertices,
+	void OpenGLDriver::drawMaskBatchWithTextureAndColor(const BatchVertexArray &vertices,
 	                                                    const TextureInformation *textureInformation,
-	                                                    const TextureCoordinates &textureCoordinates,
 	                                                    const IndiceArray &indices,
 	                                                    const IndiceArrayList &indiceList,
-	                                                    const ColorArray &/*colors*/) {
-		// TODO: Check if there is a reason we're not using the "colors"
-		// parameter.
-
-		for (IndiceArrayList::const_iterator i = indiceList.begin();
-		     i != indiceList.end(); ++i) {
-			// We make sure the texture information is valid.
-			if (textureInformation) {
-				glBindTexture(GL_TEXTURE_2D, textureInformation->textureId);
-
-				glEnable(GL_TEXTURE_2D);
-				glEnable(GL_BLEND);
+	                                                    VertexBuffer *vertexBuffer) {
+		// TODO: Check if there is a reason we're not using the vertices'
+		// colors to draw.
 
-#ifdef RB_OPENGLES
-				glBlendFuncSeparateOES(GL_ZERO, GL_ONE, GL_ZERO, GL_SRC_ALPHA);
-#else
-				glBlendFuncSeparate(GL_ZERO, GL_ONE, GL_ZERO, GL_SRC_ALPHA);
-#endif
-				glVertexPointer(2, GL_FLOAT, 0, GET_PTR_BATCH(vertices, i->first));
-				glEnableClientState(GL_VERTEX_ARRAY);
-
-				glTexCoordPointer(2, GL_FLOAT, 0, GET_TEX_PTR_BATCH(textureCoordinates, i->first));
-				glEnableClientState(GL_TEXTURE_COORD_ARRAY);
-
-				if (i == --indiceList.end()) {
-					glDrawElements(GL_TRIANGLE_STRIP, indices.size() - i->second, GL_UNSIGNED_SHORT, GET_TEX_PTR_BATCH(indices, i->second));
+		// We make sure the texture information is valid.
+		if (textureInformation) {
+			uploadVertexBuffer(vertexBuffer, vertices, indices);
 
-				} else {
-					glDrawElements(GL_TRIANGLE_STRIP, (++IndiceArrayList::const_iterator(i))->second - i->second, GL_UNSIGNED_SHORT, GET_TEX_PTR_BATCH(indices, i->second));
-				}
+			setColor(Color::WHITE);
+			bindTexture(textureInformation->textureId);
+			setTextureEnabled(true);
+			setBlendEnabled(true);
+			setBlendEquation(RB_GL_FUNC_ADD, RB_GL_FUNC_ADD);
+			setBlendFunction(GL_ZERO, GL_ONE, GL_ZERO, GL_SRC_ALPHA);
+			setClientState(GL_COLOR_ARRAY, renderState.colorArrayEnabled, false);
 
-				glDisableClientState(GL_VERTEX_ARRAY);
-				glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+			for (IndiceArrayList::const_iterator i = indiceList.begin();
+			     i != indiceList.end(); ++i) {
+				setBatchPointers(vertices, true, false, vertexBuffer, i->first);
 
-				glDisable(GL_BLEND);
-				glDisable(GL_TEXTURE_2D);
+				drawElements(indices, indiceList, i);
 			}
 		}
 	}
 
-	void OpenGLDriver::drawMaskedBatchWithTextureAndColor(const VertexArray &vertices,
+	void OpenGLDriver::drawMaskedBatchWithTextureAndColor(const BatchVertexArray &vertices,
 	                                                      const TextureInformation *textureInformation,
-	                                                      const TextureCoordinates &textureCoordinates,
 	                                                      const IndiceArray &indices,
 	                                                      const IndiceArrayList &indiceList,
-	                                                      const ColorArray &colors,
-	                                                      bool invertedMask) {
-#ifdef RB_OPENGLES
-		glBindFramebufferOES(GL_FRAMEBUFFER_OES, maskedFramebuffer);
-#else
-		glBindFramebufferEXT(GL_FRAMEBUFFER_EXT, maskedFramebuffer);
-#endif
-#ifdef RB_OPENGLES
-		glFramebufferTexture2DOES(GL_FRAMEBUFFER_OES, GL_COLOR_ATTACHMENT0_OES,
-		                          GL_TEXTURE_2D, maskedTexture, 0);
-#else
-		glFramebufferTexture2DEXT(GL_FRAMEBUFFER_EXT, GL_COLOR_ATTACHMENT0_EXT,
-		                          GL_TEXTURE_2D, maskedTexture, 0);
-#endif
-		glPushMatrix();
-		glLoadIdentity();
-
-		glColor4ub(0, 0, 0, 0);
-		glVertexPointer(2, GL_FLOAT, 0, GET_PTR(maskedGraphic->getVertices()));
-		glEnableClientState(GL_VERTEX_ARRAY);
-		glEnable(GL_BLEND);
-		glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-		glPopMatrix();
-		glColor4ub(255, 255, 255, 255);
-		for (IndiceArrayList::const_iterator i = indiceList.begin();
-		     i != indiceList.end(); ++i) {
-
-			glEnableClientState(GL_COLOR_ARRAY);
-			glColorPointer(4,
-			               GL_UNSIGNED_BYTE,
-			               0,
-			               GET_TEX_PTR_BATCH(colors, i->first));
+	                                                      bool invertedMask,
+	                                                      VertexBuffer *vertexBuffer) {
+		// We use the same renders as drawMaskedShapeWithTextureAndColor,
+		// with the vertices' colors instead of a single color.
+		if (textureInformation) {
+			uploadVertexBuffer(vertexBuffer, vertices, indices);
 
-			glBindTexture(GL_TEXTURE_2D, textureInformation->textureId);
+			setBlendEnabled(true);
+			setClientState(GL_COLOR_ARRAY, renderState.colorArrayEnabled, false);
 
-			glEnable(GL_TEXTURE_2D);
-			glEnable(GL_BLEND);
+			if (invertedMask) {
+				// First render, the alpha buffer is inverted.
+				setTextureEnabled(false);
+				setClientState(GL_TEXTURE_COORD_ARRAY, renderState.textureCoordinateArrayEnabled, false);
+				setBlendEquation(RB_GL_FUNC_ADD, RB_GL_FUNC_ADD);
+				setBlendFunction(GL_ZERO, GL_ONE, GL_ONE_MINUS_DST_ALPHA, GL_ZERO);
+				setColor(Color::WHITE);
 
-#ifdef RB_OPENGLES
-			glBlendEquationSeparateOES(GL_FUNC_ADD_OES, GL_MAX_EXT);
-			glBlendFuncSeparateOES(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ZERO);
-#else
-			glBlendEquationSeparate(GL_FUNC_ADD, GL_MAX);
-			glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ZERO);
-#endif
+				drawBatchSegments(vertices, indices, indiceList, false, false,
+				                  vertexBuffer);
+			}
 
-			glEnableClientState(GL_VERTEX_ARRAY);
-			glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+			bindTexture(textureInformation->textureId);
+			setTextureEnabled(true);
 
-			glVertexPointer(2, GL_FLOAT, 0, GET_PTR_BATCH(vertices, i->first));
-			glTexCoordPointer(2, GL_FLOAT, 0, GET_TEX_PTR_BATCH(textureCoordinates, i->first));
+			// Second render, we keep the minimum alpha between the source
+			// and the destination.
+			setBlendEquation(RB_GL_FUNC_ADD, RB_GL_MIN);
+			setBlendFunction(GL_ZERO, GL_ONE, GL_ZERO, GL_ONE);
 
-			if (i == --indiceList.end()) {
-				glDrawElements(GL_TRIANGLE_STRIP, indices.size() - i->second, GL_UNSIGNED_SHORT, GET_TEX_PTR_BATCH(indices, i->second));
+			drawBatchSegments(vertices, indices, indiceList, true, true,
+			                  vertexBuffer);
 
-			} else {
-				glDrawElements(GL_TRIANGLE_STRIP, (++IndiceArrayList::const_iterator(i))->second - i->second, GL_UNSIGNED_SHORT, GET_TEX_PTR_BATCH(indices, i->second));
-			}
+			// Third render, the colors are rendered according to the alpha
+			// buffer.
+			setBlendEquation(RB_GL_FUNC_ADD, RB_GL_FUNC_ADD);
+			setBlendFunction(GL_DST_ALPHA, GL_ONE_MINUS_DST_ALPHA, GL_DST_ALPHA, GL_ONE_MINUS_DST_ALPHA);
 
-#ifdef RB_OPENGLES
-			glBlendEquationOES(GL_FUNC_ADD_OES);
-#else
-			glBlendEquation(GL_FUNC_ADD);
-#endif
+			drawBatchSegments(vertices, indices, indiceList, true, true,
+			                  vertexBuffer);
 
-			glDisable(GL_BLEND);
-			glDisable(GL_TEXTURE_2D);
-			glDisableClientState(GL_VERTEX_ARRAY);
-			glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+			// Fourth render, the alpha channel is reset.
+			setTextureEnabled(false);
+			setBlendFunction(GL_ZERO, GL_ONE, GL_ONE, GL_ZERO);
+			setColor(Color::WHITE);
+			setClientState(GL_TEXTURE_COORD_ARRAY, renderState.textureCoordinateArrayEnabled, false);
+			setClientState(GL_COLOR_ARRAY, renderState.colorArrayEnabled, false);
 
-			glDisableClientState(GL_COLOR_ARRAY);
+			drawBatchSegments(vertices, indices, indiceList, false, false,
+			                  vertexBuffer);
 		}
-
-		drawMaskedShapeWithTextureAndColor(maskedGraphic->getVertices(),
-		                                   maskedGraphic->getTextureInformation(),
-		                                   maskedGraphic->getCurrentTextureCoordinates(),
-		                                   maskedGraphic->getColor(),
-		                                   invertedMask);
-
-		glPopMatrix();
 	}
 
-	void OpenGLDriver::unmaskBatch(const VertexArray &vertices,
+	void OpenGLDriver::unmaskBatch(const BatchVertexArray &vertices,
 	                               const IndiceArray &indices,
-	                               const IndiceArrayList &indiceList) {
-		glEnable(GL_BLEND);
+	                               const IndiceArrayList &indiceList,
+	                               VertexBuffer *vertexBuffer) {
+		uploadVertexBuffer(vertexBuffer, vertices, indices);
+
+		setColor(Color::WHITE);
+		setTextureEnabled(false);
+		setBlendEnabled(true);
+		setBlendEquation(RB_GL_FUNC_ADD, RB_GL_FUNC_ADD);
+		setBlendFunction(GL_ZERO, GL_ONE, GL_ONE, GL_ONE);
+		setClientState(GL_TEXTURE_COORD_ARRAY, renderState.textureCoordinateArrayEnabled, false);
+		setClientState(GL_COLOR_ARRAY, renderState.colorArrayEnabled, false);
 
 		for (IndiceArrayList::const_iterator i = indiceList.begin();
 		     i != indiceList.end(); ++i) {
-			glVertexPointer(2, GL_FLOAT, 0, GET_PTR_BATCH(vertices, i->first));
-			glEnableClientState(GL_VERTEX_ARRAY);
-
-#ifdef RB_OPENGLES
-			glBlendFuncSeparateOES(GL_ZERO, GL_ONE, GL_ONE, GL_ONE);
-#else
-			glBlendFuncSeparate(GL_ZERO, GL_ONE, GL_ONE, GL_ONE);
-#endif
-			glColor4ub(Color::WHITE.getRed(), Color::WHITE.getGreen(),
-			           Color::WHITE.getBlue(), Color::WHITE.getAlpha());
-
-			if (i == --indiceList.end()) {
-				glDrawElements(GL_TRIANGLE_STRIP, indices.size() - i->second, GL_UNSIGNED_SHORT, GET_TEX_PTR_BATCH(indices, i->second));
-
-			} else {
-				glDrawElements(GL_TRIANGLE_STRIP, (++IndiceArrayList::const_iterator(i))->second - i->second, GL_UNSIGNED_SHORT, GET_TEX_PTR_BATCH(indices, i->second));
-			}
+			setBatchPointers(vertices, false, false, vertexBuffer, i->first);
 
-			glDisableClientState(GL_VERTEX_ARRAY);
+			drawElements(indices, indiceList, i);
 		}
-
-		glDisable(GL_BLEND);
 	}
 
 	void OpenGLDriver::prepareScene(const Vector2 &position, float angle,
 	                                const Vector2 &zoom,
 	                                const Color &backgroundColor) {
+		// A new frame begins.
+		lastFrameStatistics = currentFrameStatistics;
+		currentFrameStatistics = StateStatistics();
+
 		glClearColor(clampColorComponent(backgroundColor.getRed()),
 		             clampColorComponent(backgroundColor.getGreen()),
 		             clampColorComponent(backgroundColor.getBlue()),
@@ -528,6 +385,10 @@ namespace BaconBox {
 	}
 
 	void OpenGLDriver::initializeGraphicDriver() {
+		// We start from a known state, the cache might not match OpenGL's
+		// state anymore when the driver is initialized again.
+		resetRenderState();
+
 		glShadeModel(GL_FLAT);
 
 		if (MainWindow::getInstance().getOrientation() == WindowOrientation::NORMAL ||
@@ -608,10 +469,16 @@ namespace BaconBox {
 
 		if (maskedTextureInformation) {
 			glDeleteTextures(1, &maskedTexture);
+
+			// OpenGL reverts the binding to 0 when the bound texture is
+			// deleted and the new texture might get the same name.
+			if (renderState.boundTexture == maskedTexture) {
+				renderState.boundTexture = 0;
+			}
 		}
 
 		glGenTextures(1, &maskedTexture);
-		glBindTexture(GL_TEXTURE_2D, maskedTexture);
+		bindTexture(maskedTexture);
 
 		if (maskedTextureInformation) {
 			delete maskedTextureInformation;
@@ -647,6 +514,15 @@ namespace BaconBox {
 		glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
 		
 		glClear(GL_COLOR_BUFFER_BIT);
+
+#ifdef RB_GLEW
+		// Vertex buffer objects are part of the core since OpenGL 1.5.
+		vertexBuffersSupported = GLEW_VERSION_1_5 == GL_TRUE;
+#else
+		vertexBuffersSupported = true;
+#endif
+
+		resetRenderState();
 	}
 
 	void OpenGLDriver::pushMatrix() {
@@ -668,6 +544,11 @@ namespace BaconBox {
     
     void OpenGLDriver::deleteTexture(TextureInformation * textureInfo){
         glDeleteTextures(1, &(textureInfo->textureId));
+
+		// OpenGL reverts the binding to 0 when the bound texture is deleted.
+		if (renderState.boundTexture == textureInfo->textureId) {
+			renderState.boundTexture = 0;
+		}
     }
 
 	TextureInformation *OpenGLDriver::loadTexture(PixMap *pixMap) {
@@ -675,7 +556,7 @@ namespace BaconBox {
 
 		TextureInformation *texInfo = new TextureInformation();
 		glGenTextures(1, &(texInfo->textureId));
-		glBindTexture(GL_TEXTURE_2D, texInfo->textureId);
+		bindTexture(texInfo->textureId);
 
 
 
@@ -720,11 +601,465 @@ namespace BaconBox {
 		return texInfo;
 	}
 
+	void OpenGLDriver::updateTexture(TextureInformation *textureInfo,
+	                                 const PixMap &subPixMap,
+	                                 unsigned int xOffset,
+	                                 unsigned int yOffset) {
+		bindTexture(textureInfo->textureId);
+
+		GLenum format = (subPixMap.getColorFormat() == ColorFormat::ALPHA) ? GL_ALPHA : GL_RGBA;
+
+		// The rows of an alpha pixmap are not always aligned on 4 bytes.
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		glTexSubImage2D(GL_TEXTURE_2D, 0, xOffset, yOffset,
+		                subPixMap.getWidth(), subPixMap.getHeight(), format,
+		                GL_UNSIGNED_BYTE, subPixMap.getBuffer());
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	}
+
+	VertexBuffer *OpenGLDriver::createVertexBuffer(VertexBufferUsage usage) {
+		VertexBuffer *result = NULL;
+
+		if (vertexBuffersSupported) {
+			result = new VertexBuffer(usage);
+			glGenBuffers(1, &(result->vertexBufferId));
+			glGenBuffers(1, &(result->indexBufferId));
+		}
+
+		return result;
+	}
+
+	void OpenGLDriver::deleteVertexBuffer(VertexBuffer *vertexBuffer) {
+		if (vertexBuffer) {
+			// OpenGL reverts the bindings to 0 when the bound buffers are
+			// deleted.
+			if (renderState.arrayBuffer == vertexBuffer->vertexBufferId) {
+				renderState.arrayBuffer = 0;
+			}
+
+			if (renderState.elementBuffer == vertexBuffer->indexBufferId) {
+				renderState.elementBuffer = 0;
+			}
+
+			// The pointers set in the deleted buffer must be set again.
+			if (renderState.vertexPointerBuffer == vertexBuffer->vertexBufferId) {
+				renderState.vertexPointer = NULL;
+				renderState.vertexPointerBuffer = 0;
+			}
+
+			if (renderState.textureCoordinatePointerBuffer == vertexBuffer->vertexBufferId) {
+				renderState.textureCoordinatePointer = NULL;
+				renderState.textureCoordinatePointerBuffer = 0;
+			}
+
+			if (renderState.colorPointerBuffer == vertexBuffer->vertexBufferId) {
+				renderState.colorPointer = NULL;
+				renderState.colorPointerBuffer = 0;
+			}
+
+			glDeleteBuffers(1, &(vertexBuffer->vertexBufferId));
+			glDeleteBuffers(1, &(vertexBuffer->indexBufferId));
+			delete vertexBuffer;
+		}
+	}
+
+	const OpenGLDriver::StateStatistics &OpenGLDriver::getLastFrameStatistics() const {
+		return lastFrameStatistics;
+	}
+
+	const OpenGLDriver::StateStatistics &OpenGLDriver::getCurrentFrameStatistics() const {
+		return currentFrameStatistics;
+	}
+
 	float OpenGLDriver::clampColorComponent(unsigned short component) {
 		return static_cast<float>(component) / static_cast<float>(Color::MAX_COMPONENT_VALUE);
 	}
 
-	OpenGLDriver::OpenGLDriver() : GraphicDriver(), maskedTexture(0),
+	void OpenGLDriver::resetRenderState() {
+		renderState = RenderState();
+
+		glBindTexture(GL_TEXTURE_2D, renderState.boundTexture);
+		glDisable(GL_TEXTURE_2D);
+		glDisable(GL_BLEND);
+#ifdef RB_OPENGLES
+		glBlendEquationSeparateOES(renderState.blendEquationRgb, renderState.blendEquationAlpha);
+		glBlendFuncSeparateOES(renderState.blendSourceRgb, renderState.blendDestinationRgb,
+		                       renderState.blendSourceAlpha, renderState.blendDestinationAlpha);
+#else
+		glBlendEquationSeparate(renderState.blendEquationRgb, renderState.blendEquationAlpha);
+		glBlendFuncSeparate(renderState.blendSourceRgb, renderState.blendDestinationRgb,
+		                    renderState.blendSourceAlpha, renderState.blendDestinationAlpha);
+#endif
+		if (vertexBuffersSupported) {
+			glBindBuffer(GL_ARRAY_BUFFER, renderState.arrayBuffer);
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, renderState.elementBuffer);
+		}
+
+		glDisableClientState(GL_VERTEX_ARRAY);
+		glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+		glDisableClientState(GL_COLOR_ARRAY);
+		glVertexPointer(2, GL_FLOAT, 0, renderState.vertexPointer);
+		glTexCoordPointer(2, GL_FLOAT, 0, renderState.textureCoordinatePointer);
+		glColorPointer(4, GL_UNSIGNED_BYTE, 0, renderState.colorPointer);
+		glColor4ub(renderState.color.getRed(), renderState.color.getGreen(),
+		           renderState.color.getBlue(), renderState.color.getAlpha());
+	}
+
+	void OpenGLDriver::bindTexture(GLuint textureId) {
+		bool issued = renderState.boundTexture != textureId;
+
+		if (issued) {
+			glBindTexture(GL_TEXTURE_2D, textureId);
+			renderState.boundTexture = textureId;
+		}
+
+		countStateChange(issued);
+	}
+
+	void OpenGLDriver::setTextureEnabled(bool enabled) {
+		bool issued = renderState.textureEnabled != enabled;
+
+		if (issued) {
+			if (enabled) {
+				glEnable(GL_TEXTURE_2D);
+
+			} else {
+				glDisable(GL_TEXTURE_2D);
+			}
+
+			renderState.textureEnabled = enabled;
+		}
+
+		countStateChange(issued);
+	}
+
+	void OpenGLDriver::setBlendEnabled(bool enabled) {
+		bool issued = renderState.blendEnabled != enabled;
+
+		if (issued) {
+			if (enabled) {
+				glEnable(GL_BLEND);
+
+			} else {
+				glDisable(GL_BLEND);
+			}
+
+			renderState.blendEnabled = enabled;
+		}
+
+		countStateChange(issued);
+	}
+
+	void OpenGLDriver::setBlendFunction(GLenum sourceRgb, GLenum destinationRgb,
+	                                   GLenum sourceAlpha, GLenum destinationAlpha) {
+		bool issued = renderState.blendSourceRgb != sourceRgb ||
+		              renderState.blendDestinationRgb != destinationRgb ||
+		              renderState.blendSourceAlpha != sourceAlpha ||
+		              renderState.blendDestinationAlpha != destinationAlpha;
+
+		if (issued) {
+#ifdef RB_OPENGLES
+			glBlendFuncSeparateOES(sourceRgb, destinationRgb, sourceAlpha, destinationAlpha);
+#else
+			glBlendFuncSeparate(sourceRgb, destinationRgb, sourceAlpha, destinationAlpha);
+#endif
+			renderState.blendSourceRgb = sourceRgb;
+			renderState.blendDestinationRgb = destinationRgb;
+			renderState.blendSourceAlpha = sourceAlpha;
+			renderState.blendDestinationAlpha = destinationAlpha;
+		}
+
+		countStateChange(issued);
+	}
+
+	void OpenGLDriver::setBlendEquation(GLenum equationRgb, GLenum equationAlpha) {
+		bool issued = renderState.blendEquationRgb != equationRgb ||
+		              renderState.blendEquationAlpha != equationAlpha;
+
+		if (issued) {
+#ifdef RB_OPENGLES
+			glBlendEquationSeparateOES(equationRgb, equationAlpha);
+#else
+			glBlendEquationSeparate(equationRgb, equationAlpha);
+#endif
+			renderState.blendEquationRgb = equationRgb;
+			renderState.blendEquationAlpha = equationAlpha;
+		}
+
+		countStateChange(issued);
+	}
+
+	void OpenGLDriver::bindArrayBuffer(GLuint bufferId) {
+		bool issued = renderState.arrayBuffer != bufferId;
+
+		if (issued) {
+			glBindBuffer(GL_ARRAY_BUFFER, bufferId);
+			renderState.arrayBuffer = bufferId;
+		}
+
+		countStateChange(issued);
+	}
+
+	void OpenGLDriver::bindElementBuffer(GLuint bufferId) {
+		bool issued = renderState.elementBuffer != bufferId;
+
+		if (issued) {
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, bufferId);
+			renderState.elementBuffer = bufferId;
+		}
+
+		countStateChange(issued);
+	}
+
+	void OpenGLDriver::bindVertexBuffer(const VertexBuffer *vertexBuffer) {
+		// Without vertex buffers, nothing is ever bound.
+		if (vertexBuffersSupported) {
+			if (vertexBuffer) {
+				bindArrayBuffer(vertexBuffer->vertexBufferId);
+				bindElementBuffer(vertexBuffer->indexBufferId);
+
+			} else {
+				bindArrayBuffer(0);
+				bindElementBuffer(0);
+			}
+		}
+	}
+
+	void OpenGLDriver::uploadVertexBuffer(VertexBuffer *vertexBuffer,
+	                                      const BatchVertexArray &vertices,
+	                                      const IndiceArray &indices) {
+		bindVertexBuffer(vertexBuffer);
+
+		if (vertexBuffer) {
+			GLenum usage = (vertexBuffer->usage == VertexBufferUsage::STATIC) ? GL_STATIC_DRAW : GL_DYNAMIC_DRAW;
+			VertexArray::SizeType nbVertices = vertices.size();
+
+			if (nbVertices > vertexBuffer->capacity ||
+			    (vertexBuffer->usage == VertexBufferUsage::DYNAMIC &&
+			     vertexBuffer->dirtyBegin == 0 && vertexBuffer->dirtyEnd >= nbVertices)) {
+				// We (re)allocate the buffer's storage when it is too small.
+				// When all the vertices of a dynamic buffer are rewritten, it
+				// orphans the storage the GPU might still be reading from
+				// instead of waiting for it.
+				if (nbVertices > vertexBuffer->capacity) {
+					vertexBuffer->capacity = VertexBuffer::getGrownCapacity(vertexBuffer->capacity, nbVertices);
+				}
+
+				glBufferData(GL_ARRAY_BUFFER,
+				             vertexBuffer->capacity * sizeof(BatchVertex),
+				             NULL, usage);
+
+				// Only the used part of the storage is uploaded.
+				uploadVertexRange(vertices, 0, nbVertices);
+
+			} else if (vertexBuffer->isDirty() &&
+			           vertexBuffer->dirtyBegin < nbVertices) {
+				// We only upload the vertices that were modified.
+				VertexArray::SizeType dirtyEnd = (vertexBuffer->dirtyEnd < nbVertices) ? vertexBuffer->dirtyEnd : nbVertices;
+				uploadVertexRange(vertices, vertexBuffer->dirtyBegin,
+				                  dirtyEnd - vertexBuffer->dirtyBegin);
+			}
+
+			if (vertexBuffer->indicesDirty) {
+				VertexArray::SizeType nbIndices = indices.size();
+
+				if (nbIndices > vertexBuffer->indexCapacity) {
+					vertexBuffer->indexCapacity = VertexBuffer::getGrownCapacity(vertexBuffer->indexCapacity, nbIndices);
+					glBufferData(GL_ELEMENT_ARRAY_BUFFER,
+					             vertexBuffer->indexCapacity * sizeof(IndiceArray::value_type),
+					             NULL, usage);
+				}
+
+				if (nbIndices) {
+					glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0,
+					                nbIndices * sizeof(IndiceArray::value_type),
+					                &indices.front());
+					currentFrameStatistics.uploadedBytes += nbIndices * sizeof(IndiceArray::value_type);
+				}
+			}
+
+			vertexBuffer->clean();
+		}
+	}
+
+	void OpenGLDriver::uploadVertexRange(const BatchVertexArray &vertices,
+	                                     VertexArray::SizeType first,
+	                                     VertexArray::SizeType nbVertices) {
+		if (nbVertices) {
+			// The vertices are interleaved, so the range is contiguous.
+			glBufferSubData(GL_ARRAY_BUFFER, first * sizeof(BatchVertex),
+			                nbVertices * sizeof(BatchVertex), &vertices[first]);
+			currentFrameStatistics.uploadedBytes += nbVertices * sizeof(BatchVertex);
+		}
+	}
+
+	void OpenGLDriver::setBatchPointers(const BatchVertexArray &vertices,
+	                                    bool textureCoordinates, bool colors,
+	                                    const VertexBuffer *vertexBuffer,
+	                                    VertexArray::SizeType first) {
+		// The attributes are read at their offset in the first vertex, with
+		// the size of a whole vertex as the stride.
+		const GLubyte *base;
+
+		if (vertexBuffer) {
+			base = reinterpret_cast<const GLubyte *>(GET_BUFFER_OFFSET(first * sizeof(BatchVertex)));
+
+		} else {
+			base = reinterpret_cast<const GLubyte *>(&vertices[first]);
+		}
+
+		setVertexPointer(base + BATCH_POSITION_OFFSET, sizeof(BatchVertex));
+
+		if (textureCoordinates) {
+			setTextureCoordinatePointer(base + BATCH_TEXTURE_COORDINATE_OFFSET,
+			                            sizeof(BatchVertex));
+		}
+
+		if (colors) {
+			setColorPointer(base + BATCH_COLOR_OFFSET, sizeof(BatchVertex));
+		}
+	}
+
+	void OpenGLDriver::drawBatchSegments(const BatchVertexArray &vertices,
+	                                     const IndiceArray &indices,
+	                                     const IndiceArrayList &indiceList,
+	                                     bool textureCoordinates, bool colors,
+	                                     const VertexBuffer *vertexBuffer) {
+		for (IndiceArrayList::const_iterator i = indiceList.begin();
+		     i != indiceList.end(); ++i) {
+			setBatchPointers(vertices, textureCoordinates, colors,
+			                 vertexBuffer, i->first);
+
+			drawElements(indices, indiceList, i);
+		}
+	}
+
+	void OpenGLDriver::setClientState(GLenum clientState, bool &cached,
+	                                  bool enabled) {
+		bool issued = cached != enabled;
+
+		if (issued) {
+			if (enabled) {
+				glEnableClientState(clientState);
+
+			} else {
+				glDisableClientState(clientState);
+			}
+
+			cached = enabled;
+		}
+
+		countStateChange(issued);
+	}
+
+	void OpenGLDriver::setVertexPointer(const GLvoid *pointer, GLsizei stride) {
+		bool issued = renderState.vertexPointer != pointer ||
+		              renderState.vertexPointerBuffer != renderState.arrayBuffer ||
+		              renderState.vertexStride != stride;
+
+		if (issued) {
+			glVertexPointer(2, GL_FLOAT, stride, pointer);
+			renderState.vertexPointer = pointer;
+			renderState.vertexPointerBuffer = renderState.arrayBuffer;
+			renderState.vertexStride = stride;
+		}
+
+		countStateChange(issued);
+		setClientState(GL_VERTEX_ARRAY, renderState.vertexArrayEnabled, true);
+	}
+
+	void OpenGLDriver::setTextureCoordinatePointer(const GLvoid *pointer, GLsizei stride) {
+		bool issued = renderState.textureCoordinatePointer != pointer ||
+		              renderState.textureCoordinatePointerBuffer != renderState.arrayBuffer ||
+		              renderState.textureCoordinateStride != stride;
+
+		if (issued) {
+			glTexCoordPointer(2, GL_FLOAT, stride, pointer);
+			renderState.textureCoordinatePointer = pointer;
+			renderState.textureCoordinatePointerBuffer = renderState.arrayBuffer;
+			renderState.textureCoordinateStride = stride;
+		}
+
+		countStateChange(issued);
+		setClientState(GL_TEXTURE_COORD_ARRAY, renderState.textureCoordinateArrayEnabled, true);
+	}
+
+	void OpenGLDriver::setColorPointer(const GLvoid *pointer, GLsizei stride) {
+		bool issued = renderState.colorPointer != pointer ||
+		              renderState.colorPointerBuffer != renderState.arrayBuffer ||
+		              renderState.colorStride != stride;
+
+		if (issued) {
+			glColorPointer(4, GL_UNSIGNED_BYTE, stride, pointer);
+			renderState.colorPointer = pointer;
+			renderState.colorPointerBuffer = renderState.arrayBuffer;
+			renderState.colorStride = stride;
+		}
+
+		countStateChange(issued);
+		setClientState(GL_COLOR_ARRAY, renderState.colorArrayEnabled, true);
+	}
+
+	void OpenGLDriver::setColor(const Color &color) {
+		bool issued = !renderState.colorKnown || renderState.color != color;
+
+		if (issued) {
+			glColor4ub(color.getRed(), color.getGreen(), color.getBlue(),
+			           color.getAlpha());
+			renderState.color = color;
+			renderState.colorKnown = true;
+		}
+
+		countStateChange(issued);
+	}
+
+	void OpenGLDriver::countStateChange(bool issued) {
+		if (issued) {
+			++currentFrameStatistics.issuedCalls;
+
+		} else {
+			++currentFrameStatistics.elidedCalls;
+		}
+	}
+
+	void OpenGLDriver::drawArrays(const VertexArray &vertices) {
+		glDrawArrays(GL_TRIANGLE_STRIP, 0, vertices.getNbVertices());
+		++currentFrameStatistics.drawCalls;
+	}
+
+	void OpenGLDriver::drawElements(const IndiceArray &indices,
+	                                const IndiceArrayList &indiceList,
+	                                IndiceArrayList::const_iterator i) {
+		// When an element buffer is bound, the indices are an offset in it.
+		const GLvoid *indicesPointer;
+
+		if (renderState.elementBuffer) {
+			indicesPointer = GET_BUFFER_OFFSET(i->second * sizeof(IndiceArray::value_type));
+
+		} else {
+			indicesPointer = GET_TEX_PTR_BATCH(indices, i->second);
+		}
+
+		// The batches' indices are triangle lists.
+		if (i == --indiceList.end()) {
+			glDrawElements(GL_TRIANGLES, indices.size() - i->second, RB_GL_INDICE_TYPE, indicesPointer);
+
+		} else {
+			glDrawElements(GL_TRIANGLES, (++IndiceArrayList::const_iterator(i))->second - i->second, RB_GL_INDICE_TYPE, indicesPointer);
+		}
+
+		++currentFrameStatistics.drawCalls;
+
+		// OpenGL's current color is undefined after drawing with a color
+		// array.
+		if (renderState.colorArrayEnabled) {
+			renderState.colorKnown = false;
+		}
+	}
+
+	OpenGLDriver::OpenGLDriver() : GraphicDriver(), renderState(),
+		currentFrameStatistics(), lastFrameStatistics(),
+		vertexBuffersSupported(false), maskedTexture(0),
 		maskedFramebuffer(0), originalFramebuffer(0), maskedGraphic(NULL),
 		maskedTextureInformation(NULL) {
 	}
@@ -739,3 +1074,5 @@ namespace BaconBox {
 		}
 	}
 }
+
+#endif
@@ -9,6 +9,8 @@
 #include "BaconBox/Display/Driver/OpenGL/RBOpenGL.h"
 #include "BaconBox/Display/Graphic.h"
 #include "BaconBox/Display/Inanimate.h"
+#include "BaconBox/Display/Color.h"
+#include "BaconBox/Display/Driver/VertexBuffer.h"
 
 namespace BaconBox {
 	/**
@@ -18,6 +20,30 @@ namespace BaconBox {
 	class OpenGLDriver : public GraphicDriver {
 		friend class Engine;
 	public:
+		/**
+		 * Counters about the OpenGL state changes requested by the driver.
+		 * Every state change goes through the driver's state cache, which
+		 * only forwards it to OpenGL when it actually changes something.
+		 */
+		struct StateStatistics {
+			/**
+			 * Default constructor. Initializes all the counters to 0.
+			 */
+			StateStatistics();
+
+			/// Number of state changing calls forwarded to OpenGL.
+			unsigned int issuedCalls;
+
+			/// Number of redundant state changing calls that were skipped.
+			unsigned int elidedCalls;
+
+			/// Number of draw calls (glDrawArrays and glDrawElements).
+			unsigned int drawCalls;
+
+			/// Number of bytes uploaded to vertex buffers.
+			unsigned int uploadedBytes;
+		};
+
 		/**
 		 * Draw a colored and textured shape with the given vertices, texture
 		 * coordinate, rendering informations (colors array and texture) and
@@ -113,37 +139,35 @@ namespace BaconBox {
 		 */
 		void unmaskShape(const VertexArray &vertices);
 
-		void drawBatchWithTextureAndColor(const VertexArray &vertices,
+		void drawBatchWithTextureAndColor(const BatchVertexArray &vertices,
 		                                  const TextureInformation *textureInformation,
-		                                  const TextureCoordinates &textureCoordinates,
 										  const IndiceArray &indices,
 										  const IndiceArrayList &indiceList,
-		                                  const ColorArray &colors);
+		                                  VertexBuffer *vertexBuffer = NULL);
 
-		void drawBatchWithTexture(const VertexArray &vertices,
+		void drawBatchWithTexture(const BatchVertexArray &vertices,
 		                          const TextureInformation *textureInformation,
-		                          const TextureCoordinates &textureCoordinates,
 								  const IndiceArray &indices,
-								  const IndiceArrayList &indiceList);
+								  const IndiceArrayList &indiceList,
+								  VertexBuffer *vertexBuffer = NULL);
 
-		void drawMaskBatchWithTextureAndColor(const VertexArray &vertices,
+		void drawMaskBatchWithTextureAndColor(const BatchVertexArray &vertices,
 		                                      const TextureInformation *textureInformation,
-		                                      const TextureCoordinates &textureCoordinates,
 											  const IndiceArray &indices,
 											  const IndiceArrayList &indiceList,
-		                                      const ColorArray &colors);
+		                                      VertexBuffer *vertexBuffer = NULL);
 
-		void drawMaskedBatchWithTextureAndColor(const VertexArray &vertices,
+		void drawMaskedBatchWithTextureAndColor(const BatchVertexArray &vertices,
 		                                        const TextureInformation *textureInformation,
-		                                        const TextureCoordinates &textureCoordinates,
 												const IndiceArray &indices,
 												const IndiceArrayList &indiceList,
-		                                        const ColorArray &colors,
-		                                        bool invertedMask);
+		                                        bool invertedMask,
+		                                        VertexBuffer *vertexBuffer = NULL);
 
-		void unmaskBatch(const VertexArray &vertices,
+		void unmaskBatch(const BatchVertexArray &vertices,
 						 const IndiceArray &indices,
-						 const IndiceArrayList &indiceList);
+						 const IndiceArrayList &indiceList,
+						 VertexBuffer *vertexBuffer = NULL);
 
 		/**
 		 * Prepare the scene before rendering object.
@@ -192,9 +216,335 @@ namespace BaconBox {
          *  Remove a texture from graphic memory
          */
         void deleteTexture(TextureInformation * textureInfo);
+
+		/**
+		 * Replaces a part of a texture already in graphic memory.
+		 * @param textureInfo Texture to update.
+		 * @param subPixMap Pixels to copy in the texture.
+		 * @param xOffset Horizontal position in the texture where the pixels
+		 * are copied.
+		 * @param yOffset Vertical position in the texture where the pixels
+		 * are copied.
+		 */
+		void updateTexture(TextureInformation *textureInfo,
+		                   const PixMap &subPixMap, unsigned int xOffset,
+		                   unsigned int yOffset);
+
+		/**
+		 * Creates a vertex buffer object and an element buffer object to
+		 * render a batch. The buffer contains the batch's vertices, followed
+		 * by its texture coordinates and then its colors.
+		 * @param usage How often the buffer's content is expected to change.
+		 * @return Pointer to the new vertex buffer, NULL if OpenGL doesn't
+		 * support vertex buffer objects.
+		 */
+		VertexBuffer *createVertexBuffer(VertexBufferUsage usage);
+
+		/**
+		 * Removes a vertex buffer from graphic memory.
+		 * @param vertexBuffer Vertex buffer to delete.
+		 */
+		void deleteVertexBuffer(VertexBuffer *vertexBuffer);
+
+		/**
+		 * Gets the statistics of the last completed frame. A frame ends when
+		 * prepareScene is called.
+		 * @return Counters of the last completed frame.
+		 */
+		const StateStatistics &getLastFrameStatistics() const;
+
+		/**
+		 * Gets the statistics of the frame currently being rendered.
+		 * @return Counters of the current frame.
+		 */
+		const StateStatistics &getCurrentFrameStatistics() const;
 	private:
+		/**
+		 * Shadow copy of the OpenGL state the driver modifies. Used to skip
+		 * the calls that would not change anything.
+		 */
+		struct RenderState {
+			/**
+			 * Default constructor. Initializes the state to OpenGL's initial
+			 * state.
+			 */
+			RenderState();
+
+			/// Texture currently bound to GL_TEXTURE_2D.
+			GLuint boundTexture;
+
+			/// Whether or not GL_TEXTURE_2D is enabled.
+			bool textureEnabled;
+
+			/// Whether or not GL_BLEND is enabled.
+			bool blendEnabled;
+
+			/// Source factor for the RGB components.
+			GLenum blendSourceRgb;
+
+			/// Destination factor for the RGB components.
+			GLenum blendDestinationRgb;
+
+			/// Source factor for the alpha component.
+			GLenum blendSourceAlpha;
+
+			/// Destination factor for the alpha component.
+			GLenum blendDestinationAlpha;
+
+			/// Blend equation for the RGB components.
+			GLenum blendEquationRgb;
+
+			/// Blend equation for the alpha component.
+			GLenum blendEquationAlpha;
+
+			/// Whether or not GL_VERTEX_ARRAY is enabled.
+			bool vertexArrayEnabled;
+
+			/// Whether or not GL_TEXTURE_COORD_ARRAY is enabled.
+			bool textureCoordinateArrayEnabled;
+
+			/// Whether or not GL_COLOR_ARRAY is enabled.
+			bool colorArrayEnabled;
+
+			/// Buffer currently bound to GL_ARRAY_BUFFER.
+			GLuint arrayBuffer;
+
+			/// Buffer currently bound to GL_ELEMENT_ARRAY_BUFFER.
+			GLuint elementBuffer;
+
+			/// Pointer last given to glVertexPointer.
+			const GLvoid *vertexPointer;
+
+			/// Pointer last given to glTexCoordPointer.
+			const GLvoid *textureCoordinatePointer;
+
+			/// Pointer last given to glColorPointer.
+			const GLvoid *colorPointer;
+
+			/// Array buffer that was bound when the vertex pointer was set.
+			GLuint vertexPointerBuffer;
+
+			/// Array buffer that was bound when the texture coordinate pointer
+			/// was set.
+			GLuint textureCoordinatePointerBuffer;
+
+			/// Array buffer that was bound when the color pointer was set.
+			GLuint colorPointerBuffer;
+
+			/// Stride last given to glVertexPointer.
+			GLsizei vertexStride;
+
+			/// Stride last given to glTexCoordPointer.
+			GLsizei textureCoordinateStride;
+
+			/// Stride last given to glColorPointer.
+			GLsizei colorStride;
+
+			/// Current color set with glColor4ub.
+			Color color;
+
+			/**
+			 * Set to false when OpenGL's current color is undefined (after
+			 * drawing with a color array).
+			 */
+			bool colorKnown;
+		};
+
 		static float clampColorComponent(unsigned short component);
 
+		/**
+		 * Forces OpenGL's state to the one the cache assumes by default.
+		 * Must be called when the context is (re)initialized.
+		 */
+		void resetRenderState();
+
+		/**
+		 * Binds a texture to GL_TEXTURE_2D if it isn't already bound.
+		 * @param textureId Texture to bind.
+		 */
+		void bindTexture(GLuint textureId);
+
+		/**
+		 * Enables or disables GL_TEXTURE_2D if needed.
+		 * @param enabled Whether or not texturing is enabled.
+		 */
+		void setTextureEnabled(bool enabled);
+
+		/**
+		 * Enables or disables GL_BLEND if needed.
+		 * @param enabled Whether or not blending is enabled.
+		 */
+		void setBlendEnabled(bool enabled);
+
+		/**
+		 * Sets the blending factors if they're different from the current
+		 * ones.
+		 * @param sourceRgb Source factor for the RGB components.
+		 * @param destinationRgb Destination factor for the RGB components.
+		 * @param sourceAlpha Source factor for the alpha component.
+		 * @param destinationAlpha Destination factor for the alpha component.
+		 */
+		void setBlendFunction(GLenum sourceRgb, GLenum destinationRgb,
+		                      GLenum sourceAlpha, GLenum destinationAlpha);
+
+		/**
+		 * Sets the blending equations if they're different from the current
+		 * ones.
+		 * @param equationRgb Equation for the RGB components.
+		 * @param equationAlpha Equation for the alpha component.
+		 */
+		void setBlendEquation(GLenum equationRgb, GLenum equationAlpha);
+
+		/**
+		 * Binds a buffer to GL_ARRAY_BUFFER if it isn't already bound.
+		 * @param bufferId Buffer to bind, 0 to use client memory.
+		 */
+		void bindArrayBuffer(GLuint bufferId);
+
+		/**
+		 * Binds a buffer to GL_ELEMENT_ARRAY_BUFFER if it isn't already bound.
+		 * @param bufferId Buffer to bind, 0 to use client memory.
+		 */
+		void bindElementBuffer(GLuint bufferId);
+
+		/**
+		 * Binds the vertex buffer's array and element buffers.
+		 * @param vertexBuffer Vertex buffer to bind. If NULL, the pointers
+		 * given to OpenGL point to client memory.
+		 */
+		void bindVertexBuffer(const VertexBuffer *vertexBuffer);
+
+		/**
+		 * Binds the vertex buffer and uploads the batch's modified vertices
+		 * and indices in it. Static buffers only receive their dirty range,
+		 * dynamic buffers are orphaned and receive the whole batch.
+		 * @param vertexBuffer Vertex buffer of the batch. If NULL, client
+		 * memory is used.
+		 * @param vertices Batch's interleaved vertices.
+		 * @param indices Batch's indices.
+		 */
+		void uploadVertexBuffer(VertexBuffer *vertexBuffer,
+		                        const BatchVertexArray &vertices,
+		                        const IndiceArray &indices);
+
+		/**
+		 * Uploads a range of the batch's vertices in the bound vertex buffer.
+		 * @param vertices Batch's interleaved vertices.
+		 * @param first Index of the first vertex to upload.
+		 * @param nbVertices Number of vertices to upload.
+		 */
+		void uploadVertexRange(const BatchVertexArray &vertices,
+		                       VertexArray::SizeType first,
+		                       VertexArray::SizeType nbVertices);
+
+		/**
+		 * Sets the pointers for one of the batch's segments, either in the
+		 * bound vertex buffer or in client memory.
+		 * @param vertices Batch's interleaved vertices.
+		 * @param textureCoordinates Whether or not the texture coordinate
+		 * array is used.
+		 * @param colors Whether or not the color array is used.
+		 * @param vertexBuffer Vertex buffer currently bound, NULL if client
+		 * memory is used.
+		 * @param first Index of the segment's first vertex.
+		 */
+		void setBatchPointers(const BatchVertexArray &vertices,
+		                      bool textureCoordinates, bool colors,
+		                      const VertexBuffer *vertexBuffer,
+		                      VertexArray::SizeType first);
+
+		/**
+		 * Enables or disables a client state if needed.
+		 * @param clientState GL_VERTEX_ARRAY, GL_TEXTURE_COORD_ARRAY or
+		 * GL_COLOR_ARRAY.
+		 * @param cached Cached value of the client state.
+		 * @param enabled Whether or not the client state is enabled.
+		 */
+		void setClientState(GLenum clientState, bool &cached, bool enabled);
+
+		/**
+		 * Sets the vertex pointer and enables the vertex array.
+		 * @param pointer Pointer to the first vertex.
+		 * @param stride Byte offset between consecutive vertices, 0 if they
+		 * are tightly packed.
+		 */
+		void setVertexPointer(const GLvoid *pointer, GLsizei stride = 0);
+
+		/**
+		 * Sets the texture coordinate pointer and enables the texture
+		 * coordinate array.
+		 * @param pointer Pointer to the first texture coordinate.
+		 * @param stride Byte offset between consecutive texture coordinates,
+		 * 0 if they are tightly packed.
+		 */
+		void setTextureCoordinatePointer(const GLvoid *pointer,
+		                                 GLsizei stride = 0);
+
+		/**
+		 * Sets the color pointer and enables the color array.
+		 * @param pointer Pointer to the first color.
+		 * @param stride Byte offset between consecutive colors, 0 if they
+		 * are tightly packed.
+		 */
+		void setColorPointer(const GLvoid *pointer, GLsizei stride = 0);
+
+		/**
+		 * Sets the current color if it's different from the current one.
+		 * @param color Color to use.
+		 */
+		void setColor(const Color &color);
+
+		/**
+		 * Takes note of a state change that was either issued or skipped.
+		 * @param issued True if the call was forwarded to OpenGL.
+		 */
+		void countStateChange(bool issued);
+
+		/**
+		 * Draws the shape with the state currently set.
+		 * @param vertices Vertices to draw.
+		 */
+		void drawArrays(const VertexArray &vertices);
+
+		/**
+		 * Draws one of the batch's segments with the state currently set.
+		 * @param indices Batch's indices.
+		 * @param indiceList Segments of the batch.
+		 * @param i Segment to draw.
+		 */
+		void drawElements(const IndiceArray &indices,
+		                  const IndiceArrayList &indiceList,
+		                  IndiceArrayList::const_iterator i);
+
+		/**
+		 * Draws all of the batch's segments with the state currently set.
+		 * @param vertices Batch's interleaved vertices.
+		 * @param indices Batch's indices.
+		 * @param indiceList Segments of the batch.
+		 * @param textureCoordinates Whether or not the texture coordinate
+		 * array is used.
+		 * @param colors Whether or not the color array is used.
+		 * @param vertexBuffer Vertex buffer currently bound, NULL if client
+		 * memory is used.
+		 */
+		void drawBatchSegments(const BatchVertexArray &vertices,
+		                       const IndiceArray &indices,
+		                       const IndiceArrayList &indiceList,
+		                       bool textureCoordinates, bool colors,
+		                       const VertexBuffer *vertexBuffer);
+
+		/// Cached OpenGL state.
+		RenderState renderState;
+
+		/// Counters for the frame being rendered.
+		StateStatistics currentFrameStatistics;
+
+		/// Counters for the last completed frame.
+		StateStatistics lastFrameStatistics;
+
+		/// Set to true if OpenGL supports vertex buffer objects.
+		bool vertexBuffersSupported;
+
 		GLuint maskedTexture;
 		GLuint maskedFramebuffer;
 		GLuint originalFramebuffer;
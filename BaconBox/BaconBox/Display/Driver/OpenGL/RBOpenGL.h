@@ -9,13 +9,19 @@
 #include <OpenGL/OpenGL.h>
 #endif
 
-#if defined(RB_IPHONE_PLATFORM)
+#if defined(RB_IPHONE_PLATFORM) && defined(RB_OPENGLES2)
+#import <OpenGLES/ES2/gl.h>
+#import <OpenGLES/ES2/glext.h>
+#elif defined(RB_IPHONE_PLATFORM)
 #import <OpenGLES/ES1/gl.h>
 #import <OpenGLES/ES1/glext.h>
 #elif defined(RB_QT)
 #include <QtOpenGL>
 #elif defined(RB_MAC_PLATFORM)
 #include <OpenGL/gl.h>
+#elif defined(RB_ANDROID) && defined(RB_OPENGLES2)
+#include <GLES2/gl2.h>
+#include <GLES2/gl2ext.h>
 #elif defined(RB_ANDROID)
 #include <GLES/gl.h>
 #include <GLES/glext.h>
@@ -25,6 +31,13 @@
 #define RB_GLEW
 #endif
 
+// OpenGL ES only guarantees 16 bit indices, must match IndiceArray.
+#ifdef RB_OPENGLES
+#define RB_GL_INDICE_TYPE GL_UNSIGNED_SHORT
+#else
+#define RB_GL_INDICE_TYPE GL_UNSIGNED_INT
+#endif
+
 #endif
 
 #endif
@@ -0,0 +1,843 @@
+#include "BaconBox/Display/Driver/OpenGL/ShaderDriver.h"
+
+#if defined (RB_OPENGL) || defined (RB_OPENGLES2)
+
+#include <cmath>
+
+#include "BaconBox/Display/TextureInformation.h"
+#include "BaconBox/Helper/MathHelper.h"
+#include "BaconBox/Display/Window/MainWindow.h"
+#include "BaconBox/Display/Color.h"
+#include "BaconBox/Display/PixMap.h"
+#include "BaconBox/Console.h"
+
+namespace BaconBox {
+	/// Attribute location of the vertices' position.
+	static const GLuint POSITION_ATTRIBUTE = 0;
+
+	/// Attribute location of the vertices' texture coordinate.
+	static const GLuint TEXTURE_COORDINATE_ATTRIBUTE = 1;
+
+	/// Attribute location of the vertices' color.
+	static const GLuint COLOR_ATTRIBUTE = 2;
+
+	/// Source of the vertex shader shared by all the programs.
+	static const char *VERTEX_SHADER_SOURCE =
+	    "uniform mat4 projection;\n"
+	    "attribute vec2 position;\n"
+	    "attribute vec2 textureCoordinate;\n"
+	    "attribute vec4 color;\n"
+	    "varying vec2 fragmentTextureCoordinate;\n"
+	    "varying vec4 fragmentColor;\n"
+	    "void main() {\n"
+	    "	fragmentTextureCoordinate = textureCoordinate;\n"
+	    "	fragmentColor = color;\n"
+	    "	gl_Position = projection * vec4(position, 0.0, 1.0);\n"
+	    "}\n";
+
+	/**
+	 * Source of the fragment shader. RB_ALPHA_TEXTURE is defined for the
+	 * textures that only have an alpha component (to do the same as the
+	 * fixed pipeline's GL_MODULATE), RB_MASKED is defined to limit the alpha
+	 * with the mask texture.
+	 */
+	static const char *FRAGMENT_SHADER_SOURCE =
+	    "#ifdef GL_ES\n"
+	    "precision mediump float;\n"
+	    "#endif\n"
+	    "uniform sampler2D spriteTexture;\n"
+	    "varying vec2 fragmentTextureCoordinate;\n"
+	    "varying vec4 fragmentColor;\n"
+	    "#ifdef RB_MASKED\n"
+	    "uniform sampler2D maskTexture;\n"
+	    "uniform vec2 maskScale;\n"
+	    "uniform float invertedMask;\n"
+	    "#endif\n"
+	    "void main() {\n"
+	    "	vec4 texel = texture2D(spriteTexture, fragmentTextureCoordinate);\n"
+	    "#ifdef RB_ALPHA_TEXTURE\n"
+	    "	gl_FragColor = vec4(fragmentColor.rgb, fragmentColor.a * texel.a);\n"
+	    "#else\n"
+	    "	gl_FragColor = fragmentColor * texel;\n"
+	    "#endif\n"
+	    "#ifdef RB_MASKED\n"
+	    "	float mask = texture2D(maskTexture, gl_FragCoord.xy * maskScale).a;\n"
+	    "	gl_FragColor.a = min(gl_FragColor.a, mix(mask, 1.0 - mask, invertedMask));\n"
+	    "#endif\n"
+	    "}\n";
+
+	/// Preprocessor definitions of each program, by program index.
+	static const char *PROGRAM_DEFINES[] = {
+		"",
+		"#define RB_ALPHA_TEXTURE\n",
+		"#define RB_MASKED\n",
+		"#define RB_ALPHA_TEXTURE\n#define RB_MASKED\n"
+	};
+
+	ShaderDriver::Transform::Transform() : a(1.0f), b(0.0f), c(0.0f),
+		d(1.0f), x(0.0f), y(0.0f) {
+	}
+
+	ShaderDriver::Transform::Transform(GLfloat newA, GLfloat newB,
+	                                   GLfloat newC, GLfloat newD,
+	                                   GLfloat newX, GLfloat newY) : a(newA),
+		b(newB), c(newC), d(newD), x(newX), y(newY) {
+	}
+
+	ShaderDriver::Transform ShaderDriver::Transform::translation(GLfloat x,
+	                                                             GLfloat y) {
+		return Transform(1.0f, 0.0f, 0.0f, 1.0f, x, y);
+	}
+
+	ShaderDriver::Transform ShaderDriver::Transform::rotation(GLfloat angle) {
+		GLfloat radians = angle * MathHelper::AngleConvert<GLfloat>::DEGREES_TO_RADIANS;
+		GLfloat cosine = std::cos(radians), sine = std::sin(radians);
+		return Transform(cosine, sine, -sine, cosine, 0.0f, 0.0f);
+	}
+
+	ShaderDriver::Transform ShaderDriver::Transform::scaling(GLfloat x,
+	                                                         GLfloat y) {
+		return Transform(x, 0.0f, 0.0f, y, 0.0f, 0.0f);
+	}
+
+	ShaderDriver::Transform ShaderDriver::Transform::operator*(const Transform &other) const {
+		return Transform(a * other.a + c * other.b,
+		                 b * other.a + d * other.b,
+		                 a * other.c + c * other.d,
+		                 b * other.c + d * other.d,
+		                 a * other.x + c * other.y + x,
+		                 b * other.x + d * other.y + y);
+	}
+
+	bool ShaderDriver::Transform::isIdentity() const {
+		return a == 1.0f && b == 0.0f && c == 0.0f && d == 1.0f &&
+		       x == 0.0f && y == 0.0f;
+	}
+
+	const Vector2 ShaderDriver::Transform::apply(const Vector2 &point) const {
+		return Vector2(a * point.x + c * point.y + x,
+		               b * point.x + d * point.y + y);
+	}
+
+	ShaderDriver::Transform ShaderDriver::getSceneTransform(WindowOrientation orientation,
+	                                                        float contextWidth,
+	                                                        float contextHeight,
+	                                                        const Vector2 &position,
+	                                                        float angle,
+	                                                        const Vector2 &zoom) {
+		// We apply the same transformations as the fixed pipeline driver
+		// does on its model view matrix.
+		Transform result;
+
+		switch (orientation.underlying()) {
+		case WindowOrientation::HORIZONTAL_LEFT:
+			result = Transform::rotation(-90.0f) *
+			         Transform::translation(-contextWidth, 0.0f);
+			break;
+
+		case WindowOrientation::HORIZONTAL_RIGHT:
+			result = Transform::rotation(90.0f) *
+			         Transform::translation(0.0f, -contextHeight);
+			break;
+
+		default:
+			break;
+		}
+
+		return result *
+		       Transform::scaling(zoom.x, zoom.y) *
+		       Transform::rotation(angle) *
+		       Transform::translation(-position.x, -position.y);
+	}
+
+	ShaderDriver::Transform ShaderDriver::getTranslation(const Vector2 &translation) {
+		// Same as the fixed pipeline driver, the translation is applied in
+		// the opposite direction.
+		return Transform::translation(-translation.x, -translation.y);
+	}
+
+	void ShaderDriver::getProjection(WindowOrientation orientation,
+	                                 float contextWidth, float contextHeight,
+	                                 GLfloat projection[16]) {
+		float left = 0.0f, right = 0.0f, bottom = 0.0f, top = 0.0f;
+
+		if (orientation == WindowOrientation::NORMAL) {
+			right = contextWidth;
+			bottom = contextHeight;
+
+		} else if (orientation == WindowOrientation::UPSIDE_DOWN) {
+			right = contextWidth;
+			top = contextHeight;
+
+		} else {
+			left = contextHeight;
+			top = contextWidth;
+		}
+
+		for (unsigned int i = 0; i < 16; ++i) {
+			projection[i] = 0.0f;
+		}
+
+		projection[0] = 2.0f / (right - left);
+		projection[5] = 2.0f / (top - bottom);
+		projection[10] = -1.0f;
+		projection[12] = -(right + left) / (right - left);
+		projection[13] = -(top + bottom) / (top - bottom);
+		projection[15] = 1.0f;
+	}
+
+	ShaderDriver::DrawState::DrawState(GLuint newTexture, bool newAlphaTexture,
+	                                   BlendMode newBlendMode, bool newMasked,
+	                                   bool newInvertedMask) :
+		texture(newTexture), alphaTexture(newAlphaTexture),
+		blendMode(newBlendMode), masked(newMasked),
+		invertedMask(newInvertedMask) {
+	}
+
+	bool ShaderDriver::DrawState::operator==(const DrawState &other) const {
+		return texture == other.texture && alphaTexture == other.alphaTexture &&
+		       blendMode == other.blendMode && masked == other.masked &&
+		       invertedMask == other.invertedMask;
+	}
+
+	unsigned int ShaderDriver::DrawState::getProgramIndex() const {
+		return (alphaTexture ? 1u : 0u) + (masked ? 2u : 0u);
+	}
+
+	ShaderDriver::Program::Program() : id(0), projection(-1), texture(-1),
+		mask(-1), maskScale(-1), invertedMask(-1), projectionChanged(true) {
+	}
+
+	void ShaderDriver::drawShapeWithTextureAndColor(const VertexArray &vertices,
+	                                                const TextureInformation *textureInformation,
+	                                                const TextureCoordinates &textureCoordinates,
+	                                                const Color &color) {
+		// We make sure the texture information is valid.
+		if (color.getAlpha() > 0u && textureInformation) {
+			addShape(getDrawState(textureInformation, BlendMode::ALPHA),
+			         vertices, &textureCoordinates, color);
+		}
+	}
+
+	void ShaderDriver::drawShapeWithTexture(const VertexArray &vertices,
+	                                        const TextureInformation *textureInformation,
+	                                        const TextureCoordinates &textureCoordinates) {
+		drawShapeWithTextureAndColor(vertices, textureInformation,
+		                             textureCoordinates, Color::WHITE);
+	}
+
+	void ShaderDriver::drawShapeWithColor(const VertexArray &vertices,
+	                                      const Color &color) {
+		if (color.getAlpha() > 0u) {
+			addShape(getDrawState(NULL, BlendMode::ALPHA), vertices, NULL,
+			         color);
+		}
+	}
+
+	void ShaderDriver::drawMaskShapeWithTextureAndColor(const VertexArray &vertices,
+	                                                    const TextureInformation *textureInformation,
+	                                                    const TextureCoordinates &textureCoordinates,
+	                                                    const Color &color) {
+		// We make sure the texture information is valid.
+		if (color.getAlpha() > 0u && textureInformation) {
+			addShape(getDrawState(textureInformation, BlendMode::MASK),
+			         vertices, &textureCoordinates, color);
+		}
+	}
+
+	void ShaderDriver::drawMaskShapeWithTexture(const VertexArray &vertices,
+	                                            const TextureInformation *textureInformation,
+	                                            const TextureCoordinates &textureCoordinates) {
+		drawMaskShapeWithTextureAndColor(vertices, textureInformation,
+		                                 textureCoordinates, Color::WHITE);
+	}
+
+	void ShaderDriver::drawMaskedShapeWithTextureAndColor(const VertexArray &vertices,
+	                                                      const TextureInformation *textureInformation,
+	                                                      const TextureCoordinates &textureCoordinates,
+	                                                      const Color &color,
+	                                                      bool invertedMask) {
+		if (color.getAlpha() > 0u && textureInformation) {
+			addShape(getDrawState(textureInformation, BlendMode::ALPHA, true,
+			                      invertedMask),
+			         vertices, &textureCoordinates, color);
+		}
+	}
+
+	void ShaderDriver::unmaskShape(const VertexArray &vertices) {
+		addShape(getDrawState(NULL, BlendMode::UNMASK), vertices, NULL,
+		         Color::WHITE);
+	}
+
+	void ShaderDriver::drawBatchWithTextureAndColor(const BatchVertexArray &vertices,
+	                                                const TextureInformation *textureInformation,
+	                                                const IndiceArray &indices,
+	                                                const IndiceArrayList &indiceList,
+	                                                VertexBuffer *) {
+		if (textureInformation) {
+			addBatch(getDrawState(textureInformation, BlendMode::ALPHA),
+			         vertices, indices, indiceList, true);
+		}
+	}
+
+	void ShaderDriver::drawBatchWithTexture(const BatchVertexArray &vertices,
+	                                        const TextureInformation *textureInformation,
+	                                        const IndiceArray &indices,
+	                                        const IndiceArrayList &indiceList,
+	                                        VertexBuffer *) {
+		if (textureInformation) {
+			addBatch(getDrawState(textureInformation, BlendMode::ALPHA),
+			         vertices, indices, indiceList, false);
+		}
+	}
+
+	void ShaderDriver::drawMaskBatchWithTextureAndColor(const BatchVertexArray &vertices,
+	                                                    const TextureInformation *textureInformation,
+	                                                    const IndiceArray &indices,
+	                                                    const IndiceArrayList &indiceList,
+	                                                    VertexBuffer *) {
+		// Like the fixed pipeline driver, the batch's colors aren't used for
+		// its mask.
+		if (textureInformation) {
+			addBatch(getDrawState(textureInformation, BlendMode::MASK),
+			         vertices, indices, indiceList, false);
+		}
+	}
+
+	void ShaderDriver::drawMaskedBatchWithTextureAndColor(const BatchVertexArray &vertices,
+	                                                      const TextureInformation *textureInformation,
+	                                                      const IndiceArray &indices,
+	                                                      const IndiceArrayList &indiceList,
+	                                                      bool invertedMask,
+	                                                      VertexBuffer *) {
+		if (textureInformation) {
+			addBatch(getDrawState(textureInformation, BlendMode::ALPHA, true,
+			                      invertedMask),
+			         vertices, indices, indiceList, true);
+		}
+	}
+
+	void ShaderDriver::unmaskBatch(const BatchVertexArray &vertices,
+	                               const IndiceArray &indices,
+	                               const IndiceArrayList &indiceList,
+	                               VertexBuffer *) {
+		addBatch(getDrawState(NULL, BlendMode::UNMASK), vertices, indices,
+		         indiceList, false);
+	}
+
+	void ShaderDriver::prepareScene(const Vector2 &position, float angle,
+	                                const Vector2 &zoom,
+	                                const Color &backgroundColor) {
+		flush();
+
+		// A new frame begins.
+		lastFrameNbDrawCalls = nbDrawCalls;
+		nbDrawCalls = 0;
+
+		// The masks of the last frame are forgotten.
+		if (maskUsed) {
+			clearMask();
+		}
+
+		bindFramebuffer(originalFramebuffer);
+		glClearColor(static_cast<GLclampf>(backgroundColor.getRed()) / static_cast<GLclampf>(Color::MAX_COMPONENT_VALUE),
+		             static_cast<GLclampf>(backgroundColor.getGreen()) / static_cast<GLclampf>(Color::MAX_COMPONENT_VALUE),
+		             static_cast<GLclampf>(backgroundColor.getBlue()) / static_cast<GLclampf>(Color::MAX_COMPONENT_VALUE),
+		             1.0f);
+		glClear(GL_COLOR_BUFFER_BIT);
+
+		currentTransform = getSceneTransform(MainWindow::getInstance().getOrientation(),
+		                                     MainWindow::getInstance().getContextWidth(),
+		                                     MainWindow::getInstance().getContextHeight(),
+		                                     position, angle, zoom);
+		transformStack.clear();
+	}
+
+	void ShaderDriver::initializeGraphicDriver() {
+#ifdef RB_GLEW
+		if (!GLEW_VERSION_2_0) {
+			Console::println("The shader graphic driver needs OpenGL 2.0 or later.");
+		}
+#endif
+		GLsizei viewportWidth, viewportHeight;
+
+		if (MainWindow::getInstance().getOrientation() == WindowOrientation::NORMAL ||
+		    MainWindow::getInstance().getOrientation() == WindowOrientation::UPSIDE_DOWN) {
+			viewportWidth = static_cast<GLsizei>(MainWindow::getInstance().getResolutionWidth());
+			viewportHeight = static_cast<GLsizei>(MainWindow::getInstance().getResolutionHeight());
+
+		} else {
+			viewportWidth = static_cast<GLsizei>(MainWindow::getInstance().getResolutionHeight());
+			viewportHeight = static_cast<GLsizei>(MainWindow::getInstance().getResolutionWidth());
+		}
+
+		glViewport(0, 0, viewportWidth, viewportHeight);
+
+		getProjection(MainWindow::getInstance().getOrientation(),
+		              MainWindow::getInstance().getContextWidth(),
+		              MainWindow::getInstance().getContextHeight(),
+		              projection);
+
+		// We find the frame buffer the scene is rendered in.
+		GLint tempBuffer;
+#ifdef RB_OPENGLES
+		glGetIntegerv(GL_FRAMEBUFFER_BINDING, &tempBuffer);
+#else
+		glGetIntegerv(GL_FRAMEBUFFER_BINDING_EXT, &tempBuffer);
+#endif
+		originalFramebuffer = static_cast<GLuint>(tempBuffer);
+		currentFramebuffer = originalFramebuffer;
+
+		// We compile the programs.
+		for (unsigned int i = 0; i < NB_PROGRAMS; ++i) {
+			if (programs[i].id) {
+				glDeleteProgram(programs[i].id);
+			}
+
+			createProgram(programs[i], PROGRAM_DEFINES[i]);
+		}
+
+		// We create the texture used to draw plain colors.
+		if (whiteTexture) {
+			glDeleteTextures(1, &whiteTexture);
+		}
+
+		static const GLubyte WHITE_PIXEL[] = {0xff, 0xff, 0xff, 0xff};
+		glGenTextures(1, &whiteTexture);
+		glBindTexture(GL_TEXTURE_2D, whiteTexture);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA,
+		             GL_UNSIGNED_BYTE, WHITE_PIXEL);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+		// We create the mask texture, it covers the whole viewport.
+		GLsizei maskWidth = MathHelper::nextPowerOf2(viewportWidth);
+		GLsizei maskHeight = MathHelper::nextPowerOf2(viewportHeight);
+		maskScale[0] = 1.0f / static_cast<GLfloat>(maskWidth);
+		maskScale[1] = 1.0f / static_cast<GLfloat>(maskHeight);
+
+		if (maskTexture) {
+			glDeleteTextures(1, &maskTexture);
+		}
+
+		glGenTextures(1, &maskTexture);
+		glBindTexture(GL_TEXTURE_2D, maskTexture);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, maskWidth, maskHeight, 0,
+		             GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glBindTexture(GL_TEXTURE_2D, 0);
+		boundTexture = 0;
+
+#ifdef RB_OPENGLES
+
+		if (maskFramebuffer) {
+			glBindFramebuffer(GL_FRAMEBUFFER, originalFramebuffer);
+			glDeleteFramebuffers(1, &maskFramebuffer);
+		}
+
+		glGenFramebuffers(1, &maskFramebuffer);
+		glBindFramebuffer(GL_FRAMEBUFFER, maskFramebuffer);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+		                       GL_TEXTURE_2D, maskTexture, 0);
+		glBindFramebuffer(GL_FRAMEBUFFER, originalFramebuffer);
+#else
+
+		if (maskFramebuffer) {
+			glBindFramebufferEXT(GL_FRAMEBUFFER_EXT, originalFramebuffer);
+			glDeleteFramebuffersEXT(1, &maskFramebuffer);
+		}
+
+		glGenFramebuffersEXT(1, &maskFramebuffer);
+		glBindFramebufferEXT(GL_FRAMEBUFFER_EXT, maskFramebuffer);
+		glFramebufferTexture2DEXT(GL_FRAMEBUFFER_EXT, GL_COLOR_ATTACHMENT0_EXT,
+		                          GL_TEXTURE_2D, maskTexture, 0);
+		glBindFramebufferEXT(GL_FRAMEBUFFER_EXT, originalFramebuffer);
+#endif
+
+		clearMask();
+
+		// All the draw calls use blending and the three attributes.
+		glEnable(GL_BLEND);
+		glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ZERO, GL_ONE);
+		currentBlendMode = BlendMode::ALPHA;
+
+		glEnableVertexAttribArray(POSITION_ATTRIBUTE);
+		glEnableVertexAttribArray(TEXTURE_COORDINATE_ATTRIBUTE);
+		glEnableVertexAttribArray(COLOR_ATTRIBUTE);
+
+		currentProgram = NB_PROGRAMS;
+
+		glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+		glClear(GL_COLOR_BUFFER_BIT);
+	}
+
+	void ShaderDriver::pushMatrix() {
+		transformStack.push_back(currentTransform);
+	}
+
+	void ShaderDriver::translate(const Vector2 &translation) {
+		currentTransform = currentTransform * getTranslation(translation);
+	}
+
+	void ShaderDriver::loadIdentity() {
+		currentTransform = Transform();
+	}
+
+	void ShaderDriver::popMatrix() {
+		if (!transformStack.empty()) {
+			currentTransform = transformStack.back();
+			transformStack.pop_back();
+		}
+	}
+
+	TextureInformation *ShaderDriver::loadTexture(PixMap *pixMap) {
+		TextureInformation *texInfo = new TextureInformation();
+		glGenTextures(1, &(texInfo->textureId));
+		glBindTexture(GL_TEXTURE_2D, texInfo->textureId);
+		boundTexture = texInfo->textureId;
+
+		int widthPoweredToTwo = MathHelper::nextPowerOf2(pixMap->getWidth());
+		int heightPoweredToTwo = MathHelper::nextPowerOf2(pixMap->getHeight());
+
+		PixMap poweredTo2Pixmap(widthPoweredToTwo, heightPoweredToTwo, pixMap->getColorFormat());
+		poweredTo2Pixmap.insertSubPixMap(*pixMap);
+
+		texInfo->imageWidth = pixMap->getWidth();
+		texInfo->imageHeight = pixMap->getHeight();
+
+		texInfo->poweredWidth = widthPoweredToTwo;
+		texInfo->poweredHeight = heightPoweredToTwo;
+
+		texInfo->colorFormat = pixMap->getColorFormat();
+
+		GLint format = (pixMap->getColorFormat() == ColorFormat::ALPHA) ? GL_ALPHA : GL_RGBA;
+
+		glTexImage2D(GL_TEXTURE_2D, 0, format, widthPoweredToTwo,
+		             heightPoweredToTwo, 0, format, GL_UNSIGNED_BYTE,
+		             poweredTo2Pixmap.getBuffer());
+
+		glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+		return texInfo;
+	}
+
+	void ShaderDriver::updateTexture(TextureInformation *textureInfo,
+	                                 const PixMap &subPixMap,
+	                                 unsigned int xOffset,
+	                                 unsigned int yOffset) {
+		// The pending shapes must be drawn with the texture's old content.
+		flush();
+
+		glBindTexture(GL_TEXTURE_2D, textureInfo->textureId);
+		boundTexture = textureInfo->textureId;
+
+		GLenum format = (subPixMap.getColorFormat() == ColorFormat::ALPHA) ? GL_ALPHA : GL_RGBA;
+
+		// The rows of an alpha pixmap are not always aligned on 4 bytes.
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		glTexSubImage2D(GL_TEXTURE_2D, 0, xOffset, yOffset,
+		                subPixMap.getWidth(), subPixMap.getHeight(), format,
+		                GL_UNSIGNED_BYTE, subPixMap.getBuffer());
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	}
+
+	void ShaderDriver::deleteTexture(TextureInformation *textureInfo) {
+		// The pending shapes might use the texture.
+		flush();
+
+		glDeleteTextures(1, &(textureInfo->textureId));
+
+		// OpenGL reverts the binding to 0 when the bound texture is deleted.
+		if (boundTexture == textureInfo->textureId) {
+			boundTexture = 0;
+		}
+	}
+
+	void ShaderDriver::finalizeScene() {
+		flush();
+	}
+
+	unsigned int ShaderDriver::getLastFrameNbDrawCalls() const {
+		return lastFrameNbDrawCalls;
+	}
+
+	GLuint ShaderDriver::compileShader(GLenum type, const char *defines,
+	                                   const char *source) {
+		GLuint result = glCreateShader(type);
+		const char *sources[] = {defines, source};
+		glShaderSource(result, 2, sources, NULL);
+		glCompileShader(result);
+
+		GLint compiled = GL_FALSE;
+		glGetShaderiv(result, GL_COMPILE_STATUS, &compiled);
+
+		if (compiled != GL_TRUE) {
+			GLchar log[1024];
+			glGetShaderInfoLog(result, sizeof(log), NULL, log);
+			Console::print("Failed to compile a shader: ");
+			Console::println(log);
+			glDeleteShader(result);
+			result = 0;
+		}
+
+		return result;
+	}
+
+	void ShaderDriver::createProgram(Program &program, const char *defines) {
+		program = Program();
+
+		GLuint vertexShader = compileShader(GL_VERTEX_SHADER, defines,
+		                                    VERTEX_SHADER_SOURCE);
+		GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER, defines,
+		                                      FRAGMENT_SHADER_SOURCE);
+
+		if (vertexShader && fragmentShader) {
+			program.id = glCreateProgram();
+			glAttachShader(program.id, vertexShader);
+			glAttachShader(program.id, fragmentShader);
+			glBindAttribLocation(program.id, POSITION_ATTRIBUTE, "position");
+			glBindAttribLocation(program.id, TEXTURE_COORDINATE_ATTRIBUTE, "textureCoordinate");
+			glBindAttribLocation(program.id, COLOR_ATTRIBUTE, "color");
+			glLinkProgram(program.id);
+
+			GLint linked = GL_FALSE;
+			glGetProgramiv(program.id, GL_LINK_STATUS, &linked);
+
+			if (linked == GL_TRUE) {
+				program.projection = glGetUniformLocation(program.id, "projection");
+				program.texture = glGetUniformLocation(program.id, "spriteTexture");
+				program.mask = glGetUniformLocation(program.id, "maskTexture");
+				program.maskScale = glGetUniformLocation(program.id, "maskScale");
+				program.invertedMask = glGetUniformLocation(program.id, "invertedMask");
+
+			} else {
+				GLchar log[1024];
+				glGetProgramInfoLog(program.id, sizeof(log), NULL, log);
+				Console::print("Failed to link a shader program: ");
+				Console::println(log);
+				glDeleteProgram(program.id);
+				program.id = 0;
+			}
+		}
+
+		// The shaders are freed along with the program.
+		if (vertexShader) {
+			glDeleteShader(vertexShader);
+		}
+
+		if (fragmentShader) {
+			glDeleteShader(fragmentShader);
+		}
+	}
+
+	ShaderDriver::DrawState ShaderDriver::getDrawState(const TextureInformation *textureInformation,
+	                                                   BlendMode blendMode,
+	                                                   bool masked,
+	                                                   bool invertedMask) const {
+		if (textureInformation) {
+			return DrawState(textureInformation->textureId,
+			                 textureInformation->colorFormat == ColorFormat::ALPHA,
+			                 blendMode, masked, invertedMask);
+
+		} else {
+			return DrawState(whiteTexture, false, blendMode, masked,
+			                 invertedMask);
+		}
+	}
+
+	void ShaderDriver::prepareState(const DrawState &state,
+	                                IndiceArray::size_type nbVertices) {
+		if (!(state == pendingState) ||
+		    pendingVertices.size() + nbVertices > MAX_NB_VERTICES) {
+			flush();
+			pendingState = state;
+		}
+	}
+
+	void ShaderDriver::addVertex(const Vector2 &position,
+	                             const Vector2 &textureCoordinate,
+	                             const Color &color) {
+		// The HUD and the layers without scrolling aren't transformed.
+		if (currentTransform.isIdentity()) {
+			pendingVertices.push_back(BatchVertex(position, textureCoordinate,
+			                                      color));
+
+		} else {
+			pendingVertices.push_back(BatchVertex(currentTransform.apply(position),
+			                                      textureCoordinate, color));
+		}
+	}
+
+	void ShaderDriver::addShape(const DrawState &state,
+	                            const VertexArray &vertices,
+	                            const TextureCoordinates *textureCoordinates,
+	                            const Color &color) {
+		VertexArray::SizeType nbVertices = vertices.getNbVertices();
+
+		if (nbVertices >= 3 && nbVertices <= MAX_NB_VERTICES) {
+			prepareState(state, nbVertices);
+
+			IndiceArray::value_type first = static_cast<IndiceArray::value_type>(pendingVertices.size());
+			VertexArray::SizeType index = 0;
+
+			for (VertexArray::ConstIterator i = vertices.getBegin();
+			     i != vertices.getEnd(); ++i, ++index) {
+				addVertex(*i, (textureCoordinates && index < textureCoordinates->size()) ? (*textureCoordinates)[index] : Vector2(), color);
+			}
+
+			// We convert the triangle strip into triangles.
+			for (IndiceArray::value_type j = 0; j < nbVertices - 2; ++j) {
+				pendingIndices.push_back(first + j);
+				pendingIndices.push_back(first + j + 1);
+				pendingIndices.push_back(first + j + 2);
+			}
+		}
+	}
+
+	void ShaderDriver::addBatch(const DrawState &state,
+	                            const BatchVertexArray &vertices,
+	                            const IndiceArray &indices,
+	                            const IndiceArrayList &indiceList,
+	                            bool colors) {
+		for (IndiceArrayList::const_iterator i = indiceList.begin();
+		     i != indiceList.end(); ++i) {
+			IndiceArrayList::const_iterator next = i;
+			++next;
+
+			// We find the segment's vertices and indices.
+			VertexArray::SizeType endVertex = (next == indiceList.end()) ? vertices.size() : next->first;
+			IndiceArray::size_type endIndice = (next == indiceList.end()) ? indices.size() : next->second;
+
+			if (endVertex > i->first && endIndice >= i->second + 3) {
+				prepareState(state, endVertex - i->first);
+
+				IndiceArray::value_type first = static_cast<IndiceArray::value_type>(pendingVertices.size());
+				for (BatchVertexArray::const_iterator vertex = vertices.begin() + i->first;
+				     vertex != vertices.begin() + endVertex; ++vertex) {
+					addVertex(vertex->position, vertex->textureCoordinate,
+					          (colors) ? vertex->color : Color::WHITE);
+				}
+
+				// The batch's indices are already a triangle list.
+				for (IndiceArray::const_iterator j = indices.begin() + i->second;
+				     j != indices.begin() + endIndice; ++j) {
+					pendingIndices.push_back(first + *j);
+				}
+			}
+		}
+	}
+
+	void ShaderDriver::flush() {
+		if (!pendingIndices.empty()) {
+			unsigned int programIndex = pendingState.getProgramIndex();
+			Program &program = programs[programIndex];
+
+			if (currentProgram != programIndex) {
+				glUseProgram(program.id);
+				currentProgram = programIndex;
+			}
+
+			if (program.projectionChanged) {
+				glUniformMatrix4fv(program.projection, 1, GL_FALSE, projection);
+				glUniform1i(program.texture, 0);
+
+				if (pendingState.masked) {
+					glUniform1i(program.mask, 1);
+					glUniform2fv(program.maskScale, 1, maskScale);
+				}
+
+				program.projectionChanged = false;
+			}
+
+			// We choose where to render and how to blend.
+			if (pendingState.blendMode != currentBlendMode) {
+				if (pendingState.blendMode == BlendMode::MASK) {
+					// The mask's alpha is multiplied by the shape's alpha.
+					glBlendFuncSeparate(GL_ZERO, GL_ONE, GL_ZERO, GL_SRC_ALPHA);
+
+				} else if (pendingState.blendMode == BlendMode::UNMASK) {
+					// The mask's alpha is reset to 1.
+					glBlendFuncSeparate(GL_ZERO, GL_ONE, GL_ONE, GL_ONE);
+
+				} else {
+					glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ZERO, GL_ONE);
+				}
+
+				currentBlendMode = pendingState.blendMode;
+			}
+
+			if (pendingState.blendMode == BlendMode::ALPHA) {
+				bindFramebuffer(originalFramebuffer);
+
+			} else {
+				bindFramebuffer(maskFramebuffer);
+				maskUsed = true;
+			}
+
+			if (pendingState.masked) {
+				glActiveTexture(GL_TEXTURE1);
+				glBindTexture(GL_TEXTURE_2D, maskTexture);
+				glActiveTexture(GL_TEXTURE0);
+				glUniform1f(program.invertedMask, (pendingState.invertedMask) ? 1.0f : 0.0f);
+			}
+
+			if (boundTexture != pendingState.texture) {
+				glBindTexture(GL_TEXTURE_2D, pendingState.texture);
+				boundTexture = pendingState.texture;
+			}
+
+			glVertexAttribPointer(POSITION_ATTRIBUTE, 2, GL_FLOAT, GL_FALSE,
+			                      sizeof(BatchVertex),
+			                      &pendingVertices.front().position);
+			glVertexAttribPointer(TEXTURE_COORDINATE_ATTRIBUTE, 2, GL_FLOAT,
+			                      GL_FALSE, sizeof(BatchVertex),
+			                      &pendingVertices.front().textureCoordinate);
+			glVertexAttribPointer(COLOR_ATTRIBUTE, 4, GL_UNSIGNED_BYTE, GL_TRUE,
+			                      sizeof(BatchVertex),
+			                      &pendingVertices.front().color);
+
+			glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(pendingIndices.size()),
+			               RB_GL_INDICE_TYPE, &pendingIndices.front());
+			++nbDrawCalls;
+		}
+
+		pendingVertices.clear();
+		pendingIndices.clear();
+	}
+
+	void ShaderDriver::bindFramebuffer(GLuint framebuffer) {
+		if (currentFramebuffer != framebuffer) {
+#ifdef RB_OPENGLES
+			glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+#else
+			glBindFramebufferEXT(GL_FRAMEBUFFER_EXT, framebuffer);
+#endif
+			currentFramebuffer = framebuffer;
+		}
+	}
+
+	void ShaderDriver::clearMask() {
+		bindFramebuffer(maskFramebuffer);
+		glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+		glClear(GL_COLOR_BUFFER_BIT);
+		maskUsed = false;
+	}
+
+	ShaderDriver::ShaderDriver() : GraphicDriver(), currentTransform(),
+		transformStack(), pendingState(0, false, BlendMode::ALPHA),
+		pendingVertices(), pendingIndices(), currentProgram(NB_PROGRAMS),
+		whiteTexture(0), maskTexture(0), maskFramebuffer(0),
+		originalFramebuffer(0), currentFramebuffer(0), boundTexture(0),
+		currentBlendMode(BlendMode::ALPHA), maskUsed(false), nbDrawCalls(0),
+		lastFrameNbDrawCalls(0) {
+		maskScale[0] = 0.0f;
+		maskScale[1] = 0.0f;
+	}
+
+	ShaderDriver::~ShaderDriver() {
+	}
+}
+
+#endif
@@ -0,0 +1,596 @@
+/**
+ * @file
+ * @ingroup GraphicDrivers
+ */
+#ifndef RB_SHADER_DRIVER_H
+#define RB_SHADER_DRIVER_H
+
+#include <vector>
+
+#include "BaconBox/Display/Driver/GraphicDriver.h"
+#include "BaconBox/Display/Driver/OpenGL/RBOpenGL.h"
+#include "BaconBox/Display/VertexArray.h"
+#include "BaconBox/Helper/SafeEnum.h"
+#include "BaconBox/Display/Window/WindowOrientation.h"
+
+namespace BaconBox {
+	/**
+	 * OpenGL graphic driver using the programmable pipeline (OpenGL 2.1 or
+	 * OpenGL ES 2.0). Vertices are sent as interleaved position, texture
+	 * coordinate and color attributes, so consecutive shapes that use the
+	 * same texture are drawn together even if their colors differ. Masks are
+	 * rendered in an offscreen texture that the masked shapes sample in a
+	 * single pass. The transformations are applied to the vertices on the
+	 * CPU, so the matrix functions do not interrupt the batches either.
+	 * @ingroup GraphicDrivers
+	 */
+	class ShaderDriver : public GraphicDriver {
+		friend class Engine;
+	public:
+		/**
+		 * Draw a colored and textured shape with the given vertices, texture
+		 * coordinate, rendering informations (colors array and texture) and
+		 * number of vertices. Color information will blend with the texture
+		 * (and background if alpha is not at max value of 255).
+		 * @param vertices Vertices to draw.
+		 * @param textureInformation Pointer to the texture information.
+		 * @param textureCoordinates Texture coordinates in the texture to
+		 * draw.
+		 * @param color Color to render.
+		 */
+		void drawShapeWithTextureAndColor(const VertexArray &vertices,
+		                                  const TextureInformation *textureInformation,
+		                                  const TextureCoordinates &textureCoordinates,
+		                                  const Color &color);
+
+		/**
+		 * Draw a textured shape with the given vertices, texture coordinate,
+		 * rendering informations (colors array and textureID) and number of
+		 * vertices.
+		 * @param vertices Vertices to draw.
+		 * @param textureInformation Pointer to the texture information.
+		 * @param textureCoordinates Texture coordinates in the texture to
+		 * draw.
+		 */
+		void drawShapeWithTexture(const VertexArray &vertices,
+		                          const TextureInformation *textureInformation,
+		                          const TextureCoordinates &textureCoordinates);
+
+		/**
+		 * Draws a colored shape.
+		 * @param vertices Vertices to draw.
+		 * @param color Color to render.
+		 */
+		void drawShapeWithColor(const VertexArray &vertices,
+		                        const Color &color);
+
+		/**
+		 * Draws the alpha component of the given vertices and texture in the
+		 * mask texture, so the next call to any "drawMaskedShape..."
+		 * functions can use it as its mask. This version of the function will
+		 * also use the alpha component of the shape's color (in addition to
+		 * the texture alpha component).
+		 * @param vertices Vertices to draw.
+		 * @param textureInformation Pointer to the texture information.
+		 * @param textureCoordinates Texture coordinates in the texture to
+		 * draw.
+		 * @param color Color to render.
+		 */
+		void drawMaskShapeWithTextureAndColor(const VertexArray &vertices,
+		                                      const TextureInformation *textureInformation,
+		                                      const TextureCoordinates &textureCoordinates,
+		                                      const Color &color);
+
+		/**
+		 * Draws the alpha component of the given vertices and texture in the
+		 * mask texture, so the next call to any "drawMaskedShape..."
+		 * functions can use it as its mask.
+		 * @param vertices Vertices to draw.
+		 * @param textureInformation Pointer to the texture information.
+		 * @param textureCoordinates Texture coordinates in the texture to
+		 * draw.
+		 */
+		void drawMaskShapeWithTexture(const VertexArray &vertices,
+		                              const TextureInformation *textureInformation,
+		                              const TextureCoordinates &textureCoordinates);
+
+		/**
+		 * Draws the given shape masked by the mask texture. The shape's
+		 * alpha is limited by the mask's alpha (or its inverse) in a single
+		 * pass.
+		 * @param vertices Vertices to draw.
+		 * @param textureInformation Pointer to the texture information.
+		 * @param textureCoordinates Texture coordinates in the texture to
+		 * draw.
+		 * @param color Color to render.
+		 * @param invertedMask If true, the mask effect will be inverted.
+		 */
+		void drawMaskedShapeWithTextureAndColor(const VertexArray &vertices,
+		                                        const TextureInformation *textureInformation,
+		                                        const TextureCoordinates &textureCoordinates,
+		                                        const Color &color,
+		                                        bool invertedMask = false);
+
+		/**
+		 * Resets the mask texture to its original state after a call to any
+		 * "drawMask..." function.
+		 * @param vertices Vertices to draw.
+		 */
+		void unmaskShape(const VertexArray &vertices);
+
+		void drawBatchWithTextureAndColor(const BatchVertexArray &vertices,
+		                                  const TextureInformation *textureInformation,
+		                                  const IndiceArray &indices,
+		                                  const IndiceArrayList &indiceList,
+		                                  VertexBuffer *vertexBuffer = NULL);
+
+		void drawBatchWithTexture(const BatchVertexArray &vertices,
+		                          const TextureInformation *textureInformation,
+		                          const IndiceArray &indices,
+		                          const IndiceArrayList &indiceList,
+		                          VertexBuffer *vertexBuffer = NULL);
+
+		void drawMaskBatchWithTextureAndColor(const BatchVertexArray &vertices,
+		                                      const TextureInformation *textureInformation,
+		                                      const IndiceArray &indices,
+		                                      const IndiceArrayList &indiceList,
+		                                      VertexBuffer *vertexBuffer = NULL);
+
+		void drawMaskedBatchWithTextureAndColor(const BatchVertexArray &vertices,
+		                                        const TextureInformation *textureInformation,
+		                                        const IndiceArray &indices,
+		                                        const IndiceArrayList &indiceList,
+		                                        bool invertedMask,
+		                                        VertexBuffer *vertexBuffer = NULL);
+
+		void unmaskBatch(const BatchVertexArray &vertices,
+		                 const IndiceArray &indices,
+		                 const IndiceArrayList &indiceList,
+		                 VertexBuffer *vertexBuffer = NULL);
+
+		/**
+		 * Prepare the scene before rendering object.
+		 * It clear the draw buffer and reset the transformation matrix with the given
+		 * parameters.
+		 * @param position Shift the matrix using this 2D vector.
+		 * @param angle Apply a rotation to the matrix in degree.
+		 * @param zoom Apply a scale factor to the matrix. 1 is unchanged, less than 1 zoom out,
+		 * more than 1 zoom in.
+		 * @param backgroundColor The scene's background color.
+		 */
+		void prepareScene(const Vector2 &position, float angle,
+		                  const Vector2 &zoom, const Color &backgroundColor);
+
+		/**
+		 * Compiles the shaders, creates the mask texture and initializes the
+		 * projection.
+		 */
+		void initializeGraphicDriver();
+
+		/**
+		 * Pushes the current matrix on the stack.
+		 */
+		void pushMatrix();
+
+		/**
+		 * Applies a translation on the current matrix.
+		 * @param translation 2D translation to apply.
+		 */
+		void translate(const Vector2 &translation);
+
+		/**
+		 * Loads the identity matrix as the current matrix.
+		 */
+		void loadIdentity();
+
+		/**
+		 * Pops the current matrix from the stack.
+		 */
+		void popMatrix();
+
+		/**
+		 * Load a texture into graphic memory.
+		 * @param pixMap A pixmap object containing the buffer the driver must load.
+		 */
+		TextureInformation *loadTexture(PixMap *pixMap);
+
+		/**
+		 * Remove a texture from graphic memory.
+		 * @param textureInfo Texture to remove.
+		 */
+		void deleteTexture(TextureInformation *textureInfo);
+
+		/**
+		 * Replaces a part of a texture already in graphic memory.
+		 * @param textureInfo Texture to update.
+		 * @param subPixMap Pixels to copy in the texture.
+		 * @param xOffset Horizontal position in the texture where the pixels
+		 * are copied.
+		 * @param yOffset Vertical position in the texture where the pixels
+		 * are copied.
+		 */
+		void updateTexture(TextureInformation *textureInfo,
+		                   const PixMap &subPixMap, unsigned int xOffset,
+		                   unsigned int yOffset);
+
+		/**
+		 * Draws the shapes waiting to be drawn.
+		 */
+		void finalizeScene();
+
+		/**
+		 * Gets the number of draw calls issued during the last completed
+		 * frame. A frame ends when prepareScene is called.
+		 * @return Number of draw calls of the last frame.
+		 */
+		unsigned int getLastFrameNbDrawCalls() const;
+
+		/**
+		 * 2D affine transformation. Replaces OpenGL's matrix stack, which
+		 * doesn't exist in OpenGL ES 2.0.
+		 */
+		struct Transform {
+			/**
+			 * Default constructor. Initializes the identity transformation.
+			 */
+			Transform();
+
+			/**
+			 * Parameterized constructor.
+			 * @param newA Horizontal scaling component.
+			 * @param newB Vertical shearing component.
+			 * @param newC Horizontal shearing component.
+			 * @param newD Vertical scaling component.
+			 * @param newX Horizontal translation.
+			 * @param newY Vertical translation.
+			 */
+			Transform(GLfloat newA, GLfloat newB, GLfloat newC, GLfloat newD,
+			          GLfloat newX, GLfloat newY);
+
+			/**
+			 * Gets a translation.
+			 * @param x Horizontal translation.
+			 * @param y Vertical translation.
+			 * @return Transformation that translates the vertices.
+			 */
+			static Transform translation(GLfloat x, GLfloat y);
+
+			/**
+			 * Gets a rotation around the origin.
+			 * @param angle Angle in degrees.
+			 * @return Transformation that rotates the vertices.
+			 */
+			static Transform rotation(GLfloat angle);
+
+			/**
+			 * Gets a scaling from the origin.
+			 * @param x Horizontal scaling.
+			 * @param y Vertical scaling.
+			 * @return Transformation that scales the vertices.
+			 */
+			static Transform scaling(GLfloat x, GLfloat y);
+
+			/**
+			 * Combines two transformations. The right operand is applied
+			 * first, like with OpenGL's matrices.
+			 * @param other Transformation to apply before this one.
+			 * @return Combined transformation.
+			 */
+			Transform operator*(const Transform &other) const;
+
+			/**
+			 * Checks if the transformation doesn't do anything.
+			 * @return True if the transformation is the identity.
+			 */
+			bool isIdentity() const;
+
+			/**
+			 * Applies the transformation to a point.
+			 * @param point Point to transform.
+			 * @return Transformed point.
+			 */
+			const Vector2 apply(const Vector2 &point) const;
+
+			/// Components of the transformation, in column-major order.
+			GLfloat a, b, c, d, x, y;
+		};
+
+		/**
+		 * Gets the transformation prepareScene starts a frame with. It is the
+		 * same as the fixed pipeline driver's model view matrix.
+		 * @param orientation Orientation of the main window.
+		 * @param contextWidth Width of the context.
+		 * @param contextHeight Height of the context.
+		 * @param position Position of the camera.
+		 * @param angle Angle of the camera (in degrees).
+		 * @param zoom Zoom of the camera.
+		 * @return Transformation to apply to the vertices.
+		 */
+		static Transform getSceneTransform(WindowOrientation orientation,
+		                                   float contextWidth,
+		                                   float contextHeight,
+		                                   const Vector2 &position,
+		                                   float angle, const Vector2 &zoom);
+
+		/**
+		 * Gets the transformation translate applies. Like the fixed pipeline
+		 * driver, the vertices are moved in the opposite direction.
+		 * @param translation Translation received by translate.
+		 * @return Transformation to combine with the current one.
+		 */
+		static Transform getTranslation(const Vector2 &translation);
+
+		/**
+		 * Calculates the same orthographic projection as the fixed pipeline
+		 * driver.
+		 * @param orientation Orientation of the main window.
+		 * @param contextWidth Width of the context.
+		 * @param contextHeight Height of the context.
+		 * @param projection Column-major 4x4 matrix to write the projection
+		 * to.
+		 */
+		static void getProjection(WindowOrientation orientation,
+		                          float contextWidth, float contextHeight,
+		                          GLfloat projection[16]);
+	private:
+
+		/**
+		 * Where a draw call renders and how it blends.
+		 */
+		struct BlendModeDef {
+			enum type {
+				/// Normal alpha blending in the frame buffer.
+				ALPHA,
+				/// Multiplies the mask texture's alpha.
+				MASK,
+				/// Resets the mask texture's alpha.
+				UNMASK
+			};
+		};
+		typedef SafeEnum<BlendModeDef> BlendMode;
+
+		/**
+		 * State that all the shapes drawn in the same draw call share.
+		 */
+		struct DrawState {
+			/**
+			 * Parameterized constructor.
+			 * @param newTexture Texture to sample.
+			 * @param newAlphaTexture Set to true if the texture only has an
+			 * alpha component.
+			 * @param newBlendMode Blending to use.
+			 * @param newMasked Set to true to limit the alpha with the mask
+			 * texture.
+			 * @param newInvertedMask Set to true to use the inverse of the
+			 * mask.
+			 */
+			DrawState(GLuint newTexture, bool newAlphaTexture,
+			          BlendMode newBlendMode, bool newMasked = false,
+			          bool newInvertedMask = false);
+
+			/**
+			 * Checks if two states can be drawn in the same draw call.
+			 * @param other State to compare with.
+			 * @return True if the states are the same.
+			 */
+			bool operator==(const DrawState &other) const;
+
+			/**
+			 * Gets the index of the shader program to use.
+			 * @return Index in the driver's programs.
+			 */
+			unsigned int getProgramIndex() const;
+
+			/// Texture to sample.
+			GLuint texture;
+
+			/// Whether or not the texture only has an alpha component.
+			bool alphaTexture;
+
+			/// Blending to use.
+			BlendMode blendMode;
+
+			/// Whether or not the alpha is limited by the mask texture.
+			bool masked;
+
+			/// Whether or not the mask is inverted.
+			bool invertedMask;
+		};
+
+		/**
+		 * Linked shader program and the locations of its uniforms.
+		 */
+		struct Program {
+			/**
+			 * Default constructor.
+			 */
+			Program();
+
+			/// OpenGL's program ID.
+			GLuint id;
+
+			/// Location of the projection matrix.
+			GLint projection;
+
+			/// Location of the sampler of the texture.
+			GLint texture;
+
+			/// Location of the sampler of the mask texture (masked only).
+			GLint mask;
+
+			/// Location of the mask's texture coordinate scaling (masked only).
+			GLint maskScale;
+
+			/// Location of the inverted mask flag (masked only).
+			GLint invertedMask;
+
+			/// Set to true when the projection must be sent again.
+			bool projectionChanged;
+		};
+
+		/// Number of shader programs (alpha texture and masked variants).
+		static const unsigned int NB_PROGRAMS = 4;
+
+		/// Maximum number of vertices in a draw call (16 bit indices).
+		static const IndiceArray::size_type MAX_NB_VERTICES = 65536;
+
+		/**
+		 * Compiles a shader.
+		 * @param type GL_VERTEX_SHADER or GL_FRAGMENT_SHADER.
+		 * @param defines Preprocessor definitions to prepend to the source.
+		 * @param source Source of the shader.
+		 * @return ID of the compiled shader, 0 if it failed.
+		 */
+		static GLuint compileShader(GLenum type, const char *defines,
+		                            const char *source);
+
+		/**
+		 * Compiles and links one of the shader programs.
+		 * @param program Program to initialize.
+		 * @param defines Preprocessor definitions of the variant.
+		 */
+		static void createProgram(Program &program, const char *defines);
+
+		/**
+		 * Gets the state to draw a texture with.
+		 * @param textureInformation Texture to draw, NULL to draw plain
+		 * colors.
+		 * @param blendMode Blending to use.
+		 * @param masked Set to true to limit the alpha with the mask texture.
+		 * @param invertedMask Set to true to use the inverse of the mask.
+		 * @return State to draw with.
+		 */
+		DrawState getDrawState(const TextureInformation *textureInformation,
+		                       BlendMode blendMode, bool masked = false,
+		                       bool invertedMask = false) const;
+
+		/**
+		 * Makes sure the pending shapes use the given state and have room for
+		 * more vertices. Draws the pending shapes if they don't.
+		 * @param state State of the next shapes.
+		 * @param nbVertices Number of vertices that will be added.
+		 */
+		void prepareState(const DrawState &state,
+		                  IndiceArray::size_type nbVertices);
+
+		/**
+		 * Adds a vertex to the pending vertices.
+		 * @param position Position of the vertex, before the transformation.
+		 * @param textureCoordinate Texture coordinate of the vertex.
+		 * @param color Color of the vertex.
+		 */
+		void addVertex(const Vector2 &position,
+		               const Vector2 &textureCoordinate, const Color &color);
+
+		/**
+		 * Adds a shape to the pending shapes.
+		 * @param state State to draw the shape with.
+		 * @param vertices Vertices of the shape's triangle strip.
+		 * @param textureCoordinates Texture coordinates of the shape, NULL if
+		 * it's not textured.
+		 * @param color Color of the shape.
+		 */
+		void addShape(const DrawState &state, const VertexArray &vertices,
+		              const TextureCoordinates *textureCoordinates,
+		              const Color &color);
+
+		/**
+		 * Adds a batch to the pending shapes. The batch's triangle strips are
+		 * converted to triangles.
+		 * @param state State to draw the batch with.
+		 * @param vertices Interleaved vertices of the batch.
+		 * @param indices Indices of the batch's triangles.
+		 * @param indiceList Segments of the batch.
+		 * @param colors Set to false to draw the batch in white instead of
+		 * using its vertices' colors.
+		 */
+		void addBatch(const DrawState &state, const BatchVertexArray &vertices,
+		              const IndiceArray &indices,
+		              const IndiceArrayList &indiceList, bool colors);
+
+		/**
+		 * Draws the pending shapes.
+		 */
+		void flush();
+
+		/**
+		 * Binds a frame buffer.
+		 * @param framebuffer Frame buffer to render to.
+		 */
+		void bindFramebuffer(GLuint framebuffer);
+
+		/**
+		 * Clears the mask texture to an opaque alpha.
+		 */
+		void clearMask();
+
+		/// Shader programs, indexed by DrawState::getProgramIndex().
+		Program programs[NB_PROGRAMS];
+
+		/// Projection matrix sent to the programs (column-major).
+		GLfloat projection[16];
+
+		/// Transformation applied to the vertices.
+		Transform currentTransform;
+
+		/// Transformations pushed with pushMatrix.
+		std::vector<Transform> transformStack;
+
+		/// State of the pending shapes.
+		DrawState pendingState;
+
+		/// Vertices of the pending shapes, transformed by the current matrix.
+		BatchVertexArray pendingVertices;
+
+		/// Indices of the pending shapes' triangles.
+		IndiceArray pendingIndices;
+
+		/// Program currently in use, NB_PROGRAMS if none.
+		unsigned int currentProgram;
+
+		/// Plain white texture used to draw untextured shapes.
+		GLuint whiteTexture;
+
+		/// Texture the masks are rendered in.
+		GLuint maskTexture;
+
+		/// Frame buffer used to render in the mask texture.
+		GLuint maskFramebuffer;
+
+		/// Frame buffer to render the scene in.
+		GLuint originalFramebuffer;
+
+		/// Frame buffer currently bound.
+		GLuint currentFramebuffer;
+
+		/// Texture currently bound on the first texture unit.
+		GLuint boundTexture;
+
+		/// Blending currently set.
+		BlendMode currentBlendMode;
+
+		/// Scaling from window coordinates to mask texture coordinates.
+		GLfloat maskScale[2];
+
+		/// Set to true when something was rendered in the mask texture.
+		bool maskUsed;
+
+		/// Number of draw calls issued during the current frame.
+		unsigned int nbDrawCalls;
+
+		/// Number of draw calls issued during the last completed frame.
+		unsigned int lastFrameNbDrawCalls;
+
+		/**
+		 * Default constructor.
+		 */
+		ShaderDriver();
+
+		/**
+		 * Destructor.
+		 */
+		~ShaderDriver();
+	};
+}
+
+#endif
@@ -0,0 +1,67 @@
+#include "BaconBox/Display/Driver/VertexBuffer.h"
+
+#include <limits>
+
+namespace BaconBox {
+#if defined (RB_OPENGL) || defined (RB_OPENGLES)
+	VertexBuffer::VertexBuffer(VertexBufferUsage newUsage) : usage(newUsage),
+		dirtyBegin(0), dirtyEnd(std::numeric_limits<StandardVertexArray::SizeType>::max()),
+		indicesDirty(true), capacity(0), indexCapacity(0), vertexBufferId(0), indexBufferId(0) {
+	}
+#else
+	VertexBuffer::VertexBuffer(VertexBufferUsage newUsage) : usage(newUsage),
+		dirtyBegin(0), dirtyEnd(std::numeric_limits<StandardVertexArray::SizeType>::max()),
+		indicesDirty(true), capacity(0), indexCapacity(0) {
+	}
+#endif
+
+	StandardVertexArray::SizeType VertexBuffer::getGrownCapacity(StandardVertexArray::SizeType currentCapacity,
+	                                                             StandardVertexArray::SizeType neededCapacity) {
+		StandardVertexArray::SizeType grownCapacity = currentCapacity + currentCapacity / 2;
+		return (grownCapacity > neededCapacity) ? (grownCapacity) : (neededCapacity);
+	}
+
+	void VertexBuffer::markDirty(StandardVertexArray::SizeType first,
+	                             StandardVertexArray::SizeType nbVertices) {
+		if (nbVertices) {
+			// We extend the dirty range to include the given vertices.
+			if (isDirty()) {
+				if (first < dirtyBegin) {
+					dirtyBegin = first;
+				}
+
+				if (first + nbVertices > dirtyEnd) {
+					dirtyEnd = first + nbVertices;
+				}
+
+			} else {
+				dirtyBegin = first;
+				dirtyEnd = first + nbVertices;
+			}
+		}
+	}
+
+	void VertexBuffer::markAllDirty() {
+		dirtyBegin = 0;
+		dirtyEnd = std::numeric_limits<StandardVertexArray::SizeType>::max();
+		indicesDirty = true;
+	}
+
+	void VertexBuffer::markIndicesDirty() {
+		indicesDirty = true;
+	}
+
+	bool VertexBuffer::isDirty() const {
+		return dirtyBegin < dirtyEnd;
+	}
+
+	bool VertexBuffer::isUpToDate() const {
+		return !isDirty() && !indicesDirty;
+	}
+
+	void VertexBuffer::clean() {
+		dirtyBegin = 0;
+		dirtyEnd = 0;
+		indicesDirty = false;
+	}
+}
@@ -0,0 +1,109 @@
+/**
+ * @file
+ * @ingroup Display
+ */
+#ifndef RB_VERTEX_BUFFER_H
+#define RB_VERTEX_BUFFER_H
+
+#include "BaconBox/PlatformFlagger.h"
+
+#include "BaconBox/Display/StandardVertexArray.h"
+#include "BaconBox/Display/Driver/VertexBufferUsage.h"
+
+namespace BaconBox {
+	/**
+	 * Struct containing information about a buffer in graphic memory used to
+	 * render a batch. Keeps track of the parts of the batch that were modified
+	 * since the last upload. Will contain different informations depending on
+	 * the platform. Vertex buffers are created and deleted by the graphic
+	 * driver.
+	 * @ingroup Display
+	 * @see BaconBox::GraphicDriver::createVertexBuffer(VertexBufferUsage)
+	 */
+	struct VertexBuffer {
+		/**
+		 * Parameterized constructor. The whole buffer starts dirty.
+		 * @param newUsage How often the buffer's content is expected to
+		 * change.
+		 */
+		explicit VertexBuffer(VertexBufferUsage newUsage);
+
+		/**
+		 * Gets the capacity to allocate for a buffer that is too small. The
+		 * capacity grows by half of itself at least, so adding bodies one at a
+		 * time doesn't reallocate the buffer each time.
+		 * @param currentCapacity Capacity currently allocated.
+		 * @param neededCapacity Capacity needed.
+		 * @return Capacity to allocate, at least the capacity needed.
+		 */
+		static StandardVertexArray::SizeType getGrownCapacity(StandardVertexArray::SizeType currentCapacity,
+		                                                      StandardVertexArray::SizeType neededCapacity);
+
+		/**
+		 * Takes note that some vertices were modified (their position, their
+		 * texture coordinates or their color).
+		 * @param first Index of the first modified vertex.
+		 * @param nbVertices Number of vertices modified.
+		 */
+		void markDirty(StandardVertexArray::SizeType first,
+		               StandardVertexArray::SizeType nbVertices);
+
+		/**
+		 * Takes note that all the vertices and the indices must be uploaded
+		 * again. Used when vertices are added or removed.
+		 */
+		void markAllDirty();
+
+		/**
+		 * Takes note that the indices must be uploaded again.
+		 */
+		void markIndicesDirty();
+
+		/**
+		 * Checks whether or not some vertices were modified since the last
+		 * upload.
+		 * @return True if some vertices need to be uploaded, false if not.
+		 */
+		bool isDirty() const;
+
+		/**
+		 * Checks whether or not the buffer's content in graphic memory
+		 * matches its batch.
+		 * @return True if neither the vertices nor the indices need to be
+		 * uploaded, false if not.
+		 */
+		bool isUpToDate() const;
+
+		/**
+		 * Takes note that the buffer's content was uploaded.
+		 */
+		void clean();
+
+		/// How often the buffer's content is expected to change.
+		VertexBufferUsage usage;
+
+		/// Index of the first modified vertex.
+		StandardVertexArray::SizeType dirtyBegin;
+
+		/// Index following the last modified vertex.
+		StandardVertexArray::SizeType dirtyEnd;
+
+		/// Set to true when the indices need to be uploaded again.
+		bool indicesDirty;
+
+		/// Number of vertices the buffer can contain in graphic memory.
+		StandardVertexArray::SizeType capacity;
+
+		/// Number of indices the buffer can contain in graphic memory.
+		StandardVertexArray::SizeType indexCapacity;
+#if defined (RB_OPENGL) || defined (RB_OPENGLES)
+		/// OpenGL's buffer containing the vertices, texture coordinates and colors.
+		unsigned int vertexBufferId;
+
+		/// OpenGL's buffer containing the indices.
+		unsigned int indexBufferId;
+#endif
+	};
+}
+
+#endif
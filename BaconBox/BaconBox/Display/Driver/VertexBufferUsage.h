@@ -0,0 +1,33 @@
+/**
+ * @file
+ * @ingroup Display
+ */
+#ifndef RB_VERTEX_BUFFER_USAGE_H
+#define RB_VERTEX_BUFFER_USAGE_H
+
+#include "BaconBox/Helper/SafeEnum.h"
+
+namespace BaconBox {
+	/**
+	 * Enum type representing how often the content of a vertex buffer is
+	 * expected to change.
+	 * @ingroup Display
+	 */
+	struct VertexBufferUsageDef {
+		enum type {
+			/**
+			 * The content rarely changes (tile layers, scenery). Only the
+			 * modified parts are uploaded again.
+			 */
+			STATIC,
+			/**
+			 * The content changes almost every frame. The whole content is
+			 * streamed again when it changes.
+			 */
+			DYNAMIC
+		};
+	};
+	typedef SafeEnum<VertexBufferUsageDef> VertexBufferUsage;
+}
+
+#endif
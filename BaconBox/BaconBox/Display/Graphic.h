@@ -83,8 +83,12 @@ namespace BaconBox {
 		 * Renders the body in the context.
 		 */
 		void render() {
+			// We only read the vertices, so we get them as constant to leave
+			// the bodies' local shapes as they are.
+			const StandardVertexArray &vertices = static_cast<const Graphic<T> *>(this)->getVertices();
+
 			// We make sure there are vertices to render.
-			if (!this->getVertices().isEmpty()) {
+			if (!vertices.isEmpty()) {
 
 				// We check which graphic driver method to use.
 				if (renderModes.isSet(RenderMode::SHAPE)) {
@@ -99,7 +103,7 @@ namespace BaconBox {
 							if (tmpMask) {
 								tmpMask->mask();
 								// Masked with texture.
-								GraphicDriver::getInstance().drawMaskedShapeWithTextureAndColor(this->getVertices(),
+								GraphicDriver::getInstance().drawMaskedShapeWithTextureAndColor(vertices,
 								                                                                this->getTextureInformation(),
 								                                                                this->getCurrentTextureCoordinates(),
 								                                                                this->getColor(),
@@ -109,7 +113,7 @@ namespace BaconBox {
 
 						} else {
 							// We render with the texture.
-							GraphicDriver::getInstance().drawShapeWithTextureAndColor(this->getVertices(),
+							GraphicDriver::getInstance().drawShapeWithTextureAndColor(vertices,
 							                                                          this->getTextureInformation(),
 							                                                          this->getCurrentTextureCoordinates(),
 							                                                          this->getColor());
@@ -117,7 +121,7 @@ namespace BaconBox {
 
 					} else if (renderModes.isSet(RenderMode::COLOR)) {
 						// We render with the color only.
-						GraphicDriver::getInstance().drawShapeWithColor(this->getVertices(), this->getColor());
+						GraphicDriver::getInstance().drawShapeWithColor(vertices, this->getColor());
 
 					}
 				}
@@ -131,8 +135,10 @@ namespace BaconBox {
 		 * as a masked renderable body).
 		 */
 		void mask() {
-			if (!this->getVertices().isEmpty()) {
-				GraphicDriver::getInstance().drawMaskShapeWithTextureAndColor(this->getVertices(),
+			const StandardVertexArray &vertices = static_cast<const Graphic<T> *>(this)->getVertices();
+
+			if (!vertices.isEmpty()) {
+				GraphicDriver::getInstance().drawMaskShapeWithTextureAndColor(vertices,
 				                                                              this->getTextureInformation(),
 				                                                              this->getCurrentTextureCoordinates(),
 				                                                              this->getColor());
@@ -144,8 +150,10 @@ namespace BaconBox {
 		 * masked renderable body has been rendered.
 		 */
 		void unmask() {
-			if (!this->getVertices().isEmpty()) {
-				GraphicDriver::getInstance().unmaskShape(this->getVertices());
+			const StandardVertexArray &vertices = static_cast<const Graphic<T> *>(this)->getVertices();
+
+			if (!vertices.isEmpty()) {
+				GraphicDriver::getInstance().unmaskShape(vertices);
 			}
 		}
 
@@ -8,6 +8,7 @@
 #include "BaconBox/Display/Graphic.h"
 #include "BaconBox/Display/Animatable.h"
 #include "BaconBox/Display/Transformable.h"
+#include "BaconBox/Display/LocalShape.h"
 #include "BaconBox/Display/TexturePointer.h"
 #include "BaconBox/Helper/ShapeFactory.h"
 #include "BaconBox/Display/TextureInformation.h"
@@ -52,7 +53,8 @@ namespace BaconBox {
 		/**
 		 * Default constructor.
 		 */
-		GraphicElement() : Graphic<Animatable>(), Parent(), ManageParent() {
+		GraphicElement() : Graphic<Animatable>(), Parent(), ManageParent(),
+			localShape() {
 		}
 
 		/**
@@ -74,7 +76,7 @@ namespace BaconBox {
 		                        const Vector2 &newTextureOffset = Vector2(),
 		                        unsigned int nbFrames = 0) :
 			Graphic<Animatable>(newTexture), Parent(startingPosition),
-			ManageParent() {
+			ManageParent(), localShape() {
 			// We check if we have to use the texture as the full image.
 			if (newSize.x <= 0.0f || newSize.y <= 0.0f) {
 				// We make sure the texture information is valid.
@@ -104,11 +106,11 @@ namespace BaconBox {
 		               const SpriteDefinition &definition,
 		               const Vector2 &startingPosition = Vector2()) :
 			Graphic<Animatable>(newTexture), Parent(startingPosition),
-			ManageParent() {
+			ManageParent(), localShape() {
 			// We make sure the texture information is valid.
 			if (this->getTextureInformation()) {
 				construct(definition);
-				this->getVertices().move(startingPosition.x, startingPosition.y);
+				localShape.move(startingPosition.x, startingPosition.y);
 
 			} else {
 				Console::println("Failed to load the sprite because the texture is NULL.");
@@ -120,7 +122,7 @@ namespace BaconBox {
 		 * @param src Managed graphic to make a copy of.
 		 */
 		GraphicElement(const GraphicElement<Parent, ManageParent> &src) : Graphic<Animatable>(src),
-			Parent(src), ManageParent(src) {
+			Parent(src), ManageParent(src), localShape(src.localShape) {
 		}
 
 		/**
@@ -138,6 +140,11 @@ namespace BaconBox {
 			this->Graphic<Animatable>::operator=(src);
 			this->Parent::operator=(src);
 			this->ManageParent::operator=(src);
+
+			if (this != &src) {
+				localShape = src.localShape;
+			}
+
 			return *this;
 		}
 
@@ -156,7 +163,7 @@ namespace BaconBox {
 		 */
 		virtual void move(float xDelta, float yDelta) {
 			this->Parent::move(xDelta, yDelta);
-			this->getVertices().move(xDelta, yDelta);
+			getLocalShape().move(xDelta, yDelta);
 		}
 
 		/**
@@ -166,7 +173,7 @@ namespace BaconBox {
 		 * @return Geometric center of the body (barycenter).
 		 */
 		virtual const Vector2 getCentroid() const {
-			return this->getVertices().getCentroid();
+			return getLocalShape().getCentroid();
 		}
 
 		/**
@@ -174,7 +181,7 @@ namespace BaconBox {
 		 * @return Vector2 containing the width and height of the body.
 		 */
 		virtual const Vector2 getSize() const {
-			return this->getVertices().getSize();
+			return getLocalShape().getSize();
 		}
 
 		/**
@@ -182,7 +189,7 @@ namespace BaconBox {
 		 * @return Width in pixels (by default).
 		 */
 		virtual float getWidth() const {
-			return this->getVertices().getWidth();
+			return getLocalShape().getSize().x;
 		}
 
 		/**
@@ -190,7 +197,7 @@ namespace BaconBox {
 		 * @return Height in pixels (by default).
 		 */
 		virtual float getHeight() const {
-			return this->getVertices().getHeight();
+			return getLocalShape().getSize().y;
 		}
 
 		using Parent::scaleFromPoint;
@@ -207,8 +214,8 @@ namespace BaconBox {
 		virtual void scaleFromPoint(float xScaling, float yScaling,
 		                            const Vector2 &fromPoint) {
 			this->Parent::scaleFromPoint(xScaling, yScaling, fromPoint);
-			this->getVertices().scaleFromPoint(xScaling, yScaling, fromPoint);
-			Vector2 tmpPosition = this->getVertices().getMinimumXY();
+			getLocalShape().scaleFromPoint(xScaling, yScaling, fromPoint);
+			const Vector2 &tmpPosition = localShape.getMinimumXY();
 			this->Parent::move(tmpPosition.x - this->getXPosition(),
 			                   tmpPosition.y - this->getYPosition());
 		}
@@ -222,8 +229,8 @@ namespace BaconBox {
 		virtual void rotateFromPoint(float rotationAngle,
 		                             const Vector2 &rotationPoint) {
 			this->Parent::rotateFromPoint(rotationAngle, rotationPoint);
-			this->getVertices().rotateFromPoint(rotationAngle, rotationPoint);
-			Vector2 tmpPosition = this->getVertices().getMinimumXY();
+			getLocalShape().rotateFromPoint(rotationAngle, rotationPoint);
+			const Vector2 &tmpPosition = localShape.getMinimumXY();
 			this->Parent::move(tmpPosition.x - this->getXPosition(),
 			                   tmpPosition.y - this->getYPosition());
 		}
@@ -236,6 +243,17 @@ namespace BaconBox {
 			this->Graphic<Animatable>::update();
 		}
 
+		/**
+		 * Takes the current vertices as the body's shape in local space. The
+		 * moves, scalings and rotations are then applied to that shape when
+		 * the vertices are needed. Done automatically before the local shape
+		 * is used again once the vertices were accessed with the non-const
+		 * getVertices().
+		 */
+		void resetLocalShape() {
+			localShape.reset(this->getVertices());
+		}
+
 		/**
 		 * Generates the vertices and the texture coordinates for the
 		 * sprite.
@@ -253,6 +271,7 @@ namespace BaconBox {
 			this->getVertices().resize(4);
 			ShapeFactory::createRectangle(newSize, newPosition,
 			                              &this->getVertices());
+			resetLocalShape();
 			// We specify the render modes.
 			addRenderMode(RenderMode::SHAPE);
 			addRenderMode(RenderMode::COLOR);
@@ -280,6 +299,7 @@ namespace BaconBox {
 			this->getVertices().resize(4);
 			ShapeFactory::createRectangle(newSize, newPosition,
 			                              &this->getVertices());
+			resetLocalShape();
 			// We specify the render modes.
 			addRenderMode(RenderMode::SHAPE);
 			addRenderMode(RenderMode::COLOR);
@@ -306,6 +326,7 @@ namespace BaconBox {
 		void construct(const SpriteDefinition &definition) {
 			// We initialize the vertices.
 			this->getVertices() = definition.vertices;
+			resetLocalShape();
 
 			// We specify the render modes.
 			addRenderMode(RenderMode::SHAPE);
@@ -336,6 +357,7 @@ namespace BaconBox {
 			// We initialize the vertices.
 			this->getVertices().resize(4);
 			ShapeFactory::createRectangle(tile.getSize(), tile.getPosition() - tile.getHeight(), &this->getVertices());
+			this->resetLocalShape();
 			// We specify the render mode.
 			this->addRenderMode(RenderMode::SHAPE);
 			this->addRenderMode(RenderMode::COLOR);
@@ -378,6 +400,7 @@ namespace BaconBox {
 			this->getVertices().resize(4);
 			ShapeFactory::createRectangle(rectangle.getSize(),
 			                              rectangle.getPosition(), &this->getVertices());
+			this->resetLocalShape();
 			// We specify the render mode.
 			this->addRenderMode(RenderMode::SHAPE);
 			this->addRenderMode(RenderMode::COLOR);
@@ -431,6 +454,7 @@ namespace BaconBox {
 			// strips. We assume the shape is convex.
 			AlgorithmHelper::riffleShuffle(this->getVertices().getBegin(),
 			                               this->getVertices().getEnd());
+			this->resetLocalShape();
 
 			// We specify the render mode.
 			this->addRenderMode(RenderMode::SHAPE);
@@ -477,6 +501,25 @@ namespace BaconBox {
 		virtual GraphicElement<Parent, ManageParent> *clone() const {
 			return new GraphicElement<Parent, ManageParent>(*this);
 		}
+	protected:
+		/**
+		 * Computes the world vertices from the local shape if it was
+		 * transformed since the last time they were computed.
+		 * @param verticesToRefresh Array containing the body's vertices.
+		 */
+		virtual void refreshVertices(StandardVertexArray &verticesToRefresh) const {
+			if (localShape.isDirty()) {
+				localShape.transform(verticesToRefresh);
+			}
+		}
+
+		/**
+		 * Marks the local shape as outdated, since the vertices might be
+		 * changed by whoever got them.
+		 */
+		virtual void prepareVerticesForChanges() {
+			localShape.markOutdated();
+		}
 	private:
 		/// Makes sure the parent type is at least transformable.
 		typedef typename StaticAssert < IsBaseOf<Transformable, Parent>::RESULT || IsSame<Transformable, Parent>::RESULT >::Result IsParentTransformable;
@@ -491,6 +534,22 @@ namespace BaconBox {
 		void loadCollidableProperties(const PropertyMap &properties) {
 			CallLoadCollidable<GraphicElement<Parent, ManageParent>, IsBaseOf<Collidable, GraphicElement<Parent, ManageParent> >::RESULT>()(properties, *this);
 		}
+
+		/**
+		 * Gets the local shape, reset from the vertices first if they might
+		 * have been changed directly.
+		 * @return Body's vertices in local space and their transform.
+		 */
+		LocalShape &getLocalShape() const {
+			if (localShape.isOutdated()) {
+				localShape.reset(this->getVertices());
+			}
+
+			return localShape;
+		}
+
+		/// Body's vertices in local space and their transform.
+		mutable LocalShape localShape;
 	};
 }
 
@@ -8,6 +8,7 @@
 #include "BaconBox/Display/Inanimate.h"
 #include "BaconBox/Display/Graphic.h"
 #include "BaconBox/Display/Transformable.h"
+#include "BaconBox/Display/LocalShape.h"
 #include "BaconBox/Display/TexturePointer.h"
 #include "BaconBox/Helper/ShapeFactory.h"
 #include "BaconBox/Display/TextureInformation.h"
@@ -44,7 +45,7 @@ namespace BaconBox {
 		 * Default constructor.
 		 */
 		InanimateGraphicElement() : Graphic<Inanimate>(), Parent(),
-			ManageParent() {
+			ManageParent(), localShape() {
 		}
 
 		/**
@@ -63,7 +64,7 @@ namespace BaconBox {
 		                                 const Vector2 &newSize = Vector2(),
 		                                 const Vector2 &newTextureOffset = Vector2()) :
 			Graphic<Inanimate>(newTexture), Parent(startingPosition),
-			ManageParent() {
+			ManageParent(), localShape() {
 			// We check if we have to use the texture as the full image.
 			if (newSize.x <= 0.0f || newSize.y <= 0.0f) {
 				// We make sure the texture information is valid.
@@ -83,7 +84,8 @@ namespace BaconBox {
 		 * @param src Layered inanimate graphic to make a copy of.
 		 */
 		InanimateGraphicElement(const InanimateGraphicElement<Parent, ManageParent> &src) :
-			Graphic<Inanimate>(src), Parent(src), ManageParent(src) {
+			Graphic<Inanimate>(src), Parent(src), ManageParent(src),
+			localShape(src.localShape) {
 		}
 
 		/**
@@ -101,6 +103,11 @@ namespace BaconBox {
 			this->Graphic<Inanimate>::operator=(src);
 			this->Parent::operator=(src);
 			this->ManageParent::operator=(src);
+
+			if (this != &src) {
+				localShape = src.localShape;
+			}
+
 			return *this;
 		}
 
@@ -119,7 +126,7 @@ namespace BaconBox {
 		 */
 		virtual void move(float xDelta, float yDelta) {
 			this->Parent::move(xDelta, yDelta);
-			this->getVertices().move(xDelta, yDelta);
+			getLocalShape().move(xDelta, yDelta);
 		}
 
 		/**
@@ -129,7 +136,7 @@ namespace BaconBox {
 		 * @return Geometric center of the body (barycenter).
 		 */
 		virtual const Vector2 getCentroid() const {
-			return this->getVertices().getCentroid();
+			return getLocalShape().getCentroid();
 		}
 
 		/**
@@ -137,7 +144,7 @@ namespace BaconBox {
 		 * @return Vector2 containing the width and height of the body.
 		 */
 		virtual const Vector2 getSize() const {
-			return this->getVertices().getSize();
+			return getLocalShape().getSize();
 		}
 
 		/**
@@ -145,7 +152,7 @@ namespace BaconBox {
 		 * @return Width in pixels (by default).
 		 */
 		virtual float getWidth() const {
-			return this->getVertices().getWidth();
+			return getLocalShape().getSize().x;
 		}
 
 		/**
@@ -153,7 +160,7 @@ namespace BaconBox {
 		 * @return Height in pixels (by default).
 		 */
 		virtual float getHeight() const {
-			return this->getVertices().getHeight();
+			return getLocalShape().getSize().y;
 		}
 
 		using Parent::scaleFromPoint;
@@ -170,8 +177,8 @@ namespace BaconBox {
 		virtual void scaleFromPoint(float xScaling, float yScaling,
 		                            const Vector2 &fromPoint) {
 			this->Parent::scaleFromPoint(xScaling, yScaling, fromPoint);
-			this->getVertices().scaleFromPoint(xScaling, yScaling, fromPoint);
-			Vector2 tmpPosition = this->getVertices().getMinimumXY();
+			getLocalShape().scaleFromPoint(xScaling, yScaling, fromPoint);
+			const Vector2 &tmpPosition = localShape.getMinimumXY();
 			this->Parent::move(tmpPosition.x - this->getXPosition(),
 			                   tmpPosition.y - this->getYPosition());
 		}
@@ -185,8 +192,8 @@ namespace BaconBox {
 		virtual void rotateFromPoint(float rotationAngle,
 		                             const Vector2 &rotationPoint) {
 			this->Parent::rotateFromPoint(rotationAngle, rotationPoint);
-			this->getVertices().rotateFromPoint(rotationAngle, rotationPoint);
-			Vector2 tmpPosition = this->getVertices().getMinimumXY();
+			getLocalShape().rotateFromPoint(rotationAngle, rotationPoint);
+			const Vector2 &tmpPosition = localShape.getMinimumXY();
 			this->Parent::move(tmpPosition.x - this->getXPosition(),
 			                   tmpPosition.y - this->getYPosition());
 		}
@@ -200,6 +207,17 @@ namespace BaconBox {
 			CallUpdate<InanimateGraphicElement<Parent, ManageParent>, Parent, IsBaseOf<Updateable, Parent>::RESULT>()(this);
 		}
 
+		/**
+		 * Takes the current vertices as the body's shape in local space. The
+		 * moves, scalings and rotations are then applied to that shape when
+		 * the vertices are needed. Done automatically before the local shape
+		 * is used again once the vertices were accessed with the non-const
+		 * getVertices().
+		 */
+		void resetLocalShape() {
+			localShape.reset(this->getVertices());
+		}
+
 		/**
 		 * Generates the vertices and the texture coordinates for the
 		 * sprite.
@@ -227,6 +245,7 @@ namespace BaconBox {
 			// We initialize the vertices.
 			this->getVertices().resize(4);
 			ShapeFactory::createRectangle(newSize, newPosition, &this->getVertices());
+			this->resetLocalShape();
 			// We specify the render mode.
 			this->addRenderMode(RenderMode::SHAPE);
 			this->addRenderMode(RenderMode::COLOR);
@@ -254,6 +273,7 @@ namespace BaconBox {
 			// We initialize the vertices.
 			this->getVertices().resize(4);
 			ShapeFactory::createRectangle(tile.getSize(), tile.getPosition() - tile.getHeight(), &this->getVertices());
+			this->resetLocalShape();
 			// We specify the render mode.
 			this->addRenderMode(RenderMode::SHAPE);
 			this->addRenderMode(RenderMode::COLOR);
@@ -312,6 +332,7 @@ namespace BaconBox {
 			// strips. We assume the shape is convex.
 			AlgorithmHelper::riffleShuffle(this->getVertices().getBegin(),
 			                               this->getVertices().getEnd());
+			this->resetLocalShape();
 
 			// We specify the render mode.
 			this->addRenderMode(RenderMode::SHAPE);
@@ -344,6 +365,25 @@ namespace BaconBox {
 		virtual InanimateGraphicElement<Parent, ManageParent> *clone() const {
 			return new InanimateGraphicElement<Parent, ManageParent>(*this);
 		}
+	protected:
+		/**
+		 * Computes the world vertices from the local shape if it was
+		 * transformed since the last time they were computed.
+		 * @param verticesToRefresh Array containing the body's vertices.
+		 */
+		virtual void refreshVertices(StandardVertexArray &verticesToRefresh) const {
+			if (localShape.isDirty()) {
+				localShape.transform(verticesToRefresh);
+			}
+		}
+
+		/**
+		 * Marks the local shape as outdated, since the vertices might be
+		 * changed by whoever got them.
+		 */
+		virtual void prepareVerticesForChanges() {
+			localShape.markOutdated();
+		}
 	private:
 		/// Makes sure the parent type is at least transformable.
 		typedef typename StaticAssert < IsBaseOf<Transformable, Parent>::RESULT || IsSame<Transformable, Parent>::RESULT >::Result IsParentTransformable;
@@ -358,6 +398,22 @@ namespace BaconBox {
 		void loadCollidableProperties(const PropertyMap &properties) {
 			CallLoadCollidable<InanimateGraphicElement<Parent, ManageParent>, IsBaseOf<Collidable, InanimateGraphicElement<Parent, ManageParent> >::RESULT>()(properties, *this);
 		}
+
+		/**
+		 * Gets the local shape, reset from the vertices first if they might
+		 * have been changed directly.
+		 * @return Body's vertices in local space and their transform.
+		 */
+		LocalShape &getLocalShape() const {
+			if (localShape.isOutdated()) {
+				localShape.reset(this->getVertices());
+			}
+
+			return localShape;
+		}
+
+		/// Body's vertices in local space and their transform.
+		mutable LocalShape localShape;
 	};
 }
 
@@ -0,0 +1,161 @@
+#include "BaconBox/Display/LocalShape.h"
+
+#include <algorithm>
+
+#include "BaconBox/Helper/VertexHelper.h"
+
+namespace BaconBox {
+	LocalShape::LocalShape() : vertices(), localCentroid(), origin(),
+		xAxis(1.0f, 0.0f), yAxis(0.0f, 1.0f), minimum(), size(),
+		dirty(false), outdated(false) {
+	}
+
+	LocalShape::LocalShape(const LocalShape &src) : vertices(src.vertices),
+		localCentroid(src.localCentroid), origin(src.origin),
+		xAxis(src.xAxis), yAxis(src.yAxis), minimum(src.minimum),
+		size(src.size), dirty(src.dirty), outdated(src.outdated) {
+	}
+
+	LocalShape::~LocalShape() {
+	}
+
+	LocalShape &LocalShape::operator=(const LocalShape &src) {
+		if (this != &src) {
+			vertices = src.vertices;
+			localCentroid = src.localCentroid;
+			origin = src.origin;
+			xAxis = src.xAxis;
+			yAxis = src.yAxis;
+			minimum = src.minimum;
+			size = src.size;
+			dirty = src.dirty;
+			outdated = src.outdated;
+		}
+
+		return *this;
+	}
+
+	void LocalShape::reset(const VertexArray &newVertices) {
+		vertices.resize(newVertices.getNbVertices());
+		std::copy(newVertices.getBegin(), newVertices.getEnd(),
+		          vertices.getBegin());
+
+		localCentroid = (vertices.isEmpty()) ? (Vector2()) : (vertices.getCentroid());
+		origin = Vector2();
+		xAxis = Vector2(1.0f, 0.0f);
+		yAxis = Vector2(0.0f, 1.0f);
+		minimum = vertices.getMinimumXY();
+		size = vertices.getSize();
+		dirty = false;
+		outdated = false;
+	}
+
+	bool LocalShape::isDirty() const {
+		return dirty;
+	}
+
+	void LocalShape::markOutdated() {
+		outdated = true;
+	}
+
+	bool LocalShape::isOutdated() const {
+		return outdated;
+	}
+
+	void LocalShape::move(float xDelta, float yDelta) {
+		origin.x += xDelta;
+		origin.y += yDelta;
+
+		// Moving doesn't change the bounding box's size.
+		if (!vertices.isEmpty()) {
+			minimum.x += xDelta;
+			minimum.y += yDelta;
+		}
+
+		dirty = true;
+	}
+
+	void LocalShape::scaleFromPoint(float xScaling, float yScaling,
+	                                const Vector2 &fromPoint) {
+		Vector2 scalingToApply(xScaling, yScaling);
+		origin = fromPoint + (origin - fromPoint).getCoordinatesMultiplication(scalingToApply);
+		xAxis = xAxis.getCoordinatesMultiplication(scalingToApply);
+		yAxis = yAxis.getCoordinatesMultiplication(scalingToApply);
+		updateBounds();
+		dirty = true;
+	}
+
+	void LocalShape::rotateFromPoint(float rotationAngle,
+	                                 const Vector2 &rotationPoint) {
+		origin -= rotationPoint;
+		origin.rotate(rotationAngle);
+		origin += rotationPoint;
+		xAxis.rotate(rotationAngle);
+		yAxis.rotate(rotationAngle);
+		updateBounds();
+		dirty = true;
+	}
+
+	const Vector2 LocalShape::getCentroid() const {
+		return origin + xAxis * localCentroid.x + yAxis * localCentroid.y;
+	}
+
+	const Vector2 &LocalShape::getMinimumXY() const {
+		return minimum;
+	}
+
+	const Vector2 &LocalShape::getSize() const {
+		return size;
+	}
+
+	void LocalShape::transform(VertexArray &worldVertices) const {
+		if (worldVertices.getNbVertices() != vertices.getNbVertices()) {
+			worldVertices.resize(vertices.getNbVertices());
+		}
+
+		if (!vertices.isEmpty()) {
+			VertexHelper::transform(&*vertices.getBegin(), vertices.getNbVertices(),
+			                        &*worldVertices.getBegin(), origin, xAxis, yAxis);
+		}
+
+		dirty = false;
+	}
+
+	void LocalShape::updateBounds() {
+		if (vertices.isEmpty()) {
+			minimum = Vector2();
+			size = Vector2();
+
+		} else {
+			// We transform the vertices without storing them, only the bounds
+			// are needed until the shape is rendered.
+			StandardVertexArray::ConstIterator i = vertices.getBegin();
+			Vector2 tmpMinimum(origin + xAxis * i->x + yAxis * i->y);
+			Vector2 tmpMaximum(tmpMinimum);
+			++i;
+
+			while (i != vertices.getEnd()) {
+				Vector2 tmpVertex(origin + xAxis * i->x + yAxis * i->y);
+
+				if (tmpVertex.x < tmpMinimum.x) {
+					tmpMinimum.x = tmpVertex.x;
+
+				} else if (tmpVertex.x > tmpMaximum.x) {
+					tmpMaximum.x = tmpVertex.x;
+				}
+
+				if (tmpVertex.y < tmpMinimum.y) {
+					tmpMinimum.y = tmpVertex.y;
+
+				} else if (tmpVertex.y > tmpMaximum.y) {
+					tmpMaximum.y = tmpVertex.y;
+				}
+
+				++i;
+			}
+
+			minimum = tmpMinimum;
+			size = tmpMaximum - tmpMinimum;
+		}
+	}
+}
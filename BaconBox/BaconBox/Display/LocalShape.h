@@ -0,0 +1,155 @@
+/**
+ * @file
+ * @ingroup Display
+ */
+#ifndef RB_LOCAL_SHAPE_H
+#define RB_LOCAL_SHAPE_H
+
+#include "BaconBox/Vector2.h"
+#include "BaconBox/Display/StandardVertexArray.h"
+
+namespace BaconBox {
+	/**
+	 * Keeps a body's vertices in local space with the transform that places
+	 * them in the world. Moving, scaling and rotating only change the
+	 * transform, the world vertices are recomputed from the untouched local
+	 * vertices only when they are needed. The world bounding box and
+	 * centroid are kept up to date without touching the world vertices.
+	 * @ingroup Display
+	 */
+	class LocalShape {
+	public:
+		/**
+		 * Default constructor.
+		 */
+		LocalShape();
+
+		/**
+		 * Copy constructor.
+		 * @param src Local shape to make a copy of.
+		 */
+		LocalShape(const LocalShape &src);
+
+		/**
+		 * Destructor.
+		 */
+		~LocalShape();
+
+		/**
+		 * Assignment operator.
+		 * @param src Local shape to copy.
+		 * @return Reference to the modified local shape.
+		 */
+		LocalShape &operator=(const LocalShape &src);
+
+		/**
+		 * Takes vertices as the new shape in local space and resets the
+		 * transform.
+		 * @param newVertices World vertices to use as the local vertices.
+		 */
+		void reset(const VertexArray &newVertices);
+
+		/**
+		 * Checks whether the world vertices need to be recomputed.
+		 * @return True if the transform changed since the last time the world
+		 * vertices were computed, false if not.
+		 */
+		bool isDirty() const;
+
+		/**
+		 * Marks the shape as outdated, for when the world vertices might have
+		 * been changed directly. The shape must then be reset from the world
+		 * vertices before it is used again.
+		 */
+		void markOutdated();
+
+		/**
+		 * Checks whether the shape must be reset from the world vertices.
+		 * @return True if the shape was marked as outdated since it was last
+		 * reset, false if not.
+		 */
+		bool isOutdated() const;
+
+		/**
+		 * Moves the shape.
+		 * @param xDelta Horizontal movement (in pixels).
+		 * @param yDelta Vertical movement (in pixels).
+		 */
+		void move(float xDelta, float yDelta);
+
+		/**
+		 * Scales the shape from a point.
+		 * @param xScaling Horizontal scaling to apply.
+		 * @param yScaling Vertical scaling to apply.
+		 * @param fromPoint Anchor point from which to apply the scaling.
+		 */
+		void scaleFromPoint(float xScaling, float yScaling,
+		                    const Vector2 &fromPoint);
+
+		/**
+		 * Rotates the shape from a point.
+		 * @param rotationAngle Angle to rotate the shape (in degrees).
+		 * @param rotationPoint Origin point on which to apply the rotation.
+		 */
+		void rotateFromPoint(float rotationAngle, const Vector2 &rotationPoint);
+
+		/**
+		 * Gets the shape's centroid in the world.
+		 * @return Average of the shape's world vertices.
+		 */
+		const Vector2 getCentroid() const;
+
+		/**
+		 * Gets the upper left corner of the shape's bounding box in the world.
+		 * @return Minimum horizontal and vertical coordinates of the world
+		 * vertices.
+		 */
+		const Vector2 &getMinimumXY() const;
+
+		/**
+		 * Gets the size of the shape's bounding box in the world.
+		 * @return Width and height of the world vertices.
+		 */
+		const Vector2 &getSize() const;
+
+		/**
+		 * Computes the world vertices from the local vertices.
+		 * @param worldVertices Vertex array to write the world vertices to.
+		 */
+		void transform(VertexArray &worldVertices) const;
+	private:
+		/**
+		 * Computes the world bounding box from the local vertices.
+		 */
+		void updateBounds();
+
+		/// Vertices of the shape in local space.
+		StandardVertexArray vertices;
+
+		/// Average of the local vertices.
+		Vector2 localCentroid;
+
+		/// Position of the local space's origin in the world.
+		Vector2 origin;
+
+		/// Local space's horizontal axis in the world.
+		Vector2 xAxis;
+
+		/// Local space's vertical axis in the world.
+		Vector2 yAxis;
+
+		/// Upper left corner of the world bounding box.
+		Vector2 minimum;
+
+		/// Size of the world bounding box.
+		Vector2 size;
+
+		/// Set to true when the world vertices need to be recomputed.
+		mutable bool dirty;
+
+		/// Set to true when the world vertices might have been changed.
+		bool outdated;
+	};
+}
+
+#endif // RB_LOCAL_SHAPE_H
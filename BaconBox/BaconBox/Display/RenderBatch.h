@@ -5,8 +5,6 @@
 #ifndef RB_RENDER_BATCH_H
 #define RB_RENDER_BATCH_H
 
-#include <set>
-#include <list>
 #include <vector>
 #include <utility>
 #include <algorithm>
@@ -16,12 +14,15 @@
 #include "BaconBox/Display/Updateable.h"
 #include "BaconBox/Display/Maskable.h"
 #include "BaconBox/Vector2.h"
-#include "BaconBox/Display/Driver/ColorArray.h"
+#include "BaconBox/Display/Driver/BatchVertex.h"
 #include "BaconBox/Display/Driver/IndiceArray.h"
 #include "BaconBox/Display/RenderModable.h"
 #include "BaconBox/Console.h"
 #include "BaconBox/Display/Driver/GraphicDriver.h"
+#include "BaconBox/Display/Driver/VertexBuffer.h"
 #include "BaconBox/Display/StandardVertexArray.h"
+#include "BaconBox/Helper/VertexHelper.h"
+#include "BaconBox/Helper/Profiler.h"
 #include "BaconBox/Display/TextureCoordinates.h"
 #include "BaconBox/Display/TextureInformation.h"
 #include "BaconBox/Display/Texturable.h"
@@ -42,18 +43,24 @@ namespace BaconBox {
 		template <typename U> friend class BatchedVertexArray;
 	public:
 		typedef T ValueType;
-			
-		typedef std::multiset<T *, Orderable::LessCompare> BodyMap;
 
-		typedef std::list<typename BodyMap::value_type> BodyList;
+		/**
+		 * Bodies sorted by their z value. A contiguous array is iterated
+		 * faster than a tree and the bodies are already sorted like their
+		 * vertices.
+		 */
+		typedef std::vector<T *> BodyMap;
+
+		typedef std::vector<typename BodyMap::value_type> BodyList;
 
 		/**
 		 * Default constructor.
 		 */
 		RenderBatchParent() : Updateable(), Maskable(), RenderModable(),
-			Texturable(), bodies(), toAdd(), toRemove(), toChange(), indices(),
-			vertices(), textureCoordinates(), colors(), updating(false),
-			currentMask(NULL) {
+			Texturable(), bodies(), toAdd(), toChange(), indices(),
+			vertices(), batchVertices(), positionsDirtyBegin(0),
+			positionsDirtyEnd(0), updating(false), currentMask(NULL),
+			vertexBuffer(NULL), bufferUsage(getDefaultBufferUsage()) {
 			renderModes.set(RenderMode::TEXTURE);
 		}
 
@@ -65,8 +72,10 @@ namespace BaconBox {
 		 */
 		explicit RenderBatchParent(TexturePointer newTexture) : Updateable(),
 			Maskable(), RenderModable(), Texturable(newTexture), bodies(),
-			toAdd(), toRemove(), toChange(), indices(), vertices(),
-			textureCoordinates(), colors(), updating(false), currentMask(NULL) {
+			toAdd(), toChange(), indices(), vertices(),
+			batchVertices(), positionsDirtyBegin(0), positionsDirtyEnd(0),
+			updating(false), currentMask(NULL), vertexBuffer(NULL),
+			bufferUsage(getDefaultBufferUsage()) {
 			renderModes.set(RenderMode::TEXTURE);
 		}
 
@@ -76,9 +85,10 @@ namespace BaconBox {
 		 */
 		RenderBatchParent(const RenderBatchParent<T> &src) : Updateable(src),
 			Maskable(src), RenderModable(src), Texturable(src), bodies(),
-			toAdd(), toRemove(), toChange(), indices(), vertices(),
-			textureCoordinates(), colors(), updating(false),
-			currentMask(src.currentMask) {
+			toAdd(), toChange(), indices(), vertices(),
+			batchVertices(), positionsDirtyBegin(0), positionsDirtyEnd(0),
+			updating(false), currentMask(src.currentMask),
+			vertexBuffer(NULL), bufferUsage(src.bufferUsage) {
 
 			for (typename BodyMap::const_iterator i = src.bodies.begin();
 			     i != src.bodies.end(); ++i) {
@@ -101,6 +111,7 @@ namespace BaconBox {
 		 */
 		virtual ~RenderBatchParent() {
 			free();
+			deleteVertexBuffer();
 		}
 
 		/**
@@ -138,6 +149,8 @@ namespace BaconBox {
 		 * Updates the body.
 		 */
 		virtual void update() {
+			RB_PROFILE_ZONE("RenderBatch::update");
+
 			// We add the sprites that are waiting to be added.
 			std::for_each(toAdd.rbegin(), toAdd.rend(), std::bind1st(std::mem_fun(&RenderBatchParent<T>::add), this));
 
@@ -146,81 +159,49 @@ namespace BaconBox {
 			// We take note that we are updating the batch's bodies.
 			updating = true;
 
-			typename BodyMap::value_type tmpBody;
-
-			// We update the bodies.
-			typename BodyMap::iterator i = bodies.begin();
-
-			while (i != bodies.end()) {
-				// We check if it needs to be deleted.
-				if ((*i)->isToBeDeleted()) {
-					// We add it to the list of sprites that are waiting to be
-					// removed.
-					toRemove.push_back(*i);
-
-					// We remove the body from the container.
-					bodies.erase(i++);
-
-				} else {
-					// We update the body.
-					if ((*i)->isActive()) {
-						(*i)->update();
-					}
-
-					// We check if the body's z coordinate has changed.
-					if ((*i)->isKeyChanged()) {
-						// We make a backup copy of its vertices.
-						(*i)->getVertices().unlinkVertices();
-
-						// We remove the body's vertices from the array.
-						tmpBody = *i;
-						bodies.erase(i++);
-						removeVertices(tmpBody->getVertices().begin, tmpBody->getVertices().getNbVertices());
-
-						toChange.push_back(tmpBody);
-
-					} else {
-						++i;
-					}
+			// We update the bodies. The bodies to remove and the bodies that
+			// had their z changed are taken out afterwards, in a single pass.
+			for (typename BodyMap::iterator i = bodies.begin(); i != bodies.end(); ++i) {
+				if (!(*i)->isToBeDeleted() && (*i)->isActive()) {
+					(*i)->update();
 				}
 			}
 
 			// We take note that we are done updating the batch's bodies.
 			updating = false;
 
-			// We remove the bodies that are waiting to be removed.
-			typename BodyList::value_type tmp;
+			// We take out the bodies to delete, their indices are patched.
+			compactBodies();
 
-			while (!toRemove.empty()) {
-				tmp = toRemove.front();
-				toRemove.pop_front();
-				removeVertices(tmp->getVertices().begin, tmp->getVertices().getNbVertices());
-				delete tmp;
+			// We re-insert the bodies that had their z changed. The draw
+			// order changed, so the indices are reconstructed.
+			if (!toChange.empty()) {
+				mergeChangedBodies();
+				refreshIndices();
 			}
-
-			// We re-insert the bodies that had their z changed.
-			std::for_each(toChange.begin(), toChange.end(), std::bind1st(std::mem_fun(&RenderBatchParent::add), this));
-
-			toChange.clear();
 		}
 
 		/**
 		 * Renders the body in the context.
 		 */
 		virtual void render() {
+			RB_PROFILE_ZONE("RenderBatch::render");
+
 			// The render mode for textures has to be set.
 			if (renderModes.isSet(RenderMode::TEXTURE)) {
+				createVertexBuffer();
+				synchronizePositions();
+
 				if (renderModes.isSet(RenderMode::INVERSE_MASKED)) {
 					if (currentMask) {
 						currentMask->mask();
 
-						GraphicDriver::getInstance().drawMaskedBatchWithTextureAndColor(vertices,
+						GraphicDriver::getInstance().drawMaskedBatchWithTextureAndColor(batchVertices,
 						                                                                this->getTextureInformation(),
-						                                                                textureCoordinates,
 						                                                                indices,
 						                                                                indiceList,
-						                                                                colors,
-						                                                                true);
+						                                                                true,
+						                                                                vertexBuffer);
 
 						currentMask->unmask();
 					}
@@ -229,24 +210,22 @@ namespace BaconBox {
 					if (currentMask) {
 						currentMask->mask();
 
-						GraphicDriver::getInstance().drawMaskedBatchWithTextureAndColor(vertices,
+						GraphicDriver::getInstance().drawMaskedBatchWithTextureAndColor(batchVertices,
 						                                                                this->getTextureInformation(),
-						                                                                textureCoordinates,
 						                                                                indices,
 						                                                                indiceList,
-						                                                                colors,
-						                                                                true);
+						                                                                true,
+						                                                                vertexBuffer);
 
 						currentMask->unmask();
 					}
 
 				} else {
-					GraphicDriver::getInstance().drawBatchWithTextureAndColor(vertices,
+					GraphicDriver::getInstance().drawBatchWithTextureAndColor(batchVertices,
 					                                                          this->getTextureInformation(),
-					                                                          textureCoordinates,
 					                                                          indices,
 					                                                          indiceList,
-					                                                          colors);
+					                                                          vertexBuffer);
 				}
 			}
 		}
@@ -258,12 +237,13 @@ namespace BaconBox {
 		 * as a masked renderable body).
 		 */
 		virtual void mask() {
-			GraphicDriver::getInstance().drawMaskBatchWithTextureAndColor(vertices,
+			createVertexBuffer();
+			synchronizePositions();
+			GraphicDriver::getInstance().drawMaskBatchWithTextureAndColor(batchVertices,
 			                                                              this->getTextureInformation(),
-			                                                              textureCoordinates,
 			                                                              indices,
 			                                                              indiceList,
-			                                                              colors);
+			                                                              vertexBuffer);
 		}
 
 		/**
@@ -271,9 +251,11 @@ namespace BaconBox {
 		 * masked renderable body has been rendered.
 		 */
 		virtual void unmask() {
-			GraphicDriver::getInstance().unmaskBatch(vertices,
+			synchronizePositions();
+			GraphicDriver::getInstance().unmaskBatch(batchVertices,
 			                                         indices,
-			                                         indiceList);
+			                                         indiceList,
+			                                         vertexBuffer);
 		}
 
 		/**
@@ -329,47 +311,27 @@ namespace BaconBox {
 				// We reset the keyChanged to false.
 				result->keyChanged = false;
 				// We insert the body in the batch.
-				bodies.insert(result);
+				typename BodyMap::iterator inserted = insertBody(result);
 
 				// We find the place to insert the body's vertices, texture
 				// coordinates and colors in the arrays.
-				VertexArray::SizeType tmpBegin = 0;
-				bool found = false;
-
-				for (typename BodyMap::iterator i = bodies.begin();
-				     i != bodies.end(); ++i) {
-					if (found) {
-						(*i)->getVertices().begin += nbVertices;
-
-					} else if (*i == result) {
-						result->getVertices().begin = tmpBegin;
-						found = true;
-
-					} else {
-						tmpBegin = (*i)->getVertices().begin +
-						           (*i)->getVertices().getNbVertices();
-					}
+				if (inserted != bodies.begin()) {
+					result->getVertices().begin = (*(inserted - 1))->getVertices().begin + (*(inserted - 1))->getVertices().getNbVertices();
 				}
 
-				// We make sure to also keep the bodies' index updated in the
-				// list of bodies to remove.
-				for (typename BodyList::iterator i = toRemove.begin();
-				     i != toRemove.end(); ++i) {
-					if ((*i)->getVertices().begin >= result->getVertices().begin) {
-						(*i)->getVertices().begin += nbVertices;
-					}
+				// We increment all the indexes for the following bodies.
+				for (typename BodyMap::iterator i = inserted + 1; i != bodies.end(); ++i) {
+					(*i)->getVertices().begin += nbVertices;
 				}
 
-				// We insert the vertices, the texture coordinates and the
-				// colors in the arrays.
+				// We insert the vertices in the arrays.
 				vertices.insert(vertices.getBegin() + result->getVertices().begin,
 				                nbVertices, Vector2());
-				textureCoordinates.insert(textureCoordinates.begin() + result->getVertices().begin,
-				                          nbVertices, Vector2());
-				colors.insert(colors.begin() + result->getVertices().begin, nbVertices, result->getColor());
+				batchVertices.insert(batchVertices.begin() + result->getVertices().begin,
+				                     nbVertices, BatchVertex(Vector2(), Vector2(), result->getColor()));
 
-				// We refresh the batch's indices.
-				refreshIndices();
+				// We add the body's indices.
+				insertBodyIndices(result->getVertices().begin, nbVertices);
 
 				// We refresh the new body's texture coordinates.
 				result->refreshTextureCoordinates();
@@ -399,7 +361,7 @@ namespace BaconBox {
 					newBody->keyChanged = false;
 
 					// We insert the new body in the batch.
-					typename BodyMap::iterator inserted = bodies.insert(newBody);
+					typename BodyMap::iterator inserted = insertBody(newBody);
 
 					// We set its first vertex's index.
 					if (inserted != bodies.begin()) {
@@ -418,22 +380,15 @@ namespace BaconBox {
 						(*i)->getVertices().begin += newBody->getVertices().nbVertices;
 					}
 
-					for (typename BodyList::iterator i = toRemove.begin(); i != toRemove.end(); ++i) {
-						if ((*i)->getVertices().begin >= newBody->getVertices().begin) {
-							(*i)->getVertices().begin += newBody->getVertices().nbVertices;
-						}
-					}
-
 					vertices.insert(vertices.getBegin() + newBody->getVertices().begin, newBody->getVertices().vertices->begin(), newBody->getVertices().vertices->end());
-					textureCoordinates.insert(textureCoordinates.begin() + newBody->getVertices().begin, newBody->getVertices().getNbVertices(), Vector2());
-					colors.insert(colors.begin() + newBody->getVertices().begin, newBody->getVertices().getNbVertices(), newBody->getColor());
+					batchVertices.insert(batchVertices.begin() + newBody->getVertices().begin, newBody->getVertices().getNbVertices(), BatchVertex(Vector2(), Vector2(), newBody->getColor()));
 
 					delete newBody->getVertices().vertices;
 					newBody->getVertices().vertices = NULL;
 
 					newBody->refreshTextureCoordinates();
 
-					refreshIndices();
+					insertBodyIndices(newBody->getVertices().begin, newBody->getVertices().getNbVertices());
 				}
 			}
 
@@ -482,7 +437,7 @@ namespace BaconBox {
 						tmp->keyChanged = false;
 
 						// We insert the new body in the batch.
-						typename BodyMap::iterator inserted = bodies.insert(tmp);
+						typename BodyMap::iterator inserted = insertBody(tmp);
 
 						// We set its first vertex's index.
 						if (inserted != bodies.begin()) {
@@ -501,15 +456,8 @@ namespace BaconBox {
 							(*i)->getVertices().begin += tmp->getVertices().nbVertices;
 						}
 
-						for (typename BodyList::iterator i = toRemove.begin(); i != toRemove.end(); ++i) {
-							if ((*i)->getVertices().begin >= tmp->getVertices().begin) {
-								(*i)->getVertices().begin += tmp->getVertices().nbVertices;
-							}
-						}
-
 						vertices.insert(vertices.getBegin() + tmp->getVertices().begin, tmp->getVertices().vertices->begin(), tmp->getVertices().vertices->end());
-						textureCoordinates.insert(textureCoordinates.begin() + tmp->getVertices().begin, tmp->getVertices().getNbVertices(), Vector2());
-						colors.insert(colors.begin() + tmp->getVertices().begin, tmp->getVertices().getNbVertices(), tmp->getColor());
+						batchVertices.insert(batchVertices.begin() + tmp->getVertices().begin, tmp->getVertices().getNbVertices(), BatchVertex(Vector2(), Vector2(), tmp->getColor()));
 
 						delete tmp->getVertices().vertices;
 						tmp->getVertices().vertices = NULL;
@@ -517,6 +465,7 @@ namespace BaconBox {
 						tmp->refreshTextureCoordinates();
 					}
 
+					// The indices are reconstructed once for all the clones.
 					refreshIndices();
 				}
 			}
@@ -534,8 +483,7 @@ namespace BaconBox {
 		 */
 		void reserveVertices(VertexArray::SizeType nbVerticesToReserve) {
 			vertices.reserve(vertices.getNbVertices() + nbVerticesToReserve);
-			textureCoordinates.reserve(textureCoordinates.size() + nbVerticesToReserve);
-			colors.reserve(colors.size() + nbVerticesToReserve);
+			batchVertices.reserve(batchVertices.size() + nbVerticesToReserve);
 		}
 
 		/**
@@ -630,6 +578,32 @@ namespace BaconBox {
 		typename BodyMap::size_type getNbBodies() const {
 			return bodies.size();
 		}
+
+		/**
+		 * Gets how often the batch's content is expected to change.
+		 * @return Usage of the batch's vertex buffer.
+		 * @see BaconBox::RenderBatchParent<T>::bufferUsage
+		 */
+		VertexBufferUsage getBufferUsage() const {
+			return bufferUsage;
+		}
+
+		/**
+		 * Sets how often the batch's content is expected to change. Static
+		 * batches only upload their modified vertices to graphic memory,
+		 * dynamic batches upload all of them when something changed.
+		 * @param newBufferUsage New usage of the batch's vertex buffer.
+		 * @see BaconBox::RenderBatchParent<T>::bufferUsage
+		 */
+		void setBufferUsage(VertexBufferUsage newBufferUsage) {
+			if (bufferUsage != newBufferUsage) {
+				bufferUsage = newBufferUsage;
+
+				// The vertex buffer will be created again with the new usage
+				// the next time the batch is rendered.
+				deleteVertexBuffer();
+			}
+		}
 	protected:
 		/**
 		 * Clears the render batch.
@@ -640,11 +614,17 @@ namespace BaconBox {
 
 				bodies.clear();
 				toAdd.clear();
-				toRemove.clear();
 				toChange.clear();
 				vertices.clear();
-				textureCoordinates.clear();
-				colors.clear();
+				batchVertices.clear();
+				indices.clear();
+				indiceList.clear();
+				positionsDirtyBegin = 0;
+				positionsDirtyEnd = 0;
+
+				if (vertexBuffer) {
+					vertexBuffer->markAllDirty();
+				}
 
 			} else {
 				Console::println("Could not clear the render batch because it's currently updating its bodies.");
@@ -663,10 +643,6 @@ namespace BaconBox {
 				delete *i;
 			}
 
-			for (typename BodyList::iterator i = toRemove.begin(); i != toRemove.end(); ++i) {
-				delete *i;
-			}
-
 			for (typename BodyList::iterator i = toChange.begin(); i != toChange.end(); ++i) {
 				delete *i;
 			}
@@ -689,18 +665,9 @@ namespace BaconBox {
 					}
 				}
 
-				// We do so too for the bodies that are to be removed but aren't
-				// yet.
-				for (typename BodyList::iterator i = toRemove.begin(); i != toRemove.end(); ++i) {
-					if ((*i)->getVertices().begin >= position) {
-						(*i)->getVertices().begin += nbVertices;
-					}
-				}
-
 				// We add the vertices to the arrays.
 				vertices.insert(vertices.getBegin() + position, nbVertices);
-				textureCoordinates.insert(textureCoordinates.begin() + position, nbVertices, TextureCoordinates::value_type());
-				colors.insert(colors.begin() + position, nbVertices, ColorArray::value_type());
+				batchVertices.insert(batchVertices.begin() + position, nbVertices, BatchVertex());
 
 				// We refresh the indices, the texture coordinates and the color
 				// arrays.
@@ -735,18 +702,9 @@ namespace BaconBox {
 					}
 				}
 
-				// We do so too for the bodies that are to be removed but aren't
-				// yet.
-				for (typename BodyList::iterator i = toRemove.begin(); i != toRemove.end(); ++i) {
-					if ((*i)->getVertices().begin >= position) {
-						(*i)->getVertices().begin -= nbVertices;
-					}
-				}
-
 				// We remove the vertices to the arrays.
 				vertices.erase(vertices.getBegin() + position, vertices.getBegin() + position + nbVertices);
-				textureCoordinates.erase(textureCoordinates.begin() + position, textureCoordinates.begin() + position + nbVertices);
-				colors.erase(colors.begin() + position, colors.begin() + position + nbVertices);
+				batchVertices.erase(batchVertices.begin() + position, batchVertices.begin() + position + nbVertices);
 
 				// We refresh the indices, the texture coordinates and the color
 				// arrays.
@@ -764,12 +722,185 @@ namespace BaconBox {
 			}
 		}
 
+		/**
+		 * Inserts a body in the array of bodies, after the bodies with the
+		 * same z.
+		 * @param newBody Body to insert.
+		 * @return Iterator to the inserted body.
+		 */
+		typename BodyMap::iterator insertBody(typename BodyMap::value_type newBody) {
+			return bodies.insert(std::upper_bound(bodies.begin(), bodies.end(),
+			                                      newBody, Orderable::LessCompare()),
+			                     newBody);
+		}
+
+		/**
+		 * Takes the bodies to delete and the bodies that had their z changed
+		 * out of the batch. The remaining bodies and their vertices are packed
+		 * in a single pass instead of erasing each body separately. The
+		 * remaining bodies' indices are packed and shifted in the same pass,
+		 * so the indices are only reconstructed when they can't be patched.
+		 */
+		void compactBodies() {
+			bool patchIndices = canPatchIndices();
+			typename BodyMap::iterator kept = bodies.begin();
+			VertexArray::SizeType nbVertices = 0;
+			VertexArray::SizeType firstMoved = vertices.getNbVertices();
+			IndiceArray::size_type indiceRead = 0, indiceWrite = 0;
+
+			for (typename BodyMap::iterator i = bodies.begin(); i != bodies.end(); ++i) {
+				VertexArray::SizeType begin = (*i)->getVertices().begin;
+				VertexArray::SizeType count = (*i)->getVertices().getNbVertices();
+				IndiceArray::size_type nbIndices = getNbIndices(count);
+
+				if ((*i)->isToBeDeleted()) {
+					firstMoved = std::min(firstMoved, nbVertices);
+					delete *i;
+
+				} else if ((*i)->isKeyChanged()) {
+					// We make a backup copy of its vertices, they are
+					// overwritten by the following bodies.
+					firstMoved = std::min(firstMoved, nbVertices);
+					(*i)->getVertices().unlinkVertices();
+					toChange.push_back(*i);
+
+				} else {
+					// We move the body's vertices after the previous body's.
+					if (begin != nbVertices) {
+						std::copy(vertices.getBegin() + begin,
+						          vertices.getBegin() + begin + count,
+						          vertices.getBegin() + nbVertices);
+						std::copy(batchVertices.begin() + begin,
+						          batchVertices.begin() + begin + count,
+						          batchVertices.begin() + nbVertices);
+						(*i)->getVertices().begin = nbVertices;
+					}
+
+					// We move the body's indices after the previous body's
+					// and make them point to the moved vertices.
+					if (patchIndices && (indiceRead != indiceWrite || begin != nbVertices)) {
+						IndiceArray::value_type shift = static_cast<IndiceArray::value_type>(begin - nbVertices);
+
+						for (IndiceArray::size_type j = 0; j < nbIndices; ++j) {
+							indices[indiceWrite + j] = indices[indiceRead + j] - shift;
+						}
+					}
+
+					nbVertices += count;
+					indiceWrite += nbIndices;
+					*(kept++) = *i;
+				}
+
+				indiceRead += nbIndices;
+			}
+
+			if (kept != bodies.end()) {
+				bodies.erase(kept, bodies.end());
+				vertices.erase(vertices.getBegin() + nbVertices, vertices.getEnd());
+				batchVertices.erase(batchVertices.begin() + nbVertices, batchVertices.end());
+
+				if (patchIndices) {
+					indices.erase(indices.begin() + indiceWrite, indices.end());
+					markVerticesMoved(firstMoved);
+
+				} else {
+					refreshIndices();
+				}
+			}
+		}
+
+		/**
+		 * Inserts the bodies that had their z changed back in the batch. They
+		 * are merged with the other bodies starting from the end of the
+		 * arrays, so each body and each vertex is moved at most once.
+		 */
+		void mergeChangedBodies() {
+			// The changed bodies with the same z keep their order.
+			std::stable_sort(toChange.begin(), toChange.end(), Orderable::LessCompare());
+
+			VertexArray::SizeType position = vertices.getNbVertices();
+
+			for (typename BodyList::const_iterator i = toChange.begin(); i != toChange.end(); ++i) {
+				position += (*i)->getVertices().vertices->size();
+			}
+
+			bodies.resize(bodies.size() + toChange.size(), NULL);
+
+			typename BodyMap::iterator body = bodies.begin() + (bodies.size() - toChange.size());
+			typename BodyMap::iterator output = bodies.end();
+			typename BodyList::iterator changed = toChange.end();
+
+			vertices.resize(position);
+			batchVertices.resize(position);
+
+			while (changed != toChange.begin()) {
+				// A changed body goes after the bodies with the same z.
+				if (body != bodies.begin() &&
+				    Orderable::LessCompare()(*(changed - 1), *(body - 1))) {
+					--body;
+					VertexArray::SizeType begin = (*body)->getVertices().begin;
+					VertexArray::SizeType count = (*body)->getVertices().getNbVertices();
+					position -= count;
+
+					if (begin != position) {
+						std::copy_backward(vertices.getBegin() + begin,
+						                   vertices.getBegin() + begin + count,
+						                   vertices.getBegin() + position + count);
+						std::copy_backward(batchVertices.begin() + begin,
+						                   batchVertices.begin() + begin + count,
+						                   batchVertices.begin() + position + count);
+						(*body)->getVertices().begin = position;
+					}
+
+					*(--output) = *body;
+
+				} else {
+					--changed;
+					VertexArray::ContainerType *backup = (*changed)->getVertices().vertices;
+					position -= backup->size();
+
+					// We put back the vertices from the body's backup copy.
+					std::copy(backup->begin(), backup->end(),
+					          vertices.getBegin() + position);
+					std::fill(batchVertices.begin() + position,
+					          batchVertices.begin() + position + backup->size(),
+					          BatchVertex(Vector2(), Vector2(), (*changed)->getColor()));
+
+					(*changed)->getVertices().nbVertices = backup->size();
+					(*changed)->getVertices().begin = position;
+					(*changed)->getVertices().vertices = NULL;
+					(*changed)->keyChanged = false;
+					delete backup;
+
+					*(--output) = *changed;
+				}
+			}
+
+			// We refresh the re-inserted bodies' texture coordinates.
+			for (typename BodyList::iterator i = toChange.begin(); i != toChange.end(); ++i) {
+				(*i)->refreshTextureCoordinates();
+			}
+
+			toChange.clear();
+		}
+
 		/**
 		 * Reconstructs the indices.
 		 */
 		void refreshIndices() {
 			static const StandardVertexArray::SizeType MAX_NB_INDICES = static_cast<StandardVertexArray::SizeType>(std::numeric_limits<IndiceArray::value_type>::max());
 
+			// The indices are only refreshed when vertices are added or
+			// removed, so the whole vertex buffer has to be uploaded again.
+			if (vertexBuffer) {
+				vertexBuffer->markAllDirty();
+			}
+
+			// The vertices were moved in the arrays, so all the positions
+			// are copied in the interleaved array again.
+			positionsDirtyBegin = 0;
+			positionsDirtyEnd = vertices.getNbVertices();
+
 			// We clear the current indices.
 			indices.clear();
 			indiceList.clear();
@@ -778,7 +909,7 @@ namespace BaconBox {
 			IndiceArray::size_type nbIndices = 0;
 
 			for (typename BodyMap::const_iterator i = bodies.begin(); i != bodies.end(); ++i) {
-				nbIndices += ((*i)->getVertices().getNbVertices() - 2) * 5 + 1;
+				nbIndices += getNbIndices((*i)->getVertices().getNbVertices());
 			}
 
 			// We reserve the necessary memory.
@@ -801,21 +932,119 @@ namespace BaconBox {
 					// We get the body's first vertex's indice.
 					indiceIterator = static_cast<IndiceArray::value_type>((*i)->getVertices().begin - indiceList.back().first);
 
-
 					// We add the indices for each of the body's triangles.
 					IndiceArray::value_type nbTriangles = static_cast<IndiceArray::value_type>((*i)->getVertices().getNbVertices() - 2);
 
 					for (IndiceArray::value_type j = 0; j < nbTriangles; ++j) {
-						indices.push_back(indiceIterator + j);
 						indices.push_back(indiceIterator + j);
 						indices.push_back(indiceIterator + j + 1);
 						indices.push_back(indiceIterator + j + 2);
-						indices.push_back(indiceIterator + j + 2);
 					}
 				}
 			}
 		}
 
+		/**
+		 * Adds the indices of a body whose vertices were just inserted in the
+		 * arrays. The indices following the body's are shifted instead of
+		 * reconstructing all of them.
+		 * @param position Index of the body's first vertex.
+		 * @param nbVertices Number of vertices the body has.
+		 */
+		void insertBodyIndices(VertexArray::SizeType position,
+		                       VertexArray::SizeType nbVertices) {
+			if (canPatchIndices()) {
+				IndiceArray::size_type first = findIndice(position);
+
+				// The following bodies' vertices were moved.
+				for (IndiceArray::iterator i = indices.begin() + first;
+				     i != indices.end(); ++i) {
+					*i += static_cast<IndiceArray::value_type>(nbVertices);
+				}
+
+				// We add the indices for each of the body's triangles.
+				indices.insert(indices.begin() + first, getNbIndices(nbVertices),
+				               IndiceArray::value_type());
+
+				IndiceArray::iterator indice = indices.begin() + first;
+
+				for (VertexArray::SizeType j = position; j + 2 < position + nbVertices; ++j) {
+					*(indice++) = static_cast<IndiceArray::value_type>(j);
+					*(indice++) = static_cast<IndiceArray::value_type>(j + 1);
+					*(indice++) = static_cast<IndiceArray::value_type>(j + 2);
+				}
+
+				markVerticesMoved(position);
+
+			} else {
+				refreshIndices();
+			}
+		}
+
+		/**
+		 * Checks whether or not the indices can be patched. They can only be
+		 * when all of the batch's vertices are addressed by a single segment,
+		 * which is always the case with 32 bit indices.
+		 * @return True if the indices can be patched, false if they need to
+		 * be reconstructed.
+		 */
+		bool canPatchIndices() const {
+			static const StandardVertexArray::SizeType MAX_NB_INDICES = static_cast<StandardVertexArray::SizeType>(std::numeric_limits<IndiceArray::value_type>::max());
+
+			return indiceList.size() == 1 &&
+			       vertices.getNbVertices() <= MAX_NB_INDICES;
+		}
+
+		/**
+		 * Finds the position of the first triangle using a vertex at or after
+		 * the given index. Each triangle starts with its lowest vertex and the
+		 * triangles are sorted, so a binary search is used.
+		 * @param position Index of the vertex to look for.
+		 * @return Position of the triangle's first indice.
+		 */
+		IndiceArray::size_type findIndice(VertexArray::SizeType position) const {
+			IndiceArray::size_type first = 0;
+			IndiceArray::size_type count = indices.size() / 3;
+
+			while (count > 0) {
+				IndiceArray::size_type step = count / 2;
+
+				if (indices[(first + step) * 3] < position) {
+					first += step + 1;
+					count -= step + 1;
+
+				} else {
+					count = step;
+				}
+			}
+
+			return first * 3;
+		}
+
+		/**
+		 * Takes note that the vertices starting at the given index were moved
+		 * in the arrays by an insertion or a removal.
+		 * @param position Index of the first moved vertex.
+		 */
+		void markVerticesMoved(VertexArray::SizeType position) {
+			if (position < vertices.getNbVertices()) {
+				markPositionsDirty(position, vertices.getNbVertices() - position);
+			}
+
+			if (vertexBuffer) {
+				vertexBuffer->markIndicesDirty();
+			}
+		}
+
+		/**
+		 * Gets the number of indices needed to draw a body.
+		 * @param nbVertices Number of vertices the body has.
+		 * @return Number of indices needed by the body's triangles.
+		 */
+		static IndiceArray::size_type getNbIndices(VertexArray::SizeType nbVertices) {
+			return (nbVertices >= 3) ? (nbVertices - 2) * 3 : 0;
+		}
+
 		/**
 		 * Reconstructs the indices and refreshes the colors and the texture
 		 * coordinates.
@@ -830,6 +1059,90 @@ namespace BaconBox {
 			}
 		}
 
+		/**
+		 * Takes note that some of the batch's vertices, texture coordinates or
+		 * colors were modified and need to be uploaded again.
+		 * @param first Index of the first modified vertex.
+		 * @param nbVertices Number of modified vertices.
+		 */
+		void markVerticesDirty(VertexArray::SizeType first,
+		                       VertexArray::SizeType nbVertices) {
+			if (vertexBuffer) {
+				vertexBuffer->markDirty(first, nbVertices);
+			}
+		}
+
+		/**
+		 * Takes note that some of the batch's vertices' positions were
+		 * modified and need to be copied in the interleaved array.
+		 * @param first Index of the first modified vertex.
+		 * @param nbVertices Number of modified vertices.
+		 */
+		void markPositionsDirty(VertexArray::SizeType first,
+		                        VertexArray::SizeType nbVertices) {
+			if (nbVertices) {
+				if (positionsDirtyBegin >= positionsDirtyEnd) {
+					positionsDirtyBegin = first;
+					positionsDirtyEnd = first + nbVertices;
+
+				} else {
+					positionsDirtyBegin = std::min(positionsDirtyBegin, first);
+					positionsDirtyEnd = std::max(positionsDirtyEnd, first + nbVertices);
+				}
+
+				markVerticesDirty(first, nbVertices);
+			}
+		}
+
+		/**
+		 * Copies the modified positions in the interleaved array before it
+		 * is sent to the graphic driver.
+		 */
+		void synchronizePositions() {
+			VertexArray::SizeType last = std::min(positionsDirtyEnd, vertices.getNbVertices());
+
+			if (positionsDirtyBegin < last) {
+				VertexHelper::copyStrided(&*(static_cast<const StandardVertexArray &>(vertices).getBegin() + positionsDirtyBegin),
+				                          last - positionsDirtyBegin,
+				                          &batchVertices[positionsDirtyBegin].position,
+				                          sizeof(BatchVertex));
+			}
+
+			positionsDirtyBegin = 0;
+			positionsDirtyEnd = 0;
+		}
+
+		/**
+		 * Asks the graphic driver for a vertex buffer if the batch doesn't
+		 * have one yet. The batch is drawn from client memory if the driver
+		 * doesn't support vertex buffers.
+		 */
+		void createVertexBuffer() {
+			if (!vertexBuffer) {
+				vertexBuffer = GraphicDriver::getInstance().createVertexBuffer(bufferUsage);
+			}
+		}
+
+		/**
+		 * Gives the batch's vertex buffer back to the graphic driver.
+		 */
+		void deleteVertexBuffer() {
+			if (vertexBuffer) {
+				GraphicDriver::getInstance().deleteVertexBuffer(vertexBuffer);
+				vertexBuffer = NULL;
+			}
+		}
+
+		/**
+		 * Gets the buffer usage a new batch starts with. Batches of animated
+		 * bodies are expected to change every frame.
+		 * @return Dynamic usage for animatable bodies, static usage for the
+		 * others.
+		 */
+		static VertexBufferUsage getDefaultBufferUsage() {
+			return (IsBaseOf<Animatable, T>::RESULT) ? VertexBufferUsage::DYNAMIC : VertexBufferUsage::STATIC;
+		}
+
 		/**
 		 * Contains all of the bodies to be rendered in batch. Bodies are sorted
 		 * by their z value (ascending).
@@ -842,12 +1155,6 @@ namespace BaconBox {
 		 */
 		BodyList toAdd;
 
-		/**
-		 * Contains all the bodies that are waiting to be removed from the main
-		 * container.
-		 */
-		BodyList toRemove;
-
 		/**
 		 * Contains all the bodies that are waiting to be re-inserted in the
 		 * main container after their z has changed.
@@ -860,14 +1167,25 @@ namespace BaconBox {
 		/// List of indexes for the the batches.
 		IndiceArrayList indiceList;
 
-		/// Array containing all the bodies' vertices.
+		/**
+		 * Array containing all the bodies' vertices. The bodies' vertex
+		 * arrays point in it.
+		 */
 		StandardVertexArray vertices;
 
-		/// Array containing the texture coordinates for each vertex.
-		TextureCoordinates textureCoordinates;
+		/**
+		 * Interleaved copy of the vertices with their texture coordinate and
+		 * their color, sent to the graphic driver. The bodies write their
+		 * texture coordinates and colors directly in it, the positions are
+		 * copied from the vertices before rendering.
+		 */
+		BatchVertexArray batchVertices;
+
+		/// Index of the first vertex whose position must be copied.
+		VertexArray::SizeType positionsDirtyBegin;
 
-		/// Array containint the colors for each vertex.
-		ColorArray colors;
+		/// Index following the last vertex whose position must be copied.
+		VertexArray::SizeType positionsDirtyEnd;
 
 		/**
 		 * Set to true while the render batch is looping through its bodies to
@@ -878,6 +1196,16 @@ namespace BaconBox {
 
 		/// Render batch's current mask.
 		Maskable *currentMask;
+
+		/**
+		 * Buffer in graphic memory containing the batch's vertices, texture
+		 * coordinates, colors and indices. NULL until the batch is rendered
+		 * or if the graphic driver doesn't support vertex buffers.
+		 */
+		VertexBuffer *vertexBuffer;
+
+		/// How often the batch's content is expected to change.
+		VertexBufferUsage bufferUsage;
 	};
 
 	template <typename T, bool ANIMATABLE>
@@ -58,6 +58,8 @@ namespace BaconBox {
 		 * @see BaconBox::Shapable<T>::vertices
 		 */
 		T &getVertices() {
+			refreshVertices(vertices);
+			prepareVerticesForChanges();
 			return vertices;
 		}
 
@@ -67,14 +69,34 @@ namespace BaconBox {
 		 * @see BaconBox::Shapable<T>::vertices
 		 */
 		const T &getVertices() const {
+			refreshVertices(vertices);
 			return vertices;
 		}
+	protected:
+		/**
+		 * Called every time the vertices are accessed. Does nothing by
+		 * default, bodies that keep their shape in local space overload it to
+		 * compute their world vertices only when they are needed.
+		 * @param verticesToRefresh Array containing the body's vertices.
+		 */
+		virtual void refreshVertices(T &) const {
+		}
+
+		/**
+		 * Called every time the vertices are accessed through the non-const
+		 * getter, once they are refreshed, since the caller can then change
+		 * them. Does nothing by default, bodies that keep their shape in local
+		 * space overload it to take the vertices back as their local shape
+		 * before it is used again.
+		 */
+		virtual void prepareVerticesForChanges() {
+		}
 	private:
 		/// Makes sure we are containing an array of vertices.
 		typedef typename StaticAssert<IsBaseOf<VertexArray, T>::RESULT>::Result IsVertexArray;
 
 		/// Array containing the body's vertices.
-		T vertices;
+		mutable T vertices;
 	};
 
 }
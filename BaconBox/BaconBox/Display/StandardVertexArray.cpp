@@ -79,7 +79,7 @@ namespace BaconBox {
 		vertices.insert(position, count, value);
 	}
 
-	void StandardVertexArray::insert(Iterator position, Iterator first, Iterator last) {
+	void StandardVertexArray::insert(Iterator position, ConstIterator first, ConstIterator last) {
 		vertices.insert(position, first, last);
 	}
 
@@ -137,7 +137,7 @@ namespace BaconBox {
 		 * @param first First vertex to be inserted.
 		 * @param last Vertex after the last vertex to be inserted.
 		 */
-		void insert(Iterator position, Iterator first, Iterator last);
+		void insert(Iterator position, ConstIterator first, ConstIterator last);
 
 		/**
 		 * Erases the specified vertex.
@@ -15,6 +15,10 @@ Font::Font(const std::string &name, const std::string &path) : fontPimpl(NULL) {
 	fontPimpl = new FontImplementation(name, path);
 }
 
+Font::Font(const std::string &name, std::vector<char> &fileContent) : fontPimpl(NULL) {
+	fontPimpl = new FontImplementation(name, fileContent);
+}
+
 const GlyphInformation *Font::getGlyphInformation(Char32 unicodeValue) {
 	return fontPimpl->getGlyphInformation(unicodeValue);
 }
@@ -27,10 +31,18 @@ void Font::setPointSize(int pointSize, int dpi) {
 	fontPimpl->setPointSize(pointSize, dpi);
 }
 
+const std::string &Font::getSize() const {
+	return fontPimpl->getSize();
+}
+
 int Font::getLineHeight() const {
 	return fontPimpl->getLineHeight();
 }
 
+unsigned int Font::getAtlasGeneration() const {
+	return fontPimpl->getAtlasGeneration();
+}
+
 void Font::setManualLineHeight(int lineHeight) {
 	fontPimpl->setManualLineHeight(lineHeight);
 }
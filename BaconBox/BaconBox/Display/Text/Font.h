@@ -6,6 +6,7 @@
 #define RB_FONT_H
 
 #include <string>
+#include <vector>
 #include "BaconBox/Display/Text/GlyphInformation.h"
 #include "BaconBox/Display/RBString32.h"
 
@@ -29,6 +30,14 @@ namespace BaconBox {
 		 */
 		Font(const std::string &name, const std::string &path);
 
+		/**
+		 * Constructor. Load the font from a font file's content.
+		 * @param name Name of the font.
+		 * @param fileContent Content of the font's file. The font takes it
+		 * and leaves it empty.
+		 */
+		Font(const std::string &name, std::vector<char> &fileContent);
+
 		/**
 		 * Return the name of the font.
 		 */
@@ -56,6 +65,13 @@ namespace BaconBox {
 		 */
 		void setPointSize(int pointSize, int dpi);
 
+		/**
+		 * Gets the font's current size, with its unit ("px" or "pt"). Glyphs
+		 * are cached by this size.
+		 * @return Current size of the font, for example "30px".
+		 */
+		const std::string &getSize() const;
+
 		/**
 		 * Tell the rendering font to use automatic line height (which is not always availlable,
 		 * but it's there most of the time.
@@ -75,6 +91,14 @@ namespace BaconBox {
 		 */
 		int getLineHeight() const;
 
+		/**
+		 * Gets the generation of the font's glyph atlases. When it changes,
+		 * glyph information read before might have lost its texture and must
+		 * be read again.
+		 * @return Generation of the font's glyph atlases.
+		 */
+		unsigned int getAtlasGeneration() const;
+
 	private:
 
 		/**
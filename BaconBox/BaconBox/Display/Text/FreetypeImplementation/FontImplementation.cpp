@@ -10,6 +10,21 @@
 #include "BaconBox/Helper/DeleteHelper.h"
 
 namespace BaconBox {
+	namespace {
+		/**
+		 * Prints why a font face couldn't be loaded.
+		 * @param error Error returned by Freetype when loading the face.
+		 */
+		void checkFaceError(FT_Error error) {
+			if (error == FT_Err_Unknown_File_Format) {
+				Console::println("Can't load font, unknow font file format");
+
+			} else if (error) {
+				Console::println("Can't load font, unknow error");
+			}
+		}
+	}
+
 	FT_Library FontImplementation::fontRenderer = NULL;
 
 
@@ -25,19 +40,25 @@ namespace BaconBox {
 
 	FontImplementation::FontImplementation(const std::string &newName,
 	                                       const std::string &newPath) :
-		name(newName), size(), font(), automaticLineHeight(true), lineHeight(0),
-		texturesKey(), glyphCache() {
+		name(newName), size(), font(), fileContent(), automaticLineHeight(true),
+		lineHeight(0), texturesKey(), glyphCache(), atlases() {
 
 		// We load the font face
-		int error = FT_New_Face(fontRenderer, newPath.c_str(), 0, &font);
-
-		if (error == FT_Err_Unknown_File_Format) {
-			Console::println("Can't load font, unknow font file format");
-
-		} else if (error) {
-			Console::println("Can't load font, unknow error");
-		}
+		checkFaceError(FT_New_Face(fontRenderer, newPath.c_str(), 0, &font));
+		setPixelSize(30);
+	}
 
+	FontImplementation::FontImplementation(const std::string &newName,
+	                                       std::vector<char> &newFileContent) :
+		name(newName), size(), font(), fileContent(), automaticLineHeight(true),
+		lineHeight(0), texturesKey(), glyphCache(), atlases() {
+		// Freetype reads the face from the content as long as it exists, so
+		// we keep it.
+		fileContent.swap(newFileContent);
+		checkFaceError(FT_New_Memory_Face(fontRenderer,
+		                                  reinterpret_cast<const FT_Byte *>((fileContent.empty()) ? (NULL) : (&fileContent[0])),
+		                                  static_cast<FT_Long>(fileContent.size()),
+		                                  0, &font));
 		setPixelSize(30);
 	}
 
@@ -46,12 +67,13 @@ namespace BaconBox {
 		     ++i) {
 			std::for_each(i->second.begin(), i->second.end(), DeletePointerFromPair());
 		}
+
+		std::for_each(atlases.begin(), atlases.end(), DeletePointerFromPair());
 	}
 
 	const GlyphInformation *FontImplementation::getGlyphInformation(Char32 unicodeValue) {
 		GlyphCache::iterator i = glyphCache.find(size);
-		GlyphInformation *result;
-		bool glyphCached = false;
+		GlyphInformation *result = NULL;
 
 		//we check if the glyph is already loaded and cached.
 		if (i != glyphCache.end()) {
@@ -59,53 +81,38 @@ namespace BaconBox {
 
 			if (j != i->second.end()) {
 				result = j->second;
-				glyphCached = true;
 			}
 		}
 
 		//If the glyph is not already cached
-		if (glyphCached == false) {
-			FT_UInt glyph_index;
-			//We ask the font face what is the glyph index for the given unicode value
-			glyph_index = FT_Get_Char_Index(font, unicodeValue);
-
-			//we load the glyph
-			if (FT_Load_Glyph(font, glyph_index, FT_LOAD_RENDER)) {
-				Console::println("Can't load glyph");
-			}
-
-			FT_Glyph currentGlyph;
-
-			if (FT_Get_Glyph(font->glyph,  &currentGlyph)) {
-				Console::println("Can't extract glyph from freetype glyph slot");
-			}
+		if (!result) {
+			result = new GlyphInformation();
+			renderGlyph(unicodeValue, result);
 
-			FT_BitmapGlyph currentBitmapGlyph = (FT_BitmapGlyph)currentGlyph;
+			i = glyphCache.insert(std::make_pair(size, GlyphCache::mapped_type())).first;
 
-			// We save the size of the glyph
-			int glyphWidth = font->glyph->bitmap.width;
-			int glyphHeight = font->glyph->bitmap.rows;
+			i->second.insert(std::make_pair(unicodeValue, result));
 
-			result = new GlyphInformation();
-			std::stringstream key;
-			key << name << "-" << size << "-" << unicodeValue;
+		} else if (result->size.x > 0.0f && result->textureCoordinates.empty()) {
+			// The glyph's image was evicted from the atlas, we render it again.
+			renderGlyph(unicodeValue, result);
 
-			//PixMap *glyphPixMap = new PixMap(currentBitmapGlyph->bitmap.buffer, glyphWidth, glyphHeight, ColorFormat::ALPHA);
-			PixMap *glyphPixMap = new PixMap(glyphWidth + 2, glyphHeight + 2, 0, ColorFormat::ALPHA);
-			glyphPixMap->insertSubPixMap(currentBitmapGlyph->bitmap.buffer, glyphWidth, glyphHeight, 1, 1);
-			result->textureInformation = ResourceManager::addTexture(key.str(), glyphPixMap);
-			result->advance.x = static_cast<float>(font->glyph->advance.x >> 6);
+		} else {
+			AtlasMap::iterator atlas = atlases.find(size);
 
-			result->size.x = static_cast<float>(glyphWidth);
-			result->size.y = static_cast<float>(glyphHeight);
+			if (atlas != atlases.end()) {
+				atlas->second->use(result);
+			}
+		}
 
-			result->horizontalBearing.x = static_cast<float>(font->glyph->bitmap_left);
-			result->horizontalBearing.y = static_cast<float>(font->glyph->bitmap_top);
+		return result;
+	}
 
-			i = glyphCache.insert(std::make_pair(size, GlyphCache::mapped_type())).first;
+	unsigned int FontImplementation::getAtlasGeneration() const {
+		unsigned int result = 0u;
 
-			i->second.insert(std::make_pair(unicodeValue, result));
-			FT_Done_Glyph(currentGlyph);
+		for (AtlasMap::const_iterator i = atlases.begin(); i != atlases.end(); ++i) {
+			result += i->second->getGeneration();
 		}
 
 		return result;
@@ -127,6 +134,10 @@ namespace BaconBox {
 		(size = Parser::intToString(pointSize)).append("pt");
 	}
 
+	const std::string &FontImplementation::getSize() const {
+		return size;
+	}
+
 	void FontImplementation::setManualLineHeight(int newLineHeight) {
 		lineHeight = newLineHeight;
 		automaticLineHeight = false;
@@ -144,4 +155,44 @@ namespace BaconBox {
 	void FontImplementation::setAutomaticLineHeight() {
 		automaticLineHeight = true;
 	}
+
+	void FontImplementation::renderGlyph(Char32 unicodeValue,
+	                                     GlyphInformation *glyph) {
+		FT_UInt glyph_index;
+		//We ask the font face what is the glyph index for the given unicode value
+		glyph_index = FT_Get_Char_Index(font, unicodeValue);
+
+		//we load the glyph
+		if (FT_Load_Glyph(font, glyph_index, FT_LOAD_RENDER)) {
+			Console::println("Can't load glyph");
+		}
+
+		// We save the size of the glyph
+		unsigned int glyphWidth = font->glyph->bitmap.width;
+		unsigned int glyphHeight = font->glyph->bitmap.rows;
+
+		glyph->advance.x = static_cast<float>(font->glyph->advance.x >> 6);
+
+		glyph->size.x = static_cast<float>(glyphWidth);
+		glyph->size.y = static_cast<float>(glyphHeight);
+
+		glyph->horizontalBearing.x = static_cast<float>(font->glyph->bitmap_left);
+		glyph->horizontalBearing.y = static_cast<float>(font->glyph->bitmap_top);
+
+		// Glyphs without an image (like spaces) don't need a place in the
+		// atlas.
+		if (glyphWidth > 0 && glyphHeight > 0) {
+			AtlasMap::iterator atlas = atlases.find(size);
+
+			if (atlas == atlases.end()) {
+				atlas = atlases.insert(std::make_pair(size, new GlyphAtlas(name + "-" + size))).first;
+			}
+
+			if (!atlas->second->insert(font->glyph->bitmap.buffer, glyphWidth,
+			                           glyphHeight, font->glyph->bitmap.pitch,
+			                           glyph)) {
+				Console::println("Can't place glyph in the font's atlas, it is too big.");
+			}
+		}
+	}
 }
@@ -12,6 +12,7 @@
 #include <map>
 
 #include "BaconBox/Display/Text/GlyphInformation.h"
+#include "BaconBox/Display/Text/GlyphAtlas.h"
 #include "BaconBox/Display/RBString32.h"
 
 namespace BaconBox {
@@ -27,6 +28,9 @@ namespace BaconBox {
 		friend class Font;
 	private:
 		typedef std::map<std::string, std::map< Char32, GlyphInformation *> > GlyphCache;
+
+		/// Type used to contain the glyph atlases by size.
+		typedef std::map<std::string, GlyphAtlas *> AtlasMap;
 		/**
 		 * Initialize the font renderer (freetype).
 		 */
@@ -39,6 +43,8 @@ namespace BaconBox {
 		 */
 		FontImplementation(const std::string &newName, const std::string &newPath);
 
+		FontImplementation(const std::string &newName, std::vector<char> &newFileContent);
+
 		/**
 		 * Destructor
 		 */
@@ -56,6 +62,14 @@ namespace BaconBox {
 		 */
 		const GlyphInformation *getGlyphInformation(Char32 unicodeValue);
 
+		/**
+		 * Gets the sum of the generations of the font's glyph atlases. Changes
+		 * every time glyphs are evicted from one of the atlases.
+		 * @return Generation of the font's glyph atlases.
+		 * @see BaconBox::GlyphAtlas::getGeneration()
+		 */
+		unsigned int getAtlasGeneration() const;
+
 		/**
 		 * Set the font size in pixel.
 		 * Warning: character wont necesserly be "pixelSize" wide.
@@ -71,6 +85,12 @@ namespace BaconBox {
 		 */
 		void setPointSize(int pointSize, int dpi);
 
+		/**
+		 * Gets the font's current size, used as the key of the glyph cache.
+		 * @return Current size of the font, for example "30px".
+		 */
+		const std::string &getSize() const;
+
 		/**
 		 * Gets the line's height (automatic or manual depending on the case,
 		 * automatic by default).
@@ -90,6 +110,14 @@ namespace BaconBox {
 		 */
 		void setManualLineHeight(int newLineHeight);
 
+		/**
+		 * Renders a glyph with freetype at the current size and places its
+		 * image in the atlas of the current size.
+		 * @param unicodeValue Unicode value of the glyph to render.
+		 * @param glyph Glyph information to fill.
+		 */
+		void renderGlyph(Char32 unicodeValue, GlyphInformation *glyph);
+
 		/// Name of the font
 		std::string name;
 
@@ -109,6 +137,10 @@ namespace BaconBox {
 		 */
 		FT_Face font;
 
+		/// Content of the font's file when it was loaded from memory,
+		/// Freetype reads the face from it.
+		std::vector<char> fileContent;
+
 		bool automaticLineHeight;
 
 		int lineHeight;
@@ -130,6 +162,12 @@ namespace BaconBox {
 		 */
 		GlyphCache glyphCache;
 
+		/**
+		 * Atlases containing the glyphs' images, by size. Every glyph of a
+		 * size shares the same few textures.
+		 */
+		AtlasMap atlases;
+
 		/// Global font renderer (Freetype library).
 		static FT_Library fontRenderer;
 
@@ -0,0 +1,186 @@
+#include "BaconBox/Display/Text/GlyphAtlas.h"
+
+#include "BaconBox/ResourceManager.h"
+#include "BaconBox/Display/PixMap.h"
+#include "BaconBox/Display/Driver/GraphicDriver.h"
+#include "BaconBox/Helper/MathHelper.h"
+#include "BaconBox/Helper/Parser.h"
+
+namespace BaconBox {
+	GlyphAtlas::GlyphAtlas(const std::string &newName,
+	                       unsigned int newPageSize,
+	                       unsigned int newMaximumNbPages) : name(newName),
+		pageSize(MathHelper::nextPowerOf2(newPageSize)),
+		maximumNbPages(newMaximumNbPages), nbPagesCreated(0u),
+		useCounter(0u), generation(0u), pages() {
+	}
+
+	GlyphAtlas::~GlyphAtlas() {
+		for (PageArray::iterator i = pages.begin(); i != pages.end(); ++i) {
+			if (i->texture) {
+				ResourceManager::removeTexture(i->key);
+			}
+		}
+	}
+
+	bool GlyphAtlas::insert(const unsigned char *buffer, unsigned int width,
+	                        unsigned int height, int pitch,
+	                        GlyphInformation *glyph) {
+		// We keep a transparent border around the glyph so the texture
+		// filtering doesn't bleed the neighbouring glyphs in.
+		unsigned int paddedWidth = width + 2u, paddedHeight = height + 2u;
+
+		if (!glyph || paddedWidth > pageSize || paddedHeight > pageSize) {
+			return false;
+		}
+
+		unsigned int x = 0u, y = 0u;
+		Page *page = NULL;
+
+		// We look for a page with enough space left.
+		for (PageArray::iterator i = pages.begin(); i != pages.end() && !page; ++i) {
+			if (allocate(*i, paddedWidth, paddedHeight, x, y)) {
+				page = &(*i);
+			}
+		}
+
+		if (!page) {
+			if (maximumNbPages == 0u || pages.size() < maximumNbPages) {
+				page = &addPage();
+
+			} else {
+				// We empty the least recently used page.
+				page = &pages.front();
+
+				for (PageArray::iterator i = pages.begin() + 1; i != pages.end(); ++i) {
+					if (i->lastUse < page->lastUse) {
+						page = &(*i);
+					}
+				}
+
+				clearPage(*page);
+			}
+
+			// The page is empty, so the glyph always fits.
+			allocate(*page, paddedWidth, paddedHeight, x, y);
+		}
+
+		// We copy the glyph's image in the page's texture.
+		if (page->texture) {
+			PixMap image(paddedWidth, paddedHeight, 0, ColorFormat::ALPHA);
+
+			for (unsigned int row = 0u; row < height; ++row) {
+				image.insertSubPixMap(buffer + static_cast<int>(row) * pitch,
+				                      width, 1u, 1u, row + 1u);
+			}
+
+			GraphicDriver::getInstance().updateTexture(page->texture, image, x, y);
+		}
+
+		// We set the glyph's position in the page.
+		float left = static_cast<float>(x + 1u), top = static_cast<float>(y + 1u);
+		float right = left + static_cast<float>(width), bottom = top + static_cast<float>(height);
+		float texelSize = 1.0f / static_cast<float>(pageSize);
+
+		glyph->textureInformation = page->texture;
+		glyph->texturePosition.x = left;
+		glyph->texturePosition.y = top;
+		glyph->textureCoordinates.resize(4);
+		glyph->textureCoordinates[0] = Vector2(left, top) * texelSize;
+		glyph->textureCoordinates[1] = Vector2(right, top) * texelSize;
+		glyph->textureCoordinates[2] = Vector2(left, bottom) * texelSize;
+		glyph->textureCoordinates[3] = Vector2(right, bottom) * texelSize;
+
+		page->glyphs.push_back(glyph);
+		page->lastUse = ++useCounter;
+
+		return true;
+	}
+
+	void GlyphAtlas::use(const GlyphInformation *glyph) {
+		if (glyph && !glyph->textureCoordinates.empty()) {
+			PageArray::iterator i = pages.begin();
+
+			while (i != pages.end() && i->texture != glyph->textureInformation) {
+				++i;
+			}
+
+			if (i != pages.end()) {
+				i->lastUse = ++useCounter;
+			}
+		}
+	}
+
+	unsigned int GlyphAtlas::getGeneration() const {
+		return generation;
+	}
+
+	unsigned int GlyphAtlas::getNbPages() const {
+		return static_cast<unsigned int>(pages.size());
+	}
+
+	bool GlyphAtlas::allocate(Page &page, unsigned int width,
+	                          unsigned int height, unsigned int &x,
+	                          unsigned int &y) const {
+		// We look for the shortest shelf the rectangle fits in, to waste as
+		// little space as possible.
+		Shelf *best = NULL;
+
+		for (std::vector<Shelf>::iterator i = page.shelves.begin();
+		     i != page.shelves.end(); ++i) {
+			if (height <= i->height && i->x + width <= pageSize &&
+			    (!best || i->height < best->height)) {
+				best = &(*i);
+			}
+		}
+
+		// If no shelf has enough space, we add a new one under the others.
+		if (!best && page.nextShelfY + height <= pageSize) {
+			Shelf newShelf;
+			newShelf.y = page.nextShelfY;
+			newShelf.height = height;
+			newShelf.x = 0u;
+			page.shelves.push_back(newShelf);
+			page.nextShelfY += height;
+			best = &page.shelves.back();
+		}
+
+		if (best) {
+			x = best->x;
+			y = best->y;
+			best->x += width;
+			return true;
+
+		} else {
+			return false;
+		}
+	}
+
+	GlyphAtlas::Page &GlyphAtlas::addPage() {
+		pages.push_back(Page());
+		Page &result = pages.back();
+		result.key = name + "-" + Parser::intToString(static_cast<int>(nbPagesCreated++));
+		result.nextShelfY = 0u;
+		result.lastUse = useCounter;
+
+		// We create an empty texture for the page.
+		PixMap empty(pageSize, pageSize, 0, ColorFormat::ALPHA);
+		result.texture = ResourceManager::addTexture(result.key, &empty);
+
+		return result;
+	}
+
+	void GlyphAtlas::clearPage(Page &page) {
+		for (std::vector<GlyphInformation *>::iterator i = page.glyphs.begin();
+		     i != page.glyphs.end(); ++i) {
+			(*i)->textureInformation = NULL;
+			(*i)->texturePosition = Vector2();
+			(*i)->textureCoordinates.clear();
+		}
+
+		page.glyphs.clear();
+		page.shelves.clear();
+		page.nextShelfY = 0u;
+		++generation;
+	}
+}
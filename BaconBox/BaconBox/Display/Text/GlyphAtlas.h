@@ -0,0 +1,179 @@
+/**
+ * @file
+ * @ingroup TextDisplay
+ */
+#ifndef RB_GLYPH_ATLAS_H
+#define RB_GLYPH_ATLAS_H
+
+#include <string>
+#include <vector>
+
+#include "BaconBox/Display/Text/GlyphInformation.h"
+
+namespace BaconBox {
+	struct TextureInformation;
+
+	/**
+	 * Packs the images of the glyphs of a font at a specific size in a few
+	 * shared textures (pages), so text using the font can be drawn with very
+	 * few texture changes. Glyphs are placed on shelves, rows of glyphs of
+	 * similar heights. Pages are added when needed. When the maximum number
+	 * of pages is reached, the least recently used page is emptied and its
+	 * glyphs must be inserted again before being used.
+	 * @ingroup TextDisplay
+	 */
+	class GlyphAtlas {
+	public:
+		/// Default width and height of the pages (in pixels).
+		static const unsigned int DEFAULT_PAGE_SIZE = 512u;
+
+		/// Default maximum number of pages.
+		static const unsigned int DEFAULT_MAXIMUM_NB_PAGES = 4u;
+
+		/**
+		 * Parameterized constructor.
+		 * @param newName Name used to build the keys of the pages' textures
+		 * in the resource manager.
+		 * @param newPageSize Width and height of the pages (in pixels).
+		 * Rounded up to the next power of 2.
+		 * @param newMaximumNbPages Maximum number of pages, 0 for no maximum.
+		 */
+		explicit GlyphAtlas(const std::string &newName,
+		                    unsigned int newPageSize = DEFAULT_PAGE_SIZE,
+		                    unsigned int newMaximumNbPages = DEFAULT_MAXIMUM_NB_PAGES);
+
+		/**
+		 * Destructor. Removes the pages' textures from the resource manager.
+		 */
+		~GlyphAtlas();
+
+		/**
+		 * Copies a glyph's image in the atlas and sets the glyph's texture,
+		 * texture position and texture coordinates. A transparent border of
+		 * one pixel is kept around the image.
+		 * @param buffer Alpha values of the glyph's image.
+		 * @param width Width of the glyph's image (in pixels).
+		 * @param height Height of the glyph's image (in pixels).
+		 * @param pitch Number of bytes between the start of each row in the
+		 * buffer.
+		 * @param glyph Glyph to place in the atlas.
+		 * @return True if the glyph was placed, false if its image is too big
+		 * to fit in a page.
+		 */
+		bool insert(const unsigned char *buffer, unsigned int width,
+		            unsigned int height, int pitch, GlyphInformation *glyph);
+
+		/**
+		 * Marks a glyph's page as recently used, so it is the last to be
+		 * emptied when space is needed.
+		 * @param glyph Glyph used.
+		 */
+		void use(const GlyphInformation *glyph);
+
+		/**
+		 * Gets the number of times a page was emptied. The texture coordinates
+		 * read from glyphs before the generation changes might be invalid.
+		 * @return Atlas' generation.
+		 */
+		unsigned int getGeneration() const;
+
+		/**
+		 * Gets the number of pages the atlas currently has.
+		 * @return Number of pages.
+		 */
+		unsigned int getNbPages() const;
+	private:
+		/// Row of glyphs in a page.
+		struct Shelf {
+			/// Vertical position of the shelf in its page.
+			unsigned int y;
+
+			/// Height of the shelf.
+			unsigned int height;
+
+			/// Horizontal position where the next glyph is placed.
+			unsigned int x;
+		};
+
+		/// Texture containing glyphs.
+		struct Page {
+			/// Key of the page's texture in the resource manager.
+			std::string key;
+
+			/// Page's texture.
+			TextureInformation *texture;
+
+			/// Rows of glyphs in the page.
+			std::vector<Shelf> shelves;
+
+			/// Vertical position where the next shelf is added.
+			unsigned int nextShelfY;
+
+			/// Value of the use counter the last time the page was used.
+			unsigned long lastUse;
+
+			/// Glyphs placed in the page.
+			std::vector<GlyphInformation *> glyphs;
+		};
+
+		/// Type used to contain the pages.
+		typedef std::vector<Page> PageArray;
+
+		/// Name used to build the keys of the pages' textures.
+		std::string name;
+
+		/// Width and height of the pages.
+		unsigned int pageSize;
+
+		/// Maximum number of pages, 0 for no maximum.
+		unsigned int maximumNbPages;
+
+		/// Number of pages created since the atlas was created.
+		unsigned int nbPagesCreated;
+
+		/// Incremented every time a glyph is inserted or used.
+		unsigned long useCounter;
+
+		/// Number of times a page was emptied.
+		unsigned int generation;
+
+		/// Pages of the atlas.
+		PageArray pages;
+
+		/**
+		 * Private undefined copy constructor.
+		 */
+		GlyphAtlas(const GlyphAtlas &src);
+
+		/**
+		 * Private undefined assignment operator.
+		 */
+		GlyphAtlas &operator=(const GlyphAtlas &src);
+
+		/**
+		 * Finds a place for a rectangle in a page.
+		 * @param page Page in which to find a place.
+		 * @param width Width of the rectangle.
+		 * @param height Height of the rectangle.
+		 * @param x Horizontal position found.
+		 * @param y Vertical position found.
+		 * @return True if a place was found, false if the page is full.
+		 */
+		bool allocate(Page &page, unsigned int width, unsigned int height,
+		              unsigned int &x, unsigned int &y) const;
+
+		/**
+		 * Adds an empty page to the atlas.
+		 * @return Reference to the new page.
+		 */
+		Page &addPage();
+
+		/**
+		 * Empties a page. Its glyphs lose their texture coordinates.
+		 * @param page Page to empty.
+		 */
+		void clearPage(Page &page);
+	};
+}
+
+#endif // RB_GLYPH_ATLAS_H
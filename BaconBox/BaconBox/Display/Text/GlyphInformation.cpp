@@ -2,7 +2,8 @@
 
 namespace BaconBox {
 	GlyphInformation::GlyphInformation() : advance(), horizontalBearing(),
-		size(), textureInformation(NULL) {
+		size(), textureInformation(NULL), texturePosition(),
+		textureCoordinates() {
 	}
 
 	GlyphInformation::GlyphInformation(const Vector2 &newAdvance,
@@ -10,12 +11,15 @@ namespace BaconBox {
 	                                   const Vector2 &newSize,
 	                                   TextureInformation *newTextureInformation) :
 		advance(newAdvance), horizontalBearing(newHorizontalBearing),
-		size(newSize), textureInformation(newTextureInformation) {
+		size(newSize), textureInformation(newTextureInformation),
+		texturePosition(), textureCoordinates() {
 	}
 
 	GlyphInformation::GlyphInformation(const GlyphInformation &src) :
 		advance(src.advance), horizontalBearing(src.horizontalBearing),
-		size(src.size), textureInformation(src.textureInformation) {
+		size(src.size), textureInformation(src.textureInformation),
+		texturePosition(src.texturePosition),
+		textureCoordinates(src.textureCoordinates) {
 	}
 
 	GlyphInformation &GlyphInformation::operator=(const GlyphInformation &src) {
@@ -24,6 +28,8 @@ namespace BaconBox {
 			horizontalBearing = src.horizontalBearing;
 			size = src.size;
 			textureInformation = src.textureInformation;
+			texturePosition = src.texturePosition;
+			textureCoordinates = src.textureCoordinates;
 		}
 
 		return *this;
@@ -6,6 +6,7 @@
 #define RB_GLYPH_INFORMATION_H
 
 #include "BaconBox/Vector2.h"
+#include "BaconBox/Display/TextureCoordinates.h"
 
 namespace BaconBox {
 	/**
@@ -38,9 +39,23 @@ namespace BaconBox {
 		/// Glyph's size.
 		Vector2 size;
 
-		/// Pointer to the texture handle and texture size.
+		/**
+		 * Pointer to the texture handle and texture size. The texture is a
+		 * glyph atlas page shared with the other glyphs of the same font and
+		 * size.
+		 */
 		TextureInformation *textureInformation;
 
+		/// Position of the glyph's image in the texture (in pixels).
+		Vector2 texturePosition;
+
+		/**
+		 * Texture coordinates of the glyph's image in its atlas page. Empty
+		 * if the glyph has no image or if its image was evicted from the
+		 * atlas.
+		 */
+		TextureCoordinates textureCoordinates;
+
 		/**
 		 * Default constructor.
 		 */
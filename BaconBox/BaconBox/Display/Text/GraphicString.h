@@ -7,7 +7,9 @@
 
 #include <cassert>
 
-#include <list>
+#include <vector>
+#include <algorithm>
+#include <limits>
 #include <utility>
 
 #include "BaconBox/Display/Text/Font.h"
@@ -17,7 +19,9 @@
 #include "BaconBox/Display/Text/TextDirection.h"
 #include "BaconBox/Display/Text/TextAlignment.h"
 #include "BaconBox/Display/Colorable.h"
-#include "BaconBox/Display/InanimateGraphicElement.h"
+#include "BaconBox/Display/Driver/BatchVertex.h"
+#include "BaconBox/Display/Driver/IndiceArray.h"
+#include "BaconBox/Display/Driver/GraphicDriver.h"
 #include "BaconBox/Display/RBString32.h"
 #include "BaconBox/Display/StandardVertexArray.h"
 #include "BaconBox/Helper/StaticAssert.h"
@@ -28,7 +32,10 @@
 
 namespace BaconBox {
 	/**
-	 * A GraphicString is a body object used to display text.
+	 * A GraphicString is a body object used to display text. The glyphs'
+	 * quads are laid out once and kept in one batch per atlas page, so the
+	 * whole string is drawn in very few calls. Changing a few characters
+	 * without changing their advance only updates their quads.
 	 * @tparam T Either Transformable or Collidable.
 	 * @ingroup TextDisplay
 	 */
@@ -53,8 +60,11 @@ namespace BaconBox {
 		                       const Vector2 &startingPosition = Vector2()) :
 			Maskable(), T(startingPosition), Colorable(Color::BLACK),
 			font(newFont.pointer), text(),
-			alignment(newAlignment), direction(newDirection), characters(),
-			vertices(4, startingPosition), currentMask(NULL) {
+			alignment(newAlignment), direction(newDirection), glyphs(),
+			batches(), vertices(4, startingPosition), currentMask(NULL),
+			invertedMask(false), layoutDirty(false), layoutFontSize(),
+			layoutLineHeight(0), layoutScaling(1.0f, 1.0f), layoutOffset(),
+			layoutFont(NULL), atlasGeneration(0u) {
 			initialize();
 		}
 
@@ -78,8 +88,11 @@ namespace BaconBox {
 		              const Vector2 &startingPosition = Vector2()) :
 			Maskable(), T(startingPosition), Colorable(Color::BLACK),
 			font(newFont.pointer), text(UTFConvert::decodeUTF8(newText)),
-			alignment(newAlignment), direction(newDirection), characters(),
-			vertices(4, startingPosition), currentMask(NULL) {
+			alignment(newAlignment), direction(newDirection), glyphs(),
+			batches(), vertices(4, startingPosition), currentMask(NULL),
+			invertedMask(false), layoutDirty(false), layoutFontSize(),
+			layoutLineHeight(0), layoutScaling(1.0f, 1.0f), layoutOffset(),
+			layoutFont(NULL), atlasGeneration(0u) {
 			initialize();
 		}
 
@@ -103,8 +116,11 @@ namespace BaconBox {
 		              const Vector2 &startingPosition = Vector2()) :
 			Maskable(), T(startingPosition), Colorable(Color::BLACK),
 			font(newFont.pointer), text(newText),
-			alignment(newAlignment), direction(newDirection), characters(),
-			vertices(4, startingPosition), currentMask(NULL) {
+			alignment(newAlignment), direction(newDirection), glyphs(),
+			batches(), vertices(4, startingPosition), currentMask(NULL),
+			invertedMask(false), layoutDirty(false), layoutFontSize(),
+			layoutLineHeight(0), layoutScaling(1.0f, 1.0f), layoutOffset(),
+			layoutFont(NULL), atlasGeneration(0u) {
 			initialize();
 		}
 
@@ -115,15 +131,18 @@ namespace BaconBox {
 		GraphicString(const GraphicString<T> &src) : Maskable(src),
 			T(src), Colorable(src), font(src.font), text(src.text),
 			alignment(src.alignment), direction(src.direction),
-			characters(src.characters), vertices(src.vertices),
-			currentMask(src.currentMask) {
+			glyphs(src.glyphs), batches(src.batches), vertices(src.vertices),
+			currentMask(src.currentMask), invertedMask(src.invertedMask),
+			layoutDirty(src.layoutDirty), layoutFontSize(src.layoutFontSize),
+			layoutLineHeight(src.layoutLineHeight),
+			layoutScaling(src.layoutScaling), layoutOffset(src.layoutOffset),
+			layoutFont(src.layoutFont), atlasGeneration(src.atlasGeneration) {
 		}
 
 		/**
 		 * Destructor.
 		 */
 		virtual ~GraphicString() {
-			clearCharacters();
 		}
 
 		/**
@@ -140,15 +159,16 @@ namespace BaconBox {
 				text = src.text;
 				alignment = src.alignment;
 				direction = src.direction;
-				clearCharacters();
-				characters.clear();
-
-				for (GlyphList::const_iterator i = src.characters.begin();
-				     i != src.characters.end(); ++i) {
-					characters.push_back(std::make_pair(i->first, ((i->second) ? (new InanimateGraphicElement<Transformable>(*i->second)) : (i->second))));
-				}
-
+				glyphs = src.glyphs;
+				batches = src.batches;
 				vertices = src.vertices;
+				layoutDirty = src.layoutDirty;
+				layoutFontSize = src.layoutFontSize;
+				layoutLineHeight = src.layoutLineHeight;
+				layoutScaling = src.layoutScaling;
+				layoutOffset = src.layoutOffset;
+				layoutFont = src.layoutFont;
+				atlasGeneration = src.atlasGeneration;
 			}
 
 			return *this;
@@ -158,10 +178,29 @@ namespace BaconBox {
 		 * Renders the body in the context.
 		 */
 		virtual void render() {
-			for (GlyphList::const_iterator i = characters.begin();
-			     i != characters.end(); ++i) {
-				if (i->second) {
-					i->second->render();
+			refreshGlyphs();
+
+			if (currentMask) {
+				currentMask->mask();
+
+				for (typename GlyphBatchList::const_iterator i = batches.begin();
+				     i != batches.end(); ++i) {
+					GraphicDriver::getInstance().drawMaskedBatchWithTextureAndColor(i->vertices,
+					                                                                i->texture,
+					                                                                i->indices,
+					                                                                i->indiceList,
+					                                                                invertedMask);
+				}
+
+				currentMask->unmask();
+
+			} else {
+				for (typename GlyphBatchList::const_iterator i = batches.begin();
+				     i != batches.end(); ++i) {
+					GraphicDriver::getInstance().drawBatchWithTextureAndColor(i->vertices,
+					                                                          i->texture,
+					                                                          i->indices,
+					                                                          i->indiceList);
 				}
 			}
 		}
@@ -173,11 +212,14 @@ namespace BaconBox {
 		 * as a masked renderable body).
 		 */
 		virtual void mask() {
-			for (GlyphList::const_iterator i = characters.begin();
-			     i != characters.end(); ++i) {
-				if (i->second) {
-					i->second->mask();
-				}
+			refreshGlyphs();
+
+			for (typename GlyphBatchList::const_iterator i = batches.begin();
+			     i != batches.end(); ++i) {
+				GraphicDriver::getInstance().drawMaskBatchWithTextureAndColor(i->vertices,
+				                                                              i->texture,
+				                                                              i->indices,
+				                                                              i->indiceList);
 			}
 		}
 
@@ -186,11 +228,10 @@ namespace BaconBox {
 		 * masked renderable body has been rendered.
 		 */
 		virtual void unmask() {
-			for (GlyphList::const_iterator i = characters.begin();
-			     i != characters.end(); ++i) {
-				if (i->second) {
-					i->second->unmask();
-				}
+			for (typename GlyphBatchList::const_iterator i = batches.begin();
+			     i != batches.end(); ++i) {
+				GraphicDriver::getInstance().unmaskBatch(i->vertices, i->indices,
+				                                         i->indiceList);
 			}
 		}
 
@@ -210,13 +251,7 @@ namespace BaconBox {
 		 */
 		virtual void setMask(Maskable *newMask, bool inverted = false) {
 			currentMask = newMask;
-
-			for (GlyphList::const_iterator i = characters.begin();
-			     i != characters.end(); ++i) {
-				if (i->second) {
-					i->second->setMask(newMask, inverted);
-				}
-			}
+			invertedMask = inverted;
 		}
 
 		using Collidable::move;
@@ -235,13 +270,17 @@ namespace BaconBox {
 		virtual void move(float xDelta, float yDelta) {
 			this->Collidable::move(xDelta, yDelta);
 
-			for (GlyphList::const_iterator i = characters.begin();
-			     i != characters.end(); ++i) {
-				if (i->second) {
-					i->second->move(xDelta, yDelta);
+			for (typename GlyphBatchList::iterator i = batches.begin();
+			     i != batches.end(); ++i) {
+				for (BatchVertexArray::iterator j = i->vertices.begin();
+				     j != i->vertices.end(); ++j) {
+					j->position.x += xDelta;
+					j->position.y += yDelta;
 				}
 			}
 
+			layoutOffset.x += xDelta;
+			layoutOffset.y += yDelta;
 			vertices.move(xDelta, yDelta);
 		}
 
@@ -284,10 +323,14 @@ namespace BaconBox {
 		                            const Vector2 &fromPoint) {
 			this->Collidable::scaleFromPoint(xScaling, yScaling, fromPoint);
 
-			for (GlyphList::const_iterator i = characters.begin();
-			     i != characters.end(); ++i) {
-				if (i->second) {
-					i->second->scaleFromPoint(xScaling, yScaling, fromPoint);
+			for (typename GlyphBatchList::iterator i = batches.begin();
+			     i != batches.end(); ++i) {
+				for (BatchVertexArray::iterator j = i->vertices.begin();
+				     j != i->vertices.end(); ++j) {
+					j->position -= fromPoint;
+					j->position.x *= xScaling;
+					j->position.y *= yScaling;
+					j->position += fromPoint;
 				}
 			}
 
@@ -304,13 +347,7 @@ namespace BaconBox {
 		virtual void rotateFromPoint(float rotationAngle,
 		                             const Vector2 &rotationPoint) {
 			this->Collidable::rotateFromPoint(rotationAngle, rotationPoint);
-
-			for (GlyphList::const_iterator i = characters.begin();
-			     i != characters.end(); ++i) {
-				if (i->second) {
-					i->second->rotateFromPoint(rotationAngle, rotationPoint);
-				}
-			}
+			rotateBatches(rotationAngle, rotationPoint);
 
 			vertices.rotateFromPoint(rotationAngle, rotationPoint);
 			refreshPosition();
@@ -324,10 +361,11 @@ namespace BaconBox {
 		virtual void setColor(const Color &newColor) {
 			this->Colorable::setColor(newColor);
 
-			for (GlyphList::const_iterator i = characters.begin();
-			     i != characters.end(); ++i) {
-				if (i->second) {
-					i->second->setColor(newColor);
+			for (typename GlyphBatchList::iterator i = batches.begin();
+			     i != batches.end(); ++i) {
+				for (BatchVertexArray::iterator j = i->vertices.begin();
+				     j != i->vertices.end(); ++j) {
+					j->color = newColor;
 				}
 			}
 		}
@@ -342,9 +380,9 @@ namespace BaconBox {
 		}
 
 		/**
-		 * Sets the graphic string's font and refreshes the text to use the
-		 * given font. Does nothing and keeps the old font if the new font is
-		 * NULL.
+		 * Sets the graphic string's font. The text is laid out again with the
+		 * new font the next time it is changed or rendered. Does nothing and
+		 * keeps the old font if the new font is NULL.
 		 * @param newFont Pointer to the new font to use.
 		 */
 		void setFont(FontPointer newFont) {
@@ -383,12 +421,14 @@ namespace BaconBox {
 		}
 
 		/**
-		 * Sets the graphic string's text.
+		 * Sets the graphic string's text. When only a few characters change
+		 * and their advances stay the same (like the digits of a score), only
+		 * their quads are updated.
 		 * @param newText UTF32 string to use as the graphic string's text.
 		 * @see BaconBox::GraphicString::text
 		 */
 		void setUtf32Text(const String32 &newText) {
-			if (text != newText) {
+			if (text != newText && !patchString(newText)) {
 				text = newText;
 				buildString();
 			}
@@ -411,7 +451,10 @@ namespace BaconBox {
 		 * @see BaconBox::GraphicString::alignment
 		 */
 		void setAlignment(TextAlignment newAlignment) {
-			alignment = newAlignment;
+			if (alignment != newAlignment) {
+				alignment = newAlignment;
+				layoutDirty = true;
+			}
 		}
 
 		/**
@@ -439,8 +482,51 @@ namespace BaconBox {
 		/// Makes sure the body type is derived from the Manageable class.
 		typedef typename StaticAssert<IsBaseOf<Positionable, T>::RESULT>::Result IsAtLeastTransformable;
 
+		/**
+		 * Maximum number of times the glyphs are fetched when building the
+		 * string while the font keeps evicting them. If the glyphs are still
+		 * evicted after that, the string is built again on the next update.
+		 */
+		static const unsigned int MAX_NB_FETCHES = 3;
+
+		/// Glyph of the graphic string, with its place in the layout.
+		struct LaidOutGlyph {
+			/// Information about the glyph.
+			const GlyphInformation *glyph;
+
+			/// Horizontal position of the pen when the glyph was placed.
+			float pen;
+
+			/**
+			 * Index of the batch containing the glyph's quad, -1 if the glyph
+			 * doesn't have one.
+			 */
+			int batch;
+
+			/// Index of the quad's first vertex in its batch.
+			BatchVertexArray::size_type firstVertex;
+		};
+
 		/// Type used to represent the list of displayed glyphs.
-		typedef std::list<std::pair<const GlyphInformation *, InanimateGraphicElement<Transformable> *> > GlyphList;
+		typedef std::vector<LaidOutGlyph> GlyphList;
+
+		/// Quads of the glyphs sharing the same atlas page.
+		struct GlyphBatch {
+			/// Atlas page containing the images of the glyphs.
+			TextureInformation *texture;
+
+			/// Vertices of the glyphs' quads, 4 per glyph.
+			BatchVertexArray vertices;
+
+			/// Indices of the quads' triangles.
+			IndiceArray indices;
+
+			/// Segments of the indices.
+			IndiceArrayList indiceList;
+		};
+
+		/// Type used to contain the batches, one for each atlas page used.
+		typedef std::vector<GlyphBatch> GlyphBatchList;
 
 		/// Rendering font.
 		Font *font;
@@ -457,8 +543,11 @@ namespace BaconBox {
 		 */
 		TextDirection direction;
 
-		/// List of sprite representing each glyph.
-		GlyphList characters;
+		/// Glyphs of the string, in the order they are displayed.
+		GlyphList glyphs;
+
+		/// Batches containing the glyphs' quads.
+		GlyphBatchList batches;
 
 		/// Vertices representing the graphic string's rectangle.
 		StandardVertexArray vertices;
@@ -466,6 +555,61 @@ namespace BaconBox {
 		/// Pointer to the current mask.
 		Maskable *currentMask;
 
+		/// Whether or not the mask's effect is inverted.
+		bool invertedMask;
+
+		/**
+		 * Set when the alignment changed since the glyphs were laid out, the
+		 * next text change then lays them out again.
+		 */
+		bool layoutDirty;
+
+		/// Size of the font when the glyphs were laid out.
+		std::string layoutFontSize;
+
+		/// Line height of the font when the glyphs were laid out.
+		int layoutLineHeight;
+
+		/// Scaling of the string when the glyphs were laid out.
+		Vector2 layoutScaling;
+
+		/**
+		 * Delta applied to the glyphs' layout positions to get their
+		 * positions on screen.
+		 */
+		Vector2 layoutOffset;
+
+		/// Font the glyphs were laid out with.
+		const Font *layoutFont;
+
+		/**
+		 * Generation of the font's glyph atlases when the glyphs were built.
+		 * @see BaconBox::Font::getAtlasGeneration()
+		 */
+		unsigned int atlasGeneration;
+
+		/**
+		 * Checks whether or not a glyph has an image in a texture.
+		 * @param glyph Glyph to check.
+		 * @return True if the glyph needs a quad to be displayed.
+		 */
+		static bool hasImage(const GlyphInformation *glyph) {
+			return glyph->size.x > 0.0f && glyph->textureInformation &&
+			       glyph->textureCoordinates.size() == 4;
+		}
+
+		/**
+		 * Rebuilds the glyphs if the font was changed or if some of them
+		 * might have been evicted from the font's glyph atlases since they
+		 * were built. Uses the font's current size.
+		 */
+		void refreshGlyphs() {
+			if (font && (font != layoutFont ||
+			             font->getAtlasGeneration() != atlasGeneration)) {
+				buildString();
+			}
+		}
+
 		/**
 		 * Initializes the graphic string.
 		 */
@@ -476,186 +620,403 @@ namespace BaconBox {
 		}
 
 		/**
-		 * Builds the graphic string's list of glyphs.
-		 * @see BaconBox::GraphicString::characters;
+		 * Gets the point the text is aligned on, using the graphic string's
+		 * current rectangle.
+		 * @return Alignment position.
 		 */
-		void buildString() {
-			Vector2 alignmentPosition;
+		const Vector2 getAlignmentPosition() const {
+			Vector2 result;
 			assert(vertices.getNbVertices() == 4);
 
 			if (alignment == TextAlignment::LEFT) {
 				StandardVertexArray::ConstIterator i = vertices.getBegin();
 				Vector2 tmp = *i;
 				i += 2;
-				alignmentPosition = tmp + (*i - tmp) * 0.5f;
+				result = tmp + (*i - tmp) * 0.5f;
 
 			} else if (alignment == TextAlignment::RIGHT) {
 				StandardVertexArray::ConstIterator i = vertices.getBegin();
 				++i;
 				Vector2 tmp = *i;
 				i += 2;
-				alignmentPosition = tmp + (*i - tmp) * 0.5f;
+				result = tmp + (*i - tmp) * 0.5f;
 
 			} else {
-				alignmentPosition = vertices.getCentroid();
+				result = vertices.getCentroid();
 			}
 
-			clearCharacters();
-			characters.clear();
+			return result;
+		}
 
-			// We make sure the font is valid.
-			if (font) {
-				// We check the text direction.
-				if (direction == TextDirection::LEFT_TO_RIGHT) {
-					// We generate the list of glyphs (one for each of the text's
-					// characters).
-					const GlyphInformation *newGlyph;
-					InanimateGraphicElement<Transformable> *newGraphic;
-
-					for (String32::const_iterator i = text.begin();
-					     i != text.end(); ++i) {
-						newGlyph = font->getGlyphInformation(*i);
-
-						if (newGlyph->size.x > 0.0f) {
-							newGraphic = new InanimateGraphicElement<Transformable>(newGlyph->textureInformation, Vector2(0.0f, 0.0f), newGlyph->size, Vector2(1.0f, 1.0f));
-							newGraphic->setScaling(this->getScaling());
-							newGraphic->setColor(getColor());
-
-						} else {
-							newGraphic = NULL;
-						}
-
-						characters.push_back(std::make_pair(newGlyph, newGraphic));
+		/**
+		 * Gets a glyph's rectangle in the layout, before it is aligned.
+		 * @param glyph Glyph to get the rectangle of.
+		 * @param position Upper left corner of the glyph's rectangle.
+		 * @param size Size of the glyph's rectangle.
+		 */
+		void getGlyphRectangle(const LaidOutGlyph &glyph, Vector2 &position,
+		                       Vector2 &size) const {
+			position.x = glyph.pen + glyph.glyph->horizontalBearing.x * layoutScaling.x;
+			position.y = static_cast<float>(layoutLineHeight) + (glyph.glyph->size.y - glyph.glyph->horizontalBearing.y) - glyph.glyph->size.y * layoutScaling.y;
+			size.x = glyph.glyph->size.x * layoutScaling.x;
+			size.y = glyph.glyph->size.y * layoutScaling.y;
+		}
+
+		/**
+		 * Gets the rectangle containing all the glyphs in the layout.
+		 * @param minimum Upper left corner of the rectangle.
+		 * @param maximum Lower right corner of the rectangle.
+		 * @return False if none of the glyphs has a size.
+		 */
+		bool getLayoutBounds(Vector2 &minimum, Vector2 &maximum) const {
+			bool started = false;
+			Vector2 position, size;
+
+			for (typename GlyphList::const_iterator i = glyphs.begin();
+			     i != glyphs.end(); ++i) {
+				// Spaces do not have a rectangle.
+				if (i->glyph->size.x > 0.0f) {
+					getGlyphRectangle(*i, position, size);
+					size += position;
+
+					if (started) {
+						minimum.x = std::min(minimum.x, position.x);
+						minimum.y = std::min(minimum.y, position.y);
+						maximum.x = std::max(maximum.x, size.x);
+						maximum.y = std::max(maximum.y, size.y);
+
+					} else {
+						started = true;
+						minimum = position;
+						maximum = size;
 					}
+				}
+			}
 
-				} else if (direction == TextDirection::RIGHT_TO_LEFT) {
-					const GlyphInformation *newGlyph;
-					InanimateGraphicElement<Transformable> *newGraphic;
+			return started;
+		}
 
-					for (String32::const_reverse_iterator i = text.rbegin();
-					     i != text.rend(); ++i) {
-						newGlyph = font->getGlyphInformation(*i);
+		/**
+		 * Gets the delta to apply to the layout to align it with the
+		 * alignment position.
+		 * @param minimum Upper left corner of the layout's rectangle.
+		 * @param maximum Lower right corner of the layout's rectangle.
+		 * @param alignmentPosition Point to align the text on.
+		 * @return Delta to apply to the layout.
+		 */
+		const Vector2 getAlignmentDelta(const Vector2 &minimum,
+		                                const Vector2 &maximum,
+		                                const Vector2 &alignmentPosition) const {
+			Vector2 anchor((minimum + maximum) * 0.5f);
 
-						if (newGlyph->size.x > 0.0f) {
-							newGraphic = new InanimateGraphicElement<Transformable>(newGlyph->textureInformation, Vector2(0.0f, 0.0f), newGlyph->size, Vector2(1.0f, 1.0f));
-							newGraphic->setScaling(this->getScaling());
-							newGraphic->setColor(getColor());
+			if (alignment == TextAlignment::LEFT) {
+				anchor.x = minimum.x;
 
-						} else {
-							newGraphic = NULL;
-						}
+			} else if (alignment == TextAlignment::RIGHT) {
+				anchor.x = maximum.x;
+			}
 
-						characters.push_back(std::make_pair(newGlyph, newGraphic));
-					}
+			return alignmentPosition - anchor;
+		}
+
+		/**
+		 * Sets the graphic string's rectangle.
+		 * @param minimum Upper left corner of the rectangle.
+		 * @param maximum Lower right corner of the rectangle.
+		 */
+		void setRectangle(const Vector2 &minimum, const Vector2 &maximum) {
+			StandardVertexArray::Iterator it = vertices.getBegin();
+			it->x = minimum.x;
+			it->y = minimum.y;
+			++it;
+			it->x = maximum.x;
+			it->y = minimum.y;
+			++it;
+			it->x = minimum.x;
+			it->y = maximum.y;
+			++it;
+			it->x = maximum.x;
+			it->y = maximum.y;
+		}
+
+		/**
+		 * Adds a quad for a glyph in the batch of its atlas page.
+		 * @param glyph Glyph to add a quad for.
+		 */
+		void addQuad(LaidOutGlyph &glyph) {
+			static const StandardVertexArray::SizeType MAX_NB_INDICES = static_cast<StandardVertexArray::SizeType>(std::numeric_limits<IndiceArray::value_type>::max());
+
+			// We find the batch of the glyph's page.
+			typename GlyphBatchList::iterator batch = batches.begin();
+
+			while (batch != batches.end() && batch->texture != glyph.glyph->textureInformation) {
+				++batch;
+			}
+
+			if (batch == batches.end()) {
+				batches.push_back(GlyphBatch());
+				batch = batches.end() - 1;
+				batch->texture = glyph.glyph->textureInformation;
+			}
+
+			glyph.batch = static_cast<int>(batch - batches.begin());
+			glyph.firstVertex = batch->vertices.size();
+			batch->vertices.resize(glyph.firstVertex + 4);
+
+			// A new segment is started when the indices can't address the
+			// quad's vertices.
+			if (batch->indiceList.empty() ||
+			    glyph.firstVertex + 4 > batch->indiceList.back().first + MAX_NB_INDICES) {
+				batch->indiceList.push_back(std::make_pair(glyph.firstVertex, batch->indices.size()));
+			}
+
+			IndiceArray::value_type first = static_cast<IndiceArray::value_type>(glyph.firstVertex - batch->indiceList.back().first);
+			batch->indices.push_back(first);
+			batch->indices.push_back(first + 1);
+			batch->indices.push_back(first + 2);
+			batch->indices.push_back(first + 1);
+			batch->indices.push_back(first + 2);
+			batch->indices.push_back(first + 3);
+		}
+
+		/**
+		 * Writes a glyph's quad using its layout rectangle and the layout
+		 * offset. A glyph without an image gets an empty quad.
+		 * @param glyph Glyph to write the quad of.
+		 */
+		void writeQuad(const LaidOutGlyph &glyph) {
+			BatchVertexArray::iterator vertex = batches[glyph.batch].vertices.begin() + glyph.firstVertex;
+			Vector2 position, size;
+
+			if (hasImage(glyph.glyph)) {
+				getGlyphRectangle(glyph, position, size);
+				position += layoutOffset;
+
+				for (unsigned int i = 0; i < 4; ++i) {
+					vertex[i].textureCoordinate = glyph.glyph->textureCoordinates[i];
 				}
 
-				float lineHeight = static_cast<float>(font->getLineHeight());
-
-				bool started = false;
-				float tmpX = 0, xMin = 0, xMax = 0, yMin = 0, yMax = 0;
-				Vector2 tmpMax;
-
-				for (GlyphList::iterator i = characters.begin();
-				     i != characters.end(); ++i) {
-					// We have to check for NULL pointers because spaces
-					// do not have graphics.
-					if (i->second) {
-						i->second->setPosition(tmpX + i->first->horizontalBearing.x * this->getXScaling(),
-						                       (lineHeight + (i->first->size.y - i->first->horizontalBearing.y) - i->first->size.y * this->getYScaling()));
-
-						tmpMax = i->second->getVertices().getMaximumXY();
-
-						if (started) {
-							if (i->second->getXPosition() < xMin) {
-								xMin = i->second->getXPosition();
-							}
-
-							if (tmpMax.x > xMax) {
-								xMax = tmpMax.x;
-							}
-
-							if (i->second->getYPosition() < yMin) {
-								yMin = i->second->getYPosition();
-							}
-
-							if (tmpMax.y > yMax) {
-								yMax = tmpMax.y;
-							}
-
-						} else {
-							started = true;
-							tmpMax = i->second->getVertices().getMaximumXY();
-							xMin = i->second->getXPosition();
-							xMax = tmpMax.x;
-							yMin = i->second->getYPosition();
-							yMax = tmpMax.y;
-						}
-					}
+			} else {
+				position = layoutOffset;
 
-					tmpX += i->first->advance.x * this->getXScaling();
+				for (unsigned int i = 0; i < 4; ++i) {
+					vertex[i].textureCoordinate = Vector2();
 				}
+			}
 
-				if (!started) {
-					xMin = xMax = this->getXPosition();
-					yMin = yMax = this->getYPosition();
+			vertex[0].position = position;
+			vertex[1].position = Vector2(position.x + size.x, position.y);
+			vertex[2].position = Vector2(position.x, position.y + size.y);
+			vertex[3].position = position + size;
+
+			for (unsigned int i = 0; i < 4; ++i) {
+				vertex[i].color = getColor();
+			}
+		}
+
+		/**
+		 * Rotates the batches' vertices.
+		 * @param rotationAngle Angle to rotate the vertices.
+		 * @param rotationPoint Origin point on which to apply the rotation.
+		 */
+		void rotateBatches(float rotationAngle, const Vector2 &rotationPoint) {
+			for (typename GlyphBatchList::iterator i = batches.begin();
+			     i != batches.end(); ++i) {
+				for (BatchVertexArray::iterator j = i->vertices.begin();
+				     j != i->vertices.end(); ++j) {
+					j->position -= rotationPoint;
+					j->position.rotate(rotationAngle);
+					j->position += rotationPoint;
 				}
+			}
+		}
 
-				// We set the vertices.
-				StandardVertexArray::Iterator it = vertices.getBegin();
-				it->x = xMin;
-				it->y = yMin;
-				++it;
-				it->x = xMax;
-				it->y = yMin;
-				++it;
-				it->x = xMin;
-				it->y = yMax;
-				++it;
-				it->x = xMax;
-				it->y = yMax;
-
-				// We check the text alignment.
-
-				Vector2 delta;
-
-				if (alignment == TextAlignment::LEFT) {
-					// We find the delta we have to apply to align the text
-					// with the alignment position.
-					it = vertices.getBegin();
-					delta = *it;
-					it += 2;
-					delta = alignmentPosition - (delta + (*it - delta) * 0.5f);
-
-				} else if (alignment == TextAlignment::RIGHT) {
-					// We find the delta we have to apply to align the text
-					// with the alignment position.
-					it = vertices.getBegin();
-					++it;
-					delta = *it;
-					it += 2;
-					delta = alignmentPosition - (delta + (*it - delta) * 0.5f);
-
-				} else if (alignment == TextAlignment::CENTER) {
-					delta = alignmentPosition - vertices.getCentroid();
+		/**
+		 * Gets the glyph of each of the text's characters from the font, in
+		 * the order they are displayed.
+		 * @see BaconBox::GraphicString::glyphs
+		 */
+		void fetchGlyphs() {
+			LaidOutGlyph newGlyph;
+			newGlyph.pen = 0.0f;
+			newGlyph.batch = -1;
+			newGlyph.firstVertex = 0;
+			glyphs.clear();
+			glyphs.reserve(text.size());
+
+			if (direction == TextDirection::LEFT_TO_RIGHT) {
+				for (String32::const_iterator i = text.begin();
+				     i != text.end(); ++i) {
+					newGlyph.glyph = font->getGlyphInformation(*i);
+					glyphs.push_back(newGlyph);
 				}
 
-				// We apply this delta and the rotation to the vertices and
-				// the graphics.
-				vertices.move(delta.x, delta.y);
-				vertices.rotateFromPoint(this->getAngle(), alignmentPosition);
+			} else if (direction == TextDirection::RIGHT_TO_LEFT) {
+				for (String32::const_reverse_iterator i = text.rbegin();
+				     i != text.rend(); ++i) {
+					newGlyph.glyph = font->getGlyphInformation(*i);
+					glyphs.push_back(newGlyph);
+				}
+			}
+		}
+
+		/**
+		 * Lays out the graphic string's glyphs and builds their quads.
+		 * @see BaconBox::GraphicString::glyphs
+		 */
+		void buildString() {
+			Vector2 alignmentPosition = getAlignmentPosition();
+
+			glyphs.clear();
+			batches.clear();
+			layoutDirty = false;
+
+			// We make sure the font is valid.
+			if (font) {
+				// Getting the glyphs can empty atlas pages, which evicts the
+				// glyphs we already got. We take the generation before getting
+				// them and get them again if it changed, so an eviction during
+				// the build is never recorded as seen.
+				unsigned int nbAttempts = 0;
+
+				do {
+					atlasGeneration = font->getAtlasGeneration();
+					fetchGlyphs();
+					++nbAttempts;
+				} while (font->getAtlasGeneration() != atlasGeneration &&
+				         nbAttempts < MAX_NB_FETCHES);
+
+				layoutFont = font;
+				layoutFontSize = font->getSize();
+				layoutLineHeight = font->getLineHeight();
+				layoutScaling = this->getScaling();
+
+				// We place the glyphs one after the other.
+				float pen = 0.0f;
+
+				for (typename GlyphList::iterator i = glyphs.begin();
+				     i != glyphs.end(); ++i) {
+					i->pen = pen;
+					pen += i->glyph->advance.x * layoutScaling.x;
+
+					if (hasImage(i->glyph)) {
+						addQuad(*i);
+					}
+				}
 
-				for (GlyphList::iterator i = characters.begin();
-				     i != characters.end(); ++i) {
-					if (i->second) {
-						i->second->move(delta);
-						i->second->rotateFromPoint(this->getAngle(), alignmentPosition);
+				// We align the layout with the alignment position.
+				Vector2 minimum, maximum;
+
+				if (!getLayoutBounds(minimum, maximum)) {
+					minimum = maximum = this->getPosition();
+				}
+
+				layoutOffset = getAlignmentDelta(minimum, maximum, alignmentPosition);
+
+				for (typename GlyphList::const_iterator i = glyphs.begin();
+				     i != glyphs.end(); ++i) {
+					if (i->batch >= 0) {
+						writeQuad(*i);
 					}
 				}
 
+				setRectangle(minimum + layoutOffset, maximum + layoutOffset);
+
+				// We apply the rotation to the vertices and the quads.
+				vertices.rotateFromPoint(this->getAngle(), alignmentPosition);
+				rotateBatches(this->getAngle(), alignmentPosition);
+
 				// We update the collidable's stored position.
 				refreshPosition();
+			}
+		}
 
+		/**
+		 * Changes the text by only updating the quads of the changed
+		 * characters. Possible when the layout is still valid and the new
+		 * characters have the same advance as the ones they replace.
+		 * @param newText New text, must be different from the current text.
+		 * @return True if the string was patched, false if it needs to be
+		 * built again.
+		 */
+		bool patchString(const String32 &newText) {
+			if (!font || font != layoutFont || layoutDirty ||
+			    newText.size() != text.size() ||
+			    glyphs.size() != text.size() || this->getAngle() != 0.0f ||
+			    font->getSize() != layoutFontSize ||
+			    font->getLineHeight() != layoutLineHeight ||
+			    font->getAtlasGeneration() != atlasGeneration ||
+			    this->getScaling() != layoutScaling) {
+				return false;
 			}
+
+			// We get the new glyphs before changing anything, in case the
+			// string can't be patched.
+			std::vector<std::pair<typename GlyphList::size_type, const GlyphInformation *> > changes;
+
+			for (String32::size_type i = 0; i < text.size(); ++i) {
+				if (text[i] != newText[i]) {
+					typename GlyphList::size_type index = (direction == TextDirection::RIGHT_TO_LEFT) ? (text.size() - 1 - i) : (i);
+					const LaidOutGlyph &oldGlyph = glyphs[index];
+					const GlyphInformation *newGlyph = font->getGlyphInformation(newText[i]);
+
+					// The glyphs after it would move if the advance changed,
+					// and the new image must be in the old quad's page.
+					if (newGlyph->advance.x != oldGlyph.glyph->advance.x ||
+					    (oldGlyph.batch < 0 && hasImage(newGlyph)) ||
+					    (oldGlyph.batch >= 0 && hasImage(newGlyph) &&
+					     newGlyph->textureInformation != batches[oldGlyph.batch].texture)) {
+						return false;
+					}
+
+					changes.push_back(std::make_pair(index, newGlyph));
+				}
+			}
+
+			// Getting the new glyphs might have emptied atlas pages.
+			if (font->getAtlasGeneration() != atlasGeneration) {
+				return false;
+			}
+
+			text = newText;
+
+			for (typename std::vector<std::pair<typename GlyphList::size_type, const GlyphInformation *> >::const_iterator i = changes.begin();
+			     i != changes.end(); ++i) {
+				LaidOutGlyph &glyph = glyphs[i->first];
+				glyph.glyph = i->second;
+
+				if (glyph.batch >= 0) {
+					writeQuad(glyph);
+				}
+			}
+
+			// The rectangle might have changed, so the alignment is applied
+			// again.
+			Vector2 alignmentPosition = getAlignmentPosition(), minimum, maximum;
+
+			if (!getLayoutBounds(minimum, maximum)) {
+				minimum = maximum = this->getPosition();
+			}
+
+			Vector2 newOffset = getAlignmentDelta(minimum, maximum, alignmentPosition);
+
+			if (newOffset != layoutOffset) {
+				Vector2 delta = newOffset - layoutOffset;
+
+				for (typename GlyphBatchList::iterator i = batches.begin();
+				     i != batches.end(); ++i) {
+					for (BatchVertexArray::iterator j = i->vertices.begin();
+					     j != i->vertices.end(); ++j) {
+						j->position += delta;
+					}
+				}
+
+				layoutOffset = newOffset;
+			}
+
+			setRectangle(minimum + layoutOffset, maximum + layoutOffset);
+			refreshPosition();
+			return true;
 		}
 
 		/**
@@ -666,19 +1027,6 @@ namespace BaconBox {
 			Vector2 delta = vertices.getMinimumXY() - this->getPosition();
 			this->Collidable::move(delta.x, delta.y);
 		}
-
-		/**
-		 * Clears the characters attribute.
-		 * @see BaconBox::GraphicString::characters
-		 */
-		void clearCharacters() {
-			for (GlyphList::iterator i = characters.begin();
-			     i != characters.end(); ++i) {
-				if (i->second) {
-					delete i->second;
-				}
-			}
-		}
 	};
 }
 
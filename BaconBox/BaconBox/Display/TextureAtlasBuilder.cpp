@@ -0,0 +1,187 @@
+#include "BaconBox/Display/TextureAtlasBuilder.h"
+
+#include <algorithm>
+#include <fstream>
+
+#include "BaconBox/Display/PixMap.h"
+#include "BaconBox/ResourceManager.h"
+#include "BaconBox/Console.h"
+#include "BaconBox/Helper/MaxRectsPacker.h"
+#include "BaconBox/Helper/ShapeFactory.h"
+#include "BaconBox/Helper/MathHelper.h"
+#include "BaconBox/Helper/Parser.h"
+
+namespace BaconBox {
+	TextureAtlasBuilder::TextureAtlasBuilder(unsigned int newMaximumPageSize,
+	                                         unsigned int newPadding) :
+		maximumPageSize(MathHelper::nextPowerOf2(newMaximumPageSize)),
+		padding(newPadding), images(), pages() {
+	}
+
+	TextureAtlasBuilder::~TextureAtlasBuilder() {
+		clearPages();
+	}
+
+	void TextureAtlasBuilder::add(const std::string &name, const PixMap *image) {
+		if (image) {
+			Image newImage;
+			newImage.name = name;
+			newImage.pixMap = image;
+			images.push_back(newImage);
+		}
+	}
+
+	bool TextureAtlasBuilder::build() {
+		bool result = true;
+		clearPages();
+
+		// Packing the biggest images first leaves the small ones to fill the
+		// gaps.
+		ImageArray sorted(images);
+		std::stable_sort(sorted.begin(), sorted.end(), &TextureAtlasBuilder::isBigger);
+
+		// The bins are bigger by the padding so the images on the right and
+		// bottom edges don't need it.
+		std::vector<MaxRectsPacker> packers;
+		std::vector<std::pair<unsigned int, Vector2> > placements(sorted.size(), std::make_pair(0u, Vector2()));
+
+		for (ImageArray::size_type i = 0; i < sorted.size(); ++i) {
+			unsigned int width = sorted[i].pixMap->getWidth() + padding;
+			unsigned int height = sorted[i].pixMap->getHeight() + padding;
+			unsigned int x = 0u, y = 0u;
+
+			if (width > maximumPageSize + padding || height > maximumPageSize + padding) {
+				Console::println("Image \"" + sorted[i].name + "\" is too big to fit in an atlas page, it is skipped.");
+				placements[i].first = static_cast<unsigned int>(-1);
+				result = false;
+
+			} else {
+				std::vector<MaxRectsPacker>::size_type page = 0;
+
+				while (page < packers.size() && !packers[page].insert(width, height, x, y)) {
+					++page;
+				}
+
+				if (page == packers.size()) {
+					packers.push_back(MaxRectsPacker(maximumPageSize + padding, maximumPageSize + padding));
+					packers.back().insert(width, height, x, y);
+				}
+
+				placements[i].first = static_cast<unsigned int>(page);
+				placements[i].second = Vector2(static_cast<float>(x), static_cast<float>(y));
+			}
+		}
+
+		// We create the pages, cropped to the space their images use.
+		pages.resize(packers.size());
+
+		for (std::vector<MaxRectsPacker>::size_type i = 0; i < packers.size(); ++i) {
+			pages[i].pixMap = new PixMap(MathHelper::nextPowerOf2(packers[i].getUsedWidth() - padding),
+			                             MathHelper::nextPowerOf2(packers[i].getUsedHeight() - padding),
+			                             0, ColorFormat::RGBA);
+		}
+
+		// We copy the images in their page and define their sprites.
+		for (ImageArray::size_type i = 0; i < sorted.size(); ++i) {
+			if (placements[i].first < pages.size()) {
+				Page &page = pages[placements[i].first];
+				const PixMap *image = sorted[i].pixMap;
+				unsigned int x = static_cast<unsigned int>(placements[i].second.x);
+				unsigned int y = static_cast<unsigned int>(placements[i].second.y);
+
+				if (image->getColorFormat() == ColorFormat::RGBA) {
+					page.pixMap->insertSubPixMap(*image, x, y);
+
+				} else {
+					PixMap converted(*image);
+					converted.convertTo(ColorFormat::RGBA);
+					page.pixMap->insertSubPixMap(converted, x, y);
+				}
+
+				SpriteDefinition &definition = page.atlas[sorted[i].name];
+				definition.vertices.resize(4);
+				ShapeFactory::createRectangle(Vector2(static_cast<float>(image->getWidth()), static_cast<float>(image->getHeight())), Vector2(), &definition.vertices);
+				definition.frames.clear();
+				definition.frames.push_back(FrameDetails(placements[i].second));
+			}
+		}
+
+		return result;
+	}
+
+	void TextureAtlasBuilder::load(const std::string &key) {
+		for (PageArray::size_type i = 0; i < pages.size(); ++i) {
+			pages[i].atlas.textureDefinition.key = key + "-" + Parser::intToString(static_cast<int>(i));
+			ResourceManager::addTexture(pages[i].atlas.textureDefinition.key, pages[i].pixMap, true);
+		}
+	}
+
+	bool TextureAtlasBuilder::save(const std::string &basePath) {
+		bool result = true;
+		std::string::size_type nameStart = basePath.find_last_of("/\\");
+		std::string baseName = (nameStart == std::string::npos) ? (basePath) : (basePath.substr(nameStart + 1));
+
+		for (PageArray::size_type i = 0; i < pages.size(); ++i) {
+			std::string suffix = "-" + Parser::intToString(static_cast<int>(i));
+
+			// The texture's path is relative to the atlas definition.
+			if (pages[i].atlas.textureDefinition.key.empty()) {
+				pages[i].atlas.textureDefinition.key = baseName + suffix;
+			}
+
+			pages[i].atlas.textureDefinition.filePath = baseName + suffix + ".png";
+
+			ResourceManager::savePixMap(*pages[i].pixMap, basePath + suffix + ".png");
+
+			std::ofstream atlasFile((basePath + suffix + ".atlas").c_str());
+
+			if (atlasFile) {
+				atlasFile << pages[i].atlas;
+
+			} else {
+				Console::println("Can't write the atlas definition " + basePath + suffix + ".atlas");
+				result = false;
+			}
+		}
+
+		return result;
+	}
+
+	void TextureAtlasBuilder::clear() {
+		images.clear();
+		clearPages();
+	}
+
+	unsigned int TextureAtlasBuilder::getNbPages() const {
+		return static_cast<unsigned int>(pages.size());
+	}
+
+	const PixMap &TextureAtlasBuilder::getPagePixMap(unsigned int index) const {
+		return *pages[index].pixMap;
+	}
+
+	const TextureAtlas &TextureAtlasBuilder::getPageAtlas(unsigned int index) const {
+		return pages[index].atlas;
+	}
+
+	bool TextureAtlasBuilder::isBigger(const Image &first, const Image &second) {
+		unsigned int firstSide = std::max(first.pixMap->getWidth(), first.pixMap->getHeight());
+		unsigned int secondSide = std::max(second.pixMap->getWidth(), second.pixMap->getHeight());
+
+		if (firstSide != secondSide) {
+			return firstSide > secondSide;
+
+		} else {
+			return first.pixMap->getWidth() * first.pixMap->getHeight() >
+			       second.pixMap->getWidth() * second.pixMap->getHeight();
+		}
+	}
+
+	void TextureAtlasBuilder::clearPages() {
+		for (PageArray::iterator i = pages.begin(); i != pages.end(); ++i) {
+			delete i->pixMap;
+		}
+
+		pages.clear();
+	}
+}
@@ -0,0 +1,169 @@
+/**
+ * @file
+ * @ingroup Display
+ */
+#ifndef RB_TEXTURE_ATLAS_BUILDER_H
+#define RB_TEXTURE_ATLAS_BUILDER_H
+
+#include <string>
+#include <vector>
+
+#include "BaconBox/Display/TextureAtlas.h"
+
+namespace BaconBox {
+	class PixMap;
+
+	/**
+	 * Combines many images in a few atlas pages. The images are packed with
+	 * the MaxRects algorithm and each page gets a texture atlas containing a
+	 * sprite definition for each of its images, named after the image. Using
+	 * fewer textures means fewer texture changes when rendering.
+	 * @see BaconBox::MaxRectsPacker
+	 * @ingroup Display
+	 */
+	class TextureAtlasBuilder {
+	public:
+		/// Default maximum width and height of the pages (in pixels).
+		static const unsigned int DEFAULT_MAXIMUM_PAGE_SIZE = 2048u;
+
+		/// Default number of transparent pixels kept between the images.
+		static const unsigned int DEFAULT_PADDING = 1u;
+
+		/**
+		 * Default and parameterized constructor.
+		 * @param newMaximumPageSize Maximum width and height of the pages.
+		 * Rounded up to the next power of 2.
+		 * @param newPadding Number of transparent pixels kept between the
+		 * images.
+		 */
+		explicit TextureAtlasBuilder(unsigned int newMaximumPageSize = DEFAULT_MAXIMUM_PAGE_SIZE,
+		                             unsigned int newPadding = DEFAULT_PADDING);
+
+		/**
+		 * Destructor. Deletes the pages' pixmaps.
+		 */
+		~TextureAtlasBuilder();
+
+		/**
+		 * Adds an image to pack in the next call to build().
+		 * @param name Name of the image's sprite definition.
+		 * @param image Image to pack. The builder doesn't take ownership of
+		 * it, it must stay valid until build() is called.
+		 */
+		void add(const std::string &name, const PixMap *image);
+
+		/**
+		 * Packs the added images in pages. The pages are as small as possible
+		 * while keeping power of 2 sizes. The previous pages are deleted.
+		 * @return True if all the images were packed, false if some were too
+		 * big to fit in a page and were skipped.
+		 */
+		bool build();
+
+		/**
+		 * Adds the pages' textures to the resource manager. The page textures
+		 * are named using the given key followed by a dash and the page's
+		 * index, the atlases' texture definitions are updated with these
+		 * keys.
+		 * @param key Key used to name the pages' textures.
+		 */
+		void load(const std::string &key);
+
+		/**
+		 * Saves the pages as PNG files along with their texture atlas
+		 * definitions. Each page is written as the given path followed by a
+		 * dash, the page's index and ".png", its atlas with ".atlas".
+		 * @param basePath Path and name to use for the files, without
+		 * extension.
+		 * @return True if all the atlas definitions could be written.
+		 */
+		bool save(const std::string &basePath);
+
+		/**
+		 * Removes the added images and deletes the pages.
+		 */
+		void clear();
+
+		/**
+		 * Gets the number of pages made by the last call to build().
+		 * @return Number of pages.
+		 */
+		unsigned int getNbPages() const;
+
+		/**
+		 * Gets a page's image.
+		 * @param index Index of the page.
+		 * @return Pixmap containing the page's images.
+		 */
+		const PixMap &getPagePixMap(unsigned int index) const;
+
+		/**
+		 * Gets a page's texture atlas.
+		 * @param index Index of the page.
+		 * @return Texture atlas with a sprite definition for each image of the
+		 * page.
+		 */
+		const TextureAtlas &getPageAtlas(unsigned int index) const;
+	private:
+		/// Image to pack.
+		struct Image {
+			/// Name of the image's sprite definition.
+			std::string name;
+
+			/// Image's pixels.
+			const PixMap *pixMap;
+		};
+
+		/// Atlas page.
+		struct Page {
+			/// Page's image.
+			PixMap *pixMap;
+
+			/// Page's texture atlas.
+			TextureAtlas atlas;
+		};
+
+		/// Type used to contain the images to pack.
+		typedef std::vector<Image> ImageArray;
+
+		/// Type used to contain the pages.
+		typedef std::vector<Page> PageArray;
+
+		/**
+		 * Used to sort the images, the biggest are packed first.
+		 * @param first First image to compare.
+		 * @param second Second image to compare.
+		 * @return True if the first image must be packed before the second.
+		 */
+		static bool isBigger(const Image &first, const Image &second);
+
+		/// Maximum width and height of the pages.
+		unsigned int maximumPageSize;
+
+		/// Number of transparent pixels kept between the images.
+		unsigned int padding;
+
+		/// Images to pack.
+		ImageArray images;
+
+		/// Pages made by the last call to build().
+		PageArray pages;
+
+		/**
+		 * Private undefined copy constructor.
+		 */
+		TextureAtlasBuilder(const TextureAtlasBuilder &src);
+
+		/**
+		 * Private undefined assignment operator.
+		 */
+		TextureAtlasBuilder &operator=(const TextureAtlasBuilder &src);
+
+		/**
+		 * Deletes the pages.
+		 */
+		void clearPages();
+	};
+}
+
+#endif // RB_TEXTURE_ATLAS_BUILDER_H
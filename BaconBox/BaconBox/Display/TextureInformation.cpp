@@ -19,11 +19,12 @@ namespace BaconBox {
 		imageWidth(newImageWidth), imageHeight(newImageHeight) {
 	}
 #else
-	TextureInformation::TextureInformation(): poweredWidth(0), poweredHeight(0), imageWidth(0),
-		imageHeight(0) {
+	TextureInformation::TextureInformation(): colorFormat(ColorFormat::RGBA),
+		poweredWidth(0), poweredHeight(0), imageWidth(0), imageHeight(0) {
 	}
 	TextureInformation::TextureInformation(unsigned int newImageWidth,
-	                                       unsigned int newImageHeight): poweredWidth(MathHelper::nextPowerOf2(newImageWidth)),
+	                                       unsigned int newImageHeight): colorFormat(ColorFormat::RGBA),
+		poweredWidth(MathHelper::nextPowerOf2(newImageWidth)),
 		poweredHeight(MathHelper::nextPowerOf2(newImageHeight)),
 		imageWidth(newImageWidth), imageHeight(newImageHeight) {
 	}
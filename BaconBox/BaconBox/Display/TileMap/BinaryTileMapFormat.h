@@ -0,0 +1,64 @@
+/**
+ * @file
+ * @ingroup TileMap
+ */
+#ifndef RB_BINARY_TILE_MAP_FORMAT_H
+#define RB_BINARY_TILE_MAP_FORMAT_H
+
+#include <stdint.h>
+
+namespace BaconBox {
+	/**
+	 * Describes the precompiled binary tile map format (.rbtm files). All the
+	 * values are 32 bits and little endian, the floats are stored as IEEE 754
+	 * single precision values. Every record starts on a 4 bytes boundary, so
+	 * the tile data can be read directly from the memory-mapped file.
+	 *
+	 * - String: length, the characters and zeros up to the next 4 bytes
+	 * boundary.
+	 * - Properties: number of properties, then a name string and a value
+	 * string for each property.
+	 * - File: MAGIC, VERSION, width and height in tiles, tile width and
+	 * height (floats), the map's name, the map's properties, the number of
+	 * tilesets, the tilesets, the number of layers and the layers.
+	 * - Tileset: name, image source (relative to the file's folder), 1 if it
+	 * has a transparent color and 0 if not, transparent color (RGBA), tile
+	 * width, tile height, tile spacing and margin (floats), properties,
+	 * number of tiles with properties, then the tile id and the properties
+	 * of each of those tiles.
+	 * - Layer: LayerType, name, opacity (0 to 255), 1 if it is visible and 0
+	 * if not and properties. Followed for tile layers by the tile id's, row
+	 * by row (width * height values), and for object layers by the color
+	 * (RGBA), the number of objects and the objects.
+	 * - Object: ObjectType, name, type, x and y (floats). Followed by the
+	 * width and height (floats) for rectangles, the tile id for tiles and the
+	 * number of vertices and their coordinates (floats) for polygons and
+	 * lines. Ends with the object's properties.
+	 * @ingroup TileMap
+	 * @see BaconBox::BinaryTileMapReader
+	 * @see BaconBox::TmxTileMapReader::convertToBinary()
+	 */
+	struct BinaryTileMapFormat {
+		/// Value of the first 4 bytes of the file ("RBTM").
+		static const uint32_t MAGIC = 0x4d544252u;
+
+		/// Version of the format.
+		static const uint32_t VERSION = 1u;
+
+		/// Types of layers.
+		enum LayerType {
+			TILE_LAYER,
+			OBJECT_LAYER
+		};
+
+		/// Types of objects in an object layer.
+		enum ObjectType {
+			RECTANGLE_OBJECT,
+			TILE_OBJECT,
+			POLYGON_OBJECT,
+			LINE_OBJECT
+		};
+	};
+}
+
+#endif // RB_BINARY_TILE_MAP_FORMAT_H
@@ -0,0 +1,402 @@
+#include "BaconBox/Display/TileMap/BinaryTileMapReader.h"
+
+#include <cstring>
+
+#include <vector>
+
+#include "BaconBox/Display/TileMap/BinaryTileMapFormat.h"
+#include "BaconBox/Display/TileMap/TileMap.h"
+#include "BaconBox/Display/TileMap/Tileset.h"
+#include "BaconBox/Display/TileMap/TileLayer.h"
+#include "BaconBox/Display/TileMap/ObjectLayer.h"
+#include "BaconBox/Display/TileMap/LineObject.h"
+#include "BaconBox/Display/TileMap/PolygonObject.h"
+#include "BaconBox/Display/TileMap/RectangleObject.h"
+#include "BaconBox/Display/TileMap/TileObject.h"
+#include "BaconBox/Display/Color.h"
+#include "BaconBox/ResourceManager.h"
+#include "BaconBox/Helper/BitHelper.h"
+#include "BaconBox/Helper/MappedFile.h"
+
+namespace BaconBox {
+	namespace {
+		/**
+		 * Reads the values of a binary tile map in a memory-mapped file. Once
+		 * a read fails because the data is too short, all the following reads
+		 * fail.
+		 */
+		class BinaryCursor {
+		public:
+			BinaryCursor(const char *newData, size_t size) : current(newData),
+				end(newData + size), bigEndian(BitHelper::isBigEndian()),
+				valid(newData != NULL) {
+			}
+
+			bool isValid() const {
+				return valid;
+			}
+
+			size_t getRemainingSize() const {
+				return static_cast<size_t>(end - current);
+			}
+
+			bool read(uint32_t &value) {
+				if (canRead(sizeof(uint32_t))) {
+					std::memcpy(&value, current, sizeof(uint32_t));
+					current += sizeof(uint32_t);
+
+					if (bigEndian) {
+						BitHelper::endianSwap(value);
+					}
+				}
+
+				return valid;
+			}
+
+			bool read(float &value) {
+				uint32_t tmpValue = 0;
+
+				if (read(tmpValue)) {
+					std::memcpy(&value, &tmpValue, sizeof(float));
+				}
+
+				return valid;
+			}
+
+			bool read(std::string &value) {
+				uint32_t length = 0;
+
+				if (read(length) && canRead(getPaddedLength(length))) {
+					value.assign(current, length);
+					current += getPaddedLength(length);
+				}
+
+				return valid;
+			}
+
+			bool read(PropertyMap &properties) {
+				uint32_t nbProperties = 0;
+				read(nbProperties);
+				std::string name, value;
+
+				for (uint32_t i = 0; valid && i < nbProperties; ++i) {
+					if (read(name) && read(value)) {
+						properties[name] = value;
+					}
+				}
+
+				return valid;
+			}
+
+			/**
+			 * Gets an array of values in the file. On little endian systems,
+			 * the array points directly in the file, on big endian systems,
+			 * the values are swapped in a buffer.
+			 * @param nbValues Number of values to read.
+			 * @param buffer Buffer used on big endian systems.
+			 * @return Pointer to the values, NULL if there aren't enough.
+			 */
+			const unsigned int *read(size_t nbValues,
+			                         std::vector<unsigned int> &buffer) {
+				const unsigned int *result = NULL;
+
+				if (nbValues <= static_cast<size_t>(end - current) / sizeof(uint32_t)) {
+					// The file is aligned on 4 bytes, so the values can be
+					// used as they are.
+					result = reinterpret_cast<const unsigned int *>(current);
+					current += nbValues * sizeof(uint32_t);
+
+					if (bigEndian) {
+						buffer.assign(result, result + nbValues);
+
+						for (std::vector<unsigned int>::iterator i = buffer.begin(); i != buffer.end(); ++i) {
+							BitHelper::endianSwap(*i);
+						}
+
+						result = (buffer.empty()) ? (NULL) : (&buffer[0]);
+					}
+
+				} else {
+					valid = false;
+				}
+
+				return result;
+			}
+		private:
+			static size_t getPaddedLength(uint32_t length) {
+				return (static_cast<size_t>(length) + 3u) & ~static_cast<size_t>(3u);
+			}
+
+			bool canRead(size_t nbBytes) {
+				valid = valid && nbBytes <= static_cast<size_t>(end - current);
+				return valid;
+			}
+
+			const char *current;
+			const char *end;
+			bool bigEndian;
+			bool valid;
+		};
+
+		bool readTileset(const std::string &currentFolder, BinaryCursor &cursor,
+		                 TileMap &map, std::string &errorMessage) {
+			std::string name, imageSource;
+			uint32_t hasTransparentColor = 0, transparentColor = 0;
+			float tileWidth = 0.0f, tileHeight = 0.0f, tileSpacing = 0.0f, margin = 0.0f;
+
+			if (!cursor.read(name) || !cursor.read(imageSource) ||
+			    !cursor.read(hasTransparentColor) ||
+			    !cursor.read(transparentColor) || !cursor.read(tileWidth) ||
+			    !cursor.read(tileHeight) || !cursor.read(tileSpacing) ||
+			    !cursor.read(margin)) {
+				return false;
+			}
+
+			// We load the tileset's texture, the same way the tmx reader does.
+			std::string texturePath(currentFolder);
+			texturePath.append(imageSource);
+			TextureInformation *textureInformation = (hasTransparentColor) ? (ResourceManager::loadTextureWithColorKey(imageSource, texturePath, Color(transparentColor))) : (ResourceManager::loadTexture(imageSource, texturePath));
+
+			if (!textureInformation) {
+				errorMessage = "BinaryTileMapReader: Could not load the texture of the tileset " + name + ".";
+				return false;
+			}
+
+			Tileset *newTileset = map.addTileset(name, textureInformation,
+			                                     Vector2(tileWidth, tileHeight),
+			                                     tileSpacing, margin);
+
+			cursor.read(newTileset->getProperties());
+
+			// We read the tiles' properties.
+			uint32_t nbTiles = 0;
+			cursor.read(nbTiles);
+			PropertyMap tmpProperties;
+
+			for (uint32_t i = 0; cursor.isValid() && i < nbTiles; ++i) {
+				uint32_t tileId = 0;
+				tmpProperties.clear();
+
+				if (cursor.read(tileId) && cursor.read(tmpProperties)) {
+					PropertyMap *tileProperties = newTileset->getTileProperties(tileId);
+
+					// We make sure the tile id was in the tileset's range.
+					if (tileProperties) {
+						tileProperties->insert(tmpProperties.begin(), tmpProperties.end());
+					}
+				}
+			}
+
+			return cursor.isValid();
+		}
+
+		bool readObject(BinaryCursor &cursor, ObjectLayer &objectLayer) {
+			uint32_t objectType = 0;
+			std::string name, type;
+			Vector2 position;
+
+			if (!cursor.read(objectType) || !cursor.read(name) ||
+			    !cursor.read(type) || !cursor.read(position.x) ||
+			    !cursor.read(position.y)) {
+				return false;
+			}
+
+			TileMapObject *object = NULL;
+
+			if (objectType == BinaryTileMapFormat::RECTANGLE_OBJECT) {
+				Vector2 size;
+
+				if (cursor.read(size.x) && cursor.read(size.y)) {
+					RectangleObject *rectangleObject = objectLayer.addRectangle();
+					rectangleObject->setSize(size);
+					object = rectangleObject;
+				}
+
+			} else if (objectType == BinaryTileMapFormat::TILE_OBJECT) {
+				uint32_t tileId = 0;
+
+				if (cursor.read(tileId)) {
+					TileObject *tileObject = objectLayer.addTile();
+					tileObject->setTileId(tileId);
+					object = tileObject;
+				}
+
+			} else if (objectType == BinaryTileMapFormat::POLYGON_OBJECT ||
+			           objectType == BinaryTileMapFormat::LINE_OBJECT) {
+				uint32_t nbVertices = 0;
+
+				// Each vertex takes 8 bytes, we make sure a corrupted number of
+				// vertices isn't reserved.
+				if (cursor.read(nbVertices) && nbVertices <= cursor.getRemainingSize() / 8u) {
+					TileMapVertexArray *vertexObject = (objectType == BinaryTileMapFormat::POLYGON_OBJECT) ? (static_cast<TileMapVertexArray *>(objectLayer.addPolygon())) : (static_cast<TileMapVertexArray *>(objectLayer.addLine()));
+					StandardVertexArray &vertices = vertexObject->getVertices();
+					vertices.reserve(nbVertices);
+					Vector2 vertex;
+
+					for (uint32_t i = 0; i < nbVertices && cursor.read(vertex.x) && cursor.read(vertex.y); ++i) {
+						vertices.pushBack(vertex);
+					}
+
+					object = vertexObject;
+				}
+			}
+
+			if (object) {
+				object->setName(name);
+				object->setType(type);
+				object->setPosition(position);
+
+				// We position the vertices at the right position.
+				TileMapVertexArray *vertexObject = dynamic_cast<TileMapVertexArray *>(object);
+
+				if (vertexObject) {
+					Vector2 delta(vertexObject->getPosition() - vertexObject->getVertices().getMinimumXY());
+					vertexObject->getVertices().move(delta.x, delta.y);
+				}
+
+				cursor.read(object->getProperties());
+			}
+
+			return object && cursor.isValid();
+		}
+
+		bool readLayer(BinaryCursor &cursor, TileMap &map) {
+			uint32_t layerType = 0, opacity = 0, visible = 0;
+			std::string name;
+
+			if (!cursor.read(layerType) || !cursor.read(name) ||
+			    !cursor.read(opacity) || !cursor.read(visible)) {
+				return false;
+			}
+
+			TileMapLayer *layer = NULL;
+			bool success = true;
+
+			if (layerType == BinaryTileMapFormat::TILE_LAYER) {
+				TileLayer *tileLayer = map.pushBackTileLayer(name);
+				layer = tileLayer;
+
+				if (cursor.read(tileLayer->getProperties())) {
+					// We fill the layer directly from the file.
+					std::vector<unsigned int> buffer;
+					const unsigned int *tileIds = cursor.read(static_cast<size_t>(map.getWidthInTiles()) * static_cast<size_t>(map.getHeightInTiles()), buffer);
+
+					if (tileIds) {
+						tileLayer->setTileIds(tileIds);
+					}
+				}
+
+			} else if (layerType == BinaryTileMapFormat::OBJECT_LAYER) {
+				ObjectLayer *objectLayer = map.pushBackObjectLayer(name);
+				layer = objectLayer;
+				uint32_t color = 0, nbObjects = 0;
+
+				if (cursor.read(objectLayer->getProperties()) &&
+				    cursor.read(color) && cursor.read(nbObjects)) {
+					objectLayer->setColor(Color(color));
+
+					for (uint32_t i = 0; success && i < nbObjects; ++i) {
+						success = readObject(cursor, *objectLayer);
+					}
+				}
+
+			} else {
+				return false;
+			}
+
+			layer->setOpacity(static_cast<int32_t>(opacity));
+			layer->setVisible(visible != 0);
+
+			return success && cursor.isValid();
+		}
+	}
+
+	BinaryTileMapReader::BinaryTileMapReader() : TileMapReader(),
+		errorMessage() {
+	}
+
+	BinaryTileMapReader::~BinaryTileMapReader() {
+	}
+
+	TileMap *BinaryTileMapReader::read(const std::string &fileName) {
+		TileMap *result = NULL;
+
+		// We make sure the file has the right extension.
+		if (supportsFile(fileName)) {
+			MappedFile file;
+
+			if (file.open(fileName)) {
+				BinaryCursor cursor(file.getData(), file.getSize());
+				uint32_t magic = 0, version = 0, width = 0, height = 0;
+				float tileWidth = 0.0f, tileHeight = 0.0f;
+				std::string name;
+
+				if (!cursor.read(magic) || magic != BinaryTileMapFormat::MAGIC) {
+					errorMessage = "BinaryTileMapReader: the file is not a binary tile map.";
+
+				} else if (!cursor.read(version) || version != BinaryTileMapFormat::VERSION) {
+					errorMessage = "BinaryTileMapReader: the binary tile map was made for another version of the format. Convert it again.";
+
+				} else if (cursor.read(width) && cursor.read(height) &&
+				           cursor.read(tileWidth) && cursor.read(tileHeight) &&
+				           cursor.read(name)) {
+					result = new TileMap(name,
+					                     TileCoordinate(static_cast<int>(width), static_cast<int>(height)),
+					                     Vector2(tileWidth, tileHeight));
+
+					cursor.read(result->getProperties());
+
+					std::string currentFolder(fileName.substr(0, fileName.find_last_of('/') + 1));
+					uint32_t nbTilesets = 0;
+					bool success = cursor.read(nbTilesets);
+
+					// The tilesets are read first, the tile layers need them to
+					// validate their tile id's.
+					for (uint32_t i = 0; success && i < nbTilesets; ++i) {
+						success = readTileset(currentFolder, cursor, *result, errorMessage);
+					}
+
+					uint32_t nbLayers = 0;
+					success = success && cursor.read(nbLayers);
+
+					for (uint32_t i = 0; success && i < nbLayers; ++i) {
+						success = readLayer(cursor, *result);
+					}
+
+					if (!success) {
+						if (errorMessage.empty()) {
+							errorMessage = "BinaryTileMapReader: the binary tile map is truncated or corrupted.";
+						}
+
+						delete result;
+						result = NULL;
+					}
+
+				} else {
+					errorMessage = "BinaryTileMapReader: the binary tile map is truncated or corrupted.";
+				}
+
+			} else {
+				errorMessage = "BinaryTileMapReader: failed to open the binary tile map file. Is the file path correct?";
+			}
+
+		} else {
+			errorMessage = "BinaryTileMapReader: tried to read a tile map from a non-supported file format.";
+		}
+
+		return result;
+	}
+
+	bool BinaryTileMapReader::supportsFile(const std::string &fileName) const {
+		static const std::string FILE_EXTENSION = "rbtm";
+		return fileName.substr(fileName.find_last_of('.') + 1) == FILE_EXTENSION;
+	}
+
+	const std::string BinaryTileMapReader::getErrorMessage() const {
+		return errorMessage;
+	}
+
+	void BinaryTileMapReader::clearErrorMessage() {
+		errorMessage.clear();
+	}
+}
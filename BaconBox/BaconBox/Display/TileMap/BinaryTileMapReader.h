@@ -0,0 +1,66 @@
+/**
+ * @file
+ * @ingroup TileMap
+ */
+#ifndef RB_BINARY_TILE_MAP_READER_H
+#define RB_BINARY_TILE_MAP_READER_H
+
+#include "BaconBox/Display/TileMap/TileMapReader.h"
+
+namespace BaconBox {
+	/**
+	 * Reads tile maps from precompiled binary files (.rbtm). The file is
+	 * memory-mapped and the tile layers are filled directly from it, so it
+	 * loads much faster than the equivalent TMX file.
+	 * @see BaconBox::BinaryTileMapFormat
+	 * @see BaconBox::TmxTileMapReader::convertToBinary()
+	 * @ingroup TileMap
+	 */
+	class BinaryTileMapReader : public TileMapReader {
+	public:
+		/**
+		 * Default constructor.
+		 */
+		BinaryTileMapReader();
+
+		/**
+		 * Destructor.
+		 */
+		~BinaryTileMapReader();
+
+		/**
+		 * Reads a tile map from a file.
+		 * @param fileName Path to the file to read.
+		 * @return Pointer to the new instance of a tile map. The caller has
+		 * to take care to delete it when he's done with it. Returns NULL if
+		 * the reading has failed.
+		 */
+		TileMap *read(const std::string &fileName);
+
+		/**
+		 * Checks wether or not the file given is supported by the reader.
+		 * Checks if the file name ends with ".rbtm".
+		 * @param fileName Path to the file to check.
+		 * @return True if the reader supports the file format, false if not.
+		 */
+		bool supportsFile(const std::string &fileName) const;
+
+		/**
+		 * Gets a string containing the error message.
+		 * @return String containing the error message if an error occured while
+		 * trying to read a tile map.
+		 */
+		const std::string getErrorMessage() const;
+
+		/**
+		 * Clears the error message.
+		 * @see BaconBox::BinaryTileMapReader::errorMessage
+		 */
+		void clearErrorMessage();
+	private:
+		/// String containing the error message.
+		std::string errorMessage;
+	};
+}
+
+#endif // RB_BINARY_TILE_MAP_READER_H
@@ -1,47 +1,104 @@
 #include "BaconBox/Display/TileMap/GraphicTileLayer.h"
 
-#include "BaconBox/Display/TileMap/TileLayer.h"
+#include <algorithm>
+
 #include "BaconBox/Display/TileMap/Tileset.h"
 #include "BaconBox/Display/TileMap/TileMap.h"
-#include "BaconBox/Helper/ShapeFactory.h"
+#include "BaconBox/Display/TileMap/TileIdRange.h"
 #include "BaconBox/Display/TextureInformation.h"
-#include "BaconBox/Display/TexturePointer.h"
+#include "BaconBox/Display/TextureCoordinates.h"
 #include "BaconBox/Display/TileMap/TileMapUtility.h"
+#include "BaconBox/Helper/TimeHelper.h"
+#include "BaconBox/Display/Driver/GraphicDriver.h"
+#include "BaconBox/Display/Driver/VertexBuffer.h"
+#include "BaconBox/Display/Maskable.h"
+#include "BaconBox/Display/Camera.h"
+#include "BaconBox/Display/Collidable.h"
 #include "BaconBox/Helper/CollisionGroup.h"
+#include "BaconBox/Engine.h"
+#include "BaconBox/State.h"
 
 namespace BaconBox {
+	class GraphicTileLayer::TileBody : public Collidable {
+	public:
+		TileBody(const Vector2 &newPosition, const Vector2 &newSize) :
+			Collidable(newPosition), size(newSize) {
+			this->setStaticBody(true);
+		}
+
+		const Vector2 getSize() const {
+			return size;
+		}
+
+		float getWidth() const {
+			return size.x;
+		}
+
+		float getHeight() const {
+			return size.y;
+		}
+	private:
+		/// Size of the tile (in pixels).
+		Vector2 size;
+	};
+
 	GraphicTileLayer::GraphicTileLayer(const Vector2 &startingPosition) :
-		GraphicTileMapLayer(startingPosition), currentMask(NULL), batches() {
+		GraphicTileMapLayer(startingPosition), currentMask(NULL),
+		invertedMask(false), tiles(), widthInTiles(0), tileSize(),
+		tileColor(Color::WHITE), tilesets(), chunks(),
+		origin(startingPosition), xAxis(1.0f, 0.0f), yAxis(0.0f, 1.0f),
+		tileBodies() {
 	}
 
 	GraphicTileLayer::GraphicTileLayer(const TileLayer &layer,
 	                                   const Vector2 &startingPosition) :
-		GraphicTileMapLayer(startingPosition), currentMask(NULL), batches() {
+		GraphicTileMapLayer(startingPosition), currentMask(NULL),
+		invertedMask(false), tiles(), widthInTiles(0), tileSize(),
+		tileColor(Color::WHITE), tilesets(), chunks(),
+		origin(startingPosition), xAxis(1.0f, 0.0f), yAxis(0.0f, 1.0f),
+		tileBodies() {
 		this->construct(layer);
 	}
 
 	GraphicTileLayer::GraphicTileLayer(const GraphicTileLayer &src) :
-		GraphicTileMapLayer(src), currentMask(src.currentMask), batches() {
-		for (BatchMap::const_iterator i = src.batches.begin();
-		     i != src.batches.end(); ++i) {
-			batches.insert(std::make_pair(i->first, new RenderBatch<BatchedInanimateGraphicElement<Collidable> >(*i->second)));
+		GraphicTileMapLayer(src), currentMask(src.currentMask),
+		invertedMask(src.invertedMask), tiles(src.tiles),
+		widthInTiles(src.widthInTiles), tileSize(src.tileSize),
+		tileColor(src.tileColor), tilesets(src.tilesets), chunks(src.chunks),
+		origin(src.origin), xAxis(src.xAxis), yAxis(src.yAxis),
+		tileBodies() {
+		// The batches are generated again when needed.
+		for (ChunkList::iterator i = chunks.begin(); i != chunks.end(); ++i) {
+			i->batches.clear();
 		}
 	}
 
 	GraphicTileLayer::~GraphicTileLayer() {
+		free();
+		deleteTileBodies();
 	}
 
 	GraphicTileLayer &GraphicTileLayer::operator=(const GraphicTileLayer &src) {
 		this->GraphicTileMapLayer::operator=(src);
 
 		if (this != &src) {
-			currentMask = src.currentMask;
 			free();
-			batches.clear();
-
-			for (BatchMap::const_iterator i = src.batches.begin();
-			     i != src.batches.end(); ++i) {
-				batches.insert(std::make_pair(i->first, new RenderBatch<BatchedInanimateGraphicElement<Collidable> >(*i->second)));
+			deleteTileBodies();
+			currentMask = src.currentMask;
+			invertedMask = src.invertedMask;
+			tiles = src.tiles;
+			widthInTiles = src.widthInTiles;
+			tileSize = src.tileSize;
+			tileColor = src.tileColor;
+			tilesets = src.tilesets;
+			chunks = src.chunks;
+			origin = src.origin;
+			xAxis = src.xAxis;
+			yAxis = src.yAxis;
+
+			// The batches are generated again when needed.
+			for (ChunkList::iterator i = chunks.begin(); i != chunks.end(); ++i) {
+				i->batches.clear();
 			}
 		}
 
@@ -51,87 +108,48 @@ namespace BaconBox {
 	void GraphicTileLayer::move(float xDelta, float yDelta) {
 		this->GraphicTileMapLayer::move(xDelta, yDelta);
 
-		for (BatchMap::iterator i = batches.begin(); i != batches.end(); ++i) {
-			for (RenderBatch<BatchedInanimateGraphicElement<Collidable> >::BodyMap::iterator j = i->second->getBegin();
-			     j != i->second->getEnd(); ++j) {
-				(*j)->move(xDelta, yDelta);
-			}
-		}
-	}
-
-	const Vector2 GraphicTileLayer::getSize() const {
-		Vector2 result;
-
-		if (!batches.empty()) {
-			bool notFirst = false;
-			Vector2 min, max;
-			float tmp;
-
-			for (BatchMap::const_iterator i = batches.begin(); i != batches.end(); ++i) {
-				for (RenderBatch<BatchedInanimateGraphicElement<Collidable> >::BodyMap::const_iterator j = i->second->getBegin();
-				     j != i->second->getEnd(); ++j) {
-					if (notFirst) {
-						if (min.x > (*j)->getXPosition()) {
-							min.x = (*j)->getXPosition();
-						}
-
-						if (min.y > (*j)->getYPosition()) {
-							min.y = (*j)->getYPosition();
-						}
+		origin.x += xDelta;
+		origin.y += yDelta;
 
-						tmp = (*j)->getXPosition() + (*j)->getWidth();
+		for (ChunkList::iterator i = chunks.begin(); i != chunks.end(); ++i) {
+			i->bounds.move(xDelta, yDelta);
 
-						if (max.x < tmp) {
-							max.x = tmp;
-						}
-
-						tmp = (*j)->getYPosition() + (*j)->getHeight();
-
-						if (max.y < tmp) {
-							max.y = tmp;
-						}
+			// We move the generated vertices, if any.
+			for (BatchList::iterator j = i->batches.begin(); j != i->batches.end(); ++j) {
+				for (BatchVertexArray::iterator k = j->vertices.begin(); k != j->vertices.end(); ++k) {
+					k->position.x += xDelta;
+					k->position.y += yDelta;
+				}
 
-					} else {
-						min = (*j)->getPosition();
-						max = (*j)->getPosition() + (*j)->getSize();
-						notFirst = true;
-					}
+				if (j->vertexBuffer) {
+					j->vertexBuffer->markDirty(0, static_cast<StandardVertexArray::SizeType>(j->vertices.size()));
 				}
 			}
+		}
 
-			result = max - min;
+		for (TileBodyList::iterator i = tileBodies.begin(); i != tileBodies.end(); ++i) {
+			(*i)->move(xDelta, yDelta);
 		}
+	}
 
-		return result;
+	const Vector2 GraphicTileLayer::getSize() const {
+		return Vector2(getWidth(), getHeight());
 	}
 
 	float GraphicTileLayer::getWidth() const {
 		float result = 0.0f;
 
-		if (!batches.empty()) {
-			bool notFirst = false;
-			float min, max;
-			float tmp;
-
-			for (BatchMap::const_iterator i = batches.begin(); i != batches.end(); ++i) {
-				for (RenderBatch<BatchedInanimateGraphicElement<Collidable> >::BodyMap::const_iterator j = i->second->getBegin();
-				     j != i->second->getEnd(); ++j) {
-					if (notFirst) {
-						if (min > (*j)->getXPosition()) {
-							min = (*j)->getXPosition();
-						}
+		if (!chunks.empty()) {
+			ChunkList::const_iterator i = chunks.begin();
+			float min = i->bounds.getLeft(), max = i->bounds.getRight();
 
-						tmp = (*j)->getXPosition() + (*j)->getWidth();
-
-						if (max < tmp) {
-							max = tmp;
-						}
+			for (++i; i != chunks.end(); ++i) {
+				if (min > i->bounds.getLeft()) {
+					min = i->bounds.getLeft();
+				}
 
-					} else {
-						min = (*j)->getXPosition();
-						max = (*j)->getXPosition() + (*j)->getWidth();
-						notFirst = true;
-					}
+				if (max < i->bounds.getRight()) {
+					max = i->bounds.getRight();
 				}
 			}
 
@@ -144,30 +162,17 @@ namespace BaconBox {
 	float GraphicTileLayer::getHeight() const {
 		float result = 0.0f;
 
-		if (!batches.empty()) {
-			bool notFirst = false;
-			float min, max;
-			float tmp;
-
-			for (BatchMap::const_iterator i = batches.begin(); i != batches.end(); ++i) {
-				for (RenderBatch<BatchedInanimateGraphicElement<Collidable> >::BodyMap::const_iterator j = i->second->getBegin();
-				     j != i->second->getEnd(); ++j) {
-					if (notFirst) {
-						if (min > (*j)->getYPosition()) {
-							min = (*j)->getYPosition();
-						}
-
-						tmp = (*j)->getYPosition() + (*j)->getHeight();
+		if (!chunks.empty()) {
+			ChunkList::const_iterator i = chunks.begin();
+			float min = i->bounds.getTop(), max = i->bounds.getBottom();
 
-						if (max < tmp) {
-							max = tmp;
-						}
+			for (++i; i != chunks.end(); ++i) {
+				if (min > i->bounds.getTop()) {
+					min = i->bounds.getTop();
+				}
 
-					} else {
-						min = (*j)->getYPosition();
-						max = (*j)->getYPosition() + (*j)->getHeight();
-						notFirst = true;
-					}
+				if (max < i->bounds.getBottom()) {
+					max = i->bounds.getBottom();
 				}
 			}
 
@@ -181,87 +186,141 @@ namespace BaconBox {
 	                                      const Vector2 &fromPoint) {
 		this->GraphicTileMapLayer::scaleFromPoint(xScaling, yScaling, fromPoint);
 
-		bool notFirst = false;
-		Vector2 newPosition;
-
-		for (BatchMap::iterator i = batches.begin(); i != batches.end(); ++i) {
-			for (RenderBatch<BatchedInanimateGraphicElement<Collidable> >::BodyMap::iterator j = i->second->getBegin();
-			     j != i->second->getEnd(); ++j) {
-				(*j)->scaleFromPoint(xScaling, yScaling, fromPoint);
-
-				if (notFirst) {
-					if (newPosition.x > (*j)->getXPosition()) {
-						newPosition.x = (*j)->getXPosition();
-					}
-
-					if (newPosition.y > (*j)->getYPosition()) {
-						newPosition.y = (*j)->getYPosition();
-					}
-
-				} else {
-					newPosition = (*j)->getPosition();
-					notFirst = true;
-				}
-			}
-		}
+		// We scale the layer's axes and its origin.
+		Vector2 scalingToApply(xScaling, yScaling);
+		origin = fromPoint + (origin - fromPoint).getCoordinatesMultiplication(scalingToApply);
+		xAxis = xAxis.getCoordinatesMultiplication(scalingToApply);
+		yAxis = yAxis.getCoordinatesMultiplication(scalingToApply);
 
-		this->GraphicTileMapLayer::move(newPosition.x - this->getXPosition(),
-		                                newPosition.y - this->getYPosition());
+		updateBounds();
+		moveToBounds();
 	}
 
 	void GraphicTileLayer::rotateFromPoint(float rotationAngle,
 	                                       const Vector2 &rotationPoint) {
 		this->GraphicTileMapLayer::rotateFromPoint(rotationAngle, rotationPoint);
 
-		bool notFirst = false;
-		Vector2 newPosition;
+		// We rotate the layer's axes and its origin.
+		origin -= rotationPoint;
+		origin.rotate(rotationAngle);
+		origin += rotationPoint;
+		xAxis.rotate(rotationAngle);
+		yAxis.rotate(rotationAngle);
 
-		for (BatchMap::iterator i = batches.begin(); i != batches.end(); ++i) {
-			for (RenderBatch<BatchedInanimateGraphicElement<Collidable> >::BodyMap::iterator j = i->second->getBegin();
-			     j != i->second->getEnd(); ++j) {
-				(*j)->rotateFromPoint(rotationAngle, rotationPoint);
+		updateBounds();
+		moveToBounds();
+	}
 
-				if (notFirst) {
-					if (newPosition.x > (*j)->getXPosition()) {
-						newPosition.x = (*j)->getXPosition();
-					}
+	void GraphicTileLayer::update() {
+		// We evaluate each animation once, all the tiles using it share the
+		// same frame.
+		double time = TimeHelper::getInstance().getSinceStart();
+		bool changed = false;
+
+		for (TilesetList::iterator i = tilesets.begin(); i != tilesets.end(); ++i) {
+			for (TileAnimationMap::iterator j = i->animations.begin(); j != i->animations.end(); ++j) {
+				unsigned int frame = j->second.animation.getFrame(time);
+				j->second.changed = (frame != j->second.currentFrame && frame < i->nbTiles);
+
+				if (j->second.changed) {
+					j->second.currentFrame = frame;
+					changed = true;
+				}
+			}
+		}
 
-					if (newPosition.y > (*j)->getYPosition()) {
-						newPosition.y = (*j)->getYPosition();
+		if (changed) {
+			const LayerTileset *tileset;
+			BatchVertexArray::size_type dirtyBegin, dirtyEnd;
+			Vector2 textureCoordinates[4];
+
+			// We patch the texture coordinates of the visible animated tiles
+			// whose frame changed.
+			for (ChunkList::iterator i = chunks.begin(); i != chunks.end(); ++i) {
+				for (BatchList::iterator j = i->batches.begin(); j != i->batches.end(); ++j) {
+					dirtyBegin = j->vertices.size();
+					dirtyEnd = 0;
+
+					for (AnimatedTileList::const_iterator k = j->animatedTiles.begin(); k != j->animatedTiles.end(); ++k) {
+						if (k->animation->changed) {
+							tileset = findTileset(k->tileId);
+							loadTextureCoordinates(*tileset, k->animation->currentFrame, k->tileId, textureCoordinates);
+
+							for (BatchVertexArray::size_type l = 0; l < 4; ++l) {
+								j->vertices[k->firstVertex + l].textureCoordinate = textureCoordinates[l];
+							}
+
+							dirtyBegin = std::min(dirtyBegin, k->firstVertex);
+							dirtyEnd = std::max(dirtyEnd, k->firstVertex + 4);
+						}
 					}
 
-				} else {
-					newPosition = (*j)->getPosition();
-					notFirst = true;
+					if (j->vertexBuffer && dirtyBegin < dirtyEnd) {
+						j->vertexBuffer->markDirty(static_cast<StandardVertexArray::SizeType>(dirtyBegin),
+						                           static_cast<StandardVertexArray::SizeType>(dirtyEnd - dirtyBegin));
+					}
 				}
 			}
 		}
-
-		this->GraphicTileMapLayer::move(newPosition.x - this->getXPosition(),
-		                                newPosition.y - this->getYPosition());
 	}
 
-	void GraphicTileLayer::update() {
-		for (BatchMap::iterator i = batches.begin(); i != batches.end(); ++i) {
-			i->second->update();
+	void GraphicTileLayer::render() {
+		prepareVisibleChunks();
+
+		GraphicDriver &graphicDriver = GraphicDriver::getInstance();
+
+		if (currentMask) {
+			currentMask->mask();
 		}
-	}
 
-	void GraphicTileLayer::render() {
-		for (BatchMap::iterator i = batches.begin(); i != batches.end(); ++i) {
-			i->second->render();
+		// Only the visible chunks have batches.
+		for (ChunkList::iterator i = chunks.begin(); i != chunks.end(); ++i) {
+			for (BatchList::iterator j = i->batches.begin(); j != i->batches.end(); ++j) {
+				if (currentMask) {
+					graphicDriver.drawMaskedBatchWithTextureAndColor(j->vertices,
+					                                                 j->textureInformation,
+					                                                 j->indices,
+					                                                 j->indiceList,
+					                                                 invertedMask,
+					                                                 j->vertexBuffer);
+
+				} else {
+					graphicDriver.drawBatchWithTextureAndColor(j->vertices,
+					                                           j->textureInformation,
+					                                           j->indices,
+					                                           j->indiceList,
+					                                           j->vertexBuffer);
+				}
+			}
+		}
+
+		if (currentMask) {
+			currentMask->unmask();
 		}
 	}
 
 	void GraphicTileLayer::mask() {
-		for (BatchMap::iterator i = batches.begin(); i != batches.end(); ++i) {
-			i->second->mask();
+		prepareVisibleChunks();
+
+		for (ChunkList::iterator i = chunks.begin(); i != chunks.end(); ++i) {
+			for (BatchList::iterator j = i->batches.begin(); j != i->batches.end(); ++j) {
+				GraphicDriver::getInstance().drawMaskBatchWithTextureAndColor(j->vertices,
+				                                                              j->textureInformation,
+				                                                              j->indices,
+				                                                              j->indiceList,
+				                                                              j->vertexBuffer);
+			}
 		}
 	}
 
 	void GraphicTileLayer::unmask() {
-		for (BatchMap::iterator i = batches.begin(); i != batches.end(); ++i) {
-			i->second->unmask();
+		for (ChunkList::iterator i = chunks.begin(); i != chunks.end(); ++i) {
+			for (BatchList::iterator j = i->batches.begin(); j != i->batches.end(); ++j) {
+				GraphicDriver::getInstance().unmaskBatch(j->vertices,
+				                                         j->indices,
+				                                         j->indiceList,
+				                                         j->vertexBuffer);
+			}
 		}
 	}
 
@@ -271,10 +330,7 @@ namespace BaconBox {
 
 	void GraphicTileLayer::setMask(Maskable *newMask, bool inverted) {
 		currentMask = newMask;
-
-		for (BatchMap::iterator i = batches.begin(); i != batches.end(); ++i) {
-			i->second->setMask(newMask, inverted);
-		}
+		invertedMask = inverted;
 	}
 
 	GraphicTileLayer *GraphicTileLayer::asTileLayer() {
@@ -291,51 +347,109 @@ namespace BaconBox {
 
 	void GraphicTileLayer::construct(const TileLayer &layer) {
 		free();
-		batches.clear();
-		// Variables used within the "for" loop.
-		RenderBatch<BatchedInanimateGraphicElement<Collidable> >::ValueType *tmpTile = NULL;
-		const Tileset *tileset;
-		TileLayer::DataContainer::const_iterator::difference_type tileIndex;
-		Color tmpColor;
-
-		// We add all the tiles.
-		for (TileLayer::DataContainer::const_iterator i = layer.getTiles().begin();
-		     i != layer.getTiles().end(); ++i) {
-			// We find the tileset the tile id belongs to.
-			tileset = layer.parentMap.getTileset(*i);
-
-			// If the tile id is valid, we should have a valid tileset.
-			if (tileset && tileset->getTextureInformation()) {
-				// We initialize the new tile.
-				tmpTile = new BatchedInanimateGraphicElement<Collidable>();
-
-				// We set the tile's texture information (optional).
-				tmpTile->setTextureInformation(tileset->getTextureInformation());
-
-				// We calculate the tile's position.
-				tileIndex = i - layer.getTiles().begin();
-				tmpTile->setPosition(layer.parentMap.getTileSize().getCoordinatesMultiplication(Vector2(static_cast<float>(tileIndex % layer.getWidthInTiles()),
-				                                                                                static_cast<float>(tileIndex / layer.getWidthInTiles()))) +
-				                     this->getPosition() + (layer.parentMap.getTileHeight() - tileset->getTileHeight()));
-
-				// We initialize the vertices.
-				tmpTile->getVertices().resize(4);
-				ShapeFactory::createRectangle(tileset->getTileSize(), tmpTile->getPosition(), &tmpTile->getVertices());
-
-				// We load the texture coordinates.
-				tileset->loadTextureCoordinates(*i, tmpTile->getTextureCoordinates());
-
-				// We set the tile's opacity.
-				tmpTile->setAlpha(layer.getOpacity());
-
-				// We set the tile to be a static body.
-				tmpTile->setStaticBody(true);
-
-				// We add the new tile to the right batch.
-				getBatch(tmpTile->getTextureInformation())->add(tmpTile);
+		deleteTileBodies();
+		chunks.clear();
+		tilesets.clear();
+
+		// We keep a copy of the tile id's.
+		tiles = layer.getTiles();
+		widthInTiles = static_cast<unsigned int>(layer.getWidthInTiles());
+		unsigned int heightInTiles = static_cast<unsigned int>(layer.getHeightInTiles());
+		tileSize = layer.parentMap.getTileSize();
+
+		// We set the tiles' opacity.
+		tileColor = Color::WHITE;
+		tileColor.setAlpha(layer.getOpacity());
+
+		origin = this->getPosition();
+		xAxis = Vector2(1.0f, 0.0f);
+		yAxis = Vector2(0.0f, 1.0f);
+
+		// We copy the information we need from the tilesets.
+		TextureCoordinates tmpTextureCoordinates;
+
+		for (TileMap::TilesetContainer::const_iterator i = layer.parentMap.getTilesets().begin();
+		     i != layer.parentMap.getTilesets().end(); ++i) {
+			if ((*i)->getTextureInformation()) {
+				tilesets.push_back(LayerTileset());
+				LayerTileset &tileset = tilesets.back();
+				tileset.textureInformation = (*i)->getTextureInformation();
+				tileset.firstTileId = (*i)->getFirstTileId();
+				tileset.nbTiles = static_cast<unsigned int>((*i)->getNbTiles());
+				tileset.tileSize = (*i)->getTileSize();
+				tileset.offset = layer.parentMap.getTileHeight() - (*i)->getTileHeight();
+				tileset.textureCoordinates.reserve(tileset.nbTiles * 4);
+
+				for (unsigned int j = 0; j < tileset.nbTiles; ++j) {
+					(*i)->loadTextureCoordinates(tileset.firstTileId + j, tmpTextureCoordinates);
+					tileset.textureCoordinates.insert(tileset.textureCoordinates.end(),
+					                                  tmpTextureCoordinates.begin(),
+					                                  tmpTextureCoordinates.begin() + 4);
+
+					// We read the tile's animation, if it has one.
+					const PropertyMap *tileProperties = (*i)->getTileProperties(tileset.firstTileId + j);
+					TileAnimationState animationState;
+
+					if (tileProperties && TileMapUtility::readTileAnimation(*tileProperties, animationState.animation)) {
+						animationState.currentFrame = j;
+						animationState.changed = false;
+						tileset.animations.insert(std::make_pair(j, animationState));
+					}
+				}
+			}
+		}
+
+		// We make sure the tilesets are sorted by their first tile id (there
+		// are only a few, so an insertion sort is enough).
+		for (TilesetList::size_type i = 1; i < tilesets.size(); ++i) {
+			for (TilesetList::size_type j = i; j > 0 && tilesets[j - 1].firstTileId > tilesets[j].firstTileId; --j) {
+				std::swap(tilesets[j - 1], tilesets[j]);
 			}
 		}
 
+		// We find the chunks that have tiles and the area they cover.
+		const LayerTileset *tileset;
+		Vector2 min, max, tilePosition;
+		bool notEmpty;
+
+		for (unsigned int yChunk = 0; yChunk < heightInTiles; yChunk += CHUNK_SIZE) {
+			for (unsigned int xChunk = 0; xChunk < widthInTiles; xChunk += CHUNK_SIZE) {
+				notEmpty = false;
+
+				for (unsigned int y = yChunk; y < std::min(yChunk + CHUNK_SIZE, heightInTiles); ++y) {
+					for (unsigned int x = xChunk; x < std::min(xChunk + CHUNK_SIZE, widthInTiles); ++x) {
+						tileset = findTileset(tiles[y * widthInTiles + x]);
+
+						if (tileset) {
+							tilePosition = tileSize.getCoordinatesMultiplication(Vector2(static_cast<float>(x), static_cast<float>(y))) + tileset->offset;
+
+							if (notEmpty) {
+								min.x = std::min(min.x, tilePosition.x);
+								min.y = std::min(min.y, tilePosition.y);
+								max.x = std::max(max.x, tilePosition.x + tileset->tileSize.x);
+								max.y = std::max(max.y, tilePosition.y + tileset->tileSize.y);
+
+							} else {
+								min = tilePosition;
+								max = tilePosition + tileset->tileSize;
+								notEmpty = true;
+							}
+						}
+					}
+				}
+
+				if (notEmpty) {
+					chunks.push_back(Chunk());
+					chunks.back().xTile = xChunk;
+					chunks.back().yTile = yChunk;
+					chunks.back().localBounds.setPosition(min);
+					chunks.back().localBounds.setSize(max - min);
+				}
+			}
+		}
+
+		updateBounds();
+
 		// We set the layer's visibility.
 		this->setVisible(layer.isVisible());
 
@@ -344,27 +458,242 @@ namespace BaconBox {
 	}
 
 	void GraphicTileLayer::addToCollisionGroup(CollisionGroup &group) {
-		for (BatchMap::iterator i = batches.begin(); i != batches.end(); ++i) {
-			for (RenderBatch<BatchedInanimateGraphicElement<Collidable> >::BodyMap::iterator j = i->second->getBegin();
-			     j != i->second->getEnd(); ++j) {
-				group.add(*j);
+		if (tileBodies.empty()) {
+			const LayerTileset *tileset;
+			Vector2 tilePosition;
+
+			for (TileLayer::DataContainer::size_type i = 0; i < tiles.size(); ++i) {
+				tileset = findTileset(tiles[i]);
+
+				if (tileset) {
+					tilePosition = tileSize.getCoordinatesMultiplication(Vector2(static_cast<float>(i % widthInTiles), static_cast<float>(i / widthInTiles))) + tileset->offset;
+					tileBodies.push_back(new TileBody(transform(tilePosition), tileset->tileSize));
+				}
 			}
 		}
+
+		for (TileBodyList::iterator i = tileBodies.begin(); i != tileBodies.end(); ++i) {
+			group.add(*i);
+		}
 	}
 
 	void GraphicTileLayer::free() {
-		for (BatchMap::iterator i = batches.begin(); i != batches.end(); ++i) {
-			delete i->second;
+		for (ChunkList::iterator i = chunks.begin(); i != chunks.end(); ++i) {
+			releaseChunk(*i);
 		}
 	}
 
-	GraphicTileLayer::BatchMap::mapped_type GraphicTileLayer::getBatch(TextureInformation *textureInformation) {
-		std::pair<BatchMap::iterator, bool> inserted = batches.insert(BatchMap::value_type(textureInformation, NULL));
+	void GraphicTileLayer::deleteTileBodies() {
+		for (TileBodyList::iterator i = tileBodies.begin(); i != tileBodies.end(); ++i) {
+			delete *i;
+		}
+
+		tileBodies.clear();
+	}
+
+	void GraphicTileLayer::buildChunk(Chunk &chunk) {
+		unsigned int xEnd = std::min(chunk.xTile + CHUNK_SIZE, widthInTiles);
+		unsigned int yEnd = std::min(chunk.yTile + CHUNK_SIZE, static_cast<unsigned int>(tiles.size()) / widthInTiles);
+		// Variables used within the "for" loops.
+		unsigned int tileId;
+		const LayerTileset *tileset;
+		BatchList::iterator batch;
+		TileAnimationMap::const_iterator animation;
+		Vector2 tilePosition, textureCoordinates[4];
+		IndiceArray::value_type firstVertex;
+
+		for (unsigned int y = chunk.yTile; y < yEnd; ++y) {
+			for (unsigned int x = chunk.xTile; x < xEnd; ++x) {
+				tileId = tiles[y * widthInTiles + x];
+				tileset = findTileset(tileId);
+
+				if (tileset) {
+					// We find the batch of the tile's texture.
+					batch = chunk.batches.begin();
+
+					while (batch != chunk.batches.end() && batch->textureInformation != tileset->textureInformation) {
+						++batch;
+					}
+
+					if (batch == chunk.batches.end()) {
+						chunk.batches.push_back(ChunkBatch());
+						batch = chunk.batches.end() - 1;
+						batch->textureInformation = tileset->textureInformation;
+						batch->vertexBuffer = NULL;
+					}
+
+					// We load the texture coordinates of the tile, or of the
+					// frame it currently shows if it is animated.
+					animation = tileset->animations.find(TileIdRange::withoutFlipFlags(tileId) - tileset->firstTileId);
+
+					if (animation == tileset->animations.end()) {
+						loadTextureCoordinates(*tileset, TileIdRange::withoutFlipFlags(tileId) - tileset->firstTileId, tileId, textureCoordinates);
+
+					} else {
+						loadTextureCoordinates(*tileset, animation->second.currentFrame, tileId, textureCoordinates);
+						batch->animatedTiles.push_back(AnimatedTile());
+						batch->animatedTiles.back().firstVertex = batch->vertices.size();
+						batch->animatedTiles.back().tileId = tileId;
+						batch->animatedTiles.back().animation = &animation->second;
+					}
+
+					// We add the tile's vertices, in the same order as
+					// ShapeFactory::createRectangle().
+					tilePosition = tileSize.getCoordinatesMultiplication(Vector2(static_cast<float>(x), static_cast<float>(y))) + tileset->offset;
+					firstVertex = static_cast<IndiceArray::value_type>(batch->vertices.size());
+					batch->vertices.push_back(BatchVertex(transform(tilePosition), textureCoordinates[0], tileColor));
+					batch->vertices.push_back(BatchVertex(transform(tilePosition + Vector2(tileset->tileSize.x, 0.0f)), textureCoordinates[1], tileColor));
+					batch->vertices.push_back(BatchVertex(transform(tilePosition + Vector2(0.0f, tileset->tileSize.y)), textureCoordinates[2], tileColor));
+					batch->vertices.push_back(BatchVertex(transform(tilePosition + tileset->tileSize), textureCoordinates[3], tileColor));
+
+					// We add the tile's two triangles.
+					batch->indices.push_back(firstVertex);
+					batch->indices.push_back(firstVertex + 1);
+					batch->indices.push_back(firstVertex + 2);
+					batch->indices.push_back(firstVertex + 1);
+					batch->indices.push_back(firstVertex + 2);
+					batch->indices.push_back(firstVertex + 3);
+				}
+			}
+		}
+
+		// A chunk never has more vertices than 16 bit indices can address, so
+		// each batch has a single segment.
+		for (BatchList::iterator i = chunk.batches.begin(); i != chunk.batches.end(); ++i) {
+			i->indiceList.push_back(std::make_pair(static_cast<StandardVertexArray::SizeType>(0),
+			                                       static_cast<IndiceArray::size_type>(0)));
+			i->vertexBuffer = GraphicDriver::getInstance().createVertexBuffer(VertexBufferUsage::STATIC);
+		}
+	}
+
+	void GraphicTileLayer::releaseChunk(Chunk &chunk) {
+		for (BatchList::iterator i = chunk.batches.begin(); i != chunk.batches.end(); ++i) {
+			if (i->vertexBuffer) {
+				GraphicDriver::getInstance().deleteVertexBuffer(i->vertexBuffer);
+			}
+		}
 
-		if (inserted.second) {
-			inserted.first->second = new RenderBatch<BatchedInanimateGraphicElement<Collidable> >(textureInformation);
+		// We make sure the memory is released.
+		BatchList().swap(chunk.batches);
+	}
+
+	void GraphicTileLayer::prepareVisibleChunks() {
+		AxisAlignedBoundingBox visibleArea;
+		bool culling = getVisibleArea(visibleArea);
+
+		for (ChunkList::iterator i = chunks.begin(); i != chunks.end(); ++i) {
+			if (!culling || i->bounds.overlaps(visibleArea)) {
+				if (i->batches.empty()) {
+					buildChunk(*i);
+				}
+
+			} else if (!i->batches.empty()) {
+				// We release the chunks the camera can't see.
+				releaseChunk(*i);
+			}
+		}
+	}
+
+	void GraphicTileLayer::updateBounds() {
+		Vector2 corners[4], min, max;
+
+		for (ChunkList::iterator i = chunks.begin(); i != chunks.end(); ++i) {
+			corners[0] = transform(i->localBounds.getPosition());
+			corners[1] = transform(Vector2(i->localBounds.getRight(), i->localBounds.getTop()));
+			corners[2] = transform(Vector2(i->localBounds.getLeft(), i->localBounds.getBottom()));
+			corners[3] = transform(Vector2(i->localBounds.getRight(), i->localBounds.getBottom()));
+			min = max = corners[0];
+
+			for (int j = 1; j < 4; ++j) {
+				min.x = std::min(min.x, corners[j].x);
+				min.y = std::min(min.y, corners[j].y);
+				max.x = std::max(max.x, corners[j].x);
+				max.y = std::max(max.y, corners[j].y);
+			}
+
+			i->bounds.setPosition(min);
+			i->bounds.setSize(max - min);
+
+			// The generated vertices aren't valid anymore.
+			releaseChunk(*i);
+		}
+	}
+
+	void GraphicTileLayer::moveToBounds() {
+		if (!chunks.empty()) {
+			ChunkList::const_iterator i = chunks.begin();
+			Vector2 newPosition = i->bounds.getPosition();
+
+			for (++i; i != chunks.end(); ++i) {
+				newPosition.x = std::min(newPosition.x, i->bounds.getXPosition());
+				newPosition.y = std::min(newPosition.y, i->bounds.getYPosition());
+			}
+
+			this->GraphicTileMapLayer::move(newPosition.x - this->getXPosition(),
+			                                newPosition.y - this->getYPosition());
+		}
+	}
+
+	const Vector2 GraphicTileLayer::transform(const Vector2 &localPosition) const {
+		return origin + xAxis * localPosition.x + yAxis * localPosition.y;
+	}
+
+	bool GraphicTileLayer::getVisibleArea(AxisAlignedBoundingBox &result) const {
+		const State *state = Engine::getCurrentState();
+
+		// Hud layers are rendered without the camera.
+		if (state && !this->isHud()) {
+			const Camera &camera = state->getCamera();
+
+			if (camera.isEnabled() && camera.isVisible()) {
+				result = camera.getViewBoundingBox();
+				// We apply the scroll factor the same way the state does
+				// when rendering.
+				result.move((1.0f - this->getXScrollFactor()) * camera.getXPosition(),
+				            (1.0f - this->getYScrollFactor()) * camera.getYPosition());
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void GraphicTileLayer::loadTextureCoordinates(const LayerTileset &tileset,
+	                                              unsigned int tile,
+	                                              unsigned int tileId,
+	                                              Vector2 *result) {
+		std::copy(tileset.textureCoordinates.begin() + tile * 4,
+		          tileset.textureCoordinates.begin() + (tile + 1) * 4,
+		          result);
+
+		if (TileIdRange::isFlippedHorizontally(tileId)) {
+			std::swap(result[0], result[1]);
+			std::swap(result[2], result[3]);
+		}
+
+		if (TileIdRange::isFlippedVertically(tileId)) {
+			std::swap(result[0], result[2]);
+			std::swap(result[1], result[3]);
+		}
+
+		if (TileIdRange::isFlippedDiagonally(tileId)) {
+			std::swap(result[0], result[3]);
+			std::swap(result[1], result[2]);
+		}
+	}
+
+	const GraphicTileLayer::LayerTileset *GraphicTileLayer::findTileset(unsigned int tileId) const {
+		tileId = TileIdRange::withoutFlipFlags(tileId);
+
+		if (tileId) {
+			// We find the last tileset starting before the tile id.
+			for (TilesetList::const_reverse_iterator i = tilesets.rbegin(); i != tilesets.rend(); ++i) {
+				if (i->firstTileId <= tileId) {
+					return (tileId < i->firstTileId + i->nbTiles) ? (&*i) : (NULL);
+				}
+			}
 		}
 
-		return inserted.first->second;
+		return NULL;
 	}
 }
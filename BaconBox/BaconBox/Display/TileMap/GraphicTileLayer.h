@@ -5,18 +5,31 @@
 #ifndef RB_GRAPHIC_TILE_LAYER_H
 #define RB_GRAPHIC_TILE_LAYER_H
 
+#include <vector>
 #include <map>
 
 #include "BaconBox/Display/TileMap/GraphicTileMapLayer.h"
-#include "BaconBox/Display/RenderBatch.h"
-#include "BaconBox/Display/BatchedInanimateGraphicElement.h"
-#include "BaconBox/Display/Collidable.h"
+#include "BaconBox/Display/TileMap/TileLayer.h"
+#include "BaconBox/Display/TileMap/TileAnimation.h"
+#include "BaconBox/Display/AxisAlignedBoundingBox.h"
+#include "BaconBox/Display/Color.h"
+#include "BaconBox/Display/Driver/BatchVertex.h"
+#include "BaconBox/Display/Driver/IndiceArray.h"
 
 namespace BaconBox {
-	class TileLayer;
+	struct TextureInformation;
+	struct VertexBuffer;
+	class Maskable;
 	class CollisionGroup;
 	/**
-	 * Graphically represents a tile layer.
+	 * Graphically represents a tile layer. The tiles are grouped in chunks of
+	 * CHUNK_SIZE by CHUNK_SIZE tiles and only the chunks visible through the
+	 * current state's camera are rendered. Only the tile id's are kept for
+	 * each tile: the vertices of a chunk are generated from its tile id's
+	 * when it becomes visible and are released when it isn't anymore.
+	 * Animated tiles (see TileMapUtility::readTileAnimation()) are animated
+	 * by the layer's update, which only patches the texture coordinates of
+	 * the visible tiles whose frame changed.
 	 * @ingroup TileMap
 	 */
 	class GraphicTileLayer : public GraphicTileMapLayer {
@@ -110,7 +123,7 @@ namespace BaconBox {
 		                     const Vector2 &rotationPoint);
 
 		/**
-		 * Updates the body.
+		 * Updates the animated tiles.
 		 */
 		void update();
 
@@ -174,20 +187,259 @@ namespace BaconBox {
 		 */
 		void construct(const TileLayer &layer);
 
+		/**
+		 * Adds all the layer's tiles to a collision group as static bodies.
+		 * The layer doesn't keep a body per tile anymore, so the bodies are
+		 * created on the first call and kept until the layer is destroyed or
+		 * constructed again. They follow the layer's moves, but not its
+		 * scaling or rotation.
+		 * @param group Collision group to add the tiles to.
+		 * @deprecated Every tile costs a body again, collide with the tile
+		 * layer directly instead, which only checks the tiles a body moved
+		 * over.
+		 * @see BaconBox::TileLayer::collide(Collidable *body, const Vector2 &layerPosition)
+		 */
 		void addToCollisionGroup(CollisionGroup &group);
+
+		/// Width and height (in tiles) of the chunks the layer is split into.
+		static const unsigned int CHUNK_SIZE = 32;
 	private:
-		/// Map of batches by their tileset's texture.
-		typedef std::map<TextureInformation *, RenderBatch<BatchedInanimateGraphicElement<Collidable> > *> BatchMap;
+		/**
+		 * Animation of a tileset's tile with the frame it currently shows.
+		 */
+		struct TileAnimationState {
+			/// Animation of the tile.
+			TileAnimation animation;
+
+			/// Frame currently shown, relative to the tileset's first tile.
+			unsigned int currentFrame;
+
+			/// Set to true when the frame changed during the last update.
+			bool changed;
+		};
+
+		/// Map of tile animations by tile, relative to the tileset's first tile.
+		typedef std::map<unsigned int, TileAnimationState> TileAnimationMap;
+
+		/**
+		 * Information about a tileset needed to generate the vertices of its
+		 * tiles. Copied from the tile map, so the layer doesn't depend on it
+		 * once it is constructed.
+		 */
+		struct LayerTileset {
+			/// Texture of the tileset.
+			TextureInformation *textureInformation;
+
+			/// Tile id of the tileset's first tile.
+			unsigned int firstTileId;
+
+			/// Number of tiles in the tileset.
+			unsigned int nbTiles;
+
+			/// Size of the tileset's tiles (in pixels).
+			Vector2 tileSize;
+
+			/// Offset applied to the tiles' positions.
+			float offset;
+
+			/// Texture coordinates of the tiles, 4 per tile.
+			std::vector<Vector2> textureCoordinates;
+
+			/// Animations of the tileset's animated tiles.
+			TileAnimationMap animations;
+		};
+
+		/// List of tilesets, sorted by first tile id.
+		typedef std::vector<LayerTileset> TilesetList;
+
+		/**
+		 * Animated tile in a chunk's batch.
+		 */
+		struct AnimatedTile {
+			/// Index of the tile's first vertex in the batch.
+			BatchVertexArray::size_type firstVertex;
+
+			/// Tile id of the tile, used for its flip flags.
+			unsigned int tileId;
+
+			/// Animation of the tile.
+			const TileAnimationState *animation;
+		};
+
+		/// List of animated tiles.
+		typedef std::vector<AnimatedTile> AnimatedTileList;
+
+		/**
+		 * Generated vertices of the tiles of a chunk sharing the same
+		 * texture.
+		 */
+		struct ChunkBatch {
+			/// Texture of the batch's tiles.
+			TextureInformation *textureInformation;
+
+			/// Vertices of the tiles, 4 per tile.
+			BatchVertexArray vertices;
+
+			/// Indices of the tiles' triangles.
+			IndiceArray indices;
+
+			/// Segments of the indices.
+			IndiceArrayList indiceList;
+
+			/// Animated tiles of the batch.
+			AnimatedTileList animatedTiles;
+
+			/// Buffer in graphic memory, NULL if the driver doesn't use any.
+			VertexBuffer *vertexBuffer;
+		};
+
+		/// List of batches of a chunk.
+		typedef std::vector<ChunkBatch> BatchList;
+
+		/**
+		 * Square group of tiles. Only keeps its batches while it is visible.
+		 */
+		struct Chunk {
+			/// Horizontal coordinate of the chunk's first tile.
+			unsigned int xTile;
+
+			/// Vertical coordinate of the chunk's first tile.
+			unsigned int yTile;
+
+			/// Area covered by the chunk's tiles, before transformations.
+			AxisAlignedBoundingBox localBounds;
+
+			/// Area covered by the chunk's tiles.
+			AxisAlignedBoundingBox bounds;
+
+			/// Batches of the chunk, empty when the chunk isn't visible.
+			BatchList batches;
+		};
+
+		/// List of chunks.
+		typedef std::vector<Chunk> ChunkList;
+
+		/// Static body of a tile, created by addToCollisionGroup().
+		class TileBody;
+
+		/// List of tile bodies.
+		typedef std::vector<TileBody *> TileBodyList;
 
 		/// Pointer to the current mask.
 		Maskable *currentMask;
 
-		/// Batches making up the graphic tile layer.
-		BatchMap batches;
-		
+		/// Set to true when the current mask is inverted.
+		bool invertedMask;
+
+		/// Tile id's of the layer, row by row.
+		TileLayer::DataContainer tiles;
+
+		/// Width of the layer in tiles.
+		unsigned int widthInTiles;
+
+		/// Size of the tile map's tiles (in pixels).
+		Vector2 tileSize;
+
+		/// Color applied to all the tiles.
+		Color tileColor;
+
+		/// Tilesets used by the layer.
+		TilesetList tilesets;
+
+		/// Chunks making up the graphic tile layer. Empty chunks are skipped.
+		ChunkList chunks;
+
+		/// Position of the layer's first tile's upper left corner.
+		Vector2 origin;
+
+		/// Direction and length of the layer's horizontal axis.
+		Vector2 xAxis;
+
+		/// Direction and length of the layer's vertical axis.
+		Vector2 yAxis;
+
+		/// Bodies of the tiles, only created by addToCollisionGroup().
+		TileBodyList tileBodies;
+
+		/**
+		 * Releases the batches of all the chunks.
+		 */
 		void free();
-		
-		BatchMap::mapped_type getBatch(TextureInformation *textureInformation);
+
+		/**
+		 * Deletes the tiles' bodies, if any.
+		 */
+		void deleteTileBodies();
+
+		/**
+		 * Generates the batches of a chunk from its tile id's.
+		 * @param chunk Chunk to build.
+		 */
+		void buildChunk(Chunk &chunk);
+
+		/**
+		 * Releases the batches of a chunk.
+		 * @param chunk Chunk to release.
+		 */
+		static void releaseChunk(Chunk &chunk);
+
+		/**
+		 * Releases the batches of all the chunks that aren't visible and
+		 * generates the batches of the visible chunks that don't have them.
+		 * Afterwards, only the visible chunks have batches.
+		 */
+		void prepareVisibleChunks();
+
+		/**
+		 * Recalculates the bounds of all the chunks from their local bounds
+		 * after the layer's transformations changed. Releases their batches.
+		 */
+		void updateBounds();
+
+		/**
+		 * Moves the layer's position to the upper left corner of its chunks'
+		 * bounds.
+		 */
+		void moveToBounds();
+
+		/**
+		 * Applies the layer's transformations to a position relative to the
+		 * layer's first tile.
+		 * @param localPosition Position to transform.
+		 * @return Transformed position.
+		 */
+		const Vector2 transform(const Vector2 &localPosition) const;
+
+		/**
+		 * Gets the area of the layer visible through the current state's
+		 * camera.
+		 * @param result Bounding box in which to write the visible area.
+		 * @return True if the visible area could be calculated, false if the
+		 * whole layer has to be rendered (no camera applied or hud layer).
+		 */
+		bool getVisibleArea(AxisAlignedBoundingBox &result) const;
+
+		/**
+		 * Loads a tile's texture coordinates and flips them like the tileset
+		 * does.
+		 * @param tileset Tileset of the tile.
+		 * @param tile Tile to load, relative to the tileset's first tile.
+		 * @param tileId Tile id containing the flip flags to apply.
+		 * @param result Array of 4 texture coordinates in which to write
+		 * the texture coordinates.
+		 */
+		static void loadTextureCoordinates(const LayerTileset &tileset,
+		                                   unsigned int tile,
+		                                   unsigned int tileId,
+		                                   Vector2 *result);
+
+		/**
+		 * Finds the tileset a tile id belongs to.
+		 * @param tileId Tile id to find, flip flags are ignored.
+		 * @return Pointer to the tileset, NULL if no tileset contains the
+		 * tile id.
+		 */
+		const LayerTileset *findTileset(unsigned int tileId) const;
 	};
 }
 
@@ -0,0 +1,45 @@
+#include "BaconBox/Display/TileMap/TileAnimation.h"
+
+#include <cmath>
+
+namespace BaconBox {
+	TileAnimation::TileAnimation() : frames(), durations() {
+	}
+
+	TileAnimation::TileAnimation(const std::vector<unsigned int> &newFrames,
+	                             const std::vector<double> &newDurations) :
+		frames(newFrames), durations(newDurations) {
+	}
+
+	unsigned int TileAnimation::getFrame(double time) const {
+		unsigned int result = 0u;
+
+		if (!frames.empty() && frames.size() == durations.size()) {
+			double totalDuration = 0.0;
+
+			for (std::vector<double>::const_iterator i = durations.begin();
+			     i != durations.end(); ++i) {
+				totalDuration += *i;
+			}
+
+			if (totalDuration > 0.0) {
+				// We find where the time falls in the current loop.
+				time = std::fmod(time, totalDuration);
+
+				std::vector<unsigned int>::size_type i = 0;
+
+				while (i + 1 < frames.size() && time >= durations[i]) {
+					time -= durations[i];
+					++i;
+				}
+
+				result = frames[i];
+
+			} else {
+				result = frames.front();
+			}
+		}
+
+		return result;
+	}
+}
@@ -0,0 +1,51 @@
+/**
+ * @file
+ * @ingroup TileMap
+ */
+#ifndef RB_TILE_ANIMATION_H
+#define RB_TILE_ANIMATION_H
+
+#include <vector>
+
+namespace BaconBox {
+	/**
+	 * Animation of a tile in a tileset. All the tiles using the animated
+	 * tile id show the same frame: the frame is calculated from the time
+	 * since the start of the game, so the tiles don't need to be updated one
+	 * by one. Tile animations always loop.
+	 * @ingroup TileMap
+	 * @see BaconBox::TileMapUtility::readTileAnimation()
+	 */
+	struct TileAnimation {
+		/**
+		 * Default constructor.
+		 */
+		TileAnimation();
+
+		/**
+		 * Parameterized constructor.
+		 * @param newFrames Tiles to show, relative to the tileset's first
+		 * tile.
+		 * @param newDurations Duration of each frame (in seconds). Must have
+		 * as many values as there are frames.
+		 */
+		TileAnimation(const std::vector<unsigned int> &newFrames,
+		              const std::vector<double> &newDurations);
+
+		/**
+		 * Gets the frame to show at a given time.
+		 * @param time Time since the animation started (in seconds).
+		 * @return Tile to show, relative to the tileset's first tile. 0 if
+		 * the animation has no frames.
+		 */
+		unsigned int getFrame(double time) const;
+
+		/// Tiles to show, relative to the tileset's first tile.
+		std::vector<unsigned int> frames;
+
+		/// Duration of each frame (in seconds).
+		std::vector<double> durations;
+	};
+}
+
+#endif // RB_TILE_ANIMATION_H
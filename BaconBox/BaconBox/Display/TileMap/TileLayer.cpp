@@ -1,8 +1,13 @@
 #include "BaconBox/Display/TileMap/TileLayer.h"
 
+#include <cmath>
+
 #include <algorithm>
 
 #include "BaconBox/Display/TileMap/TileMap.h"
+#include "BaconBox/Display/TileMap/Tileset.h"
+#include "BaconBox/Display/TileMap/TileIdRange.h"
+#include "BaconBox/Display/Collidable.h"
 
 namespace BaconBox {
 	const TileCoordinate &TileLayer::getSizeInTiles() const {
@@ -57,6 +62,61 @@ namespace BaconBox {
 		}
 	}
 
+	void TileLayer::setTileIds(const unsigned int *newTileIds) {
+		std::copy(newTileIds, newTileIds + data.size(), data.begin());
+		validateTileIds();
+	}
+
+	void TileLayer::swapTileIds(DataContainer &newTileIds) {
+		if (newTileIds.size() == data.size()) {
+			data.swap(newTileIds);
+			validateTileIds();
+		}
+	}
+
+	void TileLayer::validateTileIds() {
+		// The tilesets' tile id's follow each other, so the valid tile id's
+		// are all below the end of the last tileset. The flip flags are kept,
+		// only the tile id they're on is validated.
+		unsigned int end = (parentMap.getTilesets().empty()) ? (1u) : (parentMap.getTilesets().back()->getFirstTileId() + static_cast<unsigned int>(parentMap.getTilesets().back()->getNbTiles()));
+
+		for (DataContainer::iterator i = data.begin(); i != data.end(); ++i) {
+			if (TileIdRange::withoutFlipFlags(*i) >= end) {
+				*i = 0u;
+			}
+		}
+	}
+
+	bool TileLayer::isTileSideSolid(int xTileCoordinate, int yTileCoordinate,
+	                                Side side) const {
+		unsigned int tileId = getTileId(xTileCoordinate, yTileCoordinate);
+
+		if (tileId) {
+			const Tileset *tileset = parentMap.getTileset(tileId);
+			return tileset && tileset->isTileSideSolid(tileId, side);
+
+		} else {
+			return false;
+		}
+	}
+
+	std::pair<bool, CollisionDetails> TileLayer::collide(Collidable *body,
+	                                                     const Vector2 &layerPosition) const {
+		std::pair<bool, CollisionDetails> result(false, CollisionDetails());
+		result.second.body1 = body;
+
+		if (body && !body->isStaticBody() &&
+		    parentMap.getTileWidth() > 0.0f && parentMap.getTileHeight() > 0.0f) {
+			// The bool is set to true if there is either a horizontal or
+			// vertical collision.
+			bool solvedX = solveXCollision(*body, layerPosition, result.second);
+			bool solvedY = solveYCollision(*body, layerPosition, result.second);
+			result.first = solvedX || solvedY;
+		}
+
+		return result;
+	}
+
 	TileLayer::TileLayer(const std::string &newName,
 	                     const TileMap &newParentMap,
 	                     int32_t newOpacity,
@@ -367,4 +427,160 @@ namespace BaconBox {
 	TileLayer *TileLayer::clone(const TileMap &newParentMap) const {
 		return new TileLayer(*this, newParentMap);
 	}
+
+	bool TileLayer::getTileRange(float low, float high, float origin,
+	                             float tileLength, int nbTiles, int &first,
+	                             int &last) {
+		first = std::max(static_cast<int>(floorf((low - origin) / tileLength)), 0);
+		last = std::min(static_cast<int>(ceilf((high - origin) / tileLength)) - 1, nbTiles - 1);
+		return first <= last;
+	}
+
+	bool TileLayer::solveXCollision(Collidable &body,
+	                                const Vector2 &layerPosition,
+	                                CollisionDetails &collisionDetails) const {
+		float delta = body.getXPosition() - body.getOldXPosition();
+
+		if (delta == 0.0f) {
+			return false;
+		}
+
+		AxisAlignedBoundingBox box = body.getAxisAlignedBoundingBox();
+
+		// Like for collidables, the rows are taken at the vertical position
+		// the body had before moving.
+		float top = box.getTop() + (body.getOldYPosition() - body.getYPosition());
+		int firstRow, lastRow, firstColumn, lastColumn;
+
+		if (!getTileRange(top, top + box.getHeight(), layerPosition.y,
+		                  parentMap.getTileHeight(), getHeightInTiles(),
+		                  firstRow, lastRow)) {
+			return false;
+		}
+
+		if (delta > 0.0f) {
+			if (!body.getCollidableSides().isSet(Side::RIGHT)) {
+				return false;
+			}
+
+			// We check the tiles whose left edge was crossed by the body's
+			// right side, from left to right.
+			firstColumn = std::max(static_cast<int>(ceilf((box.getRight() - delta - Collidable::OVERLAP_BIAS - layerPosition.x) / parentMap.getTileWidth())), 0);
+			lastColumn = std::min(static_cast<int>(ceilf((box.getRight() - layerPosition.x) / parentMap.getTileWidth())) - 1, getWidthInTiles() - 1);
+
+			for (int i = firstColumn; i <= lastColumn; ++i) {
+				for (int j = firstRow; j <= lastRow; ++j) {
+					// Edges shared by two solid tiles are ignored, this way
+					// bodies don't get stuck on the seams of the floor.
+					if (isTileSideSolid(i, j, Side::LEFT) &&
+					    !isTileSideSolid(i - 1, j, Side::RIGHT)) {
+						collisionDetails.overlap = box.getRight() - (layerPosition.x + static_cast<float>(i) * parentMap.getTileWidth());
+						collisionDetails.sidesBody1.set(Side::RIGHT);
+						collisionDetails.sidesBody2.set(Side::LEFT);
+						body.moveX(-collisionDetails.overlap);
+						body.setXVelocity(-body.getXVelocity() * body.getElasticity());
+						return true;
+					}
+				}
+			}
+
+		} else {
+			if (!body.getCollidableSides().isSet(Side::LEFT)) {
+				return false;
+			}
+
+			// We check the tiles whose right edge was crossed by the body's
+			// left side, from right to left.
+			firstColumn = std::max(static_cast<int>(floorf((box.getLeft() - layerPosition.x) / parentMap.getTileWidth())), 0);
+			lastColumn = std::min(static_cast<int>(floorf((box.getLeft() - delta + Collidable::OVERLAP_BIAS - layerPosition.x) / parentMap.getTileWidth())) - 1, getWidthInTiles() - 1);
+
+			for (int i = lastColumn; i >= firstColumn; --i) {
+				for (int j = firstRow; j <= lastRow; ++j) {
+					if (isTileSideSolid(i, j, Side::RIGHT) &&
+					    !isTileSideSolid(i + 1, j, Side::LEFT)) {
+						collisionDetails.overlap = box.getLeft() - (layerPosition.x + static_cast<float>(i + 1) * parentMap.getTileWidth());
+						collisionDetails.sidesBody1.set(Side::LEFT);
+						collisionDetails.sidesBody2.set(Side::RIGHT);
+						body.moveX(-collisionDetails.overlap);
+						body.setXVelocity(-body.getXVelocity() * body.getElasticity());
+						return true;
+					}
+				}
+			}
+		}
+
+		return false;
+	}
+
+	bool TileLayer::solveYCollision(Collidable &body,
+	                                const Vector2 &layerPosition,
+	                                CollisionDetails &collisionDetails) const {
+		float delta = body.getYPosition() - body.getOldYPosition();
+
+		if (delta == 0.0f) {
+			return false;
+		}
+
+		// The columns are taken at the body's horizontal position, which was
+		// already corrected by the horizontal collision.
+		AxisAlignedBoundingBox box = body.getAxisAlignedBoundingBox();
+		int firstRow, lastRow, firstColumn, lastColumn;
+
+		if (!getTileRange(box.getLeft(), box.getRight(), layerPosition.x,
+		                  parentMap.getTileWidth(), getWidthInTiles(),
+		                  firstColumn, lastColumn)) {
+			return false;
+		}
+
+		if (delta > 0.0f) {
+			if (!body.getCollidableSides().isSet(Side::BOTTOM)) {
+				return false;
+			}
+
+			// We check the tiles whose top edge was crossed by the body's
+			// bottom side, from top to bottom.
+			firstRow = std::max(static_cast<int>(ceilf((box.getBottom() - delta - Collidable::OVERLAP_BIAS - layerPosition.y) / parentMap.getTileHeight())), 0);
+			lastRow = std::min(static_cast<int>(ceilf((box.getBottom() - layerPosition.y) / parentMap.getTileHeight())) - 1, getHeightInTiles() - 1);
+
+			for (int j = firstRow; j <= lastRow; ++j) {
+				for (int i = firstColumn; i <= lastColumn; ++i) {
+					if (isTileSideSolid(i, j, Side::TOP) &&
+					    !isTileSideSolid(i, j - 1, Side::BOTTOM)) {
+						collisionDetails.overlap = box.getBottom() - (layerPosition.y + static_cast<float>(j) * parentMap.getTileHeight());
+						collisionDetails.sidesBody1.set(Side::BOTTOM);
+						collisionDetails.sidesBody2.set(Side::TOP);
+						body.moveY(-collisionDetails.overlap);
+						body.setYVelocity(-body.getYVelocity() * body.getElasticity());
+						return true;
+					}
+				}
+			}
+
+		} else {
+			if (!body.getCollidableSides().isSet(Side::TOP)) {
+				return false;
+			}
+
+			// We check the tiles whose bottom edge was crossed by the body's
+			// top side, from bottom to top.
+			firstRow = std::max(static_cast<int>(floorf((box.getTop() - layerPosition.y) / parentMap.getTileHeight())), 0);
+			lastRow = std::min(static_cast<int>(floorf((box.getTop() - delta + Collidable::OVERLAP_BIAS - layerPosition.y) / parentMap.getTileHeight())) - 1, getHeightInTiles() - 1);
+
+			for (int j = lastRow; j >= firstRow; --j) {
+				for (int i = firstColumn; i <= lastColumn; ++i) {
+					if (isTileSideSolid(i, j, Side::BOTTOM) &&
+					    !isTileSideSolid(i, j + 1, Side::TOP)) {
+						collisionDetails.overlap = box.getTop() - (layerPosition.y + static_cast<float>(j + 1) * parentMap.getTileHeight());
+						collisionDetails.sidesBody1.set(Side::TOP);
+						collisionDetails.sidesBody2.set(Side::BOTTOM);
+						body.moveY(-collisionDetails.overlap);
+						body.setYVelocity(-body.getYVelocity() * body.getElasticity());
+						return true;
+					}
+				}
+			}
+		}
+
+		return false;
+	}
 }
@@ -6,11 +6,17 @@
 #define RB_TILE_LAYER_H
 
 #include <vector>
+#include <utility>
 
 #include "BaconBox/Display/TileMap/TileMapLayer.h"
 #include "BaconBox/Display/TileMap/TileCoordinate.h"
+#include "BaconBox/Display/CollisionDetails.h"
+#include "BaconBox/Vector2.h"
+#include "BaconBox/Side.h"
 
 namespace BaconBox {
+	class Collidable;
+
 	/**
 	 * Represents a layer of tiles in a tile map. Always has the same size as
 	 * the map that owns the layer. Can have a name, but it's not required.
@@ -102,7 +108,99 @@ namespace BaconBox {
 		 */
 		void setTileId(int xTileCoordinate, int yTileCoordinate,
 		               unsigned int newTileId);
+
+		/**
+		 * Sets the id's of all the tiles in the tile layer at once. Much
+		 * faster than setting them one by one when loading a tile map. The
+		 * invalid tile id's are set to 0.
+		 * @param newTileIds Pointer to the new tile id's, row by row. Must
+		 * contain width * height tile id's.
+		 */
+		void setTileIds(const unsigned int *newTileIds);
+
+		/**
+		 * Swaps the tile layer's tile id's with the given ones. Used to give
+		 * the tile layer tile id's decoded elsewhere without copying them.
+		 * The invalid tile id's are set to 0.
+		 * @param newTileIds Vector of new tile id's, row by row. Must contain
+		 * width * height tile id's. Receives the old tile id's.
+		 */
+		void swapTileIds(DataContainer &newTileIds);
+
+		/**
+		 * Checks if a side of a tile stops collidables.
+		 * @param xTileCoordinate Horizontal coordinate of the tile to check.
+		 * @param yTileCoordinate Vertical coordinate of the tile to check.
+		 * @param side Side of the tile to check.
+		 * @return True if the side is solid, false if not or if the tile
+		 * coordinates are out of bounds.
+		 * @see BaconBox::Tileset::isTileSideSolid(unsigned int tileId, Side side)
+		 */
+		bool isTileSideSolid(int xTileCoordinate, int yTileCoordinate,
+		                     Side side) const;
+
+		/**
+		 * Collides a collidable with the layer's solid tiles. Only the tiles
+		 * covered by the collidable's movement since its last update are
+		 * checked. The tiles act as static bodies: the collidable is
+		 * separated from them and its elasticity is applied, like when
+		 * colliding with a static collidable.
+		 * @param body Pointer to the body to collide with the layer's tiles.
+		 * Static bodies are ignored.
+		 * @param layerPosition Position of the layer's upper left corner.
+		 * @return Pair whose first value is a boolean (true if the body
+		 * collided with at least one tile, false if not) and the second value
+		 * is a structure containing collision information. The second body in
+		 * the collision information is always NULL.
+		 * @see BaconBox::Collidable::collide(Collidable *other)
+		 */
+		std::pair<bool, CollisionDetails> collide(Collidable *body,
+		                                          const Vector2 &layerPosition = Vector2()) const;
 	private:
+		/**
+		 * Sets the tile id's that are not in the tile map's tilesets to 0.
+		 */
+		void validateTileIds();
+
+		/**
+		 * Calculates the range of tiles covered by a segment on an axis.
+		 * @param low Lowest coordinate of the segment.
+		 * @param high Highest coordinate of the segment, excluded.
+		 * @param origin Coordinate of the layer's first tile.
+		 * @param tileLength Length of a tile on the axis.
+		 * @param nbTiles Number of tiles on the axis.
+		 * @param first Index of the first tile covered.
+		 * @param last Index of the last tile covered.
+		 * @return True if the segment covers at least one tile, false if not.
+		 */
+		static bool getTileRange(float low, float high, float origin,
+		                         float tileLength, int nbTiles, int &first,
+		                         int &last);
+
+		/**
+		 * Solves the collision on the horizontal axis between a collidable and
+		 * the layer's tiles.
+		 * @param body Body to collide with the tiles.
+		 * @param layerPosition Position of the layer's upper left corner.
+		 * @param collisionDetails Structure containing information about the
+		 * collision.
+		 * @return True if a collision happened, false if not.
+		 */
+		bool solveXCollision(Collidable &body, const Vector2 &layerPosition,
+		                     CollisionDetails &collisionDetails) const;
+
+		/**
+		 * Solves the collision on the vertical axis between a collidable and
+		 * the layer's tiles.
+		 * @param body Body to collide with the tiles.
+		 * @param layerPosition Position of the layer's upper left corner.
+		 * @param collisionDetails Structure containing information about the
+		 * collision.
+		 * @return True if a collision happened, false if not.
+		 */
+		bool solveYCollision(Collidable &body, const Vector2 &layerPosition,
+		                     CollisionDetails &collisionDetails) const;
+
 		/**
 		 * Constructor.
 		 * @param newName Name of the tile layer. Can be empty.
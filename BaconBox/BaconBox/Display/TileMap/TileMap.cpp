@@ -161,6 +161,10 @@ namespace BaconBox {
 		tileSize.y = newTileHeight;
 	}
 
+	const TileMap::TilesetContainer &TileMap::getTilesets() const {
+		return tilesets;
+	}
+
 	const Tileset *TileMap::getTileset(unsigned int tileId) const {
 		TilesetMapByTileId::const_iterator found = tilesetsByTileId.find(tileId);
 
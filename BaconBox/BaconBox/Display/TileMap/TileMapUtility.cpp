@@ -13,12 +13,52 @@ namespace BaconBox {
 	const std::string TileMapUtility::DEFAULT_FRAME_NAME("defaultFrame");
 	const std::string TileMapUtility::SPRITE_TYPE_NAME("Sprite");
 	const std::string TileMapUtility::INANIMATE_SPRITE_TYPE_NAME("InanimateSprite");
+	const std::string TileMapUtility::TILE_ANIMATION_NAME("tile");
 
 	static const PropertyMap::key_type::value_type TRUE_CHAR = '1';
 	static const PropertyMap::key_type::value_type FALSE_CHAR = '0';
 	static const PropertyMap::key_type FRAME_START("frame[");
 	static const PropertyMap::key_type ANIMATION_START("animation[");
 
+	/**
+	 * Reads a list of values written between brackets and separated by
+	 * commas (for example "[1, 2, 3]").
+	 * @param value String containing the list.
+	 * @param result Vector in which to write the values read. Not modified
+	 * if the string isn't a valid list.
+	 * @return True if the string was a valid list, false if not.
+	 */
+	template <typename T>
+	static bool readList(const std::string &value, std::vector<T> &result) {
+		std::string tmp(value);
+		StringHelper::trim(tmp);
+
+		if (tmp.size() >= 2 &&
+		    *tmp.begin() == '[' &&
+		    *tmp.rbegin() == ']') {
+			tmp.erase(tmp.begin());
+			tmp.erase(tmp.end() - 1);
+			std::list<std::string> indexes;
+			StringHelper::tokenize(tmp, indexes, ",");
+
+			result.assign(indexes.size(), T());
+
+			std::list<std::string>::const_iterator i = indexes.begin();
+			typename std::vector<T>::size_type i2 = 0;
+
+			while (i != indexes.end()) {
+				StringHelper::fromString(*i, result[i2]);
+				++i;
+				++i2;
+			}
+
+			return true;
+
+		} else {
+			return false;
+		}
+	}
+
 	struct BoolCharPredicate {
 		bool operator()(const PropertyMap::key_type::value_type &a) const {
 			return a == TRUE_CHAR || a == FALSE_CHAR;
@@ -54,9 +94,6 @@ namespace BaconBox {
 		static const PropertyMap::key_type VERTICAL_DRAG("verticalDrag");
 		static const float VERTICAL_DRAG_DEFAULT_VALUE = 0.0f;
 
-		static const PropertyMap::key_type COLLIDABLE_SIDES("collidableSides");
-		static const FlagSet<Side> COLLIDABLE_SIDES_DEFAULT_VALUE(FlagSet<Side>(Side::TOP) | FlagSet<Side>(Side::BOTTOM) | FlagSet<Side>(Side::LEFT) | FlagSet<Side>(Side::RIGHT));
-
 		static const PropertyMap::key_type ELASTICITY("elasticity");
 		static const float ELASTICITY_DEFAULT_VALUE = 0.0f;
 
@@ -180,19 +217,7 @@ namespace BaconBox {
 		}
 
 		// We read the collidable sides.
-		found = properties.find(COLLIDABLE_SIDES);
-
-		if (found != properties.end() &&
-		    found->second.size() == 4 &&
-		    AlgorithmHelper::allOf(found->second.begin(), found->second.end(), BoolCharPredicate())) {
-			collidable.getCollidableSides().set(Side::TOP, found->second[0] == TRUE_CHAR);
-			collidable.getCollidableSides().set(Side::BOTTOM, found->second[1] == TRUE_CHAR);
-			collidable.getCollidableSides().set(Side::LEFT, found->second[2] == TRUE_CHAR);
-			collidable.getCollidableSides().set(Side::RIGHT, found->second[3] == TRUE_CHAR);
-
-		} else {
-			collidable.getCollidableSides() = COLLIDABLE_SIDES_DEFAULT_VALUE;
-		}
+		collidable.getCollidableSides() = readCollidableSides(properties);
 
 		// We read the elasticity.
 		found = properties.find(ELASTICITY);
@@ -437,33 +462,44 @@ namespace BaconBox {
 		PropertyMap::const_iterator found = properties.find(ANIMATION_START + animationName + ANIMATION_FRAMES_END);
 
 		if (found != properties.end()) {
-			std::string tmp(found->second);
-			StringHelper::trim(tmp);
-
-			if (tmp.size() >= 2 &&
-			    *tmp.begin() == '[' &&
-			    *tmp.rbegin() == ']') {
-				tmp.erase(tmp.begin());
-				tmp.erase(tmp.end() - 1);
-				std::list<std::string> indexes;
-				StringHelper::tokenize(tmp, indexes, ",");
-
-				result.resize(indexes.size(), 0u);
-
-				std::list<std::string>::const_iterator i = indexes.begin();
-				std::vector<unsigned int>::size_type i2 = 0;
-
-				while (i != indexes.end()) {
-					StringHelper::fromString(*i, result[i2]);
-					++i;
-					++i2;
-				}
-			}
+			readList(found->second, result);
+		}
+
+		return result;
+	}
+
+	const std::vector<double> TileMapUtility::readAnimationDurations(const PropertyMap &properties,
+	                                                                 const std::string &animationName,
+	                                                                 std::vector<double>::size_type nbFrames) {
+		static const PropertyMap::key_type ANIMATION_DURATIONS_END("].durations");
+
+		std::vector<double> result;
+
+		PropertyMap::const_iterator found = properties.find(ANIMATION_START + animationName + ANIMATION_DURATIONS_END);
+
+		// We make sure there is a duration for each frame.
+		if (found == properties.end() || !readList(found->second, result) ||
+		    result.size() != nbFrames) {
+			result.assign(nbFrames, TileMapUtility::readAnimationTimePerFrame(properties, animationName));
 		}
 
 		return result;
 	}
 
+	bool TileMapUtility::readTileAnimation(const PropertyMap &properties,
+	                                       TileAnimation &result) {
+		static const PropertyMap::key_type TILE_ANIMATION_FRAMES(ANIMATION_START + TILE_ANIMATION_NAME + "].frames");
+
+		if (properties.find(TILE_ANIMATION_FRAMES) != properties.end()) {
+			result.frames = TileMapUtility::readAnimationFrames(properties, TILE_ANIMATION_NAME);
+			result.durations = TileMapUtility::readAnimationDurations(properties, TILE_ANIMATION_NAME, result.frames.size());
+			return !result.frames.empty();
+
+		} else {
+			return false;
+		}
+	}
+
 	const AnimationDefinition TileMapUtility::readAnimation(const PropertyMap &properties,
 	                                                        const std::string &animation) {
 		return AnimationDefinition(TileMapUtility::readAnimationFrames(properties, animation),
@@ -533,6 +569,37 @@ namespace BaconBox {
 		return result;
 	}
 
+	const FlagSet<Side> TileMapUtility::readCollidableSides(const PropertyMap &properties) {
+		static const PropertyMap::key_type COLLIDABLE_SIDES("collidableSides");
+
+		PropertyMap::const_iterator found = properties.find(COLLIDABLE_SIDES);
+
+		FlagSet<Side> result;
+
+		if (found != properties.end() &&
+		    found->second.size() == 4 &&
+		    AlgorithmHelper::allOf(found->second.begin(), found->second.end(), BoolCharPredicate())) {
+			result.set(Side::TOP, found->second[0] == TRUE_CHAR);
+			result.set(Side::BOTTOM, found->second[1] == TRUE_CHAR);
+			result.set(Side::LEFT, found->second[2] == TRUE_CHAR);
+			result.set(Side::RIGHT, found->second[3] == TRUE_CHAR);
+
+		} else {
+			result = Collidable::ALL_SIDES;
+		}
+
+		return result;
+	}
+
+	bool TileMapUtility::readSolid(const PropertyMap &properties) {
+		static const PropertyMap::key_type SOLID("solid");
+
+		PropertyMap::const_iterator found = properties.find(SOLID);
+
+		return found != properties.end() && found->second.size() == 1 &&
+		       found->second[0] == TRUE_CHAR;
+	}
+
 	void TileMapUtility::readZ(const PropertyMap &properties,
 	                           Orderable &orderable) {
 		PropertyMap::const_iterator found = properties.find("z");
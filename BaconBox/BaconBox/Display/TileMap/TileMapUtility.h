@@ -15,6 +15,9 @@
 #include "BaconBox/Display/Color.h"
 #include "BaconBox/Display/FrameArray.h"
 #include "BaconBox/Display/Animatable.h"
+#include "BaconBox/Display/TileMap/TileAnimation.h"
+#include "BaconBox/Helper/FlagSet.h"
+#include "BaconBox/Side.h"
 
 namespace BaconBox {
 	class Collidable;
@@ -43,6 +46,9 @@ namespace BaconBox {
 		/// Used to identify inanimate sprites.
 		static const std::string INANIMATE_SPRITE_TYPE_NAME;
 
+		/// Name of the animation read from a tileset's tile properties.
+		static const std::string TILE_ANIMATION_NAME;
+
 		/// Value to use by default if the default frame is not specified.
 		static const unsigned int DEFAULT_FRAME = 0u;
 
@@ -149,6 +155,33 @@ namespace BaconBox {
 		static const std::vector<unsigned int> readAnimationFrames(const PropertyMap &properties,
 		                                                           const std::string &animationName);
 
+		/**
+		 * Reads the duration of each frame of an animation from a property
+		 * map. Uses the "durations" property (for example "[0.1, 0.2]") if
+		 * there is one, otherwise uses the animation's time per frame for
+		 * every frame.
+		 * @param properties Properties to use to read the animation details.
+		 * @param animationName Name of the animation to read.
+		 * @param nbFrames Number of frames in the animation.
+		 * @return Vector containing the duration of each frame (in seconds).
+		 */
+		static const std::vector<double> readAnimationDurations(const PropertyMap &properties,
+		                                                        const std::string &animationName,
+		                                                        std::vector<double>::size_type nbFrames);
+
+		/**
+		 * Reads a tileset's tile animation from the tile's properties. The
+		 * animation is named TILE_ANIMATION_NAME and its frames are tiles
+		 * relative to the tileset's first tile, for example:
+		 * "animation[tile].frames" = "[4, 5, 6]" and
+		 * "animation[tile].durations" = "[0.2, 0.2, 0.4]".
+		 * @param properties Tile properties to read the animation from.
+		 * @param result Tile animation in which to write the animation read.
+		 * @return True if the tile is animated, false if not.
+		 */
+		static bool readTileAnimation(const PropertyMap &properties,
+		                              TileAnimation &result);
+
 		/**
 		 * Reads the animation from a property map.
 		 * @param properties Properties to use to read the animation details.
@@ -192,6 +225,22 @@ namespace BaconBox {
 		 */
 		static unsigned int readDefaultFrame(const PropertyMap &properties);
 
+		/**
+		 * Reads the collidable sides from a property map.
+		 * @param properties Properties to read the collidable sides from.
+		 * @return Collidable sides read. All sides are collidable if the
+		 * property is not found or is invalid.
+		 */
+		static const FlagSet<Side> readCollidableSides(const PropertyMap &properties);
+
+		/**
+		 * Reads wether or not a tile is solid from a tile's properties.
+		 * @param properties Properties of the tile.
+		 * @return True if the tile is solid, false if not or if the property
+		 * was not found.
+		 */
+		static bool readSolid(const PropertyMap &properties);
+
 		/**
 		 * Reads the z for layers.
 		 * @param properties Properties to read the z from.
@@ -7,6 +7,7 @@
 #include "BaconBox/Display/TileMap/TileMap.h"
 #include "BaconBox/Display/TextureInformation.h"
 #include "BaconBox/Display/TileMap/TileIdRange.h"
+#include "BaconBox/Display/TileMap/TileMapUtility.h"
 
 namespace BaconBox {
 	void Tileset::setName(const std::string &newName) {
@@ -105,6 +106,8 @@ namespace BaconBox {
 
 	PropertyMap *Tileset::getTileProperties(unsigned int tileId) {
 		if (TileIdRange(firstTileId, firstTileId + tileTextureCoordinates.size()).isWithinRange(tileId)) {
+			// The properties might be modified through the pointer.
+			dirtyTileSides = true;
 			return &tileProperties[TileIdRange::withoutFlipFlags(tileId)];
 
 		} else {
@@ -128,6 +131,55 @@ namespace BaconBox {
 		}
 	}
 
+	bool Tileset::isTileSideSolid(unsigned int tileId, Side side) const {
+		if (isIdInTileset(tileId)) {
+			if (dirtyTileSides) {
+				refreshTileSides();
+			}
+
+			// We find which side of the original tile is displayed at the
+			// requested side. Flips are undone in the reverse order Tiled
+			// applies them: diagonal, horizontal and then vertical.
+			if (TileIdRange::isFlippedVertically(tileId)) {
+				if (side == Side::TOP) {
+					side = Side::BOTTOM;
+
+				} else if (side == Side::BOTTOM) {
+					side = Side::TOP;
+				}
+			}
+
+			if (TileIdRange::isFlippedHorizontally(tileId)) {
+				if (side == Side::LEFT) {
+					side = Side::RIGHT;
+
+				} else if (side == Side::RIGHT) {
+					side = Side::LEFT;
+				}
+			}
+
+			if (TileIdRange::isFlippedDiagonally(tileId)) {
+				if (side == Side::LEFT) {
+					side = Side::TOP;
+
+				} else if (side == Side::TOP) {
+					side = Side::LEFT;
+
+				} else if (side == Side::RIGHT) {
+					side = Side::BOTTOM;
+
+				} else {
+					side = Side::RIGHT;
+				}
+			}
+
+			return tileSides[TileIdRange::withoutFlipFlags(tileId) - firstTileId].isSet(side);
+
+		} else {
+			return false;
+		}
+	}
+
 	Tileset::Tileset(const std::string &newName,
 	                 const TileMap &newParentMap,
 	                 TextureInformation *newTextureInformation,
@@ -139,7 +191,8 @@ namespace BaconBox {
 		parentMap(newParentMap), textureInformation(newTextureInformation),
 		tileSize(newTileSize), tileSpacing(newTileSpacing), margin(newMargin),
 		tileOffset(newTileOffset), firstTileId(newFirstTileId),
-		tileTextureCoordinates(), tileProperties() {
+		tileTextureCoordinates(), tileProperties(), tileSides(),
+		dirtyTileSides(true) {
 		initializeTextureCoordinates();
 	}
 
@@ -149,7 +202,8 @@ namespace BaconBox {
 		tileSpacing(src.tileSpacing), margin(src.margin),
 		tileOffset(src.tileOffset), firstTileId(src.firstTileId),
 		tileTextureCoordinates(src.tileTextureCoordinates),
-		tileProperties(src.tileProperties) {
+		tileProperties(src.tileProperties), tileSides(src.tileSides),
+		dirtyTileSides(src.dirtyTileSides) {
 	}
 
 	Tileset::~Tileset() {
@@ -181,6 +235,20 @@ namespace BaconBox {
 		}
 	}
 
+	void Tileset::refreshTileSides() const {
+		tileSides.assign(tileTextureCoordinates.size(), FlagSet<Side>());
+
+		for (TileProperties::const_iterator i = tileProperties.begin();
+		     i != tileProperties.end(); ++i) {
+			if (i->first >= firstTileId && i->first - firstTileId < tileSides.size() &&
+			    TileMapUtility::readSolid(i->second)) {
+				tileSides[i->first - firstTileId] = TileMapUtility::readCollidableSides(i->second);
+			}
+		}
+
+		dirtyTileSides = false;
+	}
+
 	void Tileset::initializeTextureCoordinates() {
 		// We make sure we have a valid texture information.
 		if (textureInformation) {
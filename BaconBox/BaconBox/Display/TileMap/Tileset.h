@@ -8,11 +8,14 @@
 #include <string>
 #include <deque>
 #include <map>
+#include <vector>
 
 #include "BaconBox/Vector2.h"
 #include "BaconBox/Display/TileMap/TileMapEntity.h"
 #include "BaconBox/Display/TextureCoordinates.h"
 #include "BaconBox/Display/TileMap/PropertyMap.h"
+#include "BaconBox/Helper/FlagSet.h"
+#include "BaconBox/Side.h"
 
 namespace BaconBox {
 	struct TextureInformation;
@@ -30,6 +33,9 @@ namespace BaconBox {
 		
 		typedef std::map<unsigned int, PropertyMap> TileProperties;
 
+		/// Container used to cache the tiles' collidable sides.
+		typedef std::vector<FlagSet<Side> > TileSides;
+
 		/**
 		 * Sets the name of the tileset. Does nothing if parent tile map already
 		 * has a tileset with that name.
@@ -160,7 +166,18 @@ namespace BaconBox {
 		 * @see BaconBox::Tileset::tileProperties
 		 */
 		const PropertyMap *getTileProperties(unsigned int tileId) const;
-		
+
+		/**
+		 * Checks if a side of a tile stops collidables. A tile is solid when
+		 * its "solid" property is set to "1", its "collidableSides" property
+		 * then tells which of its sides are solid. The tile id's flip flags
+		 * are taken into account.
+		 * @param tileId Id of the tile to check.
+		 * @param side Side of the tile to check, as it is displayed.
+		 * @return True if the side is solid, false if not or if the tile id
+		 * does not fit in the tileset.
+		 */
+		bool isTileSideSolid(unsigned int tileId, Side side) const;
 	private:
 
 		/**
@@ -211,6 +228,11 @@ namespace BaconBox {
 		 */
 		void initializeTextureCoordinates();
 
+		/**
+		 * Reads the collidable sides of all the tiles from their properties.
+		 */
+		void refreshTileSides() const;
+
 		/// Pointer to the tile map that owns the tileset.
 		const TileMap &parentMap;
 
@@ -246,6 +268,18 @@ namespace BaconBox {
 		
 		/// Map containing the properties of the tiles.
 		TileProperties tileProperties;
+
+		/**
+		 * Solid sides of each tile, read from the tiles' properties. Empty
+		 * for tiles that are not solid.
+		 */
+		mutable TileSides tileSides;
+
+		/**
+		 * Set to true when the tiles' properties might have been changed and
+		 * the tile sides need to be read again.
+		 */
+		mutable bool dirtyTileSides;
 	};
 }
 
@@ -2,14 +2,16 @@
 
 #include <cstring>
 #include <cstdlib>
+#include <cctype>
 
 #include <fstream>
 #include <sstream>
 #include <algorithm>
 #include <list>
+#include <vector>
+#include <utility>
 
 #include <tinyxml.h>
-#include <zlib.h>
 
 #include "BaconBox/Display/TileMap/TileMap.h"
 #include "BaconBox/ResourceManager.h"
@@ -18,13 +20,15 @@
 #include "BaconBox/Display/TileMap/TileLayer.h"
 #include "BaconBox/Display/TileMap/ObjectLayer.h"
 #include "BaconBox/Helper/Base64.h"
-#include "BaconBox/Helper/Compression.h"
+#include "BaconBox/Helper/Inflater.h"
+#include "BaconBox/Helper/BitHelper.h"
 #include "BaconBox/Helper/StringHelper.h"
 #include "BaconBox/Display/TileMap/TileMapObject.h"
 #include "BaconBox/Display/TileMap/LineObject.h"
 #include "BaconBox/Display/TileMap/PolygonObject.h"
 #include "BaconBox/Display/TileMap/RectangleObject.h"
 #include "BaconBox/Display/TileMap/TileObject.h"
+#include "BaconBox/Display/TileMap/BinaryTileMapFormat.h"
 
 namespace BaconBox {
 	const char *NAME_ATTRIBUTE = "name";
@@ -35,8 +39,14 @@ namespace BaconBox {
 	const std::string IMAGE_VALUE("image");
 	const std::string PROPERTIES_VALUE("properties");
 	const char *TILE_ID_NAME = "gid";
+	const char *TOO_MUCH_DATA_MESSAGE = "TmxTileMapReader: Too much tile layer data, the layer has more tile id's than the map has tiles.";
+	const char *NOT_ENOUGH_DATA_MESSAGE = "TmxTileMapReader: Not enough tile layer data, the layer has fewer tile id's than the map has tiles.";
 	typedef std::list<std::string> TokenList;
 
+	/// Size of the buffer base 64 data is decoded in before being
+	/// decompressed. Must be a multiple of 3.
+	const std::string::size_type BASE_64_BUFFER_SIZE = 3072;
+
 	TmxTileMapReader::TmxTileMapReader() : TileMapReader(), errorMessage() {
 	}
 
@@ -67,15 +77,25 @@ namespace BaconBox {
 
 	const std::string readNameFromElement(const TiXmlElement &element);
 
+	unsigned int readColorFromString(const char *str);
+
 	TextureInformation *loadTextureFromElement(const std::string &currentFolder,
 	                                           const TiXmlElement &element);
 
-	bool decodeCSV(const std::string &data, std::string &result,
-	               const TileCoordinate &expectedSize,
+	bool decodeTileLayerData(const TiXmlElement &dataElement,
+	                         const TileCoordinate &expectedSize,
+	                         TileLayer::DataContainer &result,
+	                         std::string &errorMessage);
+
+	bool decodeCSV(const char *data, TileLayer::DataContainer &result,
 	               std::string &errorMessage);
 
-	bool readDataFromElement(const TiXmlElement &element, std::string &result,
-	                         const TileCoordinate &expectedSize,
+	bool decodeBase64(const char *data, bool compressed,
+	                  TileLayer::DataContainer &result,
+	                  std::string &errorMessage);
+
+	bool readDataFromElement(const TiXmlElement &element,
+	                         TileLayer::DataContainer &result,
 	                         std::string &errorMessage);
 
 	void readLayerFromElement(const TiXmlElement &element,
@@ -392,12 +412,6 @@ namespace BaconBox {
 	                             TileMap *&map,
 	                             std::string &errorMessage) {
 		static const std::string DATA_VALUE("data");
-		static const char *ENCODING_NAME = "encoding";
-		static const char *CSV_ENCODING = "csv";
-		static const char *BASE_64_ENCODING = "base64";
-		static const char *COMPRESSION_NAME = "compression";
-		static const char *GZIP_COMPRESSION = "gzip";
-		static const char *ZLIB_COMPRESSION = "zlib";
 		TileLayer *newTileLayer = map->pushBackTileLayer(readNameFromElement(element));
 
 		readLayerFromElement(element, *newTileLayer);
@@ -412,104 +426,75 @@ namespace BaconBox {
 					addPropertiesFromElement(*(i->ToElement()), newTileLayer->getProperties());
 
 				} else if (i->ToElement()->Value() == DATA_VALUE) {
-					const TiXmlElement *dataElement = i->ToElement();
-					// We get the data.
-					const char *tmpData = dataElement->GetText();
-
-					std::string data;
-
-					// If we have text data.
-					if (tmpData) {
-						data.append(tmpData);
-						// We make sure to remove the white spaces at the
-						// beginning and at the end if necessary.
-						StringHelper::trim(data);
-						// We check if the data is encoded.
-						const char *tmpEncoding = dataElement->Attribute(ENCODING_NAME);
-
-						if (tmpEncoding) {
-							// We check the type of encoding.
-							if (!strcmp(CSV_ENCODING, tmpEncoding)) {
-								// Decode CSV
-								std::string encoded(data);
-
-								if (!decodeCSV(encoded, data, map->getSizeInTiles(),
-								               errorMessage)) {
-									delete map;
-									map = NULL;
-								}
+					TileLayer::DataContainer data;
 
-							} else if (!strcmp(BASE_64_ENCODING, tmpEncoding)) {
-								// Decode Base 64.
-								std::string encoded(data);
-								Base64::decode(encoded, data);
-
-								// We check if the data is compressed.
-								const char *tmpCompression = dataElement->Attribute(COMPRESSION_NAME);
-
-								if (tmpCompression) {
-									// We make sure the compression format is
-									// valid.
-									if (!strcmp(GZIP_COMPRESSION, tmpCompression) ||
-									    !strcmp(ZLIB_COMPRESSION, tmpCompression)) {
-										encoded = data;
-										Compression::decompress(encoded, data);
-
-									} else {
-										errorMessage = "TmxTileMapReader: Tile layer data compressed in an unknown format.";
-										delete map;
-										map = NULL;
-									}
-								}
-
-								// We make sure there is enough data.
-								if (data.size() / 4 != static_cast<std::string::size_type>(map->getWidthInTiles()) * static_cast<std::string::size_type>(map->getHeightInTiles())) {
-									errorMessage = "TmxTileMapReader: Tile layer data is not of the right size.";
-									delete map;
-									map = NULL;
-								}
-							}
-
-						}
+					// We decode the data and give it to the tile layer
+					// without copying it.
+					if (decodeTileLayerData(*i->ToElement(), map->getSizeInTiles(),
+					                        data, errorMessage)) {
+						newTileLayer->swapTileIds(data);
 
 					} else {
-						// We read the data from XML tags.
-						if (!readDataFromElement(*dataElement, data,
-						                         map->getSizeInTiles(),
-						                         errorMessage)) {
-							delete map;
-							map = NULL;
-						}
+						delete map;
+						map = NULL;
 					}
+				}
+			}
+		}
+	}
 
-					// We make sure the data was read successfully.
-					if (map) {
-						// We read the data and put it in the tile layer.
-						std::string::size_type index = 0;
-						int y = 0, x = 0;
+	bool decodeTileLayerData(const TiXmlElement &dataElement,
+	                         const TileCoordinate &expectedSize,
+	                         TileLayer::DataContainer &result,
+	                         std::string &errorMessage) {
+		static const char *ENCODING_NAME = "encoding";
+		static const char *CSV_ENCODING = "csv";
+		static const char *BASE_64_ENCODING = "base64";
+		static const char *COMPRESSION_NAME = "compression";
+		static const char *GZIP_COMPRESSION = "gzip";
+		static const char *ZLIB_COMPRESSION = "zlib";
+		bool success = true;
 
-						while (map && y < map->getHeightInTiles()) {
-							x = 0;
+		// The decoded tile id's go directly in their final storage.
+		result.assign(static_cast<TileLayer::DataContainer::size_type>(expectedSize.getX()) * static_cast<TileLayer::DataContainer::size_type>(expectedSize.getY()), 0u);
 
-							while (map && x < map->getWidthInTiles()) {
-								if (index < data.size()) {
-									newTileLayer->setTileId(x, y, *reinterpret_cast<unsigned int *>(&data[index]));
-									index += 4;
-									++x;
+		// We get the data.
+		const char *tmpData = dataElement.GetText();
 
-								} else {
-									errorMessage = "TmxTileMapReader: Too much tile layer data.";
-									delete map;
-									map = NULL;
-								}
-							}
+		// If we have text data.
+		if (tmpData) {
+			// We check if the data is encoded.
+			const char *tmpEncoding = dataElement.Attribute(ENCODING_NAME);
 
-							++y;
-						}
-					}
+			if (tmpEncoding && !strcmp(CSV_ENCODING, tmpEncoding)) {
+				success = decodeCSV(tmpData, result, errorMessage);
+
+			} else if (tmpEncoding && !strcmp(BASE_64_ENCODING, tmpEncoding)) {
+				// We check if the data is compressed.
+				const char *tmpCompression = dataElement.Attribute(COMPRESSION_NAME);
+
+				// We make sure the compression format is valid.
+				if (!tmpCompression || !strcmp(GZIP_COMPRESSION, tmpCompression) ||
+				    !strcmp(ZLIB_COMPRESSION, tmpCompression)) {
+					success = decodeBase64(tmpData, tmpCompression != NULL,
+					                       result, errorMessage);
+
+				} else {
+					errorMessage = "TmxTileMapReader: Tile layer data compressed in an unknown format.";
+					success = false;
 				}
+
+			} else {
+				errorMessage = "TmxTileMapReader: Tile layer data encoded in an unknown format.";
+				success = false;
 			}
+
+		} else {
+			// We read the data from XML tags.
+			success = readDataFromElement(dataElement, result, errorMessage);
 		}
+
+		return success;
 	}
 
 	void addObjectLayerFromElement(const TiXmlElement &element,
@@ -524,14 +509,7 @@ namespace BaconBox {
 		const char *tmpString = element.Attribute(COLOR_NAME);
 
 		if (tmpString) {
-			// We convert the hexadecimal color to an unsigned int.
-			std::stringstream ss;
-			std::string strColor(tmpString);
-			StringHelper::removeAll('#', strColor);
-			ss << std::hex << strColor.append("ff");
-			unsigned int tmpColor;
-			ss >> tmpColor;
-			newObjectLayer->setColor(Color(tmpColor));
+			newObjectLayer->setColor(Color(readColorFromString(tmpString)));
 		}
 
 		// We read the and the visibility of the object layer.
@@ -558,6 +536,17 @@ namespace BaconBox {
 		return (tmpName) ? (std::string(tmpName)) : (std::string());
 	}
 
+	unsigned int readColorFromString(const char *str) {
+		// We convert the hexadecimal color to an unsigned int.
+		std::stringstream ss;
+		std::string strColor(str);
+		StringHelper::removeAll('#', strColor);
+		ss << std::hex << strColor.append("ff");
+		unsigned int tmpColor = 0;
+		ss >> tmpColor;
+		return tmpColor;
+	}
+
 	TextureInformation *loadTextureFromElement(const std::string &currentFolder,
 	                                           const TiXmlElement &element) {
 		static const char *SOURCE_NAME = "source";
@@ -576,14 +565,7 @@ namespace BaconBox {
 			tmpString = element.Attribute(TRANSPARENT_COLOR_NAME);
 
 			if (tmpString) {
-				// We convert the hexadecimal color to an unsigned int.
-				std::stringstream ss;
-				std::string strColor(tmpString);
-				StringHelper::removeAll('#', strColor);
-				ss << std::hex << strColor.append("ff");
-				unsigned int tmpColor;
-				ss >> tmpColor;
-				Color transparentColor(tmpColor);
+				Color transparentColor(readColorFromString(tmpString));
 
 				result = ResourceManager::loadTextureWithColorKey(textureKey,
 				                                                  texturePath,
@@ -598,45 +580,120 @@ namespace BaconBox {
 		return result;
 	}
 
-	bool decodeCSV(const std::string &data, std::string &result,
-	               const TileCoordinate &expectedSize,
+	bool decodeCSV(const char *data, TileLayer::DataContainer &result,
 	               std::string &errorMessage) {
-		TokenList tiles;
-		StringHelper::tokenize(data, tiles, std::string(","), true);
+		TileLayer::DataContainer::size_type index = 0;
 		bool success = true;
 
-		if (tiles.size() == static_cast<TokenList::size_type>(expectedSize.getX()) *
-		    static_cast<TokenList::size_type>(expectedSize.getY())) {
-			result.resize(tiles.size() * 4);
-			std::string::size_type index = 0;
+		// We read the numbers directly from the characters.
+		while (success && *data) {
+			if (*data >= '0' && *data <= '9') {
+				unsigned int tileId = 0;
+
+				while (*data >= '0' && *data <= '9') {
+					tileId = tileId * 10u + static_cast<unsigned int>(*data - '0');
+					++data;
+				}
 
-			for (TokenList::const_iterator i = tiles.begin(); i != tiles.end();
-			     ++i) {
-				*reinterpret_cast<unsigned int *>(&result[index]) = static_cast<unsigned int>(strtoul(i->c_str(), NULL, 10));
-				index += 4;
+				if (index < result.size()) {
+					result[index++] = tileId;
+
+				} else {
+					success = false;
+					errorMessage = TOO_MUCH_DATA_MESSAGE;
+				}
+
+			} else if (*data == ',' || isspace(static_cast<unsigned char>(*data))) {
+				++data;
+
+			} else {
+				success = false;
+				errorMessage = "TmxTileMapReader: CSV layer contains an invalid character.";
 			}
+		}
 
-		} else {
+		if (success && index < result.size()) {
 			success = false;
-			errorMessage = "TmxTileMapReader: CSV layer not of the right size.";
+			errorMessage = NOT_ENOUGH_DATA_MESSAGE;
 		}
 
 		return success;
 	}
 
-	bool readDataFromElement(const TiXmlElement &element, std::string &result,
-	                         const TileCoordinate &expectedSize,
-	                         std::string &errorMessage) {
-		static const std::string TILE_VALUE("tile");
+	bool decodeBase64(const char *data, bool compressed,
+	                  TileLayer::DataContainer &result,
+	                  std::string &errorMessage) {
+		std::string::size_type size = strlen(data);
+		char *output = (result.empty()) ? (NULL) : (reinterpret_cast<char *>(&result[0]));
+		std::string::size_type outputSize = result.size() * sizeof(unsigned int);
+		std::string::size_type nbRead = 0;
 		bool success = true;
 
-		std::string::size_type tmpSize = 4 * static_cast<std::string::size_type>(expectedSize.getX()) * static_cast<std::string::size_type>(expectedSize.getY());
+		if (compressed) {
+			// We decode the base 64 in small parts that are decompressed
+			// directly in the result.
+			Inflater inflater(output, outputSize);
+			char buffer[BASE_64_BUFFER_SIZE];
+			std::string::size_type index = 0, nbDecoded = 1;
+
+			while (success && nbDecoded > 0 && index < size && !inflater.isFinished()) {
+				nbDecoded = Base64::decode(data + index, size - index, buffer,
+				                           BASE_64_BUFFER_SIZE, nbRead);
+				index += nbRead;
+				success = inflater.write(buffer, nbDecoded);
+			}
+
+			if (!success && inflater.getNbWritten() == outputSize) {
+				// The decompressed data didn't fit in the result.
+				errorMessage = TOO_MUCH_DATA_MESSAGE;
+
+			} else if (!success || !inflater.isFinished()) {
+				success = false;
+				errorMessage = "TmxTileMapReader: Tile layer data is not valid zlib or gzip compressed data.";
+
+			} else if (inflater.getNbWritten() < outputSize) {
+				success = false;
+				errorMessage = NOT_ENOUGH_DATA_MESSAGE;
+			}
+
+		} else {
+			// We decode the base 64 directly in the result, then we make sure
+			// only padding is left.
+			if (Base64::decode(data, size, output, outputSize, nbRead) < outputSize) {
+				success = false;
+				errorMessage = NOT_ENOUGH_DATA_MESSAGE;
+
+			} else {
+				while (success && nbRead < size) {
+					success = data[nbRead] == '=' || isspace(static_cast<unsigned char>(data[nbRead]));
+					++nbRead;
+				}
+
+				if (!success) {
+					errorMessage = TOO_MUCH_DATA_MESSAGE;
+				}
+			}
+		}
+
+		// The tile id's are stored in little endian.
+		if (success && BitHelper::isBigEndian()) {
+			for (TileLayer::DataContainer::iterator i = result.begin(); i != result.end(); ++i) {
+				BitHelper::endianSwap(*i);
+			}
+		}
 
-		result.resize(tmpSize);
+		return success;
+	}
+
+	bool readDataFromElement(const TiXmlElement &element,
+	                         TileLayer::DataContainer &result,
+	                         std::string &errorMessage) {
+		static const std::string TILE_VALUE("tile");
+		bool success = true;
 
 		// We read all the child tile nodes.
 		const TiXmlNode *i = NULL;
-		std::string::size_type index = 0;
+		TileLayer::DataContainer::size_type index = 0;
 
 		const char *tmpTileId;
 
@@ -646,18 +703,22 @@ namespace BaconBox {
 				tmpTileId = i->ToElement()->Attribute(TILE_ID_NAME);
 
 				if (tmpTileId) {
-					if (index < tmpSize) {
-						*reinterpret_cast<unsigned int *>(&result[index]) = static_cast<unsigned int>(strtoul(tmpTileId, NULL, 10));
-						index += 4;
+					if (index < result.size()) {
+						result[index++] = static_cast<unsigned int>(strtoul(tmpTileId, NULL, 10));
 
 					} else {
 						success = false;
-						errorMessage = "TmxTileMapReader: Too many tile tags for the tile data for the tile layer.";
+						errorMessage = TOO_MUCH_DATA_MESSAGE;
 					}
 				}
 			}
 		}
 
+		if (success && index < result.size()) {
+			success = false;
+			errorMessage = NOT_ENOUGH_DATA_MESSAGE;
+		}
+
 		return success;
 	}
 
@@ -819,6 +880,411 @@ namespace BaconBox {
 		}
 	}
 
+	namespace {
+		/**
+		 * Writes the values of a binary tile map in little endian.
+		 * @see BaconBox::BinaryTileMapFormat
+		 */
+		class BinaryWriter {
+		public:
+			BinaryWriter() : buffer() {
+			}
+
+			void write(uint32_t value) {
+				for (int i = 0; i < 4; ++i) {
+					buffer.push_back(static_cast<char>((value >> (i * 8)) & 0xffu));
+				}
+			}
+
+			void write(float value) {
+				uint32_t tmpValue = 0;
+				std::memcpy(&tmpValue, &value, sizeof(float));
+				write(tmpValue);
+			}
+
+			void write(const std::string &value) {
+				write(static_cast<uint32_t>(value.size()));
+				buffer.append(value);
+
+				// We keep the next values aligned on 4 bytes.
+				buffer.append((4u - value.size() % 4u) % 4u, '\0');
+			}
+
+			void write(const PropertyMap &properties) {
+				write(static_cast<uint32_t>(properties.size()));
+
+				for (PropertyMap::const_iterator i = properties.begin();
+				     i != properties.end(); ++i) {
+					write(i->first);
+					write(i->second);
+				}
+			}
+
+			bool save(const std::string &fileName) const {
+				std::ofstream file(fileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+				file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+				return file.good();
+			}
+		private:
+			std::string buffer;
+		};
+
+		void readPropertiesFromChildren(const TiXmlElement &element,
+		                                PropertyMap &properties) {
+			const TiXmlNode *i = NULL;
+
+			while ((i = element.IterateChildren(i))) {
+				if (i->ToElement() && i->ToElement()->ValueStr() == PROPERTIES_VALUE) {
+					addPropertiesFromElement(*i->ToElement(), properties);
+				}
+			}
+		}
+
+		bool writeTilesetFromElement(const TiXmlElement &element,
+		                             BinaryWriter &writer,
+		                             std::string &errorMessage) {
+			static const char *TILE_SPACING_NAME = "spacing";
+			static const char *MARGIN_NAME = "margin";
+			static const char *SOURCE_NAME = "source";
+			static const char *TRANSPARENT_COLOR_NAME = "trans";
+			static const char *ID_NAME = "id";
+			static const std::string TILE_VALUE("tile");
+			double tmpTileWidth = 0.0, tmpTileHeight = 0.0;
+			double tmpTileSpacing = 0.0, tmpMargin = 0.0;
+
+			if (!element.Attribute(TILE_WIDTH_NAME, &tmpTileWidth)) {
+				errorMessage = "TmxTileMapReader: Tileset does not have a tilewidth defined. Make sure it does.";
+				return false;
+			}
+
+			if (!element.Attribute(TILE_HEIGHT_NAME, &tmpTileHeight)) {
+				errorMessage = "TmxTileMapReader: Tileset does not have a tileheight defined. Make sure it does.";
+				return false;
+			}
+
+			element.Attribute(TILE_SPACING_NAME, &tmpTileSpacing);
+			element.Attribute(MARGIN_NAME, &tmpMargin);
+
+			// We find the tileset's image.
+			const TiXmlNode *i = NULL;
+			const char *source = NULL;
+			const char *transparentColor = NULL;
+
+			while (!source && (i = element.IterateChildren(i))) {
+				if (i->ToElement() && i->ToElement()->Value() == IMAGE_VALUE) {
+					source = i->ToElement()->Attribute(SOURCE_NAME);
+					transparentColor = i->ToElement()->Attribute(TRANSPARENT_COLOR_NAME);
+				}
+			}
+
+			if (!source) {
+				errorMessage = "TmxTileMapReader: Could not find any valid texture for the tileset. Make sure all tilesets have a valid <image>.";
+				return false;
+			}
+
+			writer.write(readNameFromElement(element));
+			writer.write(std::string(source));
+			writer.write(static_cast<uint32_t>((transparentColor) ? (1u) : (0u)));
+			writer.write(static_cast<uint32_t>((transparentColor) ? (readColorFromString(transparentColor)) : (0u)));
+			writer.write(static_cast<float>(tmpTileWidth));
+			writer.write(static_cast<float>(tmpTileHeight));
+			writer.write(static_cast<float>(tmpTileSpacing));
+			writer.write(static_cast<float>(tmpMargin));
+
+			PropertyMap properties;
+			readPropertiesFromChildren(element, properties);
+			writer.write(properties);
+
+			// We read the tiles' properties.
+			std::vector<std::pair<uint32_t, PropertyMap> > tiles;
+			i = NULL;
+
+			while ((i = element.IterateChildren(i))) {
+				int tmpTileId = 0;
+
+				if (i->ToElement() && i->ToElement()->ValueStr() == TILE_VALUE &&
+				    i->ToElement()->Attribute(ID_NAME, &tmpTileId)) {
+					tiles.push_back(std::make_pair(static_cast<uint32_t>(tmpTileId), PropertyMap()));
+					readPropertiesFromChildren(*i->ToElement(), tiles.back().second);
+				}
+			}
+
+			writer.write(static_cast<uint32_t>(tiles.size()));
+
+			for (std::vector<std::pair<uint32_t, PropertyMap> >::const_iterator j = tiles.begin();
+			     j != tiles.end(); ++j) {
+				writer.write(j->first);
+				writer.write(j->second);
+			}
+
+			return true;
+		}
+
+		void writeLayerFromElement(BinaryTileMapFormat::LayerType layerType,
+		                           const TiXmlElement &element,
+		                           BinaryWriter &writer) {
+			double tmpOpacity = 1.0;
+			element.Attribute(OPACITY_NAME, &tmpOpacity);
+			int tmpVisible = 1;
+			element.Attribute(VISIBLE_NAME, &tmpVisible);
+
+			writer.write(static_cast<uint32_t>(layerType));
+			writer.write(readNameFromElement(element));
+			writer.write(static_cast<uint32_t>(tmpOpacity * static_cast<double>(Color::MAX_COMPONENT_VALUE)));
+			writer.write(static_cast<uint32_t>((tmpVisible) ? (1u) : (0u)));
+
+			PropertyMap properties;
+			readPropertiesFromChildren(element, properties);
+			writer.write(properties);
+		}
+
+		bool writeTileLayerFromElement(const TiXmlElement &element,
+		                               const TileCoordinate &sizeInTiles,
+		                               BinaryWriter &writer,
+		                               std::string &errorMessage) {
+			static const std::string DATA_VALUE("data");
+			writeLayerFromElement(BinaryTileMapFormat::TILE_LAYER, element, writer);
+
+			// Layers without data are empty.
+			TileLayer::DataContainer data(static_cast<TileLayer::DataContainer::size_type>(sizeInTiles.getX()) * static_cast<TileLayer::DataContainer::size_type>(sizeInTiles.getY()), 0u);
+			const TiXmlNode *i = NULL;
+
+			while ((i = element.IterateChildren(i))) {
+				if (i->ToElement() && i->ToElement()->ValueStr() == DATA_VALUE &&
+				    !decodeTileLayerData(*i->ToElement(), sizeInTiles, data,
+				                         errorMessage)) {
+					return false;
+				}
+			}
+
+			for (TileLayer::DataContainer::const_iterator j = data.begin();
+			     j != data.end(); ++j) {
+				writer.write(static_cast<uint32_t>(*j));
+			}
+
+			return true;
+		}
+
+		void writeObjectFromElement(const TiXmlElement &element,
+		                            BinaryWriter &writer) {
+			static const std::string POLYGON_VALUE("polygon");
+			static const std::string LINE_VALUE("polyline");
+			static const char *POINT_NAME = "points";
+			static const char *X_ATTRIBUTE = "x";
+			static const char *Y_ATTRIBUTE = "y";
+			static const char *WIDTH_NAME = "width";
+			static const char *HEIGHT_NAME = "height";
+			double tmpX = 0.0, tmpY = 0.0;
+			element.Attribute(X_ATTRIBUTE, &tmpX);
+			element.Attribute(Y_ATTRIBUTE, &tmpY);
+
+			// We determine the type of the object the same way the objects
+			// are read.
+			const char *tmpTileId = element.Attribute(TILE_ID_NAME);
+			const TiXmlElement *vertexElement = NULL;
+			BinaryTileMapFormat::ObjectType objectType = BinaryTileMapFormat::RECTANGLE_OBJECT;
+
+			if (tmpTileId) {
+				objectType = BinaryTileMapFormat::TILE_OBJECT;
+
+			} else {
+				const TiXmlNode *i = NULL;
+
+				while (!vertexElement && (i = element.IterateChildren(i))) {
+					if (i->ToElement()) {
+						if (i->ToElement()->ValueStr() == POLYGON_VALUE) {
+							vertexElement = i->ToElement();
+							objectType = BinaryTileMapFormat::POLYGON_OBJECT;
+
+						} else if (i->ToElement()->ValueStr() == LINE_VALUE) {
+							vertexElement = i->ToElement();
+							objectType = BinaryTileMapFormat::LINE_OBJECT;
+						}
+					}
+				}
+			}
+
+			writer.write(static_cast<uint32_t>(objectType));
+			writer.write(readNameFromElement(element));
+			writer.write(readTypeFromElement(element));
+			writer.write(static_cast<float>(tmpX));
+			writer.write(static_cast<float>(tmpY));
+
+			if (objectType == BinaryTileMapFormat::TILE_OBJECT) {
+				writer.write(static_cast<uint32_t>(strtoul(tmpTileId, NULL, 10)));
+
+			} else if (vertexElement) {
+				StandardVertexArray vertices;
+				const char *tmpPoints = vertexElement->Attribute(POINT_NAME);
+
+				if (tmpPoints) {
+					readVerticesFromString(std::string(tmpPoints), vertices);
+				}
+
+				writer.write(static_cast<uint32_t>(vertices.getNbVertices()));
+
+				for (StandardVertexArray::SizeType i = 0; i < vertices.getNbVertices(); ++i) {
+					writer.write(vertices[i].x);
+					writer.write(vertices[i].y);
+				}
+
+			} else {
+				double tmpWidth = 0.0, tmpHeight = 0.0;
+				element.Attribute(WIDTH_NAME, &tmpWidth);
+				element.Attribute(HEIGHT_NAME, &tmpHeight);
+				writer.write(static_cast<float>(tmpWidth));
+				writer.write(static_cast<float>(tmpHeight));
+			}
+
+			PropertyMap properties;
+			readPropertiesFromChildren(element, properties);
+			writer.write(properties);
+		}
+
+		void writeObjectLayerFromElement(const TiXmlElement &element,
+		                                 BinaryWriter &writer) {
+			static const char *COLOR_NAME = "color";
+			static const std::string OBJECT_VALUE("object");
+			writeLayerFromElement(BinaryTileMapFormat::OBJECT_LAYER, element, writer);
+
+			// We use the object layers' default color if none is specified.
+			const char *tmpColor = element.Attribute(COLOR_NAME);
+			writer.write(static_cast<uint32_t>((tmpColor) ? (readColorFromString(tmpColor)) : (static_cast<uint32_t>(Color(160, 160, 164, 255)))));
+
+			uint32_t nbObjects = 0;
+			const TiXmlNode *i = NULL;
+
+			while ((i = element.IterateChildren(i))) {
+				if (i->ToElement() && i->ToElement()->ValueStr() == OBJECT_VALUE) {
+					++nbObjects;
+				}
+			}
+
+			writer.write(nbObjects);
+
+			while ((i = element.IterateChildren(i))) {
+				if (i->ToElement() && i->ToElement()->ValueStr() == OBJECT_VALUE) {
+					writeObjectFromElement(*i->ToElement(), writer);
+				}
+			}
+		}
+	}
+
+	bool TmxTileMapReader::convertToBinary(const std::string &tmxFileName,
+	                                       const std::string &binaryFileName) {
+		static const std::string ROOT_VALUE("map");
+		static const char *ORIENTATION_ATTRIBUTE_NAME = "orientation";
+		static const std::string MAP_ORIENTATION("orthogonal");
+		static const char *WIDTH_NAME = "width";
+		static const char *HEIGHT_NAME = "height";
+		static const std::string TILESET_VALUE("tileset");
+		static const std::string TILE_LAYER_VALUE("layer");
+		static const std::string OBJECT_LAYER_VALUE("objectgroup");
+
+		if (!supportsFile(tmxFileName)) {
+			errorMessage = "TmxTileMapReader: tried to convert a tile map from a non-supported file format.";
+			return false;
+		}
+
+		std::ifstream tmxFile(tmxFileName.c_str());
+
+		if (!tmxFile.is_open()) {
+			errorMessage = "TmxTileMapReader: failed to to open the tmx file. Is the file path correct?";
+			return false;
+		}
+
+		TiXmlDocument document;
+		tmxFile >> document;
+		tmxFile.close();
+
+		const TiXmlElement *root = document.RootElement();
+
+		if (!root || root->Value() != ROOT_VALUE) {
+			errorMessage = "TmxTileMapReader: the tmx file's root element is not a map.";
+			return false;
+		}
+
+		const char *tmpOrientation = root->Attribute(ORIENTATION_ATTRIBUTE_NAME);
+
+		if (!tmpOrientation || std::string(tmpOrientation) != MAP_ORIENTATION) {
+			errorMessage = "TmxTileMapReader: the tmx file's map is not orthogonal. Check that the orientation attribute of the map is defined and that it is set to orthogonal.";
+			return false;
+		}
+
+		int tmpWidth = 0, tmpHeight = 0;
+		double tmpTileWidth = 0.0, tmpTileHeight = 0.0;
+
+		if (!root->Attribute(WIDTH_NAME, &tmpWidth) ||
+		    !root->Attribute(HEIGHT_NAME, &tmpHeight) ||
+		    !root->Attribute(TILE_WIDTH_NAME, &tmpTileWidth) ||
+		    !root->Attribute(TILE_HEIGHT_NAME, &tmpTileHeight) ||
+		    tmpWidth < 0 || tmpHeight < 0) {
+			errorMessage = "TmxTileMapReader: the map must have valid width, height, tilewidth and tileheight attributes.";
+			return false;
+		}
+
+		BinaryWriter writer;
+		writer.write(BinaryTileMapFormat::MAGIC);
+		writer.write(BinaryTileMapFormat::VERSION);
+		writer.write(static_cast<uint32_t>(tmpWidth));
+		writer.write(static_cast<uint32_t>(tmpHeight));
+		writer.write(static_cast<float>(tmpTileWidth));
+		writer.write(static_cast<float>(tmpTileHeight));
+		writer.write(readNameFromElement(*root));
+
+		PropertyMap properties;
+		readPropertiesFromChildren(*root, properties);
+		writer.write(properties);
+
+		// We write the tilesets first, then the layers in their order.
+		uint32_t nbTilesets = 0, nbLayers = 0;
+		const TiXmlNode *i = NULL;
+
+		while ((i = root->IterateChildren(i))) {
+			if (i->ToElement()) {
+				if (i->ToElement()->ValueStr() == TILESET_VALUE) {
+					++nbTilesets;
+
+				} else if (i->ToElement()->ValueStr() == TILE_LAYER_VALUE ||
+				           i->ToElement()->ValueStr() == OBJECT_LAYER_VALUE) {
+					++nbLayers;
+				}
+			}
+		}
+
+		writer.write(nbTilesets);
+
+		while ((i = root->IterateChildren(i))) {
+			if (i->ToElement() && i->ToElement()->ValueStr() == TILESET_VALUE &&
+			    !writeTilesetFromElement(*i->ToElement(), writer, errorMessage)) {
+				return false;
+			}
+		}
+
+		writer.write(nbLayers);
+		TileCoordinate sizeInTiles(tmpWidth, tmpHeight);
+
+		while ((i = root->IterateChildren(i))) {
+			if (i->ToElement()) {
+				if (i->ToElement()->ValueStr() == TILE_LAYER_VALUE) {
+					if (!writeTileLayerFromElement(*i->ToElement(), sizeInTiles, writer, errorMessage)) {
+						return false;
+					}
+
+				} else if (i->ToElement()->ValueStr() == OBJECT_LAYER_VALUE) {
+					writeObjectLayerFromElement(*i->ToElement(), writer);
+				}
+			}
+		}
+
+		if (!writer.save(binaryFileName)) {
+			errorMessage = "TmxTileMapReader: failed to write the binary tile map file.";
+			return false;
+		}
+
+		return true;
+	}
+
 	bool TmxTileMapReader::supportsFile(const std::string &fileName) const {
 		static const std::string FILE_EXTENSION = "tmx";
 		return fileName.substr(fileName.find_last_of('.') + 1) == FILE_EXTENSION;
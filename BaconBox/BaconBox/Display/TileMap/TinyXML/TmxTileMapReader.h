@@ -43,6 +43,20 @@ namespace BaconBox {
 		 */
 		bool supportsFile(const std::string &fileName) const;
 
+		/**
+		 * Converts a tmx file to a precompiled binary tile map, which loads
+		 * much faster. The tilesets' images are not loaded, their paths are
+		 * kept relative to the tmx file's folder, so the binary file must be
+		 * put in the same folder as the images.
+		 * @param tmxFileName Path to the tmx file to convert.
+		 * @param binaryFileName Path to the binary file to write.
+		 * @return True if the file was converted, false if not.
+		 * @see BaconBox::BinaryTileMapReader
+		 * @see BaconBox::TmxTileMapReader::getErrorMessage()
+		 */
+		bool convertToBinary(const std::string &tmxFileName,
+		                     const std::string &binaryFileName);
+
 		/**
 		 * Gets a string containing the error message.
 		 * @return String containing the error message if an error occured while
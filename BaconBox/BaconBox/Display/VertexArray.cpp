@@ -3,6 +3,7 @@
 #include "BaconBox/Helper/Serialization/Value.h"
 #include "BaconBox/Helper/Serialization/DefaultSerializer.h"
 #include "BaconBox/Helper/Serialization/Serializer.h"
+#include "BaconBox/Helper/VertexHelper.h"
 
 namespace BaconBox {
 	bool VertexArray::isValidValueStatic(const Value &node) {
@@ -65,28 +66,13 @@ namespace BaconBox {
 	}
 
 	const Vector2 VertexArray::getMinimumXY() const {
-		if (isEmpty()) {
-			return Vector2(0.0f, 0.0f);
-
-		} else {
-			ConstIterator i = getBegin();
-			Vector2 result = *i;
-			++i;
-
-			while (i != getEnd()) {
-				if (i->x < result.x) {
-					result.x = i->x;
-				}
-
-				if (i->y < result.y) {
-					result.y = i->y;
-				}
-
-				++i;
-			}
+		Vector2 minimum, maximum;
 
-			return result;
+		if (!isEmpty()) {
+			VertexHelper::getBounds(&*getBegin(), getNbVertices(), minimum, maximum);
 		}
+
+		return minimum;
 	}
 
 	float VertexArray::getMinimumX() const {
@@ -132,28 +118,13 @@ namespace BaconBox {
 	}
 
 	const Vector2 VertexArray::getMaximumXY() const {
-		if (isEmpty()) {
-			return Vector2(0.0f, 0.0f);
-
-		} else {
-			ConstIterator i = getBegin();
-			Vector2 result = *i;
-			++i;
-
-			while (i != getEnd()) {
-				if (i->x > result.x) {
-					result.x = i->x;
-				}
-
-				if (i->y > result.y) {
-					result.y = i->y;
-				}
-
-				++i;
-			}
+		Vector2 minimum, maximum;
 
-			return result;
+		if (!isEmpty()) {
+			VertexHelper::getBounds(&*getBegin(), getNbVertices(), minimum, maximum);
 		}
+
+		return maximum;
 	}
 
 	float VertexArray::getMaximumX() const {
@@ -199,85 +170,21 @@ namespace BaconBox {
 	}
 
 	const Vector2 VertexArray::getSize() const {
-		if (isEmpty()) {
-			return Vector2(0.0f, 0.0f);
-
-		} else {
-			ConstIterator i = getBegin();
-			Vector2 min = *i;
-			Vector2 max = *i;
-			++i;
+		Vector2 minimum, maximum;
 
-			while (i != getEnd()) {
-				if (i->x < min.x) {
-					min.x = i->x;
-
-				} else if (i->x > max.x) {
-					max.x = i->x;
-				}
-
-				if (i->y < min.y) {
-					min.y = i->y;
-
-				} else if (i->y > max.y) {
-					max.y = i->y;
-				}
-
-				++i;
-			}
-
-			return max - min;
+		if (!isEmpty()) {
+			VertexHelper::getBounds(&*getBegin(), getNbVertices(), minimum, maximum);
 		}
+
+		return maximum - minimum;
 	}
 
 	float VertexArray::getWidth() const {
-		if (isEmpty()) {
-			return 0.0f;
-
-		} else {
-			ConstIterator i = getBegin();
-			float min = i->x;
-			float max = i->x;
-			++i;
-
-			while (i != getEnd()) {
-				if (i->x < min) {
-					min = i->x;
-
-				} else if (i->x > max) {
-					max = i->x;
-				}
-
-				++i;
-			}
-
-			return max - min;
-		}
+		return getSize().x;
 	}
 
 	float VertexArray::getHeight() const {
-		if (isEmpty()) {
-			return 0.0f;
-
-		} else {
-			ConstIterator i = getBegin();
-			float min = i->y;
-			float max = i->y;
-			++i;
-
-			while (i != getEnd()) {
-				if (i->y < min) {
-					min = i->y;
-
-				} else if (i->y > max) {
-					max = i->y;
-				}
-
-				++i;
-			}
-
-			return max - min;
-		}
+		return getSize().y;
 	}
 
 	const Vector2 VertexArray::getCentroid() const {
@@ -285,38 +192,34 @@ namespace BaconBox {
 	}
 
 	const Vector2 VertexArray::getSumOfVertices() const {
-		Vector2 result;
+		if (isEmpty()) {
+			return Vector2();
 
-		for (ConstIterator i = getBegin(); i != getEnd(); ++i) {
-			result += *i;
+		} else {
+			return VertexHelper::getSum(&*getBegin(), getNbVertices());
 		}
-
-		return result;
 	}
 
 	void VertexArray::move(float xDelta, float yDelta) {
-		for (Iterator i = getBegin(); i != getEnd(); ++i) {
-			i->x += xDelta;
-			i->y += yDelta;
+		if (!isEmpty()) {
+			VertexHelper::move(&*getBegin(), getNbVertices(),
+			                   Vector2(xDelta, yDelta));
 		}
 	}
 
 	void VertexArray::scaleFromPoint(float xScaling, float yScaling,
 	                                 const Vector2 &fromPoint) {
-		for (Iterator i = getBegin(); i != getEnd(); ++i) {
-			*i -= fromPoint;
-			i->x *= xScaling;
-			i->y *= yScaling;
-			*i += fromPoint;
+		if (!isEmpty()) {
+			VertexHelper::scaleFromPoint(&*getBegin(), getNbVertices(),
+			                             Vector2(xScaling, yScaling), fromPoint);
 		}
 	}
 
 	void VertexArray::rotateFromPoint(float rotationAngle,
 	                                  const Vector2 &rotationPoint) {
-		for (Iterator i = getBegin(); i != getEnd(); ++i) {
-			*i -= rotationPoint;
-			i->rotate(rotationAngle);
-			*i += rotationPoint;
+		if (!isEmpty()) {
+			VertexHelper::rotateFromPoint(&*getBegin(), getNbVertices(),
+			                              rotationAngle, rotationPoint);
 		}
 	}
 
@@ -342,30 +245,10 @@ namespace BaconBox {
 		AxisAlignedBoundingBox result;
 
 		if (!isEmpty()) {
-			ConstIterator i = getBegin();
-			result.setPosition(*i);
-			result.setSize(*i);
-			++i;
-
-			while (i != getEnd()) {
-				if (i->x < result.getXPosition()) {
-					result.setXPosition(i->x);
-
-				} else if (i->x > result.getWidth()) {
-					result.setWidth(i->x);
-				}
-
-				if (i->y < result.getYPosition()) {
-					result.setYPosition(i->y);
-
-				} else if (i->y > result.getHeight()) {
-					result.setHeight(i->y);
-				}
-
-				++i;
-			}
-
-			result.setSize(result.getSize() - result.getPosition());
+			Vector2 minimum, maximum;
+			VertexHelper::getBounds(&*getBegin(), getNbVertices(), minimum, maximum);
+			result.setPosition(minimum);
+			result.setSize(maximum - minimum);
 		}
 
 		return result;
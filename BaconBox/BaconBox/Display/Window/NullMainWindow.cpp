@@ -0,0 +1,47 @@
+#include "BaconBox/Display/Window/NullMainWindow.h"
+
+#include "BaconBox/Engine.h"
+
+namespace BaconBox {
+	void NullMainWindow::onBaconBoxInit(unsigned int resolutionWidth,
+	                                    unsigned int resolutionHeight,
+	                                    float contextWidth,
+	                                    float contextHeight) {
+		this->MainWindow::setResolution(resolutionWidth, resolutionHeight);
+		this->MainWindow::setContextSize(contextWidth, contextHeight);
+	}
+
+	void NullMainWindow::show() {
+		// The engine exits the application by itself.
+		while (true) {
+			Engine::pulse();
+			Engine::setBufferSwapped();
+		}
+	}
+
+	void NullMainWindow::setCaption(const std::string &) {
+	}
+
+	bool NullMainWindow::isFullScreen() const {
+		return fullScreen;
+	}
+
+	void NullMainWindow::setFullScreen(bool newFullScreen) {
+		fullScreen = newFullScreen;
+	}
+
+	bool NullMainWindow::isInputGrabbed() const {
+		return inputGrabbed;
+	}
+
+	void NullMainWindow::setInputGrabbed(bool newInputGrabbed) {
+		inputGrabbed = newInputGrabbed;
+	}
+
+	NullMainWindow::NullMainWindow() : MainWindow(), fullScreen(false),
+		inputGrabbed(false) {
+	}
+
+	NullMainWindow::~NullMainWindow() {
+	}
+}
@@ -0,0 +1,89 @@
+/**
+ * @file
+ * @ingroup WindowDisplay
+ */
+#ifndef RB_NULL_MAIN_WINDOW_H
+#define RB_NULL_MAIN_WINDOW_H
+
+#include "BaconBox/Display/Window/MainWindow.h"
+
+namespace BaconBox {
+	/**
+	 * Main window that doesn't open anything. Used by the headless builds
+	 * (see RB_HEADLESS in PlatformFlagger.h), it only keeps the resolution
+	 * and the context size so the states and the cameras work as usual.
+	 * @ingroup WindowDisplay
+	 */
+	class NullMainWindow : public MainWindow {
+		friend class Engine;
+	public:
+		/**
+		 * Method called when the engine is initialized.
+		 * It is used to setup the geometry of the window.
+		 * @param resolutionWidth The width of the window (in pixels).
+		 * @param resolutionHeight The height of the window (in pixels).
+		 * @param contextWidth Width of the context (can be any value).
+		 * @param contextHeight Height of the context (can be any value).
+		 */
+		void onBaconBoxInit(unsigned int resolutionWidth,
+		                    unsigned int resolutionHeight,
+		                    float contextWidth,
+		                    float contextHeight);
+
+		/**
+		 * Pulses the engine until it exits.
+		 */
+		void show();
+
+		/**
+		 * Does nothing, there is no title bar.
+		 * @param caption The text used to replace the title.
+		 */
+		void setCaption(const std::string &caption);
+
+		/**
+		 * Checks if the main window is full screen.
+		 * @return True if the main window was set to full screen, false if
+		 * not.
+		 */
+		bool isFullScreen() const;
+
+		/**
+		 * Makes the main window full screen or not.
+		 * @param newFullScreen If true, sets the main window to full screen.
+		 * If false, makes sure it's not full screen.
+		 */
+		void setFullScreen(bool newFullScreen);
+
+		/**
+		 * Checks if the main window grabs the input.
+		 * @return True if the main window was set to grab the input, false if
+		 * not.
+		 */
+		bool isInputGrabbed() const;
+
+		/**
+		 * Sets if the main window grabbed the input or not.
+		 * @param newInputGrabbed
+		 */
+		void setInputGrabbed(bool newInputGrabbed);
+	private:
+		/**
+		 * Default constructor.
+		 */
+		NullMainWindow();
+
+		/**
+		 * Destructor.
+		 */
+		~NullMainWindow();
+
+		/// Set to true when the main window was set to full screen.
+		bool fullScreen;
+
+		/// Set to true when the main window was set to grab the input.
+		bool inputGrabbed;
+	};
+}
+
+#endif // RB_NULL_MAIN_WINDOW_H
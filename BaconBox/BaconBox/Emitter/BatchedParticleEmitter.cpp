@@ -0,0 +1,505 @@
+#include "BaconBox/Emitter/BatchedParticleEmitter.h"
+
+#include <cmath>
+
+#include <algorithm>
+#include <limits>
+
+#include "BaconBox/Engine.h"
+#include "BaconBox/Helper/Random.h"
+#include "BaconBox/Helper/MathHelper.h"
+#include "BaconBox/Display/TextureInformation.h"
+#include "BaconBox/Display/Driver/GraphicDriver.h"
+#include "BaconBox/Display/Driver/VertexBuffer.h"
+
+namespace BaconBox {
+	BatchedParticleEmitter::BatchedParticleEmitter(TexturePointer newTexture,
+	                                               unsigned int newMaximumNbParticles) :
+		Emitter(), Transformable(), Texturable(), Layerable(), done(),
+		currentMask(NULL), invertedMask(false), spawningCounter(0.0),
+		maximumNbParticles(0u), textureCoordinates(4), particleSize(),
+		particleColor(Color::WHITE), particleAngle(0.0f),
+		particleScaling(1.0f, 1.0f), particleAcceleration(), xPositions(),
+		yPositions(), xVelocities(), yVelocities(), angles(),
+		anglesPerSecond(), xScalings(), yScalings(), xScalingsPerSecond(),
+		yScalingsPerSecond(), alphas(), alphasPerSecond(), timesLeft(),
+		phases(), vertices(), indices(), indiceList(), vertexBuffer(NULL) {
+		setTextureInformation(newTexture);
+		setMaximumNbParticles(newMaximumNbParticles);
+	}
+
+	BatchedParticleEmitter::BatchedParticleEmitter(const BatchedParticleEmitter &src) :
+		Emitter(src), Transformable(src), Texturable(src), Layerable(src),
+		done(), currentMask(src.currentMask), invertedMask(src.invertedMask),
+		spawningCounter(src.spawningCounter),
+		maximumNbParticles(src.maximumNbParticles),
+		textureCoordinates(src.textureCoordinates),
+		particleSize(src.particleSize), particleColor(src.particleColor),
+		particleAngle(src.particleAngle),
+		particleScaling(src.particleScaling),
+		particleAcceleration(src.particleAcceleration),
+		xPositions(src.xPositions), yPositions(src.yPositions),
+		xVelocities(src.xVelocities), yVelocities(src.yVelocities),
+		angles(src.angles), anglesPerSecond(src.anglesPerSecond),
+		xScalings(src.xScalings), yScalings(src.yScalings),
+		xScalingsPerSecond(src.xScalingsPerSecond),
+		yScalingsPerSecond(src.yScalingsPerSecond), alphas(src.alphas),
+		alphasPerSecond(src.alphasPerSecond), timesLeft(src.timesLeft),
+		phases(src.phases), vertices(), indices(), indiceList(),
+		vertexBuffer(NULL) {
+	}
+
+	BatchedParticleEmitter::~BatchedParticleEmitter() {
+		if (vertexBuffer) {
+			GraphicDriver::getInstance().deleteVertexBuffer(vertexBuffer);
+		}
+	}
+
+	BatchedParticleEmitter &BatchedParticleEmitter::operator=(const BatchedParticleEmitter &src) {
+		this->Emitter::operator=(src);
+		this->Transformable::operator=(src);
+		this->Texturable::operator=(src);
+		this->Layerable::operator=(src);
+
+		if (this != &src) {
+			currentMask = src.currentMask;
+			invertedMask = src.invertedMask;
+			spawningCounter = src.spawningCounter;
+			maximumNbParticles = src.maximumNbParticles;
+			textureCoordinates = src.textureCoordinates;
+			particleSize = src.particleSize;
+			particleColor = src.particleColor;
+			particleAngle = src.particleAngle;
+			particleScaling = src.particleScaling;
+			particleAcceleration = src.particleAcceleration;
+			xPositions = src.xPositions;
+			yPositions = src.yPositions;
+			xVelocities = src.xVelocities;
+			yVelocities = src.yVelocities;
+			angles = src.angles;
+			anglesPerSecond = src.anglesPerSecond;
+			xScalings = src.xScalings;
+			yScalings = src.yScalings;
+			xScalingsPerSecond = src.xScalingsPerSecond;
+			yScalingsPerSecond = src.yScalingsPerSecond;
+			alphas = src.alphas;
+			alphasPerSecond = src.alphasPerSecond;
+			timesLeft = src.timesLeft;
+			phases = src.phases;
+
+			// The indices are generated again at the next render.
+			indices.clear();
+			indiceList.clear();
+
+			if (vertexBuffer) {
+				vertexBuffer->markAllDirty();
+			}
+		}
+
+		return *this;
+	}
+
+	void BatchedParticleEmitter::update() {
+		// We make sure the emitter is active and has particles to emit.
+		if (isStarted() && ((getSpawningRate() > 0.0 &&
+		                     nbParticlesToShoot != 0) || isExplosion())) {
+			spawningCounter += Engine::getSinceLastUpdate();
+
+			if (!isExplosion()) {
+				// We try to shoot particles as long as the spawning rate lets
+				// us.
+				while (nbParticlesToShoot != 0 && spawningCounter > getTimeBetweenSpawns() && shootParticle()) {
+					if (nbParticlesToShoot > -1) {
+						--nbParticlesToShoot;
+					}
+
+					spawningCounter -= getTimeBetweenSpawns();
+				}
+
+				// We check if we have to count the emitter's life span.
+				if (getLifeSpan() != -1.0) {
+					// We update the emitter's elapsed time.
+					elapsedTime += Engine::getSinceLastUpdate();
+
+					if (getLifeSpan() < elapsedTime) {
+						stop();
+					}
+				}
+
+			} else {
+				while (shootParticle());
+
+				stop();
+			}
+		}
+
+		if (nbParticles > 0) {
+			float delta = static_cast<float>(Engine::getSinceLastUpdate());
+
+			// We update each value of all the particles at once.
+			addToAll(&xVelocities[0], particleAcceleration.x * delta, nbParticles);
+			addToAll(&yVelocities[0], particleAcceleration.y * delta, nbParticles);
+			integrate(&xPositions[0], &xVelocities[0], delta, nbParticles);
+			integrate(&yPositions[0], &yVelocities[0], delta, nbParticles);
+			integrate(&angles[0], &anglesPerSecond[0], delta, nbParticles);
+			integrate(&xScalings[0], &xScalingsPerSecond[0], delta, nbParticles);
+			integrate(&yScalings[0], &yScalingsPerSecond[0], delta, nbParticles);
+			integrate(&alphas[0], &alphasPerSecond[0], delta, nbParticles);
+			addToAll(&timesLeft[0], -delta, nbParticles);
+
+			// We get random access to the phases.
+			std::vector<const ParticlePhase *> phaseList;
+			phaseList.reserve(getPhases().size());
+
+			for (PhaseList::const_iterator i = getPhases().begin(); i != getPhases().end(); ++i) {
+				phaseList.push_back(&*i);
+			}
+
+			// We update the particles' phases.
+			unsigned int i = 0;
+
+			while (i < nbParticles) {
+				while (timesLeft[i] <= 0.0f && phases[i] < phaseList.size()) {
+					++phases[i];
+
+					if (phases[i] < phaseList.size()) {
+						startPhase(i, *phaseList[phases[i]]);
+					}
+				}
+
+				if (timesLeft[i] <= 0.0f) {
+					// The particle is dead, we replace it with the last alive
+					// particle.
+					--nbParticles;
+					copyParticle(nbParticles, i);
+
+				} else {
+					++i;
+				}
+			}
+		}
+
+		if ((nbParticlesToShoot == 0 ||
+		     (getLifeSpan() >= 0 && getLifeSpan() < elapsedTime)) &&
+		    isToDeleteWhenDone() && nbParticles == 0) {
+			stop();
+			// We set the emitter to be deleted if it is managed.
+			finished();
+		}
+	}
+
+	void BatchedParticleEmitter::render() {
+		if (prepareBatch()) {
+			if (currentMask) {
+				currentMask->mask();
+
+				GraphicDriver::getInstance().drawMaskedBatchWithTextureAndColor(vertices,
+				                                                                getTextureInformation(),
+				                                                                indices,
+				                                                                indiceList,
+				                                                                invertedMask,
+				                                                                vertexBuffer);
+
+				currentMask->unmask();
+
+			} else {
+				GraphicDriver::getInstance().drawBatchWithTextureAndColor(vertices,
+				                                                          getTextureInformation(),
+				                                                          indices,
+				                                                          indiceList,
+				                                                          vertexBuffer);
+			}
+		}
+	}
+
+	void BatchedParticleEmitter::mask() {
+		if (prepareBatch()) {
+			GraphicDriver::getInstance().drawMaskBatchWithTextureAndColor(vertices,
+			                                                              getTextureInformation(),
+			                                                              indices,
+			                                                              indiceList,
+			                                                              vertexBuffer);
+		}
+	}
+
+	void BatchedParticleEmitter::unmask() {
+		if (!vertices.empty()) {
+			GraphicDriver::getInstance().unmaskBatch(vertices, indices,
+			                                         indiceList, vertexBuffer);
+		}
+	}
+
+	Maskable *BatchedParticleEmitter::getMask() const {
+		return currentMask;
+	}
+
+	void BatchedParticleEmitter::setMask(Maskable *newMask, bool inverted) {
+		currentMask = newMask;
+		invertedMask = inverted;
+	}
+
+	const Vector2 BatchedParticleEmitter::getSize() const {
+		return Vector2();
+	}
+
+	float BatchedParticleEmitter::getWidth() const {
+		return 0.0f;
+	}
+
+	float BatchedParticleEmitter::getHeight() const {
+		return 0.0f;
+	}
+
+	unsigned int BatchedParticleEmitter::getMaximumNbParticles() const {
+		return maximumNbParticles;
+	}
+
+	void BatchedParticleEmitter::setMaximumNbParticles(unsigned int newMaximumNbParticles) {
+		maximumNbParticles = newMaximumNbParticles;
+		resizeArrays(maximumNbParticles);
+
+		if (nbParticles > maximumNbParticles) {
+			nbParticles = maximumNbParticles;
+		}
+	}
+
+	void BatchedParticleEmitter::setTextureInformation(TexturePointer newTexture) {
+		this->Texturable::setTextureInformation(newTexture);
+
+		if (getTextureInformation()) {
+			setFrame(Vector2(), Vector2(static_cast<float>(getTextureInformation()->imageWidth),
+			                            static_cast<float>(getTextureInformation()->imageHeight)));
+		}
+	}
+
+	void BatchedParticleEmitter::setFrame(const Vector2 &framePosition,
+	                                      const Vector2 &frameSize) {
+		particleSize = frameSize;
+
+		if (getTextureInformation()) {
+			Vector2 textureSize(static_cast<float>(getTextureInformation()->poweredWidth),
+			                    static_cast<float>(getTextureInformation()->poweredHeight));
+			Vector2 topLeft = framePosition.getCoordinatesDivision(textureSize);
+			Vector2 bottomRight = (framePosition + frameSize).getCoordinatesDivision(textureSize);
+
+			// Same order as the vertices.
+			textureCoordinates[0] = topLeft;
+			textureCoordinates[1] = Vector2(bottomRight.x, topLeft.y);
+			textureCoordinates[2] = Vector2(topLeft.x, bottomRight.y);
+			textureCoordinates[3] = bottomRight;
+		}
+	}
+
+	const Vector2 &BatchedParticleEmitter::getParticleSize() const {
+		return particleSize;
+	}
+
+	void BatchedParticleEmitter::setParticleSize(const Vector2 &newParticleSize) {
+		particleSize = newParticleSize;
+	}
+
+	const Color &BatchedParticleEmitter::getParticleColor() const {
+		return particleColor;
+	}
+
+	void BatchedParticleEmitter::setParticleColor(const Color &newParticleColor) {
+		particleColor = newParticleColor;
+	}
+
+	float BatchedParticleEmitter::getParticleAngle() const {
+		return particleAngle;
+	}
+
+	void BatchedParticleEmitter::setParticleAngle(float newParticleAngle) {
+		particleAngle = newParticleAngle;
+	}
+
+	const Vector2 &BatchedParticleEmitter::getParticleScaling() const {
+		return particleScaling;
+	}
+
+	void BatchedParticleEmitter::setParticleScaling(const Vector2 &newParticleScaling) {
+		particleScaling = newParticleScaling;
+	}
+
+	const Vector2 &BatchedParticleEmitter::getParticleAcceleration() const {
+		return particleAcceleration;
+	}
+
+	void BatchedParticleEmitter::setParticleAcceleration(const Vector2 &newParticleAcceleration) {
+		particleAcceleration = newParticleAcceleration;
+	}
+
+	void BatchedParticleEmitter::finished() {
+		this->done.shoot(this);
+		this->setToBeDeleted(true);
+	}
+
+	void BatchedParticleEmitter::integrate(float *values, const float *rates,
+	                                       float delta, unsigned int count) {
+		for (unsigned int i = 0; i < count; ++i) {
+			values[i] += rates[i] * delta;
+		}
+	}
+
+	void BatchedParticleEmitter::addToAll(float *values, float toAdd,
+	                                      unsigned int count) {
+		for (unsigned int i = 0; i < count; ++i) {
+			values[i] += toAdd;
+		}
+	}
+
+	void BatchedParticleEmitter::resizeArrays(unsigned int newSize) {
+		xPositions.resize(newSize);
+		yPositions.resize(newSize);
+		xVelocities.resize(newSize);
+		yVelocities.resize(newSize);
+		angles.resize(newSize);
+		anglesPerSecond.resize(newSize);
+		xScalings.resize(newSize);
+		yScalings.resize(newSize);
+		xScalingsPerSecond.resize(newSize);
+		yScalingsPerSecond.resize(newSize);
+		alphas.resize(newSize);
+		alphasPerSecond.resize(newSize);
+		timesLeft.resize(newSize);
+		phases.resize(newSize);
+	}
+
+	void BatchedParticleEmitter::copyParticle(unsigned int from, unsigned int to) {
+		xPositions[to] = xPositions[from];
+		yPositions[to] = yPositions[from];
+		xVelocities[to] = xVelocities[from];
+		yVelocities[to] = yVelocities[from];
+		angles[to] = angles[from];
+		anglesPerSecond[to] = anglesPerSecond[from];
+		xScalings[to] = xScalings[from];
+		yScalings[to] = yScalings[from];
+		xScalingsPerSecond[to] = xScalingsPerSecond[from];
+		yScalingsPerSecond[to] = yScalingsPerSecond[from];
+		alphas[to] = alphas[from];
+		alphasPerSecond[to] = alphasPerSecond[from];
+		timesLeft[to] = timesLeft[from];
+		phases[to] = phases[from];
+	}
+
+	void BatchedParticleEmitter::startPhase(unsigned int particle,
+	                                        const ParticlePhase &phase) {
+		timesLeft[particle] = static_cast<float>(phase.phaseDuration + Random::getRandomDouble(0.0, phase.phaseDurationVariance));
+		alphasPerSecond[particle] = phase.alphaPerSecond + Random::getRandomFloat(0.0f, phase.alphaPerSecondVariance);
+		xScalingsPerSecond[particle] = phase.scalingPerSecond.x + Random::getRandomFloat(0.0f, phase.scalingPerSecondVariance.x);
+		yScalingsPerSecond[particle] = phase.scalingPerSecond.y + Random::getRandomFloat(0.0f, phase.scalingPerSecondVariance.y);
+		anglesPerSecond[particle] = phase.anglePerSecond + Random::getRandomFloat(0.0f, phase.anglePerSecondVariance);
+	}
+
+	bool BatchedParticleEmitter::shootParticle() {
+		bool result = false;
+
+		// We make sure there is room for a new particle and that we have at
+		// least one phase.
+		if (nbParticles < maximumNbParticles && !getPhases().empty()) {
+			unsigned int particle = nbParticles;
+
+			// We initialize the particle's values.
+			xPositions[particle] = this->getXPosition();
+			yPositions[particle] = this->getYPosition();
+			Vector2 shootVector(Vector2::UP);
+			shootVector.setLength(getShootingForce() + Random::getRandomFloat(0.0f, getShootingForceVariance()));
+			shootVector.rotate(getShootingAngle() + Random::getRandomFloat(-getShootingAngleVariance(), getShootingAngleVariance()));
+			xVelocities[particle] = shootVector.x;
+			yVelocities[particle] = shootVector.y;
+			angles[particle] = particleAngle;
+			xScalings[particle] = particleScaling.x;
+			yScalings[particle] = particleScaling.y;
+			alphas[particle] = static_cast<float>(particleColor.getAlpha());
+
+			// We start its first phase.
+			phases[particle] = 0u;
+			startPhase(particle, getPhases().front());
+
+			// If the particle is correctly started, we increment the number
+			// of active particles and we return true.
+			if (timesLeft[particle] > 0.0f) {
+				++nbParticles;
+				result = true;
+			}
+		}
+
+		return result;
+	}
+
+	bool BatchedParticleEmitter::prepareBatch() {
+		// Number of particles a segment of indices can address.
+		static const unsigned int MAX_NB_PARTICLES_PER_SEGMENT = static_cast<unsigned int>(std::min<unsigned long>(std::numeric_limits<IndiceArray::value_type>::max() / 4ul,
+		                                                                                                             std::numeric_limits<unsigned int>::max() / 4u));
+
+		if (nbParticles == 0 || !getTextureInformation()) {
+			vertices.clear();
+			return false;
+		}
+
+		if (!vertexBuffer) {
+			vertexBuffer = GraphicDriver::getInstance().createVertexBuffer(VertexBufferUsage::DYNAMIC);
+		}
+
+		// We generate the particles' vertices.
+		bool sizeChanged = vertices.size() != nbParticles * 4;
+		vertices.resize(nbParticles * 4);
+		Vector2 halfSize = particleSize * 0.5f;
+		float radians, cosine, sine, halfWidth, halfHeight;
+		Color color(particleColor);
+		BatchVertexArray::iterator vertex = vertices.begin();
+
+		for (unsigned int i = 0; i < nbParticles; ++i) {
+			radians = MathHelper::AngleConvert<float>::DEGREES_TO_RADIANS * angles[i];
+			cosine = std::cos(radians);
+			sine = std::sin(radians);
+			halfWidth = halfSize.x * xScalings[i];
+			halfHeight = halfSize.y * yScalings[i];
+			color.setAlpha(static_cast<int32_t>(std::max(0.0f, std::min(255.0f, alphas[i]))));
+
+			// The corners are rotated like Vector2::rotate() does.
+			for (int corner = 0; corner < 4; ++corner, ++vertex) {
+				float x = (corner & 1) ? (halfWidth) : (-halfWidth);
+				float y = (corner & 2) ? (halfHeight) : (-halfHeight);
+				vertex->position.x = xPositions[i] + x * cosine + y * sine;
+				vertex->position.y = yPositions[i] + y * cosine - x * sine;
+				vertex->textureCoordinate = textureCoordinates[corner];
+				vertex->color = color;
+			}
+		}
+
+		// The indices follow the same pattern for each particle, so we only
+		// add or remove the ones of the particles that were shot or killed.
+		IndiceArray::size_type oldNbIndices = indices.size();
+		indices.resize(nbParticles * 6);
+
+		for (IndiceArray::size_type i = oldNbIndices / 6; i < nbParticles; ++i) {
+			IndiceArray::value_type first = static_cast<IndiceArray::value_type>((i % MAX_NB_PARTICLES_PER_SEGMENT) * 4);
+			indices[i * 6] = first;
+			indices[i * 6 + 1] = first + 1;
+			indices[i * 6 + 2] = first + 2;
+			indices[i * 6 + 3] = first + 1;
+			indices[i * 6 + 4] = first + 2;
+			indices[i * 6 + 5] = first + 3;
+		}
+
+		indiceList.clear();
+
+		for (unsigned int i = 0; i < nbParticles; i += MAX_NB_PARTICLES_PER_SEGMENT) {
+			indiceList.push_back(std::make_pair(static_cast<StandardVertexArray::SizeType>(i * 4),
+			                                    static_cast<IndiceArray::size_type>(i * 6)));
+		}
+
+		if (vertexBuffer) {
+			if (sizeChanged) {
+				vertexBuffer->markAllDirty();
+
+			} else {
+				vertexBuffer->markDirty(0, static_cast<StandardVertexArray::SizeType>(vertices.size()));
+			}
+		}
+
+		return true;
+	}
+}
@@ -0,0 +1,370 @@
+/**
+ * @file
+ */
+#ifndef RB_BATCHED_PARTICLE_EMITTER_H
+#define RB_BATCHED_PARTICLE_EMITTER_H
+
+#include <vector>
+
+#include <sigly.h>
+
+#include "BaconBox/Emitter/Emitter.h"
+#include "BaconBox/Display/Transformable.h"
+#include "BaconBox/Display/Texturable.h"
+#include "BaconBox/Display/Layerable.h"
+#include "BaconBox/Display/Color.h"
+#include "BaconBox/Display/TextureCoordinates.h"
+#include "BaconBox/Display/Driver/BatchVertex.h"
+#include "BaconBox/Display/Driver/IndiceArray.h"
+
+namespace BaconBox {
+	struct VertexBuffer;
+
+	/**
+	 * Particle emitter that keeps its particles in contiguous arrays
+	 * (positions, velocities, angles, scalings, alphas and times left)
+	 * instead of one graphic per particle. The particles are updated by
+	 * simple loops over those arrays and all of them are rendered in a
+	 * single batch. All the particles are textured quads sharing the same
+	 * texture, frame, size and color. The alive particles are always the
+	 * first ones in the arrays. The animation names of the phases are
+	 * ignored.
+	 */
+	class BatchedParticleEmitter : public Emitter, public Transformable,
+		public Texturable, public Layerable {
+	public:
+		/// Signal shot when the particle emitter is done.
+		sigly::Signal1<BatchedParticleEmitter *> done;
+
+		/**
+		 * Default and parameterized constructor.
+		 * @param newTexture Texture of the particles.
+		 * @param newMaximumNbParticles Maximum number of particles the
+		 * emitter can have at the same time.
+		 */
+		explicit BatchedParticleEmitter(TexturePointer newTexture = TexturePointer(),
+		                                unsigned int newMaximumNbParticles = 0u);
+
+		/**
+		 * Copy constructor.
+		 * @param src Batched particle emitter to make a copy of.
+		 */
+		BatchedParticleEmitter(const BatchedParticleEmitter &src);
+
+		/**
+		 * Destructor.
+		 */
+		virtual ~BatchedParticleEmitter();
+
+		/**
+		 * Assignment operator.
+		 * @param src Batched particle emitter to make a copy of.
+		 * @return Reference to the modified batched particle emitter.
+		 */
+		BatchedParticleEmitter &operator=(const BatchedParticleEmitter &src);
+
+		/**
+		 * Shoots the new particles and updates the particles.
+		 */
+		virtual void update();
+
+		/**
+		 * Renders all the particles in a single batch.
+		 */
+		virtual void render();
+
+		/**
+		 * Similar to the render function except that it will only
+		 * render to the alpha component of the color buffer. It is used to mask
+		 * the next rendered renderable body (if the next renderable body is set
+		 * as a masked renderable body).
+		 */
+		virtual void mask();
+
+		/**
+		 * Undo what the mask function did. This function must be once after the
+		 * masked renderable body has been rendered.
+		 */
+		virtual void unmask();
+
+		/**
+		 * Gets the renderable body masking the current renderable body.
+		 * @return Pointer to the renderable body's mask.
+		 */
+		virtual Maskable *getMask() const;
+
+		/**
+		 * Sets the renderable body used to mask the parent renderstep.
+		 * @param newMask A mask sprite.
+		 * @param inverted Sets this parameter to true if you want to invert
+		 * the effect of the mask. False by default.
+		 */
+		virtual void setMask(Maskable *newMask, bool inverted = false);
+
+		/**
+		 * Gets the body's size.
+		 * @return Always an empty vector, the emitter is a point.
+		 */
+		virtual const Vector2 getSize() const;
+
+		/**
+		 * Gets the body's width.
+		 * @return Always 0.
+		 */
+		virtual float getWidth() const;
+
+		/**
+		 * Gets the body's height.
+		 * @return Always 0.
+		 */
+		virtual float getHeight() const;
+
+		/**
+		 * Gets the maximum number of particles.
+		 * @return Maximum number of particles the emitter can have at the
+		 * same time.
+		 */
+		unsigned int getMaximumNbParticles() const;
+
+		/**
+		 * Sets the maximum number of particles. Kills the particles that
+		 * don't fit anymore.
+		 * @param newMaximumNbParticles Maximum number of particles the emitter
+		 * can have at the same time.
+		 */
+		void setMaximumNbParticles(unsigned int newMaximumNbParticles);
+
+		/**
+		 * Sets the texture of the particles. The particles use the whole
+		 * texture and have the size of its image.
+		 * @param newTexture Pointer to the new texture.
+		 */
+		virtual void setTextureInformation(TexturePointer newTexture);
+
+		/**
+		 * Sets the part of the texture the particles show. Also sets the
+		 * particles' size to the frame's size.
+		 * @param framePosition Position of the frame's upper left corner in
+		 * the texture (in pixels).
+		 * @param frameSize Size of the frame (in pixels).
+		 */
+		void setFrame(const Vector2 &framePosition, const Vector2 &frameSize);
+
+		/**
+		 * Gets the size of the particles before their scaling.
+		 * @return Size of the particles (in pixels).
+		 */
+		const Vector2 &getParticleSize() const;
+
+		/**
+		 * Sets the size of the particles before their scaling.
+		 * @param newParticleSize New size of the particles (in pixels).
+		 */
+		void setParticleSize(const Vector2 &newParticleSize);
+
+		/**
+		 * Gets the color of the new particles.
+		 * @return Color of the particles when they are shot.
+		 */
+		const Color &getParticleColor() const;
+
+		/**
+		 * Sets the color of the new particles. The phases then change their
+		 * alpha.
+		 * @param newParticleColor Color of the particles when they are
+		 * shot.
+		 */
+		void setParticleColor(const Color &newParticleColor);
+
+		/**
+		 * Gets the angle of the new particles.
+		 * @return Angle of the particles when they are shot (in degrees).
+		 */
+		float getParticleAngle() const;
+
+		/**
+		 * Sets the angle of the new particles.
+		 * @param newParticleAngle Angle of the particles when they are shot
+		 * (in degrees).
+		 */
+		void setParticleAngle(float newParticleAngle);
+
+		/**
+		 * Gets the scaling of the new particles.
+		 * @return Scaling of the particles when they are shot.
+		 */
+		const Vector2 &getParticleScaling() const;
+
+		/**
+		 * Sets the scaling of the new particles.
+		 * @param newParticleScaling Scaling of the particles when they are
+		 * shot.
+		 */
+		void setParticleScaling(const Vector2 &newParticleScaling);
+
+		/**
+		 * Gets the acceleration applied to all the particles.
+		 * @return Acceleration of the particles (in pixels per second per
+		 * second).
+		 */
+		const Vector2 &getParticleAcceleration() const;
+
+		/**
+		 * Sets the acceleration applied to all the particles (gravity, for
+		 * example).
+		 * @param newParticleAcceleration Acceleration of the particles (in
+		 * pixels per second per second).
+		 */
+		void setParticleAcceleration(const Vector2 &newParticleAcceleration);
+
+	protected:
+		/**
+		 * Called when the particle emitter is done emitting. Shoots the done
+		 * signal and sets the emitter to be deleted.
+		 */
+		virtual void finished();
+
+	private:
+		/// Array of values, one per particle.
+		typedef std::vector<float> ValueArray;
+
+		/**
+		 * Adds a rate of change multiplied by a delta to each value.
+		 * @param values Values to update.
+		 * @param rates Rate of change of each value.
+		 * @param delta Time elapsed since the last update (in seconds).
+		 * @param count Number of values to update.
+		 */
+		static void integrate(float *values, const float *rates, float delta,
+		                      unsigned int count);
+
+		/**
+		 * Adds the same value to each value.
+		 * @param values Values to update.
+		 * @param toAdd Value to add.
+		 * @param count Number of values to update.
+		 */
+		static void addToAll(float *values, float toAdd, unsigned int count);
+
+		/**
+		 * Resizes all the particles' arrays.
+		 * @param newSize New size of the arrays.
+		 */
+		void resizeArrays(unsigned int newSize);
+
+		/**
+		 * Copies a particle over another one. Used to keep the alive
+		 * particles at the beginning of the arrays.
+		 * @param from Index of the particle to copy.
+		 * @param to Index of the particle to overwrite.
+		 */
+		void copyParticle(unsigned int from, unsigned int to);
+
+		/**
+		 * Starts the phase of a particle.
+		 * @param particle Index of the particle.
+		 * @param phase Phase to start.
+		 */
+		void startPhase(unsigned int particle, const ParticlePhase &phase);
+
+		/**
+		 * Shoots a new particle, if the maximum number of particles isn't
+		 * reached.
+		 * @return True if a particle was shot, false if not.
+		 */
+		bool shootParticle();
+
+		/**
+		 * Generates the vertices of the alive particles and the indices
+		 * needed to draw them.
+		 * @return True if there is something to draw, false if not.
+		 */
+		bool prepareBatch();
+
+		/// Pointer to the emitter's mask.
+		Maskable *currentMask;
+
+		/// Set to true when the current mask is inverted.
+		bool invertedMask;
+
+		/// Used to keep track of the particles' spawning rate.
+		double spawningCounter;
+
+		/// Maximum number of particles alive at the same time.
+		unsigned int maximumNbParticles;
+
+		/// Texture coordinates of the particles' frame.
+		TextureCoordinates textureCoordinates;
+
+		/// Size of the particles before their scaling.
+		Vector2 particleSize;
+
+		/// Color of the particles when they are shot.
+		Color particleColor;
+
+		/// Angle of the particles when they are shot.
+		float particleAngle;
+
+		/// Scaling of the particles when they are shot.
+		Vector2 particleScaling;
+
+		/// Acceleration applied to all the particles.
+		Vector2 particleAcceleration;
+
+		/// Horizontal position of each particle.
+		ValueArray xPositions;
+
+		/// Vertical position of each particle.
+		ValueArray yPositions;
+
+		/// Horizontal velocity of each particle.
+		ValueArray xVelocities;
+
+		/// Vertical velocity of each particle.
+		ValueArray yVelocities;
+
+		/// Angle of each particle (in degrees).
+		ValueArray angles;
+
+		/// Rotation per second of each particle.
+		ValueArray anglesPerSecond;
+
+		/// Horizontal scaling of each particle.
+		ValueArray xScalings;
+
+		/// Vertical scaling of each particle.
+		ValueArray yScalings;
+
+		/// Horizontal scaling per second of each particle.
+		ValueArray xScalingsPerSecond;
+
+		/// Vertical scaling per second of each particle.
+		ValueArray yScalingsPerSecond;
+
+		/// Alpha of each particle (0 to 255).
+		ValueArray alphas;
+
+		/// Alpha per second of each particle.
+		ValueArray alphasPerSecond;
+
+		/// Time left in each particle's current phase (in seconds).
+		ValueArray timesLeft;
+
+		/// Index of each particle's current phase.
+		std::vector<unsigned int> phases;
+
+		/// Vertices of the alive particles, 4 per particle.
+		BatchVertexArray vertices;
+
+		/// Indices of the particles' triangles.
+		IndiceArray indices;
+
+		/// Segments of the indices.
+		IndiceArrayList indiceList;
+
+		/// Buffer in graphic memory, NULL if the driver doesn't use any.
+		VertexBuffer *vertexBuffer;
+	};
+}
+
+#endif // RB_BATCHED_PARTICLE_EMITTER_H
@@ -8,6 +8,7 @@
 #include "BaconBox/PlatformFlagger.h"
 #include "BaconBox/Helper/TimeHelper.h"
 #include "BaconBox/Display/Driver/GraphicDriver.h"
+#include "BaconBox/Display/Driver/DeferredGraphicDriver.h"
 #include "BaconBox/Helper/DeleteHelper.h"
 
 #ifndef RB_ANDROID
@@ -23,6 +24,7 @@
 #include "BaconBox/Console.h"
 #include "BaconBox/Factory.h"
 #include "BaconBox/Display/TileMap/GraphicObjectLayer.h"
+#include "BaconBox/Helper/Profiler.h"
 #include <libgen.h>
 
 #include RB_MAIN_WINDOW_INCLUDE
@@ -120,7 +122,33 @@ namespace BaconBox {
 		}
 	}
 
+	bool Engine::isFixedTimestep() {
+		return getInstance().fixedTimestep;
+	}
+
+	void Engine::setFixedTimestep(bool newFixedTimestep) {
+		getInstance().fixedTimestep = newFixedTimestep;
+	}
+
+	bool Engine::isFreeRunning() {
+		return getInstance().freeRunning;
+	}
+
+	void Engine::setFreeRunning(bool newFreeRunning) {
+		getInstance().freeRunning = newFreeRunning;
+	}
+
+	double Engine::getInterpolationAlpha() {
+		return getInstance().interpolationAlpha;
+	}
+
+	double Engine::getSimulationTime() {
+		return getInstance().simulationTime;
+	}
+
 	void Engine::pulse() {
+		RB_PROFILE_FRAME("Engine::pulse");
+
 		Engine &engine = getInstance();
 
 		// We make sure the pointer to the current state is valid.
@@ -134,39 +162,40 @@ namespace BaconBox {
 
 			engine.loops = 0;
 
-			while (TimeHelper::getInstance().getSinceStartComplete() > engine.nextUpdate &&
-			       engine.loops < engine.minFps) {
-				// We refresh the time.
-				TimeHelper::getInstance().refreshTime();
-
-				// We call the focus methods if needed.
-				if (engine.nextState) {
-					// If the next state is the first state the engine is
-					// playing, the current state will be set to NULL, so we
-					// call the onLoseFocus only if the currentState is valid.
-					if (engine.currentState) {
-						engine.currentState->internalOnLoseFocus();
-					}
-
-					// We set the next state as the current state.
-					engine.currentState = engine.nextState;
-					// We call the onGetFocus method.
-					engine.currentState->internalOnGetFocus();
-
-					engine.nextState = NULL;
+			if (engine.freeRunning) {
+				// We run exactly one update per pulse, whatever time it is.
+				engine.stepFreely();
+				++engine.loops;
+
+			} else {
+				while (TimeHelper::getInstance().getSinceStartComplete() > engine.nextUpdate &&
+				       engine.loops < engine.minFps) {
+					// We refresh the time.
+					TimeHelper::getInstance().refreshTime();
+
+					engine.step();
+
+					engine.nextUpdate += engine.updateDelay;
+					engine.lastUpdate = TimeHelper::getInstance().getSinceStartComplete();
+					++engine.loops;
 				}
+			}
 
-				// We update the current state.
-				engine.currentState->internalUpdate();
+			// We calculate how far the render is between the last two
+			// updates, only meaningful when the updates are ahead of the
+			// wall clock.
+			if (engine.fixedTimestep && !engine.freeRunning && engine.updateDelay > 0.0) {
+				engine.interpolationAlpha = 1.0 - (engine.nextUpdate - TimeHelper::getInstance().getSinceStartComplete()) / engine.updateDelay;
 
-				engine.renderedSinceLastUpdate = false;
-				// We update the input manager.
-				InputManager::getInstance().update();
-				// We update the timers.
-				TimerManager::update();
-				engine.nextUpdate += engine.updateDelay;
-				engine.lastUpdate = TimeHelper::getInstance().getSinceStartComplete();
-				++engine.loops;
+				if (engine.interpolationAlpha < 0.0) {
+					engine.interpolationAlpha = 0.0;
+
+				} else if (engine.interpolationAlpha > 1.0) {
+					engine.interpolationAlpha = 1.0;
+				}
+
+			} else {
+				engine.interpolationAlpha = 1.0;
 			}
 
 			if (!engine.renderedSinceLastUpdate) {
@@ -176,11 +205,31 @@ namespace BaconBox {
 				engine.lastRender = TimeHelper::getInstance().getSinceStartComplete();
 			}
 
-			if (static_cast<AudioEngine *>(engine.soundEngine) != static_cast<AudioEngine *>(engine.musicEngine)) {
-				engine.soundEngine->update();
+			engine.updateAudioAndLoads();
+		}
+
+		if (engine.needsExit) {
+			exit(engine.tmpExitCode);
+		}
+	}
+
+	void Engine::runFrames(unsigned int nbFrames) {
+		Engine &engine = getInstance();
+
+		// We make sure the pointer to the current state is valid.
+		if (engine.currentState || engine.nextState) {
+			// The updates receive the update delay as when free running.
+			bool tmpFreeRunning = engine.freeRunning;
+			engine.freeRunning = true;
+
+			for (unsigned int i = 0; i < nbFrames && !engine.needsExit; ++i) {
+				RB_PROFILE_FRAME("Engine::runFrames");
+
+				engine.stepFreely();
+				engine.updateAudioAndLoads();
 			}
 
-			engine.musicEngine->update();
+			engine.freeRunning = tmpFreeRunning;
 		}
 
 		if (engine.needsExit) {
@@ -206,7 +255,13 @@ namespace BaconBox {
 
 	double Engine::getSinceLastUpdate() {
 		Engine &engine = getInstance();
-		return (engine.lastUpdate) ? (TimeHelper::getInstance().getSinceStartComplete() - engine.lastUpdate) : (engine.lastUpdate);
+
+		if (engine.fixedTimestep || engine.freeRunning) {
+			return engine.updateDelay;
+
+		} else {
+			return (engine.lastUpdate) ? (TimeHelper::getInstance().getSinceStartComplete() - engine.lastUpdate) : (engine.lastUpdate);
+		}
 	}
 
 	double Engine::getSinceLastRender() {
@@ -252,7 +307,26 @@ namespace BaconBox {
 	}
 
 	GraphicDriver &Engine::getGraphicDriver() {
-		return *getInstance().graphicDriver;
+		Engine &engine = getInstance();
+		return (engine.deferredGraphicDriver) ? (*engine.deferredGraphicDriver) : (*engine.graphicDriver);
+	}
+
+	void Engine::setDeferredRendering(bool deferred) {
+		Engine &engine = getInstance();
+
+		if (deferred && !engine.deferredGraphicDriver) {
+			engine.deferredGraphicDriver = new DeferredGraphicDriver(*engine.graphicDriver);
+
+		} else if (!deferred && engine.deferredGraphicDriver) {
+			// We draw what is left in the queue.
+			engine.deferredGraphicDriver->flush();
+			delete engine.deferredGraphicDriver;
+			engine.deferredGraphicDriver = NULL;
+		}
+	}
+
+	bool Engine::isDeferredRendering() {
+		return getInstance().deferredGraphicDriver != NULL;
 	}
 
 	SoundEngine &Engine::getSoundEngine() {
@@ -270,15 +344,76 @@ namespace BaconBox {
 
 	Engine::Engine() : currentState(NULL), nextState(NULL) , lastUpdate(0.0), lastRender(0.0),
 		loops(0), nextUpdate(0), updateDelay(1.0 / DEFAULT_UPDATES_PER_SECOND),
-		minFps(DEFAULT_MIN_FRAMES_PER_SECOND), bufferSwapped(false), needsExit(false),
+		minFps(DEFAULT_MIN_FRAMES_PER_SECOND), fixedTimestep(false),
+		freeRunning(false), interpolationAlpha(1.0), simulationTime(0.0),
+		bufferSwapped(false), needsExit(false),
 		tmpExitCode(0), renderedSinceLastUpdate(true), applicationPath(),
 		applicationName(DEFAULT_APPLICATION_NAME), mainWindow(NULL),
-		graphicDriver(NULL), soundEngine(NULL), musicEngine(NULL) {
+		graphicDriver(NULL), deferredGraphicDriver(NULL), soundEngine(NULL),
+		musicEngine(NULL) {
 
 		mainWindow = RB_MAIN_WINDOW_IMPL;
 		graphicDriver = RB_GRAPHIC_DRIVER_IMPL;
 		soundEngine = RB_SOUND_ENGINE_IMPL;
 		musicEngine = RB_MUSIC_ENGINE_IMPL;
+
+#ifdef RB_HEADLESS
+		// The virtual clock only advances with the updates.
+		freeRunning = true;
+#endif
+	}
+
+	void Engine::step() {
+		// We call the focus methods if needed.
+		if (nextState) {
+			// If the next state is the first state the engine is
+			// playing, the current state will be set to NULL, so we
+			// call the onLoseFocus only if the currentState is valid.
+			if (currentState) {
+				currentState->internalOnLoseFocus();
+			}
+
+			// We set the next state as the current state.
+			currentState = nextState;
+			// We call the onGetFocus method.
+			currentState->internalOnGetFocus();
+
+			nextState = NULL;
+		}
+
+		// We keep the time elapsed the update receives.
+		simulationTime += getSinceLastUpdate();
+
+		// We update the current state.
+		currentState->internalUpdate();
+
+		renderedSinceLastUpdate = false;
+		// We update the input manager.
+		InputManager::getInstance().update();
+		// We update the timers.
+		TimerManager::update();
+	}
+
+	void Engine::stepFreely() {
+		// Virtual clocks follow the simulation, the others ignore it.
+		TimeHelper::getInstance().advance(updateDelay);
+		TimeHelper::getInstance().refreshTime();
+
+		step();
+
+		nextUpdate = TimeHelper::getInstance().getSinceStartComplete();
+		lastUpdate = nextUpdate;
+	}
+
+	void Engine::updateAudioAndLoads() {
+		if (static_cast<AudioEngine *>(soundEngine) != static_cast<AudioEngine *>(musicEngine)) {
+			soundEngine->update();
+		}
+
+		musicEngine->update();
+
+		// We finish the asynchronous loads within their time budget.
+		ResourceManager::updateAsyncLoads();
 	}
 
 	Engine::~Engine() {
@@ -303,6 +438,10 @@ namespace BaconBox {
 		}
 
 		// We unload the graphic driver;
+		if (deferredGraphicDriver) {
+			delete deferredGraphicDriver;
+		}
+
 		if (graphicDriver) {
 			delete graphicDriver;
 		}
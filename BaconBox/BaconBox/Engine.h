@@ -14,6 +14,7 @@
 namespace BaconBox {
 	class MainWindow;
 	class GraphicDriver;
+	class DeferredGraphicDriver;
 	class SoundEngine;
 	class MusicEngine;
 	/**
@@ -102,12 +103,80 @@ namespace BaconBox {
 		 */
 		static void setUpdatesPerSecond(double updatesPerSecond);
 
+		/**
+		 * Checks whether the engine runs with a fixed timestep.
+		 * @return True if the updates all receive the update delay as the
+		 * time elapsed, false if they receive the wall clock time elapsed.
+		 * @see BaconBox::Engine::fixedTimestep
+		 */
+		static bool isFixedTimestep();
+
+		/**
+		 * Sets whether the engine runs with a fixed timestep. In that mode,
+		 * getSinceLastUpdate() always returns the update delay, so the
+		 * collidables, the animations, the timers and the emitters integrate
+		 * the same step whatever the frame rate is, and the simulation is
+		 * reproducible.
+		 * @param newFixedTimestep True to use a fixed timestep, false to use
+		 * the wall clock time elapsed.
+		 * @see BaconBox::Engine::fixedTimestep
+		 */
+		static void setFixedTimestep(bool newFixedTimestep);
+
+		/**
+		 * Checks whether the engine steps without waiting for the wall clock.
+		 * @return True if each pulse runs one update right away, false if the
+		 * updates follow the updates per second.
+		 * @see BaconBox::Engine::freeRunning
+		 */
+		static bool isFreeRunning();
+
+		/**
+		 * Sets whether the engine steps without waiting for the wall clock.
+		 * When free running, each pulse runs exactly one update with a fixed
+		 * timestep followed by a render, so the simulation runs as fast as the
+		 * machine allows. Used to run replays and soak tests faster than real
+		 * time. Headless builds start free running since their virtual clock
+		 * only advances with the updates.
+		 * @param newFreeRunning True to step as fast as possible, false to
+		 * follow the updates per second.
+		 * @see BaconBox::Engine::freeRunning
+		 */
+		static void setFreeRunning(bool newFreeRunning);
+
+		/**
+		 * Gets how far the current time is between the last two updates. With
+		 * a fixed timestep, the current state is a bit ahead of the wall
+		 * clock, so the bodies can be rendered between their previous and
+		 * their current state with this alpha.
+		 * @return Value between 0 (previous state) and 1 (current state). Always
+		 * 1 without a fixed timestep or when free running.
+		 */
+		static double getInterpolationAlpha();
+
+		/**
+		 * Gets the time simulated by the updates. With a fixed timestep, it is
+		 * the number of updates multiplied by the update delay.
+		 * @return Sum of the time elapsed given to the updates (in seconds).
+		 */
+		static double getSimulationTime();
+
 		/**
 		 * Called by the context to call the update and the render correctly
 		 * on the current state.
 		 */
 		static void pulse();
 
+		/**
+		 * Runs updates back-to-back without rendering and without waiting,
+		 * each of them receiving the update delay as when free running. The
+		 * audio engines and the asynchronous loads are updated after each of
+		 * them. Used to run simulations in headless builds (see RB_HEADLESS in
+		 * PlatformFlagger.h), but works with any platform.
+		 * @param nbFrames Number of updates to run.
+		 */
+		static void runFrames(unsigned int nbFrames);
+
 		/**
 		 * Initialize the different parts of the engine (drawer, audio engine, etc.)
 		 * @param resolutionWidth Set the window resolution width
@@ -125,6 +194,7 @@ namespace BaconBox {
 		/**
 		 * Gets the time elapsed since the last update called on a state.
 		 * @return Time in seconds since the last update called on a state.
+		 * Always the update delay with a fixed timestep or when free running.
 		 */
 		static double getSinceLastUpdate();
 
@@ -193,6 +263,22 @@ namespace BaconBox {
 		 */
 		static GraphicDriver &getGraphicDriver();
 
+		/**
+		 * Enables or disables deferred rendering. When enabled, textured
+		 * shapes are queued, sorted by layer and texture and drawn as
+		 * batches instead of being drawn one by one.
+		 * @param deferred Whether or not to defer the rendering.
+		 * @see BaconBox::DeferredGraphicDriver
+		 */
+		static void setDeferredRendering(bool deferred);
+
+		/**
+		 * Checks whether or not deferred rendering is enabled.
+		 * @return True if the textured shapes are queued and drawn in
+		 * batches, false if not.
+		 */
+		static bool isDeferredRendering();
+
 		/**
 		 * Gets the sound engine.
 		 * @return Reference to the sound engine.
@@ -228,6 +314,23 @@ namespace BaconBox {
 		 */
 		~Engine();
 
+		/**
+		 * Updates the current state, the input manager and the timers once.
+		 * Changes the current state first if needed.
+		 */
+		void step();
+
+		/**
+		 * Advances the clock by the update delay and updates once, without
+		 * waiting for the wall clock.
+		 */
+		void stepFreely();
+
+		/**
+		 * Updates the audio engines and the asynchronous loads.
+		 */
+		void updateAudioAndLoads();
+
 		/// Map of states in the engine.
 		std::map<std::string, State *> states;
 
@@ -255,6 +358,21 @@ namespace BaconBox {
 		/// Minimum renders that can be skipped between updates.
 		unsigned int minFps;
 
+		/**
+		 * Set to true when the updates receive the update delay as the time
+		 * elapsed instead of the wall clock time.
+		 */
+		bool fixedTimestep;
+
+		/// Set to true when each pulse runs one update right away.
+		bool freeRunning;
+
+		/// How far the last render was between the last two updates.
+		double interpolationAlpha;
+
+		/// Sum of the time elapsed given to the updates.
+		double simulationTime;
+
 		/// Flag to set when the buffer needs to be swapped.
 		bool bufferSwapped;
 
@@ -282,6 +400,12 @@ namespace BaconBox {
 		/// Pointer to the graphic driver.
 		GraphicDriver *graphicDriver;
 
+		/**
+		 * Pointer to the driver wrapping the graphic driver when the
+		 * rendering is deferred. NULL when deferred rendering is disabled.
+		 */
+		DeferredGraphicDriver *deferredGraphicDriver;
+
 		/// Pointer to the sound engine instance.
 		SoundEngine *soundEngine;
 
@@ -71,6 +71,52 @@ namespace BaconBox {
 		}
 	}
 
+	std::string::size_type Base64::decode(const char *data,
+	                                      std::string::size_type size,
+	                                      char *result,
+	                                      std::string::size_type resultSize,
+	                                      std::string::size_type &nbRead) {
+		std::string::size_type in = 0, out = 0;
+		unsigned int group = 0, nbChars = 0;
+
+		while (in < size) {
+			if (isspace(static_cast<unsigned char>(data[in]))) {
+				++in;
+
+			} else if (data[in] == '=' || !isBase64(data[in]) ||
+			           (nbChars == 0 && out == resultSize)) {
+				break;
+
+			} else {
+				// We accumulate the 6 bits of each character.
+				group = (group << 6) | BASE_64_INDEXES[data[in] - '+'];
+				++nbChars;
+				++in;
+
+				if (nbChars == 4) {
+					for (int i = 2; i >= 0 && out < resultSize; --i) {
+						result[out++] = static_cast<char>((group >> (i * 8)) & 0xff);
+					}
+
+					group = 0;
+					nbChars = 0;
+				}
+			}
+		}
+
+		// We decode the last characters when there is no padding.
+		if (nbChars > 1) {
+			group <<= 6 * (4 - nbChars);
+
+			for (unsigned int i = 0; i < nbChars - 1 && out < resultSize; ++i) {
+				result[out++] = static_cast<char>((group >> ((2 - i) * 8)) & 0xff);
+			}
+		}
+
+		nbRead = in;
+		return out;
+	}
+
 	void Base64::encode(const std::string &data, std::string &result) {
 		if (!data.empty()) {
 			result.clear();
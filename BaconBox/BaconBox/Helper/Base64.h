@@ -25,6 +25,25 @@ namespace BaconBox {
 		 */
 		static void decode(const std::string &data, std::string &result);
 
+		/**
+		 * Decodes base 64 characters directly into a buffer. White spaces are
+		 * skipped. The decoding stops at the first padding or invalid
+		 * character, at the end of the data or when the buffer is full. Can
+		 * be called again on the rest of the data to decode it in parts, as
+		 * long as the buffer's size is a multiple of 3.
+		 * @param data Pointer to the characters to decode.
+		 * @param size Number of characters to decode.
+		 * @param result Buffer that will contain the decoded bytes.
+		 * @param resultSize Size of the buffer in bytes.
+		 * @param nbRead Set to the number of characters read.
+		 * @return Number of bytes written in the buffer.
+		 */
+		static std::string::size_type decode(const char *data,
+		                                     std::string::size_type size,
+		                                     char *result,
+		                                     std::string::size_type resultSize,
+		                                     std::string::size_type &nbRead);
+
 		/**
 		 * Encodes the data to base 64.
 		 * @param data String containing the data to encode.
@@ -0,0 +1,35 @@
+/**
+ * @file
+ * @ingroup Physics
+ */
+#ifndef RB_BROADPHASE_STRATEGY_H
+#define RB_BROADPHASE_STRATEGY_H
+
+#include "BaconBox/Helper/SafeEnum.h"
+
+namespace BaconBox {
+	/**
+	 * Enum type representing how a collision group finds the pairs of bodies
+	 * that might collide.
+	 * @ingroup Physics
+	 * @see BaconBox::CollisionGroup
+	 */
+	struct BroadphaseStrategyDef {
+		enum type {
+			/**
+			 * The bodies are kept in a quadtree. Best when a few bodies are
+			 * tested against a lot of static bodies.
+			 */
+			QUADTREE,
+			/**
+			 * The bodies are sorted along the axis on which they are the most
+			 * spread out and swept for overlaps. Best when testing all the
+			 * bodies of a group against each other.
+			 */
+			SWEEP_AND_PRUNE
+		};
+	};
+	typedef SafeEnum<BroadphaseStrategyDef> BroadphaseStrategy;
+}
+
+#endif // RB_BROADPHASE_STRATEGY_H
@@ -4,24 +4,30 @@
 #include <cmath>
 
 #include <algorithm>
-#include <queue>
 
 #include "BaconBox/Helper/DeleteHelper.h"
 
 #include "BaconBox/Display/Collidable.h"
+#include "BaconBox/Helper/Profiler.h"
 
 namespace BaconBox {
 	CollisionGroup::CollisionGroup(const AxisAlignedBoundingBox &newBounds,
 	                               unsigned int newDepth,
 	                               unsigned int newPoolDepth) : bodies(),
-		root(NULL), depth(newDepth), tmpDepth(), bounds(newBounds), poolDepth(newPoolDepth),
-		quadPool(calculatePoolSize(newDepth)), quadOverflow() {
+		entries(), movingBodies(), reconstructionNeeded(true),
+		strategy(BroadphaseStrategy::QUADTREE),
+		sweepEntries(), sweepAlongX(true), maxSweepLength(0.0f), root(NULL),
+		depth(newDepth), tmpDepth(newDepth), bounds(newBounds),
+		poolDepth(newPoolDepth), quadPool(calculatePoolSize(newDepth)),
+		quadOverflow(), nodeQueue(), detailsBuffer() {
 	}
 
 	CollisionGroup::CollisionGroup(const CollisionGroup &src) : bodies(src.bodies),
-		root(NULL), depth(src.depth), tmpDepth(), bounds(src.bounds),
+		entries(), movingBodies(), reconstructionNeeded(true),
+		strategy(src.strategy), sweepEntries(), sweepAlongX(true),
+		maxSweepLength(0.0f), root(NULL), depth(src.depth), tmpDepth(src.depth), bounds(src.bounds),
 		poolDepth(src.poolDepth), quadPool(src.quadPool.getMaxSize()),
-		quadOverflow() {
+		quadOverflow(), nodeQueue(), detailsBuffer() {
 	}
 
 	CollisionGroup::~CollisionGroup() {
@@ -31,63 +37,297 @@ namespace BaconBox {
 	CollisionGroup &CollisionGroup::operator=(const CollisionGroup &src) {
 		if (this != &src) {
 			bodies = src.bodies;
-			root = NULL;
 			depth = src.depth;
 			bounds = src.bounds;
 			poolDepth = src.poolDepth;
+			strategy = src.strategy;
+			resetTree();
 			quadPool.reset(src.quadPool.getMaxSize());
-			clearOverflow();
-			quadOverflow.clear();
 		}
 
 		return *this;
 	}
 
 	void CollisionGroup::update() {
-		if (!bodies.empty()) {
-			// We reset the pool and the quadtree.
-			quadPool.reset();
-			clearOverflow();
-			quadOverflow.clear();
+		RB_PROFILE_ZONE("CollisionGroup::update");
 
-			// We initialize the root node.
-			root = getNewQuad(bounds);
+		if (reconstructionNeeded) {
+			reconstruct();
 
-			tmpDepth = depth;
+		} else if (strategy == BroadphaseStrategy::SWEEP_AND_PRUNE) {
+			updateSweep(true);
 
-			// We add all the bodies in the quad tree.
+		} else {
 			AxisAlignedBoundingBox tmpBox;
 
-			for (BodySet::iterator i = bodies.begin(); i != bodies.end(); ++i) {
-				tmpBox = (*i)->getAxisAlignedBoundingBox();
+			// We only move the bodies that moved since the last update.
+			for (EntryArray::iterator i = movingBodies.begin(); i != movingBodies.end(); ++i) {
+				tmpBox = (*i)->body->getAxisAlignedBoundingBox();
 
-				// If the box is completely within the root node's bounds.
-				if (tmpBox.isCompletelyInside(root->bounds)) {
-					// We insert the box in the root or one of its subdivision.
-					subInsert(tmpBox, *i);
+				if (tmpBox != (*i)->box) {
+					(*i)->box = tmpBox;
 
-				} else {
-					// We create a node parent to the current root and make
-					// this new node the new root. Repeat until we find a
-					// size in which the body's box fits.
-					supInsert(tmpBox, *i);
+					// If the body still fits in its node and the node has no
+					// subdivisions, it can stay there.
+					if ((*i)->node->nodes[NW] || (*i)->node->nodes[NE] ||
+					    (*i)->node->nodes[SW] || (*i)->node->nodes[SE] ||
+					    !tmpBox.isCompletelyInside((*i)->node->bounds)) {
+						detach(*i);
+						insert(*i);
+					}
 				}
 			}
 		}
 	}
 
 	void CollisionGroup::add(Collidable *newBody) {
-		if (newBody) {
-			bodies.insert(newBody);
+		if (newBody && bodies.insert(newBody).second && !reconstructionNeeded) {
+			if (strategy == BroadphaseStrategy::SWEEP_AND_PRUNE) {
+				SweepEntry entry(newBody);
+				refreshInterval(entry);
+
+				if (entry.max - entry.min > maxSweepLength) {
+					maxSweepLength = entry.max - entry.min;
+				}
+
+				sweepEntries.insert(std::upper_bound(sweepEntries.begin(), sweepEntries.end(), entry, isBefore), entry);
+
+			} else {
+				addEntry(newBody);
+			}
 		}
 	}
 
 	void CollisionGroup::remove(Collidable *body) {
-		bodies.erase(body);
+		if (bodies.erase(body)) {
+			for (SweepArray::iterator i = sweepEntries.begin(); i != sweepEntries.end(); ++i) {
+				if (i->body == body) {
+					sweepEntries.erase(i);
+					break;
+				}
+			}
+
+			EntryMap::iterator found = entries.find(body);
+
+			if (found != entries.end()) {
+				detach(&found->second);
+
+				EntryArray::iterator moving = std::find(movingBodies.begin(), movingBodies.end(), &found->second);
+
+				if (moving != movingBodies.end()) {
+					*moving = movingBodies.back();
+					movingBodies.pop_back();
+				}
+
+				entries.erase(found);
+			}
+		}
 	}
 
 	const std::list<CollisionDetails> CollisionGroup::collide(Collidable *body) {
-		std::list<CollisionDetails> result;
+		collide(body, detailsBuffer);
+		return std::list<CollisionDetails>(detailsBuffer.begin(), detailsBuffer.end());
+	}
+
+	const std::list<CollisionDetails> CollisionGroup::collide(CollisionGroup *collisionGroup) {
+		collide(collisionGroup, detailsBuffer);
+		return std::list<CollisionDetails>(detailsBuffer.begin(), detailsBuffer.end());
+	}
+
+	const std::list<CollisionDetails> CollisionGroup::collide() {
+		return this->collide(this);
+	}
+
+	void CollisionGroup::collide(Collidable *body, CollisionDetailsArray &result) {
+		RB_PROFILE_ZONE("CollisionGroup::collide");
+
+		result.clear();
+
+		if (strategy == BroadphaseStrategy::SWEEP_AND_PRUNE) {
+			appendSweepCollisions(body, result);
+
+		} else {
+			appendCollisions(body, result);
+		}
+	}
+
+	void CollisionGroup::collide(CollisionGroup *collisionGroup,
+	                             CollisionDetailsArray &result) {
+		RB_PROFILE_ZONE("CollisionGroup::collide");
+
+		result.clear();
+
+		if (strategy == BroadphaseStrategy::SWEEP_AND_PRUNE) {
+			if (collisionGroup == this) {
+				// Each pair of overlapping bodies is tested once.
+				sweep(result);
+
+			} else {
+				for (BodySet::iterator i = collisionGroup->bodies.begin(); i != collisionGroup->bodies.end(); ++i) {
+					appendSweepCollisions(*i, result);
+				}
+			}
+
+		} else {
+			for (BodySet::iterator i = collisionGroup->bodies.begin(); i != collisionGroup->bodies.end(); ++i) {
+				// We make the body collide with the quad tree.
+				appendCollisions(*i, result);
+			}
+		}
+	}
+
+	void CollisionGroup::collide(CollisionDetailsArray &result) {
+		this->collide(this, result);
+	}
+
+	CollisionGroup::BodySet &CollisionGroup::getBodies() {
+		// The set might be modified through the reference.
+		reconstructionNeeded = true;
+		return bodies;
+	}
+
+	const CollisionGroup::BodySet &CollisionGroup::getBodies() const {
+		return bodies;
+	}
+
+	unsigned int CollisionGroup::getDepth() const {
+		return depth;
+	}
+
+	void CollisionGroup::setDepth(unsigned int newDepth) {
+		depth = newDepth;
+		reconstructionNeeded = true;
+	}
+
+	AxisAlignedBoundingBox &CollisionGroup::getBounds() {
+		return bounds;
+	}
+
+	const AxisAlignedBoundingBox &CollisionGroup::getBounds() const {
+		return bounds;
+	}
+
+	unsigned int CollisionGroup::getPoolDepth() const {
+		return poolDepth;
+	}
+
+	void CollisionGroup::setPoolDepth(unsigned int newPoolDepth) {
+		poolDepth = newPoolDepth;
+
+		// The quad nodes are in the pool, so the quadtree can't be kept.
+		resetTree();
+		quadPool.reset(calculatePoolSize(newPoolDepth));
+	}
+
+	BroadphaseStrategy CollisionGroup::getStrategy() const {
+		return strategy;
+	}
+
+	void CollisionGroup::setStrategy(BroadphaseStrategy newStrategy) {
+		if (strategy != newStrategy) {
+			strategy = newStrategy;
+			resetTree();
+		}
+	}
+
+	void CollisionGroup::clear() {
+		resetTree();
+	}
+
+	StackPool<CollisionGroup::QuadNode>::SizeType CollisionGroup::calculatePoolSize(unsigned int depth) {
+		return static_cast<StackPool<CollisionGroup::QuadNode>::SizeType>(ceil((1.0 - pow(4.0, static_cast<double>(depth))) / -3.0));
+	}
+
+	void CollisionGroup::reconstruct() {
+		resetTree();
+
+		if (strategy == BroadphaseStrategy::SWEEP_AND_PRUNE) {
+			sweepEntries.reserve(bodies.size());
+
+			for (BodySet::iterator i = bodies.begin(); i != bodies.end(); ++i) {
+				sweepEntries.push_back(SweepEntry(*i));
+			}
+
+			updateSweep(false);
+
+		} else if (!bodies.empty()) {
+			// We initialize the root node.
+			root = getNewQuad(bounds);
+
+			// We add all the bodies in the quad tree.
+			for (BodySet::iterator i = bodies.begin(); i != bodies.end(); ++i) {
+				addEntry(*i);
+			}
+		}
+
+		reconstructionNeeded = false;
+	}
+
+	void CollisionGroup::resetTree() {
+		quadPool.reset();
+		clearOverflow();
+		quadOverflow.clear();
+		root = NULL;
+		tmpDepth = depth;
+		entries.clear();
+		movingBodies.clear();
+		sweepEntries.clear();
+		maxSweepLength = 0.0f;
+		reconstructionNeeded = true;
+	}
+
+	void CollisionGroup::addEntry(Collidable *newBody) {
+		if (!root) {
+			root = getNewQuad(bounds);
+		}
+
+		BodyEntry *entry = &entries[newBody];
+		entry->body = newBody;
+		entry->box = newBody->getAxisAlignedBoundingBox();
+
+		// Static bodies are never checked again.
+		if (!newBody->isStaticBody()) {
+			movingBodies.push_back(entry);
+		}
+
+		insert(entry);
+	}
+
+	void CollisionGroup::insert(BodyEntry *entry) {
+		// If the box is completely within the root node's bounds.
+		if (entry->box.isCompletelyInside(root->bounds)) {
+			// We insert the box in the root or one of its subdivision.
+			subInsert(entry->box, entry);
+
+		} else {
+			// We create a node parent to the current root and make
+			// this new node the new root. Repeat until we find a
+			// size in which the body's box fits.
+			supInsert(entry->box, entry);
+		}
+	}
+
+	void CollisionGroup::detach(BodyEntry *entry) {
+		if (entry->node) {
+			EntryArray &boxes = entry->node->boxes;
+
+			// We replace the entry with the node's last one.
+			boxes[entry->index] = boxes.back();
+			boxes[entry->index]->index = entry->index;
+			boxes.pop_back();
+
+			entry->node = NULL;
+		}
+	}
+
+	void CollisionGroup::attach(QuadNode *node, BodyEntry *entry) {
+		entry->node = node;
+		entry->index = node->boxes.size();
+		node->boxes.push_back(entry);
+	}
+
+	void CollisionGroup::appendCollisions(Collidable *body,
+	                                      CollisionDetailsArray &result) {
 		AxisAlignedBoundingBox tmpBox = body->getAxisAlignedBoundingBox();
 
 		// We make sure the body has chances to collide with the group. To do
@@ -95,29 +335,29 @@ namespace BaconBox {
 		// node's bounds.
 		if (root && tmpBox.overlaps(root->bounds)) {
 			// Queue containing the nodes to test collision with.
-			std::queue<QuadNode *> nodeStack;
-			nodeStack.push(root);
+			nodeQueue.clear();
+			nodeQueue.push_back(root);
 
 			bool oldResult;
 			std::pair<bool, CollisionDetails> tmpDetails;
 
 			// As long as we haven't tested collision with all the concerned
 			// nodes.
-			while (!nodeStack.empty()) {
+			for (std::vector<QuadNode *>::size_type front = 0; front < nodeQueue.size(); ++front) {
+				QuadNode *node = nodeQueue[front];
 				oldResult = false;
 
 				// We collide with all of the node's bodies.
-				for (BodyList::iterator i = nodeStack.front()->boxes.begin(); i != nodeStack.front()->boxes.end(); ++i) {
+				for (EntryArray::iterator i = node->boxes.begin(); i != node->boxes.end(); ++i) {
 					// We collide the two bodies.
-					tmpDetails = (*i)->collide(body);
+					tmpDetails = (*i)->body->collide(body);
 
 					// If there was a collision.
 					if (tmpDetails.first) {
 						// We take note to update the bounding box when the loop
 						// is over.
 						oldResult = true;
-						// We make sure the result's bool is set to true.
-						// We add the collision details to the list.
+						// We add the collision details to the buffer.
 						result.push_back(tmpDetails.second);
 					}
 				}
@@ -131,83 +371,141 @@ namespace BaconBox {
 				// We get all the nodes that need to be tested.
 				for (unsigned int i = 0; i < 4; ++i) {
 					// If the box overlaps with the node's bounds.
-					if (nodeStack.front()->nodes[i] && nodeStack.front()->nodes[i]->bounds.overlaps(tmpBox)) {
+					if (node->nodes[i] && node->nodes[i]->bounds.overlaps(tmpBox)) {
 						// We add the node to the end of the queue.
-						nodeStack.push(nodeStack.front()->nodes[i]);
+						nodeQueue.push_back(node->nodes[i]);
 					}
 				}
+			}
+		}
+	}
+
+	void CollisionGroup::updateSweep(bool nearlySorted) {
+		// We refresh the moving bodies' boxes and measure how spread out
+		// the bodies are on each axis.
+		double sumX = 0.0, sumY = 0.0, sumSquaredX = 0.0, sumSquaredY = 0.0;
+		double center;
 
-				// We are done with this node, we pop it from the front of the
-				// line.
-				nodeStack.pop();
+		for (SweepArray::iterator i = sweepEntries.begin(); i != sweepEntries.end(); ++i) {
+			if (!i->staticBody) {
+				i->box = i->body->getAxisAlignedBoundingBox();
 			}
+
+			center = static_cast<double>(i->box.getXPositionCenter());
+			sumX += center;
+			sumSquaredX += center * center;
+
+			center = static_cast<double>(i->box.getYPositionCenter());
+			sumY += center;
+			sumSquaredY += center * center;
 		}
 
-		return result;
-	}
+		// We sweep along the axis with the highest variance.
+		double nbEntries = static_cast<double>(sweepEntries.size());
+		bool newSweepAlongX = sweepEntries.empty() ||
+		                      sumSquaredX - sumX * sumX / nbEntries >= sumSquaredY - sumY * sumY / nbEntries;
 
-	const std::list<CollisionDetails> CollisionGroup::collide(CollisionGroup *collisionGroup) {
-		std::list<CollisionDetails> result;
+		if (newSweepAlongX != sweepAlongX) {
+			sweepAlongX = newSweepAlongX;
+			nearlySorted = false;
+		}
 
-		std::list<CollisionDetails> tmpDetails;
+		maxSweepLength = 0.0f;
 
-		for (BodySet::iterator i = collisionGroup->bodies.begin(); i != collisionGroup->bodies.end(); ++i) {
-			// We make the body collide with the quad tree.
-			tmpDetails = this->collide(*i);
+		for (SweepArray::iterator i = sweepEntries.begin(); i != sweepEntries.end(); ++i) {
+			refreshInterval(*i);
 
-			result.insert(result.end(), tmpDetails.begin(), tmpDetails.end());
+			if (i->max - i->min > maxSweepLength) {
+				maxSweepLength = i->max - i->min;
+			}
 		}
 
-		return result;
-	}
+		if (nearlySorted) {
+			// Insertion sort, almost linear since the bodies moved little.
+			for (SweepArray::size_type i = 1; i < sweepEntries.size(); ++i) {
+				if (isBefore(sweepEntries[i], sweepEntries[i - 1])) {
+					SweepEntry tmp = sweepEntries[i];
+					SweepArray::size_type j = i;
 
-	const std::list<CollisionDetails> CollisionGroup::collide() {
-		return this->collide(this);
-	}
+					do {
+						sweepEntries[j] = sweepEntries[j - 1];
+						--j;
+					} while (j > 0 && isBefore(tmp, sweepEntries[j - 1]));
 
-	CollisionGroup::BodySet &CollisionGroup::getBodies() {
-		return bodies;
-	}
+					sweepEntries[j] = tmp;
+				}
+			}
 
-	const CollisionGroup::BodySet &CollisionGroup::getBodies() const {
-		return bodies;
+		} else {
+			std::sort(sweepEntries.begin(), sweepEntries.end(), isBefore);
+		}
 	}
 
-	unsigned int CollisionGroup::getDepth() const {
-		return depth;
-	}
+	void CollisionGroup::refreshInterval(SweepEntry &entry) const {
+		if (sweepAlongX) {
+			entry.min = entry.box.getLeft();
+			entry.max = entry.box.getRight();
 
-	void CollisionGroup::setDepth(unsigned int newDepth) {
-		depth = newDepth;
+		} else {
+			entry.min = entry.box.getTop();
+			entry.max = entry.box.getBottom();
+		}
 	}
 
-	AxisAlignedBoundingBox &CollisionGroup::getBounds() {
-		return bounds;
-	}
+	void CollisionGroup::appendSweepCollisions(Collidable *body,
+	                                           CollisionDetailsArray &result) {
+		SweepEntry tested(body);
+		refreshInterval(tested);
 
-	const AxisAlignedBoundingBox &CollisionGroup::getBounds() const {
-		return bounds;
-	}
+		// The first body that might overlap can't start earlier than the
+		// longest body's length.
+		SweepEntry first;
+		first.min = tested.min - maxSweepLength;
 
-	unsigned int CollisionGroup::getPoolDepth() const {
-		return poolDepth;
+		std::pair<bool, CollisionDetails> tmpDetails;
+
+		for (SweepArray::iterator i = std::lower_bound(sweepEntries.begin(), sweepEntries.end(), first, isBefore);
+		     i != sweepEntries.end() && i->min <= tested.max; ++i) {
+			if (i->max >= tested.min && touches(i->box, tested.box)) {
+				tmpDetails = i->body->collide(body);
+
+				// If there was a collision, the body might have moved.
+				if (tmpDetails.first) {
+					result.push_back(tmpDetails.second);
+					tested.box = body->getAxisAlignedBoundingBox();
+					refreshInterval(tested);
+				}
+			}
+		}
 	}
 
-	void CollisionGroup::setPoolDepth(unsigned int newPoolDepth) {
-		poolDepth = newPoolDepth;
-		quadPool.reset(calculatePoolSize(newPoolDepth));
+	void CollisionGroup::sweep(CollisionDetailsArray &result) {
+		std::pair<bool, CollisionDetails> tmpDetails;
+
+		for (SweepArray::iterator i = sweepEntries.begin(); i != sweepEntries.end(); ++i) {
+			// We only test the bodies starting before the current one ends.
+			for (SweepArray::iterator j = i + 1; j != sweepEntries.end() && j->min <= i->max; ++j) {
+				if (touches(i->box, j->box)) {
+					tmpDetails = i->body->collide(j->body);
+
+					if (tmpDetails.first) {
+						result.push_back(tmpDetails.second);
+					}
+				}
+			}
+		}
 	}
 
-	void CollisionGroup::clear() {
-		quadPool.reset();
-		clearOverflow();
-		quadOverflow.clear();
-		root = NULL;
-		tmpDepth = depth;
+	bool CollisionGroup::isBefore(const SweepEntry &first, const SweepEntry &second) {
+		return first.min < second.min;
 	}
 
-	StackPool<CollisionGroup::QuadNode>::SizeType CollisionGroup::calculatePoolSize(unsigned int depth) {
-		return static_cast<StackPool<CollisionGroup::QuadNode>::SizeType>(ceil((1.0 - pow(4.0, static_cast<double>(depth))) / -3.0));
+	bool CollisionGroup::touches(const AxisAlignedBoundingBox &first,
+	                             const AxisAlignedBoundingBox &second) {
+		return first.getLeft() <= second.getRight() &&
+		       first.getRight() >= second.getLeft() &&
+		       first.getTop() <= second.getBottom() &&
+		       first.getBottom() >= second.getTop();
 	}
 
 	CollisionGroup::QuadNode *CollisionGroup::getNewQuad() {
@@ -245,7 +543,7 @@ namespace BaconBox {
 		return result;
 	}
 
-	void CollisionGroup::subInsert(const AxisAlignedBoundingBox &newBox, Collidable *newBody) {
+	void CollisionGroup::subInsert(const AxisAlignedBoundingBox &newBox, BodyEntry *entry) {
 		// We start from the root node.
 		QuadNode *currentNode = root;
 		unsigned int currentDepth = tmpDepth;
@@ -308,7 +606,7 @@ namespace BaconBox {
 			// If the new box doesn't fit completely into any of the quads,
 			// we insert it into the current node's list of boxes.
 			if (i == 4) {
-				currentNode->boxes.push_back(newBody);
+				attach(currentNode, entry);
 				currentNode = NULL;
 			}
 		}
@@ -317,11 +615,11 @@ namespace BaconBox {
 		// inserted yet, we insert it into the current node, even if it isn't
 		// the smallest quad the box could fit into.
 		if (!currentDepth && currentNode) {
-			currentNode->boxes.push_back(newBody);
+			attach(currentNode, entry);
 		}
 	}
 
-	void CollisionGroup::supInsert(const AxisAlignedBoundingBox &newBox, Collidable *newBody) {
+	void CollisionGroup::supInsert(const AxisAlignedBoundingBox &newBox, BodyEntry *entry) {
 		// We initialize the first current node as the root.
 		QuadNode *newRoot, *currentNode = root;
 		bool right, bottom;
@@ -332,8 +630,9 @@ namespace BaconBox {
 			right = newBox.getLeft() < currentNode->bounds.getLeft();
 			bottom = newBox.getTop() < currentNode->bounds.getTop();
 
-			// We get a new quad node for the new root node.
-			newRoot = getNewQuad();
+			// We get a new quad node for the new root node, starting at the
+			// current node's position.
+			newRoot = getNewQuad(currentNode->bounds);
 			// We set the new root node's size.
 			newRoot->bounds.setSize(currentNode->bounds.getSize() * 2.0f);
 
@@ -348,7 +647,7 @@ namespace BaconBox {
 			}
 
 			// We make the currentNode a child node of the new root node.
-			newRoot->nodes[static_cast<unsigned int>(right) + static_cast<unsigned int>(bottom) * 2] = root;
+			newRoot->nodes[static_cast<unsigned int>(right) + static_cast<unsigned int>(bottom) * 2] = currentNode;
 
 			// We increase the temporary depth because we made the quad tree
 			// grow upwards.
@@ -361,7 +660,7 @@ namespace BaconBox {
 				// We make sure to stop the looping.
 				currentNode = NULL;
 				// We insert the new box in the new root node.
-				subInsert(newBox, newBody);
+				subInsert(newBox, entry);
 
 			} else {
 				// We continue making the quad tree bigger.
@@ -388,4 +687,17 @@ namespace BaconBox {
 		nodes[SW] = NULL;
 		nodes[SE] = NULL;
 	}
+
+	CollisionGroup::BodyEntry::BodyEntry() : body(NULL), box(), node(NULL),
+		index(0) {
+	}
+
+	CollisionGroup::SweepEntry::SweepEntry() : body(NULL), box(), min(0.0f),
+		max(0.0f), staticBody(false) {
+	}
+
+	CollisionGroup::SweepEntry::SweepEntry(Collidable *newBody) :
+		body(newBody), box(newBody->getAxisAlignedBoundingBox()), min(0.0f),
+		max(0.0f), staticBody(newBody->isStaticBody()) {
+	}
 }
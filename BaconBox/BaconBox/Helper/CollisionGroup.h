@@ -6,11 +6,14 @@
 #define RB_COLLISION_GROUP_H
 
 #include <set>
+#include <map>
 #include <list>
 #include <deque>
+#include <vector>
 #include <utility>
 
 #include "BaconBox/Helper/StackPool.h"
+#include "BaconBox/Helper/BroadphaseStrategy.h"
 #include "BaconBox/Display/AxisAlignedBoundingBox.h"
 #include "BaconBox/Display/CollisionDetails.h"
 
@@ -19,10 +22,13 @@ namespace BaconBox {
 
 	/**
 	 * Represents a group of bodies used to optimize collisions between a lot of
-	 * bodies. Uses a quadtree that needs to be reconstructed with the method
-	 * update() when the bodies in the collision group are moved or when bodies
-	 * are added or removed. To speed up the reconstruction of the quadtree,
-	 * the collision group uses a pool of quad nodes.
+	 * bodies. Uses a quadtree that is kept from one update to the next. The
+	 * method update() only moves the bodies whose bounding box changed, static
+	 * bodies are inserted once and never checked again. To speed up the
+	 * construction of the quadtree, the collision group uses a pool of quad
+	 * nodes. The group can instead sort its bodies along an axis and sweep
+	 * them, which is faster to test all of its bodies against each other.
+	 * @see BaconBox::BroadphaseStrategy
 	 * @see BaconBox::StackPool
 	 * @ingroup Physics
 	 */
@@ -31,6 +37,9 @@ namespace BaconBox {
 		/// Type used to represent the set of bodies contained in the group.
 		typedef std::set<Collidable *> BodySet;
 
+		/// Type used to return collision details in a reusable buffer.
+		typedef std::vector<CollisionDetails> CollisionDetailsArray;
+
 		/**
 		 * Default depth of the quad tree and default depth used to calculate
 		 * the number of quad nodes to initialize in the pool.
@@ -78,22 +87,24 @@ namespace BaconBox {
 		CollisionGroup &operator=(const CollisionGroup &src);
 
 		/**
-		 * Reconstructs the quadtree to get ready for collision testing.
+		 * Updates the quadtree to get ready for collision testing. Only the
+		 * non-static bodies whose bounding box changed are moved in the
+		 * quadtree. It is reconstructed completely only after the group's
+		 * settings or its set of bodies were modified directly. Static bodies
+		 * are not checked, they must be removed and added again to be moved.
 		 */
 		void update();
 
 		/**
-		 * Adds a body to the collision group. The collision group will need to
-		 * be updated for this body to not be ignored when testing for
-		 * collisions.
+		 * Adds a body to the collision group. If the quadtree is already
+		 * constructed, the body is inserted in it right away.
 		 * @param newBody Pointer to the new body to add to the collision group.
 		 *
 		 */
 		void add(Collidable *newBody);
 
 		/**
-		 * Removes a body from the collision group. The collision group will
-		 * need to be updated after removing the body.
+		 * Removes a body from the collision group and from its quadtree.
 		 * @param body Pointer to the body to remove from the group.
 		 */
 		void remove(Collidable *body);
@@ -128,9 +139,38 @@ namespace BaconBox {
 		 */
 		const std::list<CollisionDetails> collide();
 
+		/**
+		 * Tests a body for collision with the collision group.
+		 * @param body Pointer to the body to test collisions with.
+		 * @param result Buffer in which to write the collision details. It is
+		 * cleared first, so the same buffer can be reused every update. In
+		 * all the collision details, the first body is the one in the group
+		 * and the second body is the one received in parameter here.
+		 */
+		void collide(Collidable *body, CollisionDetailsArray &result);
+
+		/**
+		 * Tests collisions between two collision groups.
+		 * @param collisionGroup Pointer to the collision group to detect
+		 * collisions with. Can be "this".
+		 * @param result Buffer in which to write the collision details. It is
+		 * cleared first, so the same buffer can be reused every update.
+		 */
+		void collide(CollisionGroup *collisionGroup,
+		             CollisionDetailsArray &result);
+
+		/**
+		 * Tests collisions with itself.
+		 * @param result Buffer in which to write the collision details. It is
+		 * cleared first, so the same buffer can be reused every update.
+		 */
+		void collide(CollisionDetailsArray &result);
+
 		/**
 		 * Gets the set containing the bodies that are in the
-		 * collision group.
+		 * collision group. Since the set can be modified through the
+		 * returned reference, the quadtree will be reconstructed completely
+		 * on the next update.
 		 * @return Reference to the set containing the bodies.
 		 */
 		BodySet &getBodies();
@@ -190,13 +230,35 @@ namespace BaconBox {
 		 */
 		void setPoolDepth(unsigned int newPoolDepth);
 
+		/**
+		 * Gets the method used to find the pairs of bodies that might
+		 * collide.
+		 * @return Collision group's broadphase strategy.
+		 * @see BaconBox::CollisionGroup::strategy
+		 */
+		BroadphaseStrategy getStrategy() const;
+
+		/**
+		 * Sets the method used to find the pairs of bodies that might
+		 * collide. The collision group must be updated before testing for
+		 * collisions again.
+		 * @param newStrategy New broadphase strategy.
+		 * @see BaconBox::CollisionGroup::strategy
+		 */
+		void setStrategy(BroadphaseStrategy newStrategy);
+
 		/**
 		 * Clears the collision group of all bodies.
 		 */
 		void clear();
 	private:
-		/// List of pointers of collidables, contained by the quad nodes.
-		typedef std::list<Collidable *> BodyList;
+		struct BodyEntry;
+
+		/// Array of pointers to bodies' entries, contained by the quad nodes.
+		typedef std::vector<BodyEntry *> EntryArray;
+
+		/// Entries of the bodies inserted in the quadtree.
+		typedef std::map<Collidable *, BodyEntry> EntryMap;
 
 		/// Index number of the north west quad.
 		static const unsigned int NW = 0;
@@ -231,10 +293,68 @@ namespace BaconBox {
 			/// Quad subdivisions.
 			QuadNode *nodes[4];
 
-			/// List of collidable bodies in the node.
-			BodyList boxes;
+			/// Entries of the collidable bodies in the node.
+			EntryArray boxes;
 		};
 
+		/**
+		 * Represents a body inserted in the quadtree.
+		 * @ingroup Physics
+		 */
+		struct BodyEntry {
+			/**
+			 * Default constructor.
+			 */
+			BodyEntry();
+
+			/// Pointer to the body.
+			Collidable *body;
+
+			/// Body's bounding box when it was inserted in the quadtree.
+			AxisAlignedBoundingBox box;
+
+			/// Node containing the body.
+			QuadNode *node;
+
+			/// Index of the body's entry in its node's boxes.
+			EntryArray::size_type index;
+		};
+
+		/**
+		 * Represents a body sorted along the sweep axis.
+		 * @ingroup Physics
+		 */
+		struct SweepEntry {
+			/**
+			 * Default constructor.
+			 */
+			SweepEntry();
+
+			/**
+			 * Parameterized constructor.
+			 * @param newBody Pointer to the body.
+			 */
+			explicit SweepEntry(Collidable *newBody);
+
+			/// Pointer to the body.
+			Collidable *body;
+
+			/// Body's bounding box when the group was last updated.
+			AxisAlignedBoundingBox box;
+
+			/// Lowest coordinate of the box on the sweep axis.
+			float min;
+
+			/// Highest coordinate of the box on the sweep axis.
+			float max;
+
+			/// Set to true if the body was static when it was added.
+			bool staticBody;
+		};
+
+		/// Array of bodies sorted by their lowest coordinate on the sweep axis.
+		typedef std::vector<SweepEntry> SweepArray;
+
 		/**
 		 * Calculates the size of the pool for a specific depth.
 		 * @param depth Depth to use to calculate the pool size.
@@ -259,20 +379,115 @@ namespace BaconBox {
 		 */
 		QuadNode *getNewQuad(const AxisAlignedBoundingBox &newBounds);
 
+		/**
+		 * Reconstructs the whole quadtree from the set of bodies.
+		 */
+		void reconstruct();
+
+		/**
+		 * Clears the quadtree and the bodies' entries, the quadtree will be
+		 * reconstructed on the next update.
+		 */
+		void resetTree();
+
+		/**
+		 * Creates a body's entry and inserts it in the quadtree.
+		 * @param newBody Pointer to the body to insert.
+		 */
+		void addEntry(Collidable *newBody);
+
+		/**
+		 * Inserts a body's entry in the quadtree, either in the root's
+		 * subdivisions or higher than the root.
+		 * @param entry Body's entry, its box must be up to date.
+		 */
+		void insert(BodyEntry *entry);
+
+		/**
+		 * Removes a body's entry from the quad node containing it.
+		 * @param entry Body's entry to remove.
+		 */
+		void detach(BodyEntry *entry);
+
+		/**
+		 * Adds a body's entry to a quad node.
+		 * @param node Quad node to add the entry to.
+		 * @param entry Body's entry to add.
+		 */
+		void attach(QuadNode *node, BodyEntry *entry);
+
 		/**
 		 * Inserts a new body in the subdivisions of the quadtree's roots.
 		 * @param newBox Colliding box of the new body.
-		 * @param newBody Pointer to the new body to insert in the quadtree.
+		 * @param entry Entry of the new body to insert in the quadtree.
 		 */
-		void subInsert(const AxisAlignedBoundingBox &newBox, Collidable *newBody);
+		void subInsert(const AxisAlignedBoundingBox &newBox, BodyEntry *entry);
 
 		/**
 		 * Inserts a new body higher than the root. Makes the root bigger until
 		 * the new body can fit in it.
 		 * @param newBox Colliding box of the new body.
-		 * @param newBody Pointer to the new body to insert in the quadtree.
+		 * @param entry Entry of the new body to insert in the quadtree.
+		 */
+		void supInsert(const AxisAlignedBoundingBox &newBox, BodyEntry *entry);
+
+		/**
+		 * Tests a body for collision with the quadtree and appends the
+		 * collision details to the given buffer.
+		 * @param body Pointer to the body to test collisions with.
+		 * @param result Buffer to append the collision details to.
+		 */
+		void appendCollisions(Collidable *body, CollisionDetailsArray &result);
+
+		/**
+		 * Refreshes the non-static bodies' boxes, picks the axis on which the
+		 * bodies are the most spread out and sorts the bodies along it.
+		 * Since the bodies move little between updates, the array is nearly
+		 * sorted and an insertion sort is used, unless the axis changed.
+		 * @param nearlySorted Set to false when the array was just filled,
+		 * it is then sorted completely.
+		 */
+		void updateSweep(bool nearlySorted);
+
+		/**
+		 * Sets the sweep entry's interval on the current sweep axis from its
+		 * box.
+		 * @param entry Sweep entry to refresh.
+		 */
+		void refreshInterval(SweepEntry &entry) const;
+
+		/**
+		 * Tests a body for collision with the sorted bodies and appends the
+		 * collision details to the given buffer.
+		 * @param body Pointer to the body to test collisions with.
+		 * @param result Buffer to append the collision details to.
+		 */
+		void appendSweepCollisions(Collidable *body,
+		                           CollisionDetailsArray &result);
+
+		/**
+		 * Sweeps the sorted bodies to test each pair of overlapping bodies
+		 * once and appends the collision details to the given buffer.
+		 * @param result Buffer to append the collision details to.
+		 */
+		void sweep(CollisionDetailsArray &result);
+
+		/**
+		 * Compares the sweep entries' lowest coordinate on the sweep axis.
+		 * @param first First sweep entry to compare.
+		 * @param second Second sweep entry to compare.
+		 * @return True if the first entry starts before the second.
 		 */
-		void supInsert(const AxisAlignedBoundingBox &newBox, Collidable *newBody);
+		static bool isBefore(const SweepEntry &first, const SweepEntry &second);
+
+		/**
+		 * Checks if two boxes overlap or touch each other.
+		 * @param first First box.
+		 * @param second Second box.
+		 * @return True if the boxes overlap or touch, false if not.
+		 */
+		static bool touches(const AxisAlignedBoundingBox &first,
+		                    const AxisAlignedBoundingBox &second);
 
 		/**
 		 * Clears the pool overflow.
@@ -282,6 +497,36 @@ namespace BaconBox {
 		/// Set of pointers to bodies that make up the collision group.
 		BodySet bodies;
 
+		/// Entries of the bodies currently in the quadtree.
+		EntryMap entries;
+
+		/// Entries of the non-static bodies, checked on every update.
+		EntryArray movingBodies;
+
+		/**
+		 * Set to true when the quadtree needs to be reconstructed completely
+		 * on the next update.
+		 */
+		bool reconstructionNeeded;
+
+		/**
+		 * Method used to find the pairs of bodies that might collide. Uses a
+		 * quadtree by default.
+		 */
+		BroadphaseStrategy strategy;
+
+		/// Bodies sorted along the sweep axis (sweep and prune only).
+		SweepArray sweepEntries;
+
+		/// Set to true when the bodies are sorted horizontally.
+		bool sweepAlongX;
+
+		/**
+		 * Longest interval of the bodies on the sweep axis. Used to find the
+		 * first body that might overlap when testing a single body.
+		 */
+		float maxSweepLength;
+
 		/// Root quad node.
 		QuadNode *root;
 
@@ -321,6 +566,12 @@ namespace BaconBox {
 		 * Used to contain pointers to quad nodes if the pool overflows.
 		 */
 		std::deque<QuadNode *> quadOverflow;
+
+		/// Queue of quad nodes reused when testing collisions.
+		std::vector<QuadNode *> nodeQueue;
+
+		/// Buffer reused by the collide functions returning lists.
+		CollisionDetailsArray detailsBuffer;
 	};
 }
 
@@ -0,0 +1,65 @@
+#include "BaconBox/Helper/Inflater.h"
+
+#include <zlib.h>
+
+#include "BaconBox/Console.h"
+
+namespace BaconBox {
+	Inflater::Inflater(char *newOutput, std::string::size_type newOutputSize) :
+		stream(new z_stream), outputSize(newOutputSize), valid(true),
+		finished(false) {
+		stream->zalloc = Z_NULL;
+		stream->zfree = Z_NULL;
+		stream->opaque = Z_NULL;
+		stream->next_in = Z_NULL;
+		stream->avail_in = 0;
+		stream->next_out = reinterpret_cast<Bytef *>(newOutput);
+		stream->avail_out = static_cast<uInt>(outputSize);
+
+		// We let zlib detect whether the data is in gzip or zlib.
+		if (inflateInit2(stream, 15 + 32) != Z_OK) {
+			Console::println("Could not initialize the zlib decompression.");
+			valid = false;
+		}
+	}
+
+	Inflater::~Inflater() {
+		// Safe even if the initialization failed.
+		inflateEnd(stream);
+		delete stream;
+	}
+
+	bool Inflater::write(const char *data, std::string::size_type size) {
+		stream->next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data));
+		stream->avail_in = static_cast<uInt>(size);
+
+		while (valid && !finished && stream->avail_in > 0) {
+			int ret = inflate(stream, Z_NO_FLUSH);
+
+			if (ret == Z_STREAM_END) {
+				finished = true;
+
+			} else if (ret != Z_OK) {
+				// Without output space left, the buffer is too small.
+				if (ret == Z_BUF_ERROR && stream->avail_out == 0) {
+					Console::println("The decompressed data is bigger than expected.");
+
+				} else {
+					Console::println("Incorrect zlib compressed data!");
+				}
+
+				valid = false;
+			}
+		}
+
+		return valid;
+	}
+
+	bool Inflater::isFinished() const {
+		return finished;
+	}
+
+	std::string::size_type Inflater::getNbWritten() const {
+		return outputSize - static_cast<std::string::size_type>(stream->avail_out);
+	}
+}
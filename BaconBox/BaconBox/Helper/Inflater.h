@@ -0,0 +1,80 @@
+/**
+ * @file
+ * @ingroup Helper
+ */
+#ifndef RB_INFLATER_H
+#define RB_INFLATER_H
+
+#include <string>
+
+struct z_stream_s;
+
+namespace BaconBox {
+	/**
+	 * Decompresses gzip or zlib data given in parts directly into a buffer of
+	 * a known size. Used when the decompressed size is known in advance, so
+	 * the compressed data doesn't need to be gathered first and the output
+	 * doesn't need to grow.
+	 * @see BaconBox::Compression
+	 * @ingroup Helper
+	 */
+	class Inflater {
+	public:
+		/**
+		 * Parameterized constructor.
+		 * @param newOutput Buffer that will contain the decompressed data.
+		 * @param newOutputSize Size of the buffer in bytes.
+		 */
+		Inflater(char *newOutput, std::string::size_type newOutputSize);
+
+		/**
+		 * Destructor.
+		 */
+		~Inflater();
+
+		/**
+		 * Decompresses the next part of the compressed data.
+		 * @param data Pointer to the compressed data.
+		 * @param size Size of the compressed data in bytes.
+		 * @return True on success, false if the data is invalid or if the
+		 * buffer is too small.
+		 */
+		bool write(const char *data, std::string::size_type size);
+
+		/**
+		 * Checks whether or not the end of the compressed data was reached.
+		 * @return True if all the data was decompressed, false if not.
+		 */
+		bool isFinished() const;
+
+		/**
+		 * Gets the number of decompressed bytes written in the buffer.
+		 * @return Number of bytes written.
+		 */
+		std::string::size_type getNbWritten() const;
+	private:
+		/// Zlib's decompression stream.
+		z_stream_s *stream;
+
+		/// Size of the buffer in bytes.
+		std::string::size_type outputSize;
+
+		/// Set to false once an error occured.
+		bool valid;
+
+		/// Set to true once the end of the compressed data is reached.
+		bool finished;
+
+		/**
+		 * Private undefined copy constructor.
+		 */
+		Inflater(const Inflater &src);
+
+		/**
+		 * Private undefined assignment operator.
+		 */
+		Inflater &operator=(const Inflater &src);
+	};
+}
+
+#endif // RB_INFLATER_H
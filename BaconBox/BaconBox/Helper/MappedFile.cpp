@@ -0,0 +1,109 @@
+#include "BaconBox/Helper/MappedFile.h"
+
+#ifdef RB_HAS_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#else
+#include <cstdio>
+#endif
+
+namespace BaconBox {
+	MappedFile::MappedFile() : data(NULL), size(0), opened(false)
+#ifndef RB_HAS_MMAP
+		, buffer()
+#endif
+	{
+	}
+
+	MappedFile::~MappedFile() {
+		close();
+	}
+
+	bool MappedFile::open(const std::string &filePath) {
+		close();
+
+#ifdef RB_HAS_MMAP
+		int file = ::open(filePath.c_str(), O_RDONLY);
+
+		if (file >= 0) {
+			struct stat fileStatus;
+
+			if (fstat(file, &fileStatus) == 0) {
+				size = static_cast<size_t>(fileStatus.st_size);
+
+				if (size > 0) {
+					void *mapped = mmap(NULL, size, PROT_READ, MAP_PRIVATE, file, 0);
+
+					if (mapped != MAP_FAILED) {
+						data = static_cast<const char *>(mapped);
+						opened = true;
+					}
+
+				} else {
+					opened = true;
+				}
+			}
+
+			// The mapping stays valid once the file is closed.
+			::close(file);
+		}
+
+#else
+		FILE *file = fopen(filePath.c_str(), "rb");
+
+		if (file) {
+			fseek(file, 0, SEEK_END);
+			long fileSize = ftell(file);
+			fseek(file, 0, SEEK_SET);
+
+			if (fileSize >= 0) {
+				size = static_cast<size_t>(fileSize);
+				buffer.resize((size + sizeof(unsigned int) - 1) / sizeof(unsigned int));
+
+				if (size == 0 || fread(&buffer[0], 1, size, file) == size) {
+					data = (size > 0) ? (reinterpret_cast<const char *>(&buffer[0])) : (NULL);
+					opened = true;
+				}
+			}
+
+			fclose(file);
+		}
+
+#endif
+
+		if (!opened) {
+			close();
+		}
+
+		return opened;
+	}
+
+	void MappedFile::close() {
+#ifdef RB_HAS_MMAP
+
+		if (data) {
+			munmap(const_cast<char *>(data), size);
+		}
+
+#else
+		buffer.clear();
+#endif
+		data = NULL;
+		size = 0;
+		opened = false;
+	}
+
+	bool MappedFile::isOpen() const {
+		return opened;
+	}
+
+	const char *MappedFile::getData() const {
+		return data;
+	}
+
+	size_t MappedFile::getSize() const {
+		return size;
+	}
+}
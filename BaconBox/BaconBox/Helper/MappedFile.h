@@ -0,0 +1,93 @@
+/**
+ * @file
+ * @ingroup Helper
+ */
+#ifndef RB_MAPPED_FILE_H
+#define RB_MAPPED_FILE_H
+
+#include <string>
+#include <vector>
+
+#include "BaconBox/PlatformFlagger.h"
+
+namespace BaconBox {
+	/**
+	 * Read-only view of a file's content. The file is memory-mapped on the
+	 * platforms that support it (when RB_HAS_MMAP is defined), so its pages
+	 * are only read when they are accessed. On the other platforms, the
+	 * file is read in a buffer.
+	 * @ingroup Helper
+	 */
+	class MappedFile {
+	public:
+		/**
+		 * Default constructor.
+		 */
+		MappedFile();
+
+		/**
+		 * Destructor. Closes the file.
+		 */
+		~MappedFile();
+
+		/**
+		 * Opens a file. Closes the file already opened, if any.
+		 * @param filePath Path to the file to open.
+		 * @return True if the file was opened, false if not.
+		 */
+		bool open(const std::string &filePath);
+
+		/**
+		 * Closes the file. Its data can't be used afterwards.
+		 */
+		void close();
+
+		/**
+		 * Checks whether or not a file is opened.
+		 * @return True if a file is opened, false if not.
+		 */
+		bool isOpen() const;
+
+		/**
+		 * Gets the file's content.
+		 * @return Pointer to the first byte of the file, NULL if no file is
+		 * opened or if the file is empty. Always aligned on at least 4 bytes.
+		 */
+		const char *getData() const;
+
+		/**
+		 * Gets the file's size.
+		 * @return Size of the file in bytes.
+		 */
+		size_t getSize() const;
+	private:
+		/// Content of the file.
+		const char *data;
+
+		/// Size of the file in bytes.
+		size_t size;
+
+		/// Set once a file is opened.
+		bool opened;
+
+#ifndef RB_HAS_MMAP
+		/**
+		 * Buffer the file is read in. Stored as 32 bits integers so the data
+		 * is aligned.
+		 */
+		std::vector<unsigned int> buffer;
+#endif
+
+		/**
+		 * Private undefined copy constructor.
+		 */
+		MappedFile(const MappedFile &src);
+
+		/**
+		 * Private undefined assignment operator.
+		 */
+		MappedFile &operator=(const MappedFile &src);
+	};
+}
+
+#endif // RB_MAPPED_FILE_H
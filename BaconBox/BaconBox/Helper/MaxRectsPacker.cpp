@@ -0,0 +1,168 @@
+#include "BaconBox/Helper/MaxRectsPacker.h"
+
+#include <limits>
+
+namespace BaconBox {
+	MaxRectsPacker::Rectangle::Rectangle(unsigned int newX, unsigned int newY,
+	                                     unsigned int newWidth,
+	                                     unsigned int newHeight) : x(newX),
+		y(newY), width(newWidth), height(newHeight) {
+	}
+
+	bool MaxRectsPacker::Rectangle::contains(const Rectangle &other) const {
+		return other.x >= x && other.y >= y &&
+		       other.x + other.width <= x + width &&
+		       other.y + other.height <= y + height;
+	}
+
+	bool MaxRectsPacker::Rectangle::overlaps(const Rectangle &other) const {
+		return other.x < x + width && other.x + other.width > x &&
+		       other.y < y + height && other.y + other.height > y;
+	}
+
+	MaxRectsPacker::MaxRectsPacker(unsigned int newWidth,
+	                               unsigned int newHeight) : width(0u),
+		height(0u), usedWidth(0u), usedHeight(0u), usedArea(0u),
+		freeRectangles() {
+		reset(newWidth, newHeight);
+	}
+
+	void MaxRectsPacker::reset(unsigned int newWidth, unsigned int newHeight) {
+		width = newWidth;
+		height = newHeight;
+		usedWidth = 0u;
+		usedHeight = 0u;
+		usedArea = 0u;
+		freeRectangles.clear();
+		freeRectangles.push_back(Rectangle(0u, 0u, width, height));
+	}
+
+	bool MaxRectsPacker::insert(unsigned int rectangleWidth,
+	                            unsigned int rectangleHeight,
+	                            unsigned int &x, unsigned int &y) {
+		RectangleArray::const_iterator best = freeRectangles.end();
+		unsigned int bestShortSide = std::numeric_limits<unsigned int>::max();
+		unsigned int bestLongSide = std::numeric_limits<unsigned int>::max();
+
+		// We look for the free rectangle leaving the smallest leftover on its
+		// shortest side, the longest side's leftover breaks ties.
+		for (RectangleArray::const_iterator i = freeRectangles.begin();
+		     i != freeRectangles.end(); ++i) {
+			if (rectangleWidth <= i->width && rectangleHeight <= i->height) {
+				unsigned int leftoverX = i->width - rectangleWidth;
+				unsigned int leftoverY = i->height - rectangleHeight;
+				unsigned int shortSide = (leftoverX < leftoverY) ? (leftoverX) : (leftoverY);
+				unsigned int longSide = (leftoverX < leftoverY) ? (leftoverY) : (leftoverX);
+
+				if (shortSide < bestShortSide ||
+				    (shortSide == bestShortSide && longSide < bestLongSide)) {
+					best = i;
+					bestShortSide = shortSide;
+					bestLongSide = longSide;
+				}
+			}
+		}
+
+		if (best != freeRectangles.end()) {
+			x = best->x;
+			y = best->y;
+
+			place(Rectangle(x, y, rectangleWidth, rectangleHeight));
+
+			if (x + rectangleWidth > usedWidth) {
+				usedWidth = x + rectangleWidth;
+			}
+
+			if (y + rectangleHeight > usedHeight) {
+				usedHeight = y + rectangleHeight;
+			}
+
+			usedArea += static_cast<unsigned long>(rectangleWidth) * static_cast<unsigned long>(rectangleHeight);
+			return true;
+
+		} else {
+			return false;
+		}
+	}
+
+	unsigned int MaxRectsPacker::getWidth() const {
+		return width;
+	}
+
+	unsigned int MaxRectsPacker::getHeight() const {
+		return height;
+	}
+
+	unsigned int MaxRectsPacker::getUsedWidth() const {
+		return usedWidth;
+	}
+
+	unsigned int MaxRectsPacker::getUsedHeight() const {
+		return usedHeight;
+	}
+
+	float MaxRectsPacker::getOccupancy() const {
+		return (width > 0u && height > 0u) ? (static_cast<float>(usedArea) / (static_cast<float>(width) * static_cast<float>(height))) : (0.0f);
+	}
+
+	void MaxRectsPacker::place(const Rectangle &used) {
+		RectangleArray newRectangles;
+		RectangleArray::iterator i = freeRectangles.begin();
+
+		while (i != freeRectangles.end()) {
+			if (i->overlaps(used)) {
+				// We keep the parts of the free rectangle on each side of the
+				// used rectangle, they can overlap each other.
+				if (used.x > i->x) {
+					newRectangles.push_back(Rectangle(i->x, i->y, used.x - i->x, i->height));
+				}
+
+				if (used.x + used.width < i->x + i->width) {
+					newRectangles.push_back(Rectangle(used.x + used.width, i->y, i->x + i->width - (used.x + used.width), i->height));
+				}
+
+				if (used.y > i->y) {
+					newRectangles.push_back(Rectangle(i->x, i->y, i->width, used.y - i->y));
+				}
+
+				if (used.y + used.height < i->y + i->height) {
+					newRectangles.push_back(Rectangle(i->x, used.y + used.height, i->width, i->y + i->height - (used.y + used.height)));
+				}
+
+				i = freeRectangles.erase(i);
+
+			} else {
+				++i;
+			}
+		}
+
+		freeRectangles.insert(freeRectangles.end(), newRectangles.begin(), newRectangles.end());
+		pruneFreeRectangles();
+	}
+
+	void MaxRectsPacker::pruneFreeRectangles() {
+		RectangleArray::size_type i = 0;
+
+		while (i < freeRectangles.size()) {
+			bool removed = false;
+			RectangleArray::size_type j = i + 1;
+
+			while (!removed && j < freeRectangles.size()) {
+				if (freeRectangles[j].contains(freeRectangles[i])) {
+					freeRectangles.erase(freeRectangles.begin() + i);
+					removed = true;
+
+				} else if (freeRectangles[i].contains(freeRectangles[j])) {
+					freeRectangles.erase(freeRectangles.begin() + j);
+
+				} else {
+					++j;
+				}
+			}
+
+			if (!removed) {
+				++i;
+			}
+		}
+	}
+}
@@ -0,0 +1,150 @@
+/**
+ * @file
+ * @ingroup Helper
+ */
+#ifndef RB_MAX_RECTS_PACKER_H
+#define RB_MAX_RECTS_PACKER_H
+
+#include <vector>
+
+namespace BaconBox {
+	/**
+	 * Packs rectangles in a bin using the MaxRects algorithm. The packer keeps
+	 * the list of the maximal free rectangles left in the bin and places each
+	 * new rectangle in the free rectangle where it fits the tightest (best
+	 * short side fit).
+	 * @ingroup Helper
+	 */
+	class MaxRectsPacker {
+	public:
+		/**
+		 * Parameterized constructor.
+		 * @param newWidth Width of the bin.
+		 * @param newHeight Height of the bin.
+		 */
+		MaxRectsPacker(unsigned int newWidth, unsigned int newHeight);
+
+		/**
+		 * Empties the bin and changes its size.
+		 * @param newWidth New width of the bin.
+		 * @param newHeight New height of the bin.
+		 */
+		void reset(unsigned int newWidth, unsigned int newHeight);
+
+		/**
+		 * Finds a place for a rectangle in the bin.
+		 * @param rectangleWidth Width of the rectangle to place.
+		 * @param rectangleHeight Height of the rectangle to place.
+		 * @param x Horizontal position of the placed rectangle.
+		 * @param y Vertical position of the placed rectangle.
+		 * @return True if the rectangle was placed, false if there isn't
+		 * enough space left for it. The positions are not modified when the
+		 * rectangle can't be placed.
+		 */
+		bool insert(unsigned int rectangleWidth, unsigned int rectangleHeight,
+		            unsigned int &x, unsigned int &y);
+
+		/**
+		 * Gets the bin's width.
+		 * @return Width of the bin.
+		 */
+		unsigned int getWidth() const;
+
+		/**
+		 * Gets the bin's height.
+		 * @return Height of the bin.
+		 */
+		unsigned int getHeight() const;
+
+		/**
+		 * Gets the width actually used by the placed rectangles.
+		 * @return Right side of the rightmost placed rectangle.
+		 */
+		unsigned int getUsedWidth() const;
+
+		/**
+		 * Gets the height actually used by the placed rectangles.
+		 * @return Bottom side of the lowest placed rectangle.
+		 */
+		unsigned int getUsedHeight() const;
+
+		/**
+		 * Gets the ratio of the bin's area covered by rectangles.
+		 * @return Value between 0 and 1.
+		 */
+		float getOccupancy() const;
+	private:
+		/// Rectangle in the bin.
+		struct Rectangle {
+			/**
+			 * Parameterized constructor.
+			 * @param newX Horizontal position of the rectangle.
+			 * @param newY Vertical position of the rectangle.
+			 * @param newWidth Width of the rectangle.
+			 * @param newHeight Height of the rectangle.
+			 */
+			Rectangle(unsigned int newX, unsigned int newY,
+			          unsigned int newWidth, unsigned int newHeight);
+
+			/**
+			 * Checks whether or not the rectangle contains another one.
+			 * @param other Rectangle to check.
+			 * @return True if the other rectangle is completely inside.
+			 */
+			bool contains(const Rectangle &other) const;
+
+			/**
+			 * Checks whether or not the rectangle overlaps another one.
+			 * @param other Rectangle to check.
+			 * @return True if the rectangles share some area.
+			 */
+			bool overlaps(const Rectangle &other) const;
+
+			/// Horizontal position.
+			unsigned int x;
+
+			/// Vertical position.
+			unsigned int y;
+
+			/// Width.
+			unsigned int width;
+
+			/// Height.
+			unsigned int height;
+		};
+
+		/// Type used to contain rectangles.
+		typedef std::vector<Rectangle> RectangleArray;
+
+		/// Width of the bin.
+		unsigned int width;
+
+		/// Height of the bin.
+		unsigned int height;
+
+		/// Width used by the placed rectangles.
+		unsigned int usedWidth;
+
+		/// Height used by the placed rectangles.
+		unsigned int usedHeight;
+
+		/// Area covered by the placed rectangles.
+		unsigned long usedArea;
+
+		/// Maximal free rectangles left in the bin.
+		RectangleArray freeRectangles;
+
+		/**
+		 * Splits the free rectangles overlapped by a newly placed rectangle.
+		 * @param used Rectangle that was placed.
+		 */
+		void place(const Rectangle &used);
+
+		/**
+		 * Removes the free rectangles contained in other free rectangles.
+		 */
+		void pruneFreeRectangles();
+	};
+}
+
+#endif // RB_MAX_RECTS_PACKER_H
@@ -0,0 +1,65 @@
+#include "BaconBox/Helper/Mutex.h"
+
+namespace BaconBox {
+	Mutex::Mutex() {
+#ifdef RB_THREADS
+		pthread_mutex_init(&mutex, NULL);
+#endif
+	}
+
+	Mutex::~Mutex() {
+#ifdef RB_THREADS
+		pthread_mutex_destroy(&mutex);
+#endif
+	}
+
+	void Mutex::lock() {
+#ifdef RB_THREADS
+		pthread_mutex_lock(&mutex);
+#endif
+	}
+
+	void Mutex::unlock() {
+#ifdef RB_THREADS
+		pthread_mutex_unlock(&mutex);
+#endif
+	}
+
+	MutexLock::MutexLock(Mutex &newMutex) : mutex(newMutex) {
+		mutex.lock();
+	}
+
+	MutexLock::~MutexLock() {
+		mutex.unlock();
+	}
+
+	Condition::Condition() {
+#ifdef RB_THREADS
+		pthread_cond_init(&condition, NULL);
+#endif
+	}
+
+	Condition::~Condition() {
+#ifdef RB_THREADS
+		pthread_cond_destroy(&condition);
+#endif
+	}
+
+	void Condition::wait(Mutex &mutex) {
+#ifdef RB_THREADS
+		pthread_cond_wait(&condition, &mutex.mutex);
+#endif
+	}
+
+	void Condition::signal() {
+#ifdef RB_THREADS
+		pthread_cond_signal(&condition);
+#endif
+	}
+
+	void Condition::broadcast() {
+#ifdef RB_THREADS
+		pthread_cond_broadcast(&condition);
+#endif
+	}
+}
@@ -0,0 +1,143 @@
+/**
+ * @file
+ * @ingroup Helper
+ */
+#ifndef RB_MUTEX_H
+#define RB_MUTEX_H
+
+#include "BaconBox/PlatformFlagger.h"
+
+#ifdef RB_THREADS
+#include <pthread.h>
+#endif
+
+namespace BaconBox {
+	/**
+	 * Mutual exclusion lock. Does nothing on platforms without threads
+	 * (when RB_THREADS isn't defined).
+	 * @ingroup Helper
+	 */
+	class Mutex {
+		friend class Condition;
+	public:
+		/**
+		 * Default constructor.
+		 */
+		Mutex();
+
+		/**
+		 * Destructor.
+		 */
+		~Mutex();
+
+		/**
+		 * Locks the mutex, waits until it is available if another thread
+		 * has locked it.
+		 */
+		void lock();
+
+		/**
+		 * Unlocks the mutex.
+		 */
+		void unlock();
+	private:
+#ifdef RB_THREADS
+		/// Underlying mutex.
+		pthread_mutex_t mutex;
+#endif
+
+		/**
+		 * Private undefined copy constructor.
+		 */
+		Mutex(const Mutex &src);
+
+		/**
+		 * Private undefined assignment operator.
+		 */
+		Mutex &operator=(const Mutex &src);
+	};
+
+	/**
+	 * Locks a mutex for as long as it exists.
+	 * @ingroup Helper
+	 */
+	class MutexLock {
+	public:
+		/**
+		 * Parameterized constructor. Locks the mutex.
+		 * @param newMutex Mutex to lock.
+		 */
+		explicit MutexLock(Mutex &newMutex);
+
+		/**
+		 * Destructor. Unlocks the mutex.
+		 */
+		~MutexLock();
+	private:
+		/// Locked mutex.
+		Mutex &mutex;
+
+		/**
+		 * Private undefined copy constructor.
+		 */
+		MutexLock(const MutexLock &src);
+
+		/**
+		 * Private undefined assignment operator.
+		 */
+		MutexLock &operator=(const MutexLock &src);
+	};
+
+	/**
+	 * Condition threads can wait on until another thread signals it.
+	 * @ingroup Helper
+	 */
+	class Condition {
+	public:
+		/**
+		 * Default constructor.
+		 */
+		Condition();
+
+		/**
+		 * Destructor.
+		 */
+		~Condition();
+
+		/**
+		 * Unlocks the mutex and waits until the condition is signaled, then
+		 * locks the mutex again. The mutex must be locked by the caller.
+		 * Waits can end without a signal, so the caller must check again
+		 * what it is waiting for.
+		 * @param mutex Mutex protecting what the caller is waiting for.
+		 */
+		void wait(Mutex &mutex);
+
+		/**
+		 * Wakes up one of the threads waiting on the condition.
+		 */
+		void signal();
+
+		/**
+		 * Wakes up all the threads waiting on the condition.
+		 */
+		void broadcast();
+	private:
+#ifdef RB_THREADS
+		/// Underlying condition variable.
+		pthread_cond_t condition;
+#endif
+
+		/**
+		 * Private undefined copy constructor.
+		 */
+		Condition(const Condition &src);
+
+		/**
+		 * Private undefined assignment operator.
+		 */
+		Condition &operator=(const Condition &src);
+	};
+}
+
+#endif // RB_MUTEX_H
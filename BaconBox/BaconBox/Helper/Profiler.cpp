@@ -0,0 +1,214 @@
+#include "BaconBox/Helper/Profiler.h"
+
+#include <cstdio>
+#include <fstream>
+
+#ifdef RB_WIN32
+#include <windows.h>
+#else
+#include <sys/time.h>
+#endif
+
+namespace BaconBox {
+	unsigned int Profiler::getNbFramesKept() {
+		return static_cast<unsigned int>(getInstance().frames.size());
+	}
+
+	void Profiler::setNbFramesKept(unsigned int newNbFramesKept) {
+		Profiler &profiler = getInstance();
+		profiler.frames.assign((newNbFramesKept) ? (newNbFramesKept) : (1u), Frame());
+		profiler.currentFrame = 0;
+		profiler.nbFrames = 0;
+		profiler.openZones.clear();
+	}
+
+	unsigned int Profiler::getNbFrames() {
+		return getInstance().nbFrames;
+	}
+
+	double Profiler::getFrameDuration(unsigned int index) {
+		Profiler &profiler = getInstance();
+
+		if (index < profiler.nbFrames) {
+			// The oldest frame is right after the current one once the ring
+			// buffer is full.
+			unsigned int nbFramesKept = static_cast<unsigned int>(profiler.frames.size());
+			const Frame &frame = profiler.frames[(profiler.currentFrame + 1 + nbFramesKept - profiler.nbFrames + index) % nbFramesKept];
+			return frame.duration / 1000000.0;
+
+		} else {
+			return 0.0;
+		}
+	}
+
+	void Profiler::clear() {
+		setNbFramesKept(getNbFramesKept());
+	}
+
+	void Profiler::writeChromeTrace(std::ostream &output) {
+		Profiler &profiler = getInstance();
+		unsigned int nbFramesKept = static_cast<unsigned int>(profiler.frames.size());
+		bool first = true;
+		char number[32];
+
+		output << "{\"traceEvents\":[";
+
+		for (unsigned int i = 0; i < profiler.nbFrames; ++i) {
+			const Frame &frame = profiler.frames[(profiler.currentFrame + 1 + nbFramesKept - profiler.nbFrames + i) % nbFramesKept];
+
+			for (std::vector<Zone>::const_iterator zone = frame.zones.begin(); zone != frame.zones.end(); ++zone) {
+				// The zones still open have no duration yet.
+				if (zone->duration >= 0.0) {
+					if (!first) {
+						output << ",";
+					}
+
+					first = false;
+					output << "\n{\"name\":";
+					writeJsonString(output, zone->name);
+					std::sprintf(number, "%.3f", zone->start);
+					output << ",\"cat\":\"BaconBox\",\"ph\":\"X\",\"ts\":" << number;
+					std::sprintf(number, "%.3f", zone->duration);
+					output << ",\"dur\":" << number << ",\"pid\":0,\"tid\":0}";
+				}
+			}
+		}
+
+		output << "\n],\"displayTimeUnit\":\"ms\"}\n";
+	}
+
+	bool Profiler::saveChromeTrace(const std::string &filePath) {
+		std::ofstream file(filePath.c_str());
+
+		if (file.is_open()) {
+			writeChromeTrace(file);
+			return file.good();
+
+		} else {
+			return false;
+		}
+	}
+
+	void Profiler::beginFrame() {
+		Profiler &profiler = getInstance();
+
+		if (profiler.openZones.empty()) {
+			profiler.currentFrame = (profiler.currentFrame + 1) % static_cast<unsigned int>(profiler.frames.size());
+
+			if (profiler.nbFrames < profiler.frames.size()) {
+				++profiler.nbFrames;
+			}
+
+			// We keep the zones' memory from the frame replaced.
+			Frame &frame = profiler.frames[profiler.currentFrame];
+			frame.start = getTime();
+			frame.duration = 0.0;
+			frame.zones.clear();
+		}
+	}
+
+	void Profiler::beginZone(const char *name) {
+		Profiler &profiler = getInstance();
+		Frame &frame = profiler.getCurrentFrame();
+		Zone zone;
+		zone.name = name;
+		zone.duration = -1.0;
+		zone.depth = static_cast<unsigned int>(profiler.openZones.size());
+		profiler.openZones.push_back(static_cast<unsigned int>(frame.zones.size()));
+		frame.zones.push_back(zone);
+
+		// We read the time last so the zone's bookkeeping isn't counted.
+		frame.zones.back().start = getTime();
+	}
+
+	void Profiler::endZone() {
+		double now = getTime();
+		Profiler &profiler = getInstance();
+
+		if (!profiler.openZones.empty()) {
+			Frame &frame = profiler.frames[profiler.currentFrame];
+			Zone &zone = frame.zones[profiler.openZones.back()];
+			zone.duration = now - zone.start;
+			profiler.openZones.pop_back();
+
+			if (profiler.openZones.empty()) {
+				frame.duration = now - frame.start;
+			}
+		}
+	}
+
+	Profiler &Profiler::getInstance() {
+		static Profiler instance;
+		return instance;
+	}
+
+	double Profiler::getTime() {
+#ifdef RB_WIN32
+		static LARGE_INTEGER frequency;
+		static LARGE_INTEGER startTime;
+
+		if (!frequency.QuadPart) {
+			QueryPerformanceFrequency(&frequency);
+			QueryPerformanceCounter(&startTime);
+		}
+
+		LARGE_INTEGER currentTime;
+		QueryPerformanceCounter(&currentTime);
+		return static_cast<double>(currentTime.QuadPart - startTime.QuadPart) * 1000000.0 / static_cast<double>(frequency.QuadPart);
+#else
+		static timeval startTime;
+		timeval currentTime;
+		gettimeofday(&currentTime, 0);
+
+		if (!startTime.tv_sec && !startTime.tv_usec) {
+			startTime = currentTime;
+		}
+
+		return static_cast<double>(currentTime.tv_sec - startTime.tv_sec) * 1000000.0 +
+		       static_cast<double>(currentTime.tv_usec - startTime.tv_usec);
+#endif
+	}
+
+	void Profiler::writeJsonString(std::ostream &output, const char *text) {
+		output << '"';
+
+		for (const char *i = text; *i; ++i) {
+			if (*i == '"' || *i == '\\') {
+				output << '\\' << *i;
+
+			} else if (static_cast<unsigned char>(*i) < 0x20) {
+				output << ' ';
+
+			} else {
+				output << *i;
+			}
+		}
+
+		output << '"';
+	}
+
+	Profiler::Profiler() : frames(DEFAULT_NB_FRAMES_KEPT), currentFrame(0),
+		nbFrames(0), openZones() {
+	}
+
+	Profiler::Frame &Profiler::getCurrentFrame() {
+		// Zones opened before the first frame start one.
+		if (!nbFrames) {
+			beginFrame();
+		}
+
+		return frames[currentFrame];
+	}
+
+	ProfileZone::ProfileZone(const char *name, bool newFrame) {
+		if (newFrame) {
+			Profiler::beginFrame();
+		}
+
+		Profiler::beginZone(name);
+	}
+
+	ProfileZone::~ProfileZone() {
+		Profiler::endZone();
+	}
+}
@@ -0,0 +1,217 @@
+/**
+ * @file
+ * @ingroup Debug
+ */
+#ifndef RB_PROFILER_H
+#define RB_PROFILER_H
+
+#include <vector>
+#include <string>
+#include <iostream>
+
+#include "BaconBox/PlatformFlagger.h"
+
+// Define RB_PROFILER to record the zones, the macros expand to nothing
+// otherwise.
+#ifdef RB_PROFILER
+	#define RB_PROFILE_CONCAT_IMPL(a, b) a ## b
+	#define RB_PROFILE_CONCAT(a, b) RB_PROFILE_CONCAT_IMPL(a, b)
+
+	/// Times the rest of the enclosing scope as a zone with the given name.
+	#define RB_PROFILE_ZONE(name) BaconBox::ProfileZone RB_PROFILE_CONCAT(rbProfileZone, __LINE__)(name)
+
+	/// Starts a new frame and times the rest of the enclosing scope.
+	#define RB_PROFILE_FRAME(name) BaconBox::ProfileZone RB_PROFILE_CONCAT(rbProfileZone, __LINE__)(name, true)
+#else
+	#define RB_PROFILE_ZONE(name)
+	#define RB_PROFILE_FRAME(name)
+#endif // RB_PROFILER
+
+namespace BaconBox {
+	/**
+	 * Records how long the zones placed with RB_PROFILE_ZONE take in each
+	 * frame. The last frames are kept in a ring buffer and can be exported
+	 * to the Chrome trace format (chrome://tracing or Perfetto) to look at
+	 * the frame spikes. The zones have to be on the main thread.
+	 * @ingroup Debug
+	 */
+	class Profiler {
+	public:
+		/// Number of frames kept by default, 5 seconds at 60 updates per second.
+		static const unsigned int DEFAULT_NB_FRAMES_KEPT = 300;
+
+		/**
+		 * Gets the maximum number of frames kept.
+		 * @return Number of frames kept before the oldest ones are replaced.
+		 */
+		static unsigned int getNbFramesKept();
+
+		/**
+		 * Sets the maximum number of frames kept. Clears the recorded frames.
+		 * @param newNbFramesKept Number of frames kept before the oldest ones
+		 * are replaced, must be at least 1.
+		 */
+		static void setNbFramesKept(unsigned int newNbFramesKept);
+
+		/**
+		 * Gets the number of frames recorded.
+		 * @return Number of frames recorded, at most the number of frames
+		 * kept.
+		 */
+		static unsigned int getNbFrames();
+
+		/**
+		 * Gets a recorded frame's duration.
+		 * @param index Index of the frame, 0 being the oldest frame recorded.
+		 * @return Time taken by the frame (in seconds), 0 if the index is out
+		 * of bounds or if the frame isn't over yet.
+		 */
+		static double getFrameDuration(unsigned int index);
+
+		/**
+		 * Forgets the recorded frames.
+		 */
+		static void clear();
+
+		/**
+		 * Writes the recorded frames' zones in the Chrome trace JSON format.
+		 * @param output Stream to write the trace to.
+		 */
+		static void writeChromeTrace(std::ostream &output);
+
+		/**
+		 * Saves the recorded frames' zones in the Chrome trace JSON format.
+		 * @param filePath Path to the file to write.
+		 * @return True if the file was written, false if not.
+		 */
+		static bool saveChromeTrace(const std::string &filePath);
+
+		/**
+		 * Starts a new frame, replacing the oldest one if the ring buffer is
+		 * full. Does nothing while zones are open, so a frame run within
+		 * another one is part of it. Called by RB_PROFILE_FRAME.
+		 */
+		static void beginFrame();
+
+		/**
+		 * Opens a zone in the current frame. Called by RB_PROFILE_ZONE.
+		 * @param name Name of the zone, must outlive the profiler (usually
+		 * a string literal).
+		 */
+		static void beginZone(const char *name);
+
+		/**
+		 * Closes the last zone opened. Called by RB_PROFILE_ZONE.
+		 */
+		static void endZone();
+	private:
+		/**
+		 * Timing of a zone within a frame.
+		 */
+		struct Zone {
+			/// Name of the zone.
+			const char *name;
+
+			/// Time at which the zone was opened (in microseconds).
+			double start;
+
+			/// Time taken by the zone (in microseconds), negative while open.
+			double duration;
+
+			/// Number of zones the zone is in.
+			unsigned int depth;
+		};
+
+		/**
+		 * Zones recorded during a frame.
+		 */
+		struct Frame {
+			/// Time at which the frame started (in microseconds).
+			double start;
+
+			/// Time taken by the frame (in microseconds).
+			double duration;
+
+			/// Zones in the order they were opened.
+			std::vector<Zone> zones;
+		};
+
+		/**
+		 * Gets the profiler's instance.
+		 * @return Reference to the profiler's instance.
+		 */
+		static Profiler &getInstance();
+
+		/**
+		 * Gets the time elapsed since the profiler was created. Uses the
+		 * system's clock directly so it isn't affected by the virtual clock
+		 * or the time scaling.
+		 * @return Time elapsed (in microseconds).
+		 */
+		static double getTime();
+
+		/**
+		 * Escapes a string to write it in JSON.
+		 * @param output Stream to write the escaped string to.
+		 * @param text String to escape.
+		 */
+		static void writeJsonString(std::ostream &output, const char *text);
+
+		/**
+		 * Default constructor.
+		 */
+		Profiler();
+
+		/**
+		 * Gets the frame being recorded.
+		 * @return Reference to the current frame.
+		 */
+		Frame &getCurrentFrame();
+
+		/// Ring buffer of frames, its size is the number of frames kept.
+		std::vector<Frame> frames;
+
+		/// Index of the frame being recorded.
+		unsigned int currentFrame;
+
+		/// Number of frames recorded.
+		unsigned int nbFrames;
+
+		/// Indexes of the zones opened in the current frame.
+		std::vector<unsigned int> openZones;
+	};
+
+	/**
+	 * Opens a profiler zone at its construction and closes it at its
+	 * destruction. Use RB_PROFILE_ZONE and RB_PROFILE_FRAME instead of
+	 * using it directly, so the zones are removed from the builds without
+	 * RB_PROFILER.
+	 * @ingroup Debug
+	 */
+	class ProfileZone {
+	public:
+		/**
+		 * Opens the zone.
+		 * @param name Name of the zone, usually a string literal.
+		 * @param newFrame Set to true to start a new frame first.
+		 */
+		explicit ProfileZone(const char *name, bool newFrame = false);
+
+		/**
+		 * Closes the zone.
+		 */
+		~ProfileZone();
+	private:
+		/**
+		 * Private undefined copy constructor, a zone is closed only once.
+		 */
+		ProfileZone(const ProfileZone &src);
+
+		/**
+		 * Private undefined assignment operator.
+		 */
+		ProfileZone &operator=(const ProfileZone &src);
+	};
+}
+
+#endif // RB_PROFILER_H
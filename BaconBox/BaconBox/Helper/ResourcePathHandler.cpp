@@ -192,4 +192,33 @@ namespace BaconBox {
 
 		return result;
 	}
+
+	bool ResourcePathHandler::readFile(const std::string &filePath,
+	                                   std::vector<char> &content) {
+		std::ifstream file(filePath.c_str(), std::ios::binary);
+		bool result = false;
+
+		if (file.is_open()) {
+			// We get the file's size to read it all at once.
+			file.seekg(0, std::ios::end);
+			std::streamoff size = file.tellg();
+			file.seekg(0, std::ios::beg);
+
+			if (size >= 0) {
+				content.resize(static_cast<std::vector<char>::size_type>(size));
+
+				if (!content.empty()) {
+					file.read(&content[0], size);
+				}
+
+				result = !file.fail();
+			}
+		}
+
+		if (!result) {
+			content.clear();
+		}
+
+		return result;
+	}
 }
@@ -14,6 +14,8 @@
 #define RB_RESOURCE_PATH_HANDLER_H
 
 #include <string>
+#include <vector>
+
 namespace BaconBox {
 	/**
 	 * Functions used to get the resource paths for files. All slashes must be
@@ -81,6 +83,15 @@ namespace BaconBox {
 		 * @return True if the file exists and is writable, false if not.
 		 */
 		static bool isFileWritable(const std::string &filePath);
+
+		/**
+		 * Reads a whole file in memory. Can be called from any thread.
+		 * @param filePath Path to the file to read.
+		 * @param content Set to the file's content.
+		 * @return True if the file was read, false if not.
+		 */
+		static bool readFile(const std::string &filePath,
+		                     std::vector<char> &content);
 	private:
 		/**
 		 * Default constructor, to make sure no one tries to instantiate this
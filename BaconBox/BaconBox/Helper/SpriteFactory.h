@@ -28,7 +28,8 @@ namespace BaconBox {
 		 * @param color Polygon's color when rendered.
 		 * @return Pointer to the sprite constructed.
 		 * @tparam A type that is derived from Shapable, Colorable and
-		 * RenderModable.
+		 * RenderModable and that keeps its shape in local space, like the
+		 * graphic elements.
 		 */
 		template <typename T>
 		static T *makeSpecificPolygon(unsigned int nbSides, float sideLength,
@@ -39,6 +40,7 @@ namespace BaconBox {
 				result = new T();
 				result->getVertices().resize(nbSides);
 				ShapeFactory::createRegularPolygon(nbSides, sideLength, Vector2(), &(result->getVertices()));
+				result->resetLocalShape();
 				result->setColor(color);
 				result->setRenderModes(FlagSet<RenderMode>(RenderMode::SHAPE) |
 				                       FlagSet<RenderMode>(RenderMode::COLOR));
@@ -62,6 +62,9 @@ bool TimeHelper::isPaused() const {
 	return paused;
 }
 
+void TimeHelper::advance(double) {
+}
+
 TimeHelper::TimeHelper() : sinceStart(0.0), sinceStartReal(0.0),
 sinceStartComplete(0.0), timeScale(1.0), paused(false) {
 }
@@ -113,6 +113,13 @@ namespace BaconBox {
 		 * Refreshes the time variable.
 		 */
 		virtual void refreshTime() = 0;
+		/**
+		 * Advances a virtual clock without waiting. Used by the engine when it
+		 * steps faster than real time. Clocks that follow the system's time
+		 * ignore it.
+		 * @param duration Time to add to the clock (in seconds).
+		 */
+		virtual void advance(double duration);
 	private:
 		/**
 		 * Time scaling. The higher the value, the faster the time is being
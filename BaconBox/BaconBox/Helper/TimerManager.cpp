@@ -4,6 +4,7 @@
 #include <algorithm>
 
 #include "BaconBox/Helper/Timer.h"
+#include "BaconBox/Helper/Profiler.h"
 
 using namespace BaconBox;
 
@@ -20,6 +21,8 @@ void TimerManager::removeTimer(Timer *timer) {
 }
 
 void TimerManager::update() {
+	RB_PROFILE_ZONE("TimerManager::update");
+
 	// We update the timers.
 	std::for_each(timers.begin(), timers.end(), TimerManager::updateTimer);
 }
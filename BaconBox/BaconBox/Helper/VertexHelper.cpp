@@ -0,0 +1,283 @@
+#include "BaconBox/Helper/VertexHelper.h"
+
+#include <cmath>
+
+#include "BaconBox/PlatformFlagger.h"
+#include "BaconBox/Helper/MathHelper.h"
+#include "BaconBox/Helper/StaticAssert.h"
+
+#if defined(RB_SSE2)
+#include <emmintrin.h>
+#elif defined(RB_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace BaconBox {
+	/// The kernels read the vertices as contiguous pairs of floats.
+	typedef StaticAssert<sizeof(Vector2) == 2 * sizeof(float)>::Result IsVector2Packed;
+
+	/**
+	 * Applies an affine transform around a point to vertices. Each
+	 * destination vertex is origin + xAxis * (source.x - center.x) +
+	 * yAxis * (source.y - center.y).
+	 * @param source Pointer to the first vertex to transform.
+	 * @param nbVertices Number of vertices to transform.
+	 * @param destination Pointer to the first vertex to write.
+	 * @param center Point subtracted from the vertices before the transform.
+	 * @param origin Translation of the transform.
+	 * @param xAxis Vector the horizontal coordinates are multiplied by.
+	 * @param yAxis Vector the vertical coordinates are multiplied by.
+	 */
+	static void transformFromPoint(const Vector2 *source, std::size_t nbVertices,
+	                               Vector2 *destination, const Vector2 &center,
+	                               const Vector2 &origin, const Vector2 &xAxis,
+	                               const Vector2 &yAxis) {
+		std::size_t i = 0;
+#if defined(RB_SSE2)
+		// We transform the vertices two by two, the x and y coordinates are
+		// duplicated to be multiplied by both axes at the same time.
+		const float *in = reinterpret_cast<const float *>(source);
+		float *out = reinterpret_cast<float *>(destination);
+		__m128 centers = _mm_setr_ps(center.x, center.y, center.x, center.y);
+		__m128 origins = _mm_setr_ps(origin.x, origin.y, origin.x, origin.y);
+		__m128 xAxes = _mm_setr_ps(xAxis.x, xAxis.y, xAxis.x, xAxis.y);
+		__m128 yAxes = _mm_setr_ps(yAxis.x, yAxis.y, yAxis.x, yAxis.y);
+
+		for (; i + 2 <= nbVertices; i += 2) {
+			__m128 vertices = _mm_sub_ps(_mm_loadu_ps(in + i * 2), centers);
+			__m128 xs = _mm_shuffle_ps(vertices, vertices, _MM_SHUFFLE(2, 2, 0, 0));
+			__m128 ys = _mm_shuffle_ps(vertices, vertices, _MM_SHUFFLE(3, 3, 1, 1));
+			_mm_storeu_ps(out + i * 2, _mm_add_ps(origins,
+			                                      _mm_add_ps(_mm_mul_ps(xAxes, xs),
+			                                                 _mm_mul_ps(yAxes, ys))));
+		}
+
+#elif defined(RB_NEON)
+		// We transform the vertices four by four, the loads split the x and
+		// y coordinates in separate registers.
+		const float *in = reinterpret_cast<const float *>(source);
+		float *out = reinterpret_cast<float *>(destination);
+		float32x4_t xOrigins = vdupq_n_f32(origin.x);
+		float32x4_t yOrigins = vdupq_n_f32(origin.y);
+
+		for (; i + 4 <= nbVertices; i += 4) {
+			float32x4x2_t vertices = vld2q_f32(in + i * 2);
+			float32x4_t xs = vsubq_f32(vertices.val[0], vdupq_n_f32(center.x));
+			float32x4_t ys = vsubq_f32(vertices.val[1], vdupq_n_f32(center.y));
+			vertices.val[0] = vmlaq_n_f32(vmlaq_n_f32(xOrigins, xs, xAxis.x), ys, yAxis.x);
+			vertices.val[1] = vmlaq_n_f32(vmlaq_n_f32(yOrigins, xs, xAxis.y), ys, yAxis.y);
+			vst2q_f32(out + i * 2, vertices);
+		}
+
+#endif
+
+		// We copy the transform so the compiler doesn't reload it after
+		// each write to the destination.
+		float centerX = center.x, centerY = center.y;
+		float originX = origin.x, originY = origin.y;
+		float xAxisX = xAxis.x, xAxisY = xAxis.y;
+		float yAxisX = yAxis.x, yAxisY = yAxis.y;
+
+		for (; i < nbVertices; ++i) {
+			float x = source[i].x - centerX;
+			float y = source[i].y - centerY;
+			destination[i].x = originX + xAxisX * x + yAxisX * y;
+			destination[i].y = originY + xAxisY * x + yAxisY * y;
+		}
+	}
+
+	void VertexHelper::move(Vector2 *vertices, std::size_t nbVertices,
+	                        const Vector2 &delta) {
+		std::size_t i = 0;
+#if defined(RB_SSE2)
+		float *values = reinterpret_cast<float *>(vertices);
+		__m128 deltas = _mm_setr_ps(delta.x, delta.y, delta.x, delta.y);
+
+		for (; i + 2 <= nbVertices; i += 2) {
+			_mm_storeu_ps(values + i * 2, _mm_add_ps(_mm_loadu_ps(values + i * 2), deltas));
+		}
+
+#elif defined(RB_NEON)
+		float *values = reinterpret_cast<float *>(vertices);
+		float32x2_t delta2 = vld1_f32(&delta.x);
+		float32x4_t deltas = vcombine_f32(delta2, delta2);
+
+		for (; i + 2 <= nbVertices; i += 2) {
+			vst1q_f32(values + i * 2, vaddq_f32(vld1q_f32(values + i * 2), deltas));
+		}
+
+#endif
+
+		float xDelta = delta.x, yDelta = delta.y;
+
+		for (; i < nbVertices; ++i) {
+			vertices[i].x += xDelta;
+			vertices[i].y += yDelta;
+		}
+	}
+
+	void VertexHelper::scaleFromPoint(Vector2 *vertices, std::size_t nbVertices,
+	                                  const Vector2 &scaling,
+	                                  const Vector2 &fromPoint) {
+		transformFromPoint(vertices, nbVertices, vertices, fromPoint, fromPoint,
+		                   Vector2(scaling.x, 0.0f), Vector2(0.0f, scaling.y));
+	}
+
+	void VertexHelper::rotateFromPoint(Vector2 *vertices, std::size_t nbVertices,
+	                                   float rotationAngle,
+	                                   const Vector2 &rotationPoint) {
+		// We use the same rotation as Vector2::rotate, but we compute the
+		// sine and the cosine only once.
+		float radians = MathHelper::AngleConvert<float>::DEGREES_TO_RADIANS * rotationAngle;
+		float cosine = std::cos(radians);
+		float sine = std::sin(radians);
+		transformFromPoint(vertices, nbVertices, vertices, rotationPoint,
+		                   rotationPoint, Vector2(cosine, -sine),
+		                   Vector2(sine, cosine));
+	}
+
+	void VertexHelper::transform(const Vector2 *source, std::size_t nbVertices,
+	                             Vector2 *destination, const Vector2 &origin,
+	                             const Vector2 &xAxis, const Vector2 &yAxis) {
+		transformFromPoint(source, nbVertices, destination, Vector2(), origin,
+		                   xAxis, yAxis);
+	}
+
+	const Vector2 VertexHelper::getSum(const Vector2 *vertices,
+	                                   std::size_t nbVertices) {
+		Vector2 result;
+		std::size_t i = 0;
+#if defined(RB_SSE2)
+		const float *values = reinterpret_cast<const float *>(vertices);
+		__m128 sums = _mm_setzero_ps();
+
+		for (; i + 2 <= nbVertices; i += 2) {
+			sums = _mm_add_ps(sums, _mm_loadu_ps(values + i * 2));
+		}
+
+		// We add the two halves of the sums together.
+		sums = _mm_add_ps(sums, _mm_movehl_ps(sums, sums));
+		result.x = _mm_cvtss_f32(sums);
+		result.y = _mm_cvtss_f32(_mm_shuffle_ps(sums, sums, _MM_SHUFFLE(1, 1, 1, 1)));
+#elif defined(RB_NEON)
+		const float *values = reinterpret_cast<const float *>(vertices);
+		float32x4_t xSums = vdupq_n_f32(0.0f);
+		float32x4_t ySums = vdupq_n_f32(0.0f);
+
+		for (; i + 4 <= nbVertices; i += 4) {
+			float32x4x2_t tmpVertices = vld2q_f32(values + i * 2);
+			xSums = vaddq_f32(xSums, tmpVertices.val[0]);
+			ySums = vaddq_f32(ySums, tmpVertices.val[1]);
+		}
+
+		// We add the lanes together, the x sum ends up in the first lane and
+		// the y sum in the second one.
+		float32x2_t sums = vpadd_f32(vpadd_f32(vget_low_f32(xSums), vget_high_f32(xSums)),
+		                             vpadd_f32(vget_low_f32(ySums), vget_high_f32(ySums)));
+		result.x = vget_lane_f32(sums, 0);
+		result.y = vget_lane_f32(sums, 1);
+#endif
+
+		for (; i < nbVertices; ++i) {
+			result.x += vertices[i].x;
+			result.y += vertices[i].y;
+		}
+
+		return result;
+	}
+
+	void VertexHelper::getBounds(const Vector2 *vertices, std::size_t nbVertices,
+	                             Vector2 &minimum, Vector2 &maximum) {
+		// We work on copies so the compiler can keep the bounds in registers.
+		Vector2 tmpMinimum(vertices[0]);
+		Vector2 tmpMaximum(vertices[0]);
+		std::size_t i = 1;
+#if defined(RB_SSE2)
+		const float *values = reinterpret_cast<const float *>(vertices);
+		__m128 minimums = _mm_setr_ps(tmpMinimum.x, tmpMinimum.y, tmpMinimum.x, tmpMinimum.y);
+		__m128 maximums = minimums;
+
+		for (i = 0; i + 2 <= nbVertices; i += 2) {
+			__m128 tmpVertices = _mm_loadu_ps(values + i * 2);
+			minimums = _mm_min_ps(minimums, tmpVertices);
+			maximums = _mm_max_ps(maximums, tmpVertices);
+		}
+
+		// We compare the two halves of the bounds.
+		minimums = _mm_min_ps(minimums, _mm_movehl_ps(minimums, minimums));
+		maximums = _mm_max_ps(maximums, _mm_movehl_ps(maximums, maximums));
+		tmpMinimum.x = _mm_cvtss_f32(minimums);
+		tmpMinimum.y = _mm_cvtss_f32(_mm_shuffle_ps(minimums, minimums, _MM_SHUFFLE(1, 1, 1, 1)));
+		tmpMaximum.x = _mm_cvtss_f32(maximums);
+		tmpMaximum.y = _mm_cvtss_f32(_mm_shuffle_ps(maximums, maximums, _MM_SHUFFLE(1, 1, 1, 1)));
+#elif defined(RB_NEON)
+		const float *values = reinterpret_cast<const float *>(vertices);
+		float32x4_t xMinimums = vdupq_n_f32(tmpMinimum.x);
+		float32x4_t yMinimums = vdupq_n_f32(tmpMinimum.y);
+		float32x4_t xMaximums = xMinimums;
+		float32x4_t yMaximums = yMinimums;
+
+		for (i = 0; i + 4 <= nbVertices; i += 4) {
+			float32x4x2_t tmpVertices = vld2q_f32(values + i * 2);
+			xMinimums = vminq_f32(xMinimums, tmpVertices.val[0]);
+			yMinimums = vminq_f32(yMinimums, tmpVertices.val[1]);
+			xMaximums = vmaxq_f32(xMaximums, tmpVertices.val[0]);
+			yMaximums = vmaxq_f32(yMaximums, tmpVertices.val[1]);
+		}
+
+		// We compare the lanes together, the x bound ends up in the first
+		// lane and the y bound in the second one.
+		float32x2_t minimums = vpmin_f32(vpmin_f32(vget_low_f32(xMinimums), vget_high_f32(xMinimums)),
+		                                 vpmin_f32(vget_low_f32(yMinimums), vget_high_f32(yMinimums)));
+		float32x2_t maximums = vpmax_f32(vpmax_f32(vget_low_f32(xMaximums), vget_high_f32(xMaximums)),
+		                                 vpmax_f32(vget_low_f32(yMaximums), vget_high_f32(yMaximums)));
+		tmpMinimum.x = vget_lane_f32(minimums, 0);
+		tmpMinimum.y = vget_lane_f32(minimums, 1);
+		tmpMaximum.x = vget_lane_f32(maximums, 0);
+		tmpMaximum.y = vget_lane_f32(maximums, 1);
+#endif
+
+		// We use conditional expressions instead of branches, the compiler
+		// turns them into minimum and maximum instructions.
+		for (; i < nbVertices; ++i) {
+			float x = vertices[i].x, y = vertices[i].y;
+			tmpMinimum.x = (x < tmpMinimum.x) ? (x) : (tmpMinimum.x);
+			tmpMinimum.y = (y < tmpMinimum.y) ? (y) : (tmpMinimum.y);
+			tmpMaximum.x = (x > tmpMaximum.x) ? (x) : (tmpMaximum.x);
+			tmpMaximum.y = (y > tmpMaximum.y) ? (y) : (tmpMaximum.y);
+		}
+
+		minimum = tmpMinimum;
+		maximum = tmpMaximum;
+	}
+
+	void VertexHelper::copyStrided(const Vector2 *source, std::size_t nbVertices,
+	                               Vector2 *destination, std::size_t stride) {
+		char *out = reinterpret_cast<char *>(destination);
+		std::size_t i = 0;
+#if defined(RB_SSE2)
+		// We load the vertices two by two and store each half separately.
+		const float *in = reinterpret_cast<const float *>(source);
+
+		for (; i + 2 <= nbVertices; i += 2) {
+			__m128 tmpVertices = _mm_loadu_ps(in + i * 2);
+			_mm_storel_pi(reinterpret_cast<__m64 *>(out + i * stride), tmpVertices);
+			_mm_storeh_pi(reinterpret_cast<__m64 *>(out + (i + 1) * stride), tmpVertices);
+		}
+
+#elif defined(RB_NEON)
+		const float *in = reinterpret_cast<const float *>(source);
+
+		for (; i + 2 <= nbVertices; i += 2) {
+			float32x4_t tmpVertices = vld1q_f32(in + i * 2);
+			vst1_f32(reinterpret_cast<float *>(out + i * stride), vget_low_f32(tmpVertices));
+			vst1_f32(reinterpret_cast<float *>(out + (i + 1) * stride), vget_high_f32(tmpVertices));
+		}
+
+#endif
+
+		for (; i < nbVertices; ++i) {
+			*reinterpret_cast<Vector2 *>(out + i * stride) = source[i];
+		}
+	}
+}
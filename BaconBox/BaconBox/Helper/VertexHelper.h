@@ -0,0 +1,109 @@
+/**
+ * @file
+ * @ingroup Helper
+ */
+#ifndef RB_VERTEX_HELPER_H
+#define RB_VERTEX_HELPER_H
+
+#include <cstddef>
+
+#include "BaconBox/Vector2.h"
+
+namespace BaconBox {
+	/**
+	 * Kernels that work on whole spans of contiguous vertices. They use SSE2
+	 * or NEON when the build targets them (see RB_SSE2 and RB_NEON in
+	 * PlatformFlagger.h) and plain loops otherwise. Define RB_NO_SIMD to
+	 * force the plain loops.
+	 * @ingroup Helper
+	 */
+	class VertexHelper {
+	public:
+		/**
+		 * Moves vertices.
+		 * @param vertices Pointer to the first vertex.
+		 * @param nbVertices Number of vertices to move.
+		 * @param delta Movement to add to each vertex.
+		 */
+		static void move(Vector2 *vertices, std::size_t nbVertices,
+		                 const Vector2 &delta);
+
+		/**
+		 * Scales vertices from a point.
+		 * @param vertices Pointer to the first vertex.
+		 * @param nbVertices Number of vertices to scale.
+		 * @param scaling Horizontal and vertical scaling to apply.
+		 * @param fromPoint Anchor point from which to apply the scaling.
+		 */
+		static void scaleFromPoint(Vector2 *vertices, std::size_t nbVertices,
+		                           const Vector2 &scaling,
+		                           const Vector2 &fromPoint);
+
+		/**
+		 * Rotates vertices around a point. The rotation matrix is computed
+		 * once for all the vertices.
+		 * @param vertices Pointer to the first vertex.
+		 * @param nbVertices Number of vertices to rotate.
+		 * @param rotationAngle Angle to rotate the vertices (in degrees).
+		 * @param rotationPoint Origin point on which to apply the rotation.
+		 * @see BaconBox::Vector2::rotate(ValueType angle)
+		 */
+		static void rotateFromPoint(Vector2 *vertices, std::size_t nbVertices,
+		                            float rotationAngle,
+		                            const Vector2 &rotationPoint);
+
+		/**
+		 * Applies an affine transform to vertices. Each destination vertex
+		 * is origin + xAxis * source.x + yAxis * source.y. The source and the
+		 * destination can be the same span.
+		 * @param source Pointer to the first vertex to transform.
+		 * @param nbVertices Number of vertices to transform.
+		 * @param destination Pointer to the first vertex to write.
+		 * @param origin Translation of the transform.
+		 * @param xAxis Vector the horizontal coordinates are multiplied by.
+		 * @param yAxis Vector the vertical coordinates are multiplied by.
+		 */
+		static void transform(const Vector2 *source, std::size_t nbVertices,
+		                      Vector2 *destination, const Vector2 &origin,
+		                      const Vector2 &xAxis, const Vector2 &yAxis);
+
+		/**
+		 * Gets the sum of vertices.
+		 * @param vertices Pointer to the first vertex.
+		 * @param nbVertices Number of vertices to add.
+		 * @return Sum of the vertices.
+		 */
+		static const Vector2 getSum(const Vector2 *vertices,
+		                            std::size_t nbVertices);
+
+		/**
+		 * Gets the bounds of vertices.
+		 * @param vertices Pointer to the first vertex.
+		 * @param nbVertices Number of vertices, must be at least 1.
+		 * @param minimum Set to the minimum horizontal and vertical
+		 * coordinates.
+		 * @param maximum Set to the maximum horizontal and vertical
+		 * coordinates.
+		 */
+		static void getBounds(const Vector2 *vertices, std::size_t nbVertices,
+		                      Vector2 &minimum, Vector2 &maximum);
+
+		/**
+		 * Copies vertices to a strided destination, like the positions of
+		 * interleaved vertices.
+		 * @param source Pointer to the first vertex to copy.
+		 * @param nbVertices Number of vertices to copy.
+		 * @param destination Pointer to the first destination vertex.
+		 * @param stride Number of bytes between two destination vertices.
+		 */
+		static void copyStrided(const Vector2 *source, std::size_t nbVertices,
+		                        Vector2 *destination, std::size_t stride);
+	private:
+		/**
+		 * Private undefined constructor, the helper only has static functions.
+		 */
+		VertexHelper();
+	};
+}
+
+#endif // RB_VERTEX_HELPER_H
@@ -0,0 +1,27 @@
+#include "BaconBox/Helper/VirtualTimeHelper.h"
+
+using namespace BaconBox;
+
+VirtualTimeHelper::VirtualTimeHelper() : TimeHelper() {
+}
+
+VirtualTimeHelper::~VirtualTimeHelper() {
+}
+
+void VirtualTimeHelper::sleep(double duration) {
+	advance(duration);
+}
+
+void VirtualTimeHelper::refreshTime() {
+}
+
+void VirtualTimeHelper::advance(double duration) {
+	// We add time to sinceStart and sinceStartReal only if the game isn't
+	// paused.
+	if (!isPaused()) {
+		sinceStart += duration * getTimeScale();
+		sinceStartReal += duration;
+	}
+
+	sinceStartComplete += duration;
+}
@@ -0,0 +1,50 @@
+/**
+ * @file
+ * @ingroup Helper
+ */
+#ifndef RB_VIRTUAL_TIME_HELPER_H
+#define RB_VIRTUAL_TIME_HELPER_H
+
+#include "BaconBox/Helper/TimeHelper.h"
+
+namespace BaconBox {
+	/**
+	 * Clock that doesn't follow the system's time, it only moves forward when
+	 * the engine advances it. Used by the headless builds (see RB_HEADLESS in
+	 * PlatformFlagger.h) so the camera shakes, the tile animations and the
+	 * stopwatches follow the simulation instead of the wall clock.
+	 * @ingroup Helper
+	 */
+	class VirtualTimeHelper : public TimeHelper {
+		friend class TimeHelper;
+	public:
+		/**
+		 * Advances the clock by the duration instead of sleeping.
+		 * @param duration Duration of the sleep.
+		 */
+		void sleep(double duration);
+	private:
+		/**
+		 * Default constructor.
+		 */
+		VirtualTimeHelper();
+
+		/**
+		 * Destructor.
+		 */
+		~VirtualTimeHelper();
+
+		/**
+		 * Does nothing, the time only changes when the clock is advanced.
+		 */
+		void refreshTime();
+
+		/**
+		 * Advances the clock.
+		 * @param duration Time to add to the clock (in seconds).
+		 */
+		void advance(double duration);
+	};
+}
+
+#endif // RB_VIRTUAL_TIME_HELPER_H
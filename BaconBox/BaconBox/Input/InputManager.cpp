@@ -1,6 +1,7 @@
 #include "BaconBox/Input/InputManager.h"
 
 #include "BaconBox/PlatformFlagger.h"
+#include "BaconBox/Helper/Profiler.h"
 
 #ifdef RB_ACCELEROMETER_INCLUDE
 #include RB_ACCELEROMETER_INCLUDE
@@ -233,6 +234,8 @@ InputManager::~InputManager() {
 }
 
 void InputManager::update() {
+	RB_PROFILE_ZONE("InputManager::update");
+
 	for (std::vector<Accelerometer*>::iterator i = accelerometers.begin();
 		 i != accelerometers.end(); ++i) {
 		if(*i) {
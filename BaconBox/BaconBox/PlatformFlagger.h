@@ -14,6 +14,17 @@
 	#define RB_SDL
 #endif
 
+// Headless builds have no window and use the null drivers, whatever other
+// platform is defined.
+#ifdef HEADLESS
+	#define RB_HEADLESS
+#endif
+
+#ifdef RB_HEADLESS
+	#undef RB_SDL
+	#undef RB_QT
+#endif // RB_HEADLESS
+
 
 /*******************************************************************************
  * System-specific defines
@@ -34,6 +45,9 @@
 	#ifndef RB_ANDROID
 		#define RB_HAS_GCC_STACKTRACE
 	#endif
+
+	#define RB_THREADS
+	#define RB_HAS_MMAP
 #endif // linux
 
 //Windows systems
@@ -84,6 +98,9 @@
 	#endif
 
 	#define RB_HAS_GCC_STACKTRACE
+
+	#define RB_THREADS
+	#define RB_HAS_MMAP
 #endif // __APPLE__
 
 /*******************************************************************************
@@ -163,11 +180,47 @@
 	#define RB_MAIN_WINDOW_INCLUDE "BaconBox/Input/Pointer/ios/IOSMainWindow.h"
 #endif // RB_IPHONE_PLATFORM
 
+//Headless platform
+#ifdef RB_HEADLESS
+	// No graphics at all, the null graphic driver is used.
+	#undef RB_OPENGL
+	#undef RB_OPENGLES
+
+	// Time only advances with the simulation.
+	#undef RB_TIME_HELPER_IMPL
+	#undef RB_TIME_HELPER_INCLUDE
+	#define RB_TIME_HELPER_IMPL BaconBox::VirtualTimeHelper
+	#define RB_TIME_HELPER_INCLUDE "BaconBox/Helper/VirtualTimeHelper.h"
+#endif // RB_HEADLESS
+
 #if defined (RB_OPENGL) || defined (RB_OPENGLES)
-	#define RB_GRAPHIC_DRIVER_IMPL new OpenGLDriver()
-	#define RB_GRAPHIC_DRIVER_INCLUDE "BaconBox/Display/Driver/OpenGL/OpenGLDriver.h"
+	// Define RB_OPENGL_SHADERS to use the programmable pipeline (OpenGL 2.0
+	// or OpenGL ES 2.0) instead of the fixed pipeline.
+	#ifdef RB_OPENGL_SHADERS
+		#ifdef RB_OPENGLES
+			#define RB_OPENGLES2
+		#endif
+
+		#define RB_GRAPHIC_DRIVER_IMPL new ShaderDriver()
+		#define RB_GRAPHIC_DRIVER_INCLUDE "BaconBox/Display/Driver/OpenGL/ShaderDriver.h"
+	#else
+		#define RB_GRAPHIC_DRIVER_IMPL new OpenGLDriver()
+		#define RB_GRAPHIC_DRIVER_INCLUDE "BaconBox/Display/Driver/OpenGL/OpenGLDriver.h"
+	#endif
 #endif
 
+/*******************************************************************************
+ * Instruction set defines
+ ******************************************************************************/
+// Define RB_NO_SIMD to use the plain loops in the vertex kernels.
+#ifndef RB_NO_SIMD
+	#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		#define RB_SSE2
+	#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+		#define RB_NEON
+	#endif
+#endif // RB_NO_SIMD
+
 /*
 //Mac platform (without SDL or Qt) (currently unsupported)
 //TODO: Support mac platform with cocoa only and related defines
@@ -206,7 +259,7 @@
 // For NULL main window.
 #ifndef RB_MAIN_WINDOW_IMPL
 	#define RB_MAIN_WINDOW_IMPL new NullMainWindow()
-	#define RB_MAIN_WINDOW_INCLUDE "NullMainWindow.h"
+	#define RB_MAIN_WINDOW_INCLUDE "BaconBox/Display/Window/NullMainWindow.h"
 #endif
 
 // For NULL sound engine
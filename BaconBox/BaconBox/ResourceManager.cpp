@@ -6,6 +6,7 @@
 #include "BaconBox/Audio/BackgroundMusic.h"
 #include "BaconBox/Audio/SoundInfo.h"
 #include "BaconBox/Audio/MusicInfo.h"
+#include "BaconBox/Audio/SoundData.h"
 #include "BaconBox/Display/TextureInformation.h"
 #include "BaconBox/Audio/AudioEngine.h"
 #include "BaconBox/Audio/SoundEngine.h"
@@ -13,6 +14,11 @@
 #include "BaconBox/Display/Driver/GraphicDriver.h"
 #include "BaconBox/Helper/ResourcePathHandler.h"
 #include "BaconBox/Display/Color.h"
+#include "BaconBox/AsyncLoader.h"
+#include "BaconBox/AsyncLoadJob.h"
+#include "BaconBox/Display/TileMap/TileMap.h"
+#include "BaconBox/Display/TileMap/BinaryTileMapReader.h"
+#include "BaconBox/Display/TileMap/TinyXML/TmxTileMapReader.h"
 
 #ifndef RB_ANDROID
 #include "BaconBox/Display/Text/Font.h"
@@ -25,15 +31,215 @@
 #define PNG_HEADER_SIZE 8
 
 namespace BaconBox {
+	namespace {
+		/**
+		 * Decodes a texture's image on a worker thread and creates the
+		 * texture on the main thread.
+		 */
+		class TextureLoadJob : public AsyncLoadJob {
+		public:
+			TextureLoadJob(const std::string &newKey,
+			               const std::string &newFilePath,
+			               ColorFormat newColorFormat, bool newOverwrite) :
+				AsyncLoadJob(), key(newKey), filePath(newFilePath),
+				colorFormat(newColorFormat), transparentColor(),
+				useColorKey(false), overwrite(newOverwrite), pixMap(NULL) {
+			}
+
+			TextureLoadJob(const std::string &newKey,
+			               const std::string &newFilePath,
+			               const Color &newTransparentColor, bool newOverwrite) :
+				AsyncLoadJob(), key(newKey), filePath(newFilePath),
+				colorFormat(ColorFormat::RGBA),
+				transparentColor(newTransparentColor), useColorKey(true),
+				overwrite(newOverwrite), pixMap(NULL) {
+			}
+
+			~TextureLoadJob() {
+				delete pixMap;
+			}
+
+			void load() {
+				pixMap = (useColorKey) ? (ResourceManager::loadPixMap(filePath, transparentColor)) : (ResourceManager::loadPixMap(filePath, colorFormat));
+			}
+
+			bool finish() {
+				return pixMap && ResourceManager::addTexture(key, pixMap, overwrite);
+			}
+		private:
+			std::string key;
+			std::string filePath;
+			ColorFormat colorFormat;
+			Color transparentColor;
+			bool useColorKey;
+			bool overwrite;
+			PixMap *pixMap;
+		};
+	}
+
+	/**
+	 * Reads and decodes a sound effect, a music or a font on a worker thread.
+	 * The audio engines and the font renderer aren't thread safe, so only the
+	 * sound effect, the music or the font is created on the main thread.
+	 */
+	class ResourceManager::FileLoadJob : public AsyncLoadJob {
+	public:
+		enum ResourceType {
+			SOUND,
+			MUSIC,
+			FONT
+		};
+
+		FileLoadJob(ResourceType newType, const std::string &newKey,
+		            const std::string &newFilePath, bool newOverwrite) :
+			AsyncLoadJob(), type(newType), key(newKey), filePath(newFilePath),
+			overwrite(newOverwrite), soundData(NULL), fileContent(),
+			read(false) {
+		}
+
+		~FileLoadJob() {
+			delete soundData;
+		}
+
+		void load() {
+			switch (type) {
+			case SOUND:
+				soundData = ResourceManager::decodeSound(filePath);
+				read = soundData != NULL;
+				break;
+
+			case MUSIC:
+				read = ResourceManager::readMusic(filePath, fileContent);
+				break;
+
+			case FONT:
+				read = ResourcePathHandler::readFile(filePath, fileContent);
+				break;
+
+			default:
+				break;
+			}
+		}
+
+		bool finish() {
+			if (!read) {
+				Console::println("Couldn't read the file " + filePath +
+				                 " to load the resource named " + key + ".");
+				return false;
+			}
+
+			switch (type) {
+			case SOUND:
+				return ResourceManager::loadDecodedSound(key, *soundData, overwrite) != NULL;
+
+			case MUSIC:
+				return ResourceManager::loadMusicFromMemory(key, filePath, fileContent, overwrite) != NULL;
+
+#ifndef RB_ANDROID
+
+			case FONT:
+				return ResourceManager::loadFontFromMemory(key, fileContent, overwrite) != NULL;
+#endif
+
+			default:
+				return false;
+			}
+		}
+	private:
+		ResourceType type;
+		std::string key;
+		std::string filePath;
+		bool overwrite;
+		SoundData *soundData;
+		std::vector<char> fileContent;
+		bool read;
+	};
+
+	/**
+	 * Reads a tile map on a worker thread. The readers load the tilesets'
+	 * textures through the resource manager, which has the main thread
+	 * create them. The tile map is added to the tile maps' map on the main
+	 * thread.
+	 */
+	class ResourceManager::TileMapLoadJob : public AsyncLoadJob {
+	public:
+		TileMapLoadJob(const std::string &newKey,
+		               const std::string &newFilePath, bool newOverwrite) :
+			AsyncLoadJob(), key(newKey), filePath(newFilePath),
+			overwrite(newOverwrite), tileMap(NULL), errorMessage() {
+		}
+
+		~TileMapLoadJob() {
+			delete tileMap;
+		}
+
+		void load() {
+			TmxTileMapReader tmxReader;
+			BinaryTileMapReader binaryReader;
+			TileMapReader &reader = (tmxReader.supportsFile(filePath)) ? (static_cast<TileMapReader &>(tmxReader)) : (static_cast<TileMapReader &>(binaryReader));
+			tileMap = reader.read(filePath);
+
+			if (!tileMap) {
+				errorMessage = reader.getErrorMessage();
+			}
+		}
+
+		bool finish() {
+			if (!tileMap) {
+				Console::println("Couldn't load the tile map named " + key +
+				                 " found at " + filePath + ". " + errorMessage);
+				return false;
+			}
+
+			std::map<std::string, TileMap *>::iterator i = tileMaps.find(key);
+
+			if (i != tileMaps.end()) {
+				if (overwrite) {
+					// We replace the existing tile map.
+					delete i->second;
+					i->second = tileMap;
+					tileMap = NULL;
+					Console::println("Overwrote the existing tile map named " +
+					                 key + ".");
+
+				} else {
+					// We keep the existing tile map, the new one is deleted
+					// with the job.
+					Console::println("Couldn't load the tile map named " + key +
+					                 " found at " + filePath +
+					                 " because a tile map with that name already exists.");
+				}
+
+			} else {
+				tileMaps.insert(std::pair<std::string, TileMap *>(key, tileMap));
+				tileMap = NULL;
+			}
+
+			return true;
+		}
+	private:
+		std::string key;
+		std::string filePath;
+		bool overwrite;
+		TileMap *tileMap;
+		std::string errorMessage;
+	};
+
 	std::map<std::string, TextureInformation *> ResourceManager::textures = std::map<std::string, TextureInformation *>();
 	std::map<std::string, SoundInfo *> ResourceManager::sounds = std::map<std::string, SoundInfo *>();
 	std::map<std::string, MusicInfo *> ResourceManager::musics = std::map<std::string, MusicInfo *>();
 #ifndef RB_ANDROID
 	std::map<std::string, Font *> ResourceManager::fonts = std::map<std::string, Font *>();
 #endif
+	std::map<std::string, TileMap *> ResourceManager::tileMaps = std::map<std::string, TileMap *>();
 
 	TextureInformation *ResourceManager::addTexture(const std::string &key, PixMap *aPixmap,
 	                                                bool overwrite) {
+		// Textures added by the worker threads are created on the main thread.
+		if (!AsyncLoader::getInstance().isMainThread()) {
+			return AsyncLoader::getInstance().uploadTexture(key, aPixmap, overwrite);
+		}
+
 		TextureInformation *texInfo = NULL;
 
 		// We check if there is already a texture with this name.
@@ -411,7 +617,223 @@ namespace BaconBox {
 		fonts.erase(i);
 	}
 #endif
+
+	TileMap *ResourceManager::getTileMap(const std::string &key) {
+		std::map<std::string, TileMap *>::iterator itr = tileMaps.find(key);
+		return (itr != tileMaps.end()) ? (itr->second) : (NULL);
+	}
+
+	void ResourceManager::removeTileMap(const std::string &key) {
+		std::map<std::string, TileMap *>::iterator i = tileMaps.find(key);
+
+		if (i != tileMaps.end()) {
+			delete i->second;
+			tileMaps.erase(i);
+		}
+	}
+
+	AsyncLoadHandle ResourceManager::loadTextureAsync(const std::string &key,
+	                                                  const std::string &filePath,
+	                                                  ColorFormat colorFormat,
+	                                                  bool overwrite) {
+		return loadAsync(new TextureLoadJob(key, filePath, colorFormat, overwrite));
+	}
+
+	AsyncLoadHandle ResourceManager::loadTextureWithColorKeyAsync(const std::string &key,
+	                                                              const std::string &filePath,
+	                                                              const Color &transparentColor,
+	                                                              bool overwrite) {
+		return loadAsync(new TextureLoadJob(key, filePath, transparentColor, overwrite));
+	}
+
+	AsyncLoadHandle ResourceManager::loadTextureRelativePathAsync(const std::string &key,
+	                                                              const std::string &relativePath,
+	                                                              ColorFormat colorFormat,
+	                                                              bool overwrite) {
+		return loadTextureAsync(key,
+		                        ResourcePathHandler::getResourcePathFor(relativePath),
+		                        colorFormat, overwrite);
+	}
+
+	AsyncLoadHandle ResourceManager::loadSoundAsync(const std::string &key,
+	                                                const std::string &filePath,
+	                                                bool overwrite) {
+		return loadAsync(new FileLoadJob(FileLoadJob::SOUND, key, filePath, overwrite));
+	}
+
+	AsyncLoadHandle ResourceManager::loadMusicAsync(const std::string &key,
+	                                                const std::string &filePath,
+	                                                bool overwrite) {
+		return loadAsync(new FileLoadJob(FileLoadJob::MUSIC, key, filePath, overwrite));
+	}
+
+#ifndef RB_ANDROID
+	AsyncLoadHandle ResourceManager::loadFontAsync(const std::string &key,
+	                                               const std::string &path,
+	                                               bool overwrite) {
+		return loadAsync(new FileLoadJob(FileLoadJob::FONT, key, path, overwrite));
+	}
+#endif
+
+	AsyncLoadHandle ResourceManager::loadTileMapAsync(const std::string &key,
+	                                                  const std::string &filePath,
+	                                                  bool overwrite) {
+		return loadAsync(new TileMapLoadJob(key, filePath, overwrite));
+	}
+
+	AsyncLoadHandle ResourceManager::loadAsync(AsyncLoadJob *job) {
+		return AsyncLoader::getInstance().add(job);
+	}
+
+	AsyncLoadState ResourceManager::getAsyncLoadState(AsyncLoadHandle handle) {
+		return AsyncLoader::getInstance().getState(handle);
+	}
+
+	float ResourceManager::getLoadingProgress() {
+		return AsyncLoader::getInstance().getProgress();
+	}
+
+	unsigned int ResourceManager::getNbPendingLoads() {
+		return AsyncLoader::getInstance().getNbPending();
+	}
+
+	void ResourceManager::setAsyncLoadTimeBudget(double newTimeBudget) {
+		AsyncLoader::getInstance().timeBudget = newTimeBudget;
+	}
+
+	double ResourceManager::getAsyncLoadTimeBudget() {
+		return AsyncLoader::getInstance().timeBudget;
+	}
+
+	void ResourceManager::updateAsyncLoads() {
+		AsyncLoader::getInstance().update();
+	}
+
+	SoundData *ResourceManager::decodeSound(const std::string &filePath) {
+		return AudioEngine::getSoundEngine().decodeSound(filePath);
+	}
+
+	SoundInfo *ResourceManager::loadDecodedSound(const std::string &key,
+	                                             SoundData &data,
+	                                             bool overwrite) {
+		SoundInfo *newSnd = NULL;
+
+		if (sounds.find(key) != sounds.end()) {
+			if (overwrite) {
+				// We delete the existing sound effect.
+				newSnd = sounds[key];
+
+				if (newSnd) {
+					delete newSnd;
+				}
+
+				// We load the sound effect and we overwrite the existing sound
+				// effect.
+				newSnd = sounds[key] = AudioEngine::getSoundEngine().loadDecodedSound(data);
+				Console::println("Overwrote the existing sound effect named " + key +
+				                 ".");
+
+			} else {
+				Console::println("Couldn't load the sound effect named " + key +
+				                 " found at " + data.filePath +
+				                 " because a sound with that name already exists.");
+				newSnd = sounds[key];
+			}
+
+		} else {
+			// We load the sound effect.
+			newSnd = AudioEngine::getSoundEngine().loadDecodedSound(data);
+
+			// If it was loaded correctly.
+			if (newSnd) {
+				sounds.insert(std::pair<std::string, SoundInfo *>(key, newSnd));
+			}
+		}
+
+		return newSnd;
+	}
+
+	bool ResourceManager::readMusic(const std::string &filePath,
+	                                std::vector<char> &fileContent) {
+		return AudioEngine::getMusicEngine().readMusic(filePath, fileContent);
+	}
+
+	MusicInfo *ResourceManager::loadMusicFromMemory(const std::string &key,
+	                                                const std::string &filePath,
+	                                                std::vector<char> &fileContent,
+	                                                bool overwrite) {
+		MusicInfo *newBgm = NULL;
+
+		if (musics.find(key) != musics.end()) {
+			if (overwrite) {
+				// We delete the existing music.
+				newBgm = musics[key];
+
+				if (newBgm) {
+					delete newBgm;
+				}
+
+				// We load the music and we overwrite the existing music.
+				newBgm = musics[key] = AudioEngine::getMusicEngine().loadMusicFromMemory(filePath, fileContent);
+				Console::println("Overwrote the existing music named " + key +
+				                 ".");
+
+			} else {
+				Console::println("Couldn't load the music named " + key +
+				                 " found at " + filePath +
+				                 " because a music with that name already exists.");
+				newBgm = musics[key];
+			}
+
+		} else {
+			// We load the music.
+			newBgm = AudioEngine::getMusicEngine().loadMusicFromMemory(filePath, fileContent);
+
+			// If it was loaded correctly.
+			if (newBgm) {
+				musics.insert(std::pair<std::string, MusicInfo *>(key, newBgm));
+			}
+		}
+
+		return newBgm;
+	}
+#ifndef RB_ANDROID
+
+	Font *ResourceManager::loadFontFromMemory(const std::string &key,
+	                                          std::vector<char> &fileContent,
+	                                          bool overwrite) {
+		Font *aFont = NULL;
+
+		// We check if there is already a font with this name.
+		if (fonts.find(key) != fonts.end()) {
+			// We check if we overwrite the existing font or not.
+			if (overwrite) {
+				// We free the allocated memory.
+				delete fonts[key];
+
+				// We load the new font.
+				aFont = fonts[key] = new Font(key, fileContent);
+				Console::println("Overwrote the existing font named " + key + ".");
+
+			} else {
+				Console::println("Can't load font with key: " + key +
+				                 " font is already loaded");
+				aFont = fonts[key];
+			}
+
+		} else {
+			aFont = new Font(key, fileContent);
+			fonts.insert(std::pair<std::string, Font *>(key, aFont));
+		}
+
+		return aFont;
+	}
+#endif
+
 	void ResourceManager::unloadAll() {
+		// We stop the asynchronous loads before unloading what they use.
+		AsyncLoader::getInstance().stop();
+
 		// We unload the textures.
 		for (std::map<std::string, TextureInformation *>::iterator i = textures.begin();
 		     i != textures.end(); ++i) {
@@ -447,6 +869,14 @@ namespace BaconBox {
 
 		fonts.clear();
 #endif
+
+		// We unload the tile maps.
+		for (std::map<std::string, TileMap *>::iterator i = tileMaps.begin();
+		     i != tileMaps.end(); ++i) {
+			delete i->second;
+		}
+
+		tileMaps.clear();
 	}
 
 	PixMap *ResourceManager::loadPixMap(const std::string &filePath, ColorFormat colorFormat) {
@@ -8,18 +8,23 @@
 
 #include <string>
 #include <map>
+#include <vector>
 
 #include "BaconBox/Audio/SoundParameters.h"
 #include "BaconBox/Audio/MusicParameters.h"
 #include "BaconBox/Display/PixMap.h"
+#include "BaconBox/AsyncLoadState.h"
 
 namespace BaconBox {
 	class SoundFX;
 	class BackgroundMusic;
 	struct SoundInfo;
+	struct SoundData;
 	struct MusicInfo;
 	struct TextureInformation;
 	class Color;
+	class AsyncLoadJob;
+	class TileMap;
 #ifndef RB_ANDROID
 	class Font;
 #endif
@@ -291,6 +296,21 @@ namespace BaconBox {
 		 */
 		static void removeFont(const std::string &key);
 #endif
+
+		/**
+		 * Return a pointer to the tile map specified by the given name.
+		 * @param key Key of the tile map to get.
+		 * @return Pointer to the specified tile map, NULL if no tile map is
+		 * found.
+		 * @see BaconBox::ResourceManager::loadTileMapAsync()
+		 */
+		static TileMap *getTileMap(const std::string &key);
+
+		/**
+		 * Remove the specified tile map from the tile maps' map.
+		 * @param key Key of the tile map to remove.
+		 */
+		static void removeTileMap(const std::string &key);
 		
 		/// Create a PixMap from an image file at the given path.
 		static PixMap *loadPixMap(const std::string &filePath, ColorFormat colorFormat);
@@ -310,12 +330,238 @@ namespace BaconBox {
 		 */
 		static void savePixMap(const PixMap &pixMap,
 							   const std::string &filePath);
+
+		/**
+		 * Loads a texture in the background. The image is decoded by a worker
+		 * thread and the texture is created on the main thread, so it can
+		 * only be used once its load's state is LOADED.
+		 * @param key Key used to identify this new texture.
+		 * @param filePath Path to the file containing the texture.
+		 * @param colorFormat Used to select the internal colorFormat of the
+		 * texture.
+		 * @param overwrite When set to true, it will delete any existing
+		 * texture at the specified key.
+		 * @return Handle identifying the load.
+		 * @see BaconBox::ResourceManager::getAsyncLoadState()
+		 */
+		static AsyncLoadHandle loadTextureAsync(const std::string &key,
+		                                        const std::string &filePath,
+		                                        ColorFormat colorFormat = ColorFormat::RGBA,
+		                                        bool overwrite = false);
+
+		/**
+		 * Loads a texture in the background with a transparent color.
+		 * @param key Key used to identify this new texture.
+		 * @param filePath Path to the file containing the texture.
+		 * @param transparentColor Color to be read as transparent.
+		 * @param overwrite When set to true, it will delete any existing
+		 * texture at the specified key.
+		 * @return Handle identifying the load.
+		 * @see BaconBox::ResourceManager::loadTextureAsync()
+		 */
+		static AsyncLoadHandle loadTextureWithColorKeyAsync(const std::string &key,
+		                                                    const std::string &filePath,
+		                                                    const Color &transparentColor,
+		                                                    bool overwrite = false);
+
+		/**
+		 * Loads a texture in the background. This version needs a relative
+		 * path from the resources folder.
+		 * @param key Key used to identify this new texture.
+		 * @param relativePath Relative path (relative to the resources folder)
+		 * to the file containing the texture.
+		 * @param colorFormat Used to select the internal colorFormat of the
+		 * texture.
+		 * @param overwrite When set to true, it will delete any existing
+		 * texture at the specified key.
+		 * @return Handle identifying the load.
+		 * @see BaconBox::ResourceManager::loadTextureAsync()
+		 */
+		static AsyncLoadHandle loadTextureRelativePathAsync(const std::string &key,
+		                                                    const std::string &relativePath,
+		                                                    ColorFormat colorFormat = ColorFormat::RGBA,
+		                                                    bool overwrite = false);
+
+		/**
+		 * Loads a sound effect in the background. The file is read and
+		 * decoded on a worker thread. The audio engines aren't thread safe,
+		 * so only the sound effect is created on the main thread, within the
+		 * time given to asynchronous loads each frame.
+		 * @param key Name to give to the sound effect.
+		 * @param filePath Path to the sound file to load.
+		 * @param overwrite Flag checked to know if the loaded sound will
+		 * overwrite the existing sound if the key already exists.
+		 * @return Handle identifying the load.
+		 */
+		static AsyncLoadHandle loadSoundAsync(const std::string &key,
+		                                      const std::string &filePath,
+		                                      bool overwrite = false);
+
+		/**
+		 * Loads a background music asynchronously. The file is read in
+		 * memory on a worker thread and the music is created on the main
+		 * thread, like the sound effects.
+		 * @param key Name to give to the background music.
+		 * @param filePath Path to the music file to load.
+		 * @param overwrite Flag checked to know if the loaded music will
+		 * overwrite the existing music if the key already exists.
+		 * @return Handle identifying the load.
+		 * @see BaconBox::ResourceManager::loadSoundAsync()
+		 */
+		static AsyncLoadHandle loadMusicAsync(const std::string &key,
+		                                      const std::string &filePath,
+		                                      bool overwrite = false);
+
+#ifndef RB_ANDROID
+		/**
+		 * Loads a font in the background. The file is read in memory on a
+		 * worker thread and the font is created on the main thread, like the
+		 * sound effects.
+		 * @param key Name of the font.
+		 * @param path Path of the font.
+		 * @param overwrite Flag checked to know if the loaded font will
+		 * overwrite the existing font if the key already exists.
+		 * @return Handle identifying the load.
+		 * @see BaconBox::ResourceManager::loadSoundAsync()
+		 */
+		static AsyncLoadHandle loadFontAsync(const std::string &key,
+		                                     const std::string &path,
+		                                     bool overwrite = false);
+#endif
+
+		/**
+		 * Loads a tile map in the background. The tmx or binary tile map file
+		 * is read on a worker thread, the tilesets' textures are created on
+		 * the main thread. Files ending with ".tmx" are read with the
+		 * TmxTileMapReader, the others with the BinaryTileMapReader.
+		 * @param key Name to give to the tile map.
+		 * @param filePath Path to the tile map file to load.
+		 * @param overwrite Flag checked to know if the loaded tile map will
+		 * overwrite the existing tile map if the key already exists.
+		 * @return Handle identifying the load.
+		 * @see BaconBox::ResourceManager::getTileMap()
+		 */
+		static AsyncLoadHandle loadTileMapAsync(const std::string &key,
+		                                        const std::string &filePath,
+		                                        bool overwrite = false);
+
+		/**
+		 * Loads a custom resource in the background.
+		 * @param job Job loading the resource, the resource manager takes its
+		 * ownership.
+		 * @return Handle identifying the load.
+		 */
+		static AsyncLoadHandle loadAsync(AsyncLoadJob *job);
+
+		/**
+		 * Gets where an asynchronous load is at. A failed load is only
+		 * reported as FAILED once, later calls report it as LOADED. Loads
+		 * cancelled by the loader's shutdown are reported as FAILED.
+		 * @param handle Handle of the load.
+		 * @return State of the load.
+		 */
+		static AsyncLoadState getAsyncLoadState(AsyncLoadHandle handle);
+
+		/**
+		 * Gets the ratio of the asynchronous loads finished since nothing was
+		 * pending. Useful for loading screens.
+		 * @return Value between 0 and 1, 1 if nothing is pending.
+		 */
+		static float getLoadingProgress();
+
+		/**
+		 * Gets the number of asynchronous loads not finished yet.
+		 * @return Number of pending loads.
+		 */
+		static unsigned int getNbPendingLoads();
+
+		/**
+		 * Sets the time given to the asynchronous loads each frame. At least
+		 * one load is finished each frame, even if it takes longer.
+		 * @param newTimeBudget Time in seconds.
+		 */
+		static void setAsyncLoadTimeBudget(double newTimeBudget);
+
+		/**
+		 * Gets the time given to the asynchronous loads each frame.
+		 * @return Time in seconds.
+		 */
+		static double getAsyncLoadTimeBudget();
+
+		/**
+		 * Finishes the asynchronous loads until their time budget is spent.
+		 * Called by the engine each frame.
+		 */
+		static void updateAsyncLoads();
 	private:
+		/// Asynchronous load of a sound effect, a music or a font.
+		class FileLoadJob;
+
+		/// Asynchronous load of a tile map.
+		class TileMapLoadJob;
+
 		/**
 		 * Unloads everything in the ResourceManager.
 		 */
 		static void unloadAll();
 
+		/**
+		 * Has the sound engine read and decode a sound file. Called on a
+		 * worker thread.
+		 * @param filePath Path to the sound file to decode.
+		 * @return Decoded sound, NULL if it couldn't be decoded.
+		 */
+		static SoundData *decodeSound(const std::string &filePath);
+
+		/**
+		 * Loads a sound effect decoded by decodeSound().
+		 * @param key Name to give to the sound effect.
+		 * @param data Decoded sound.
+		 * @param overwrite Flag checked to know if the loaded sound will
+		 * overwrite the existing sound if the key already exists.
+		 * @return Pointer to the sound effect's information.
+		 */
+		static SoundInfo *loadDecodedSound(const std::string &key,
+		                                   SoundData &data, bool overwrite);
+
+		/**
+		 * Has the music engine read a music file in memory. Called on a
+		 * worker thread.
+		 * @param filePath Path to the music file to read.
+		 * @param fileContent Set to the file's content.
+		 * @return False if the file couldn't be read, true if not.
+		 */
+		static bool readMusic(const std::string &filePath,
+		                      std::vector<char> &fileContent);
+
+		/**
+		 * Loads a background music read by readMusic().
+		 * @param key Name to give to the background music.
+		 * @param filePath Path to the music file.
+		 * @param fileContent File's content.
+		 * @param overwrite Flag checked to know if the loaded music will
+		 * overwrite the existing music if the key already exists.
+		 * @return Pointer to the music's information.
+		 */
+		static MusicInfo *loadMusicFromMemory(const std::string &key,
+		                                      const std::string &filePath,
+		                                      std::vector<char> &fileContent,
+		                                      bool overwrite);
+#ifndef RB_ANDROID
+
+		/**
+		 * Loads a font from its file's content.
+		 * @param key Name of the font.
+		 * @param fileContent Content of the font's file.
+		 * @param overwrite Flag checked to know if the loaded font will
+		 * overwrite the existing font if the key already exists.
+		 * @return Pointer to the font.
+		 */
+		static Font *loadFontFromMemory(const std::string &key,
+		                                std::vector<char> &fileContent,
+		                                bool overwrite);
+#endif
+
 		///Create a PixMap from a PNG file at the given path.
 		static PixMap *loadPixMapFromPNG(const std::string &filePath);
 		
@@ -338,6 +584,9 @@ namespace BaconBox {
 		/// Map  associating the fonts' names and their information.
 		static std::map<std::string, Font *> fonts;
 #endif
+
+		/// Map associating the tile maps' names and the tile maps.
+		static std::map<std::string, TileMap *> tileMaps;
 	};
 }
 
@@ -5,6 +5,7 @@
 
 #include "BaconBox/Console.h"
 #include "BaconBox/Display/Driver/GraphicDriver.h"
+#include "BaconBox/Helper/Profiler.h"
 
 namespace BaconBox {
 	const std::string State::DEFAULT_NAME = "State";
@@ -50,6 +51,8 @@ namespace BaconBox {
 	}
 
 	void State::internalUpdate() {
+		RB_PROFILE_ZONE("State::internalUpdate");
+
 		this->BodyManager<Layerable, Layerable::LessCompare>::internalUpdate();
 
 		if (camera.isEnabled() && camera.isActive()) {
@@ -60,6 +63,8 @@ namespace BaconBox {
 	}
 
 	void State::internalRender() {
+		RB_PROFILE_ZONE("State::internalRender");
+
 		if (camera.isEnabled() && camera.isVisible()) {
 			camera.render();
 		}
@@ -104,6 +109,7 @@ namespace BaconBox {
 					}
 
 					// We render the body.
+					graphicDriver.setCurrentLayer((*i)->getZ());
 					(*i)->render();
 				}
 
@@ -118,6 +124,8 @@ namespace BaconBox {
 		if (!(camera.isEnabled() && camera.isVisible())) {
 			camera.render();
 		}
+
+		GraphicDriver::getInstance().finalizeScene();
 	}
 
 	void State::internalOnGetFocus() {
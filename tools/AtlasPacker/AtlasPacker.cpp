@@ -0,0 +1,101 @@
+/**
+ * @file
+ * Command line tool packing images in texture atlas pages. Link it with the
+ * BaconBox library.
+ *
+ * Usage: AtlasPacker [-s maximumPageSize] [-p padding] output image.png...
+ *
+ * Writes output-0.png, output-0.atlas, output-1.png... Each image's sprite
+ * definition is named after its file name, without the extension.
+ */
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "BaconBox/Display/TextureAtlasBuilder.h"
+#include "BaconBox/Display/PixMap.h"
+#include "BaconBox/ResourceManager.h"
+
+using namespace BaconBox;
+
+namespace {
+	/**
+	 * Gets the name of an image's sprite definition from its path.
+	 * @param path Path to the image.
+	 * @return File name without the directories and the extension.
+	 */
+	std::string getImageName(const std::string &path) {
+		std::string::size_type nameStart = path.find_last_of("/\\");
+		std::string result = (nameStart == std::string::npos) ? (path) : (path.substr(nameStart + 1));
+		std::string::size_type extension = result.find_last_of('.');
+
+		if (extension != std::string::npos && extension > 0) {
+			result.erase(extension);
+		}
+
+		return result;
+	}
+
+	void printUsage() {
+		std::cerr << "Usage: AtlasPacker [-s maximumPageSize] [-p padding] output image.png..." << std::endl;
+	}
+}
+
+int main(int argc, char *argv[]) {
+	unsigned int maximumPageSize = TextureAtlasBuilder::DEFAULT_MAXIMUM_PAGE_SIZE;
+	unsigned int padding = TextureAtlasBuilder::DEFAULT_PADDING;
+	int i = 1;
+
+	// We read the options.
+	while (i + 1 < argc && argv[i][0] == '-') {
+		if (std::strcmp(argv[i], "-s") == 0) {
+			maximumPageSize = static_cast<unsigned int>(std::atoi(argv[i + 1]));
+
+		} else if (std::strcmp(argv[i], "-p") == 0) {
+			padding = static_cast<unsigned int>(std::atoi(argv[i + 1]));
+
+		} else {
+			printUsage();
+			return EXIT_FAILURE;
+		}
+
+		i += 2;
+	}
+
+	if (argc - i < 2 || maximumPageSize == 0u) {
+		printUsage();
+		return EXIT_FAILURE;
+	}
+
+	std::string output(argv[i++]);
+	TextureAtlasBuilder builder(maximumPageSize, padding);
+	std::vector<PixMap *> images;
+	int result = EXIT_SUCCESS;
+
+	for (; i < argc; ++i) {
+		PixMap *image = ResourceManager::loadPixMap(argv[i], ColorFormat(ColorFormat::RGBA));
+
+		if (image) {
+			images.push_back(image);
+			builder.add(getImageName(argv[i]), image);
+
+		} else {
+			std::cerr << "Can't load " << argv[i] << std::endl;
+			result = EXIT_FAILURE;
+		}
+	}
+
+	if (!builder.build() || !builder.save(output)) {
+		result = EXIT_FAILURE;
+	}
+
+	std::cout << "Packed " << images.size() << " images in " << builder.getNbPages() << " pages." << std::endl;
+
+	for (std::vector<PixMap *>::iterator j = images.begin(); j != images.end(); ++j) {
+		delete *j;
+	}
+
+	return result;
+}
@@ -0,0 +1,180 @@
+/**
+ * @file
+ * Command line benchmark of the collision groups' broadphase strategies. The
+ * quadtree and the sweep and prune are compared on bodies spread uniformly,
+ * gathered in a few clusters and laid out along a long horizontal
+ * corridor. Each frame, the bodies move by a few pixels around their
+ * starting position, then the group is updated and tested against itself.
+ * Both strategies start every frame from the same positions. Link it with
+ * the BaconBox library built with HEADLESS, so the bodies' updates don't
+ * depend on the time.
+ *
+ * Usage: BroadphaseBenchmark [nbBodies]
+ *
+ * nbBodies is the number of bodies in the group, 2000 by default.
+ */
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <vector>
+
+#include "BaconBox/PlatformFlagger.h"
+#include "BaconBox/Vector2.h"
+#include "BaconBox/Display/Collidable.h"
+#include "BaconBox/Helper/CollisionGroup.h"
+
+using namespace BaconBox;
+
+/// Number of frames updated for each measure.
+static const int NB_FRAMES = 100;
+
+/// Width and height of the bodies.
+static const float BODY_SIZE = 16.0f;
+
+/**
+ * Square body with a fixed size.
+ */
+class Box : public Collidable {
+public:
+	/**
+	 * Default constructor.
+	 */
+	Box() : Collidable() {
+	}
+
+	float getWidth() const {
+		return BODY_SIZE;
+	}
+
+	float getHeight() const {
+		return BODY_SIZE;
+	}
+};
+
+/**
+ * Gets a random number between 0 and the given maximum.
+ */
+static float getRandom(float maximum) {
+	return static_cast<float>(std::rand()) / static_cast<float>(RAND_MAX) * maximum;
+}
+
+/**
+ * Spreads the bodies uniformly in a 4096 by 4096 square.
+ */
+static AxisAlignedBoundingBox spreadUniformly(std::vector<Vector2> &positions) {
+	for (std::vector<Vector2>::iterator i = positions.begin(); i != positions.end(); ++i) {
+		*i = Vector2(getRandom(4096.0f), getRandom(4096.0f));
+	}
+
+	return AxisAlignedBoundingBox(Vector2(), Vector2(4096.0f, 4096.0f));
+}
+
+/**
+ * Gathers the bodies in 8 clusters in a 4096 by 4096 square. The bodies are
+ * denser near the clusters' centers.
+ */
+static AxisAlignedBoundingBox gatherInClusters(std::vector<Vector2> &positions) {
+	static const int NB_CLUSTERS = 8;
+	std::vector<Vector2> centers(NB_CLUSTERS);
+
+	for (std::vector<Vector2>::iterator i = centers.begin(); i != centers.end(); ++i) {
+		*i = Vector2(256.0f + getRandom(3584.0f), 256.0f + getRandom(3584.0f));
+	}
+
+	for (std::vector<Vector2>::size_type i = 0; i < positions.size(); ++i) {
+		positions[i] = centers[i % NB_CLUSTERS] +
+		               Vector2(getRandom(128.0f) + getRandom(128.0f) - 128.0f,
+		                       getRandom(128.0f) + getRandom(128.0f) - 128.0f);
+	}
+
+	return AxisAlignedBoundingBox(Vector2(), Vector2(4096.0f, 4096.0f));
+}
+
+/**
+ * Lays out the bodies along a 65536 by 128 corridor.
+ */
+static AxisAlignedBoundingBox layOutInCorridor(std::vector<Vector2> &positions) {
+	for (std::vector<Vector2>::iterator i = positions.begin(); i != positions.end(); ++i) {
+		*i = Vector2(getRandom(65536.0f), getRandom(128.0f));
+	}
+
+	return AxisAlignedBoundingBox(Vector2(), Vector2(65536.0f, 128.0f));
+}
+
+/**
+ * Gets a body's offset from its starting position for a frame. The bodies
+ * don't all move the same way, since bodies moving together are not tested.
+ */
+static Vector2 getOffset(std::vector<Box>::size_type body, int frame) {
+	return Vector2(static_cast<float>((body + frame) % 8),
+	               static_cast<float>((body * 3 + frame * 5) % 8));
+}
+
+typedef AxisAlignedBoundingBox (*Distribution)(std::vector<Vector2> &);
+
+/**
+ * Measures a broadphase strategy.
+ * @param strategy Strategy to measure.
+ * @param bounds Bounds given to the collision group.
+ * @param positions Bodies' starting positions.
+ * @param bodies Bodies to test.
+ * @param nbCollisions Set to the average number of collisions per frame.
+ * @return Average time per frame (in microseconds).
+ */
+static double measure(BroadphaseStrategy strategy,
+                      const AxisAlignedBoundingBox &bounds,
+                      const std::vector<Vector2> &positions,
+                      std::vector<Box> &bodies, double &nbCollisions) {
+	CollisionGroup group(bounds);
+	group.setStrategy(strategy);
+	CollisionGroup::CollisionDetailsArray result;
+	std::clock_t total = 0;
+	std::size_t collisions = 0;
+
+	for (std::vector<Box>::iterator i = bodies.begin(); i != bodies.end(); ++i) {
+		group.add(&*i);
+	}
+
+	for (int frame = 0; frame < NB_FRAMES; ++frame) {
+		for (std::vector<Box>::size_type i = 0; i < bodies.size(); ++i) {
+			// The body is updated where it was on the previous frame, so its
+			// old position is set, then moved by a few pixels.
+			bodies[i].setPosition(positions[i] + getOffset(i, frame));
+			bodies[i].update();
+			bodies[i].setPosition(positions[i] + getOffset(i, frame + 1));
+		}
+
+		std::clock_t start = std::clock();
+		group.update();
+		group.collide(result);
+		total += std::clock() - start;
+		collisions += result.size();
+	}
+
+	nbCollisions = static_cast<double>(collisions) / static_cast<double>(NB_FRAMES);
+
+	return static_cast<double>(total) / CLOCKS_PER_SEC * 1.0e6 /
+	       static_cast<double>(NB_FRAMES);
+}
+
+int main(int argc, char *argv[]) {
+	std::vector<Vector2>::size_type nbBodies = (argc > 1) ? (std::strtoul(argv[1], NULL, 10)) : (2000);
+	static const char *DISTRIBUTION_NAMES[] = {"uniform", "clustered", "corridor"};
+	static const Distribution DISTRIBUTIONS[] = {spreadUniformly, gatherInClusters, layOutInCorridor};
+
+	for (unsigned int distribution = 0; distribution < sizeof(DISTRIBUTIONS) / sizeof(DISTRIBUTIONS[0]); ++distribution) {
+		std::vector<Vector2> positions(nbBodies);
+		std::vector<Box> bodies(nbBodies);
+		AxisAlignedBoundingBox bounds = DISTRIBUTIONS[distribution](positions);
+		double quadtreeCollisions, sweepCollisions;
+		double quadtree = measure(BroadphaseStrategy::QUADTREE, bounds, positions, bodies, quadtreeCollisions);
+		double sweep = measure(BroadphaseStrategy::SWEEP_AND_PRUNE, bounds, positions, bodies, sweepCollisions);
+		std::cout << nbBodies << " bodies, " << DISTRIBUTION_NAMES[distribution]
+		          << ": " << quadtree << " us per frame with the quadtree ("
+		          << quadtreeCollisions << " collisions), " << sweep
+		          << " us per frame with sweep and prune (" << sweepCollisions
+		          << " collisions)" << std::endl;
+	}
+
+	return EXIT_SUCCESS;
+}
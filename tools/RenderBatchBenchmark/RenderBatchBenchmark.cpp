@@ -0,0 +1,181 @@
+/**
+ * @file
+ * Command line benchmark of the render batches' updates with 1 000, 10 000
+ * and 100 000 sprites. Each frame, a few sprites are removed, or a few
+ * sprites have their z changed. Only the batch's update is timed, the
+ * removed sprites are replaced afterwards, and an update without changes is
+ * measured as a reference. The time of an update is
+ * compared with the time it takes to reconstruct all of the batch's indices,
+ * which is what every removal used to cost. After each measure, the batch's
+ * patched indices are compared with reconstructed ones. Link it with the
+ * BaconBox library, no graphic context is needed since the batches are not
+ * rendered.
+ *
+ * Usage: RenderBatchBenchmark [nbChangesPerFrame]
+ *
+ * nbChangesPerFrame is the number of sprites removed or moved each frame,
+ * 10 by default.
+ *
+ * Returns EXIT_SUCCESS if the indices are always valid, EXIT_FAILURE
+ * otherwise.
+ */
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+
+#include "BaconBox/PlatformFlagger.h"
+#include "BaconBox/Vector2.h"
+#include "BaconBox/Display/InanimateSpriteBatch.h"
+
+using namespace BaconBox;
+
+/// Number of frames updated for each measure.
+static const int NB_FRAMES = 100;
+
+/// Number of different z values given to the sprites.
+static const int NB_LAYERS = 8;
+
+/**
+ * Render batch that gives access to its indices so they can be checked.
+ */
+class CheckedBatch : public RenderBatch<BatchedInanimateSprite> {
+public:
+	/**
+	 * Compares the batch's current indices with reconstructed indices.
+	 * @return True if they are the same, false if not.
+	 */
+	bool checkIndices() {
+		IndiceArray patched(indices);
+		refreshIndices();
+		return patched == indices;
+	}
+
+	/**
+	 * Reconstructs all of the batch's indices.
+	 */
+	void rebuildIndices() {
+		refreshIndices();
+	}
+};
+
+/**
+ * Adds a sprite at a random position and z to the batch.
+ */
+static void addSprite(CheckedBatch &batch) {
+	BatchedInanimateSprite *sprite = new BatchedInanimateSprite(TexturePointer(),
+	                                                            Vector2(static_cast<float>(std::rand() % 1024),
+	                                                                    static_cast<float>(std::rand() % 768)),
+	                                                            Vector2(16.0f, 16.0f));
+	sprite->setZ(std::rand() % NB_LAYERS);
+	batch.add(sprite);
+}
+
+/**
+ * Gets a random sprite of the batch.
+ */
+static BatchedInanimateSprite *getRandomSprite(CheckedBatch &batch) {
+	return *(batch.getBegin() + std::rand() % batch.getNbBodies());
+}
+
+/**
+ * Updates the batch without changing it, the other measures include this
+ * time.
+ * @return Time spent updating the batch.
+ */
+static std::clock_t updateSprites(CheckedBatch &batch, int) {
+	std::clock_t start = std::clock();
+	batch.update();
+	return std::clock() - start;
+}
+
+/**
+ * Removes sprites, then adds as many new ones so the batch keeps its size.
+ * @return Time spent updating the batch.
+ */
+static std::clock_t replaceSprites(CheckedBatch &batch, int nbChanges) {
+	for (int i = 0; i < nbChanges; ++i) {
+		getRandomSprite(batch)->setToBeDeleted(true);
+	}
+
+	std::clock_t start = std::clock();
+	batch.update();
+	std::clock_t result = std::clock() - start;
+
+	for (int i = 0; i < nbChanges; ++i) {
+		addSprite(batch);
+	}
+
+	return result;
+}
+
+/**
+ * Changes the z of sprites.
+ * @return Time spent updating the batch.
+ */
+static std::clock_t moveSprites(CheckedBatch &batch, int nbChanges) {
+	for (int i = 0; i < nbChanges; ++i) {
+		getRandomSprite(batch)->setZ(std::rand() % NB_LAYERS);
+	}
+
+	std::clock_t start = std::clock();
+	batch.update();
+	return std::clock() - start;
+}
+
+/**
+ * Reconstructs the batch's indices.
+ * @return Time spent reconstructing the indices.
+ */
+static std::clock_t rebuildIndices(CheckedBatch &batch, int) {
+	std::clock_t start = std::clock();
+	batch.rebuildIndices();
+	return std::clock() - start;
+}
+
+typedef std::clock_t (*Operation)(CheckedBatch &, int);
+
+/**
+ * Measures an operation.
+ * @return Average time per frame (in microseconds).
+ */
+static double measure(Operation operation, CheckedBatch &batch, int nbChanges) {
+	std::clock_t total = 0;
+
+	for (int i = 0; i < NB_FRAMES; ++i) {
+		total += operation(batch, nbChanges);
+	}
+
+	return static_cast<double>(total) / CLOCKS_PER_SEC * 1.0e6 /
+	       static_cast<double>(NB_FRAMES);
+}
+
+int main(int argc, char *argv[]) {
+	int nbChanges = (argc > 1) ? (std::atoi(argv[1])) : (10);
+	static const int NB_SPRITES[] = {1000, 10000, 100000};
+	static const char *OPERATION_NAMES[] = {"update", "remove", "change z", "reconstruct indices"};
+	static const Operation OPERATIONS[] = {updateSprites, replaceSprites, moveSprites, rebuildIndices};
+	bool valid = true;
+
+	for (unsigned int size = 0; size < sizeof(NB_SPRITES) / sizeof(NB_SPRITES[0]); ++size) {
+		CheckedBatch batch;
+		batch.reserveVertices(NB_SPRITES[size] * 4);
+
+		for (int i = 0; i < NB_SPRITES[size]; ++i) {
+			addSprite(batch);
+		}
+
+		for (unsigned int operation = 0; operation < sizeof(OPERATIONS) / sizeof(OPERATIONS[0]); ++operation) {
+			double time = measure(OPERATIONS[operation], batch, nbChanges);
+			std::cout << NB_SPRITES[size] << " sprites, " << OPERATION_NAMES[operation]
+			          << ": " << time << " us per frame" << std::endl;
+
+			if (!batch.checkIndices()) {
+				std::cout << "The indices are invalid after the "
+				          << OPERATION_NAMES[operation] << " frames" << std::endl;
+				valid = false;
+			}
+		}
+	}
+
+	return (valid) ? (EXIT_SUCCESS) : (EXIT_FAILURE);
+}
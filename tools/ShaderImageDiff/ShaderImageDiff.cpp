@@ -0,0 +1,522 @@
+/**
+ * @file
+ * Command line image comparison of the shader driver with the fixed pipeline
+ * driver. The same scenes are rendered offscreen with the graphic driver the
+ * BaconBox library was built with: colored shapes, textured shapes blended
+ * with colors, alpha textures, a camera with nested translations, masked and
+ * inversely masked shapes, and batches. The image is saved, then compared
+ * with the image of the other driver.
+ *
+ * Environment: Linux with Mesa's EGL and its software rasterizer (llvmpipe
+ * or softpipe), no display is needed. The tool renders in an EGL pbuffer
+ * with a desktop OpenGL context, using the Mesa surfaceless platform when it
+ * is available. Set LIBGL_ALWAYS_SOFTWARE=1 to make sure llvmpipe is used
+ * on a machine with a GPU. Build the BaconBox library twice for linux
+ * without SDL and with RB_OPENGL defined, once more with RB_OPENGL_SHADERS
+ * defined, and link this tool with each of them, libEGL and libGL.
+ *
+ * Usage: ShaderImageDiff output.ppm [reference.ppm]
+ *
+ * output.ppm is where the rendered scenes are saved, one below the other.
+ * reference.ppm is the image saved by the other driver's build. Run the
+ * fixed pipeline build first without a reference, then the shader build
+ * with the fixed pipeline's image as the reference.
+ *
+ * Returns EXIT_SUCCESS if the scenes were rendered and match the reference,
+ * EXIT_FAILURE otherwise.
+ */
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "BaconBox/PlatformFlagger.h"
+#include "BaconBox/Display/Driver/OpenGL/RBOpenGL.h"
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include "BaconBox/Engine.h"
+#include "BaconBox/Vector2.h"
+#include "BaconBox/Display/Color.h"
+#include "BaconBox/Display/PixMap.h"
+#include "BaconBox/Display/StandardVertexArray.h"
+#include "BaconBox/Display/TextureCoordinates.h"
+#include "BaconBox/Display/TextureInformation.h"
+#include "BaconBox/Display/Driver/GraphicDriver.h"
+#include "BaconBox/Display/Driver/BatchVertex.h"
+#include "BaconBox/Display/Driver/IndiceArray.h"
+
+using namespace BaconBox;
+
+/// Width and height of each scene, in pixels.
+static const int SCENE_SIZE = 128;
+
+/// Number of scenes rendered.
+static const int NB_SCENES = 5;
+
+/// Names of the scenes, in the order they are rendered.
+static const char *SCENE_NAMES[NB_SCENES] = {"colors", "textures", "camera", "masks", "batches"};
+
+/**
+ * Largest difference accepted between the color components of a pixel of
+ * both drivers. Blending in the shaders is done in floating point, the
+ * fixed pipeline may round differently.
+ */
+static const int TOLERANCE = 3;
+
+/**
+ * Ratio of the pixels of a scene allowed to differ more than the tolerance.
+ * The shader driver transforms the vertices on the CPU, so the edges of the
+ * rotated shapes can be rasterized a pixel apart.
+ */
+static const double MAX_DIFFERENT_RATIO = 0.005;
+
+/**
+ * Creates an offscreen OpenGL context with Mesa's EGL and makes it current.
+ * @return True if the context was created, false if not.
+ */
+static bool createContext() {
+	EGLDisplay display = EGL_NO_DISPLAY;
+	PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+
+	if (getPlatformDisplay) {
+		display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+	}
+
+	if (display == EGL_NO_DISPLAY) {
+		display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+	}
+
+	EGLint major = 0, minor = 0;
+
+	if (display == EGL_NO_DISPLAY || !eglInitialize(display, &major, &minor) ||
+	    !eglBindAPI(EGL_OPENGL_API)) {
+		std::cout << "Couldn't initialize EGL with desktop OpenGL." << std::endl;
+		return false;
+	}
+
+	// The fixed pipeline driver needs the destination alpha for its masks.
+	static const EGLint CONFIG_ATTRIBUTES[] = {
+		EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+		EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+		EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8, EGL_ALPHA_SIZE, 8,
+		EGL_NONE
+	};
+	static const EGLint SURFACE_ATTRIBUTES[] = {
+		EGL_WIDTH, SCENE_SIZE, EGL_HEIGHT, SCENE_SIZE, EGL_NONE
+	};
+	EGLConfig config;
+	EGLint nbConfigs = 0;
+
+	if (!eglChooseConfig(display, CONFIG_ATTRIBUTES, &config, 1, &nbConfigs) ||
+	    nbConfigs < 1) {
+		std::cout << "No EGL configuration with an RGBA pbuffer." << std::endl;
+		return false;
+	}
+
+	EGLSurface surface = eglCreatePbufferSurface(display, config, SURFACE_ATTRIBUTES);
+	EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, NULL);
+
+	if (surface == EGL_NO_SURFACE || context == EGL_NO_CONTEXT ||
+	    !eglMakeCurrent(display, surface, surface, context)) {
+		std::cout << "Couldn't create the EGL pbuffer and context." << std::endl;
+		return false;
+	}
+
+#ifdef RB_GLEW
+	glewInit();
+#endif
+	std::cout << "Renderer: " << glGetString(GL_RENDERER) << ", OpenGL "
+	          << glGetString(GL_VERSION) << std::endl;
+	return true;
+}
+
+/**
+ * Makes a rectangle in the order the drivers draw it (triangle strip).
+ * @param x Left side.
+ * @param y Top side.
+ * @param width Width of the rectangle.
+ * @param height Height of the rectangle.
+ * @return Vertices of the rectangle.
+ */
+static StandardVertexArray makeRectangle(float x, float y, float width,
+                                         float height) {
+	StandardVertexArray result(4);
+	result[0] = Vector2(x, y);
+	result[1] = Vector2(x + width, y);
+	result[2] = Vector2(x, y + height);
+	result[3] = Vector2(x + width, y + height);
+	return result;
+}
+
+/**
+ * Makes a rectangle rotated around its center.
+ * @param center Center of the rectangle.
+ * @param size Size of the rectangle.
+ * @param angle Angle in degrees.
+ * @return Vertices of the rectangle.
+ */
+static StandardVertexArray makeRotatedRectangle(const Vector2 &center,
+                                                const Vector2 &size,
+                                                float angle) {
+	StandardVertexArray result(makeRectangle(center.x - size.x * 0.5f,
+	                                         center.y - size.y * 0.5f,
+	                                         size.x, size.y));
+	result.rotateFromPoint(angle, center);
+	return result;
+}
+
+/**
+ * Gets the texture coordinates of a whole texture, in the same order as the
+ * rectangles' vertices.
+ * @param texture Texture to get the coordinates of.
+ * @return Texture coordinates.
+ */
+static TextureCoordinates makeTextureCoordinates(const TextureInformation *texture) {
+	float right = static_cast<float>(texture->imageWidth) / static_cast<float>(texture->poweredWidth);
+	float bottom = static_cast<float>(texture->imageHeight) / static_cast<float>(texture->poweredHeight);
+	TextureCoordinates result(4);
+	result[0] = Vector2(0.0f, 0.0f);
+	result[1] = Vector2(right, 0.0f);
+	result[2] = Vector2(0.0f, bottom);
+	result[3] = Vector2(right, bottom);
+	return result;
+}
+
+/**
+ * Makes a checkerboard texture whose alpha goes from opaque at the top to
+ * transparent at the bottom.
+ * @return Texture loaded by the graphic driver.
+ */
+static TextureInformation *makeCheckerTexture() {
+	PixMap pixMap(32, 32, ColorFormat::RGBA);
+	uint8_t *pixel = pixMap.getBuffer();
+
+	for (unsigned int y = 0; y < pixMap.getHeight(); ++y) {
+		for (unsigned int x = 0; x < pixMap.getWidth(); ++x) {
+			bool light = ((x / 8) + (y / 8)) % 2 == 0;
+			*pixel++ = (light) ? (240) : (30);
+			*pixel++ = (light) ? (200) : (90);
+			*pixel++ = static_cast<uint8_t>(x * 8);
+			*pixel++ = static_cast<uint8_t>(255 - y * 7);
+		}
+	}
+
+	return GraphicDriver::getInstance().loadTexture(&pixMap);
+}
+
+/**
+ * Makes an alpha texture with a disc, like the glyphs and the masks use.
+ * @return Texture loaded by the graphic driver.
+ */
+static TextureInformation *makeDiscTexture() {
+	PixMap pixMap(32, 32, ColorFormat::ALPHA);
+	uint8_t *pixel = pixMap.getBuffer();
+
+	for (unsigned int y = 0; y < pixMap.getHeight(); ++y) {
+		for (unsigned int x = 0; x < pixMap.getWidth(); ++x) {
+			float distance = std::sqrt((x - 15.5f) * (x - 15.5f) + (y - 15.5f) * (y - 15.5f));
+			*pixel++ = (distance < 12.0f) ? (255) : ((distance < 16.0f) ? (static_cast<uint8_t>((16.0f - distance) * 63.0f)) : (0));
+		}
+	}
+
+	return GraphicDriver::getInstance().loadTexture(&pixMap);
+}
+
+/**
+ * Adds a rectangle to a batch, as two triangles.
+ * @param vertices Batch's vertices.
+ * @param indices Batch's indices.
+ * @param rectangle Vertices of the rectangle.
+ * @param textureCoordinates Texture coordinates of the rectangle.
+ * @param colors Colors of the rectangle's 4 vertices.
+ */
+static void addToBatch(BatchVertexArray &vertices, IndiceArray &indices,
+                       const StandardVertexArray &rectangle,
+                       const TextureCoordinates &textureCoordinates,
+                       const Color colors[4]) {
+	IndiceArray::value_type first = static_cast<IndiceArray::value_type>(vertices.size());
+
+	for (int i = 0; i < 4; ++i) {
+		vertices.push_back(BatchVertex(rectangle[i], textureCoordinates[i], colors[i]));
+	}
+
+	static const int TRIANGLES[] = {0, 1, 2, 2, 1, 3};
+
+	for (int i = 0; i < 6; ++i) {
+		indices.push_back(first + TRIANGLES[i]);
+	}
+}
+
+/**
+ * Renders one of the scenes.
+ * @param scene Index of the scene to render.
+ * @param checker Checkerboard texture.
+ * @param disc Alpha texture with a disc.
+ */
+static void renderScene(int scene, const TextureInformation *checker,
+                        const TextureInformation *disc) {
+	GraphicDriver &driver = GraphicDriver::getInstance();
+	TextureCoordinates checkerCoordinates(makeTextureCoordinates(checker));
+	TextureCoordinates discCoordinates(makeTextureCoordinates(disc));
+	Color background(40, 40, 60);
+
+	if (scene == 2) {
+		driver.prepareScene(Vector2(-20.0f, 10.0f), 20.0f, Vector2(1.5f, 0.75f), background);
+
+	} else {
+		driver.prepareScene(Vector2(), 0.0f, Vector2(1.0f, 1.0f), background);
+	}
+
+	switch (scene) {
+	case 0:
+		driver.drawShapeWithColor(makeRectangle(8.0f, 8.0f, 70.0f, 50.0f), Color(255, 0, 0));
+		driver.drawShapeWithColor(makeRectangle(40.0f, 30.0f, 70.0f, 50.0f), Color(0, 255, 0, 128));
+		driver.drawShapeWithColor(makeRectangle(20.0f, 50.0f, 60.0f, 60.0f), Color(60, 120, 255, 64));
+		driver.drawShapeWithColor(makeRotatedRectangle(Vector2(96.0f, 96.0f), Vector2(40.0f, 20.0f), 30.0f), Color(255, 255, 0, 200));
+		break;
+
+	case 1:
+		driver.drawShapeWithTexture(makeRectangle(4.0f, 4.0f, 64.0f, 64.0f), checker, checkerCoordinates);
+		driver.drawShapeWithTextureAndColor(makeRectangle(60.0f, 8.0f, 64.0f, 64.0f), checker, checkerCoordinates, Color(255, 128, 0, 200));
+		driver.drawShapeWithTextureAndColor(makeRectangle(8.0f, 64.0f, 56.0f, 56.0f), disc, discCoordinates, Color(255, 255, 255));
+		driver.drawShapeWithTextureAndColor(makeRotatedRectangle(Vector2(90.0f, 92.0f), Vector2(48.0f, 48.0f), -25.0f), disc, discCoordinates, Color(0, 200, 255, 150));
+		break;
+
+	case 2:
+		driver.drawShapeWithColor(makeRectangle(0.0f, 0.0f, 60.0f, 40.0f), Color(200, 60, 60));
+		driver.pushMatrix();
+		driver.translate(Vector2(-30.0f, -20.0f));
+		driver.drawShapeWithTextureAndColor(makeRectangle(0.0f, 0.0f, 48.0f, 48.0f), checker, checkerCoordinates, Color(255, 255, 255, 220));
+		driver.pushMatrix();
+		driver.translate(Vector2(10.0f, -30.0f));
+		driver.drawShapeWithTextureAndColor(makeRectangle(0.0f, 0.0f, 40.0f, 40.0f), disc, discCoordinates, Color(120, 255, 120));
+		driver.popMatrix();
+		driver.popMatrix();
+		driver.drawShapeWithColor(makeRectangle(50.0f, 50.0f, 30.0f, 30.0f), Color(255, 255, 255, 100));
+		break;
+
+	case 3: {
+		// Masks, the same way a masked graphic renders itself.
+		StandardVertexArray mask(makeRectangle(16.0f, 8.0f, 64.0f, 64.0f));
+		driver.drawShapeWithColor(makeRectangle(0.0f, 0.0f, 128.0f, 64.0f), Color(90, 20, 20));
+		driver.drawMaskShapeWithTexture(mask, disc, discCoordinates);
+		driver.drawMaskedShapeWithTextureAndColor(makeRectangle(4.0f, 4.0f, 80.0f, 60.0f), checker, checkerCoordinates, Color(255, 255, 255), false);
+		driver.unmaskShape(mask);
+
+		StandardVertexArray invertedMask(makeRectangle(56.0f, 60.0f, 64.0f, 64.0f));
+		driver.drawMaskShapeWithTextureAndColor(invertedMask, disc, discCoordinates, Color(255, 255, 255, 180));
+		driver.drawMaskedShapeWithTextureAndColor(makeRectangle(40.0f, 56.0f, 84.0f, 68.0f), checker, checkerCoordinates, Color(100, 255, 200), true);
+		driver.unmaskShape(invertedMask);
+
+		// Nothing is masked anymore.
+		driver.drawShapeWithColor(makeRectangle(4.0f, 100.0f, 30.0f, 24.0f), Color(255, 255, 0, 160));
+		break;
+	}
+
+	case 4: {
+		BatchVertexArray vertices, maskVertices;
+		IndiceArray indices, maskIndices;
+		IndiceArrayList indiceList, maskIndiceList;
+		// The fixed pipeline uses flat shading, so like the engine's
+		// batches, every quad has a single color. Its masked batches are
+		// drawn in several passes over the whole batch, so the quads don't
+		// overlap.
+		Color colors[3] = {Color(255, 255, 255), Color(255, 80, 80, 200), Color(80, 255, 120, 128)};
+		Color white[4] = {Color::WHITE, Color::WHITE, Color::WHITE, Color::WHITE};
+
+		for (int i = 0; i < 3; ++i) {
+			Color quadColors[4] = {colors[i], colors[i], colors[i], colors[i]};
+			addToBatch(vertices, indices, makeRectangle(4.0f + i * 40.0f, 4.0f + i * 20.0f, 36.0f, 36.0f), checkerCoordinates, quadColors);
+		}
+
+		indiceList.push_back(std::make_pair(static_cast<StandardVertexArray::SizeType>(0), static_cast<IndiceArray::size_type>(0)));
+		driver.drawBatchWithTextureAndColor(vertices, checker, indices, indiceList);
+
+		addToBatch(maskVertices, maskIndices, makeRectangle(24.0f, 64.0f, 56.0f, 56.0f), discCoordinates, white);
+		maskIndiceList.push_back(std::make_pair(static_cast<StandardVertexArray::SizeType>(0), static_cast<IndiceArray::size_type>(0)));
+		driver.drawMaskBatchWithTextureAndColor(maskVertices, disc, maskIndices, maskIndiceList);
+		driver.drawMaskedBatchWithTextureAndColor(vertices, checker, indices, indiceList, false);
+		driver.unmaskBatch(maskVertices, maskIndices, maskIndiceList);
+		driver.drawBatchWithTexture(maskVertices, checker, maskIndices, maskIndiceList);
+		break;
+	}
+
+	default:
+		break;
+	}
+
+	driver.finalizeScene();
+}
+
+/**
+ * Reads the rendered scene's colors, from the top row to the bottom one.
+ * @param image Image the scene's rows are appended to (RGB).
+ */
+static void readScene(std::vector<unsigned char> &image) {
+	std::vector<unsigned char> pixels(SCENE_SIZE * SCENE_SIZE * 4);
+	glFinish();
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+	glReadPixels(0, 0, SCENE_SIZE, SCENE_SIZE, GL_RGBA, GL_UNSIGNED_BYTE, &pixels[0]);
+
+	// OpenGL's rows go from the bottom to the top.
+	for (int y = SCENE_SIZE - 1; y >= 0; --y) {
+		for (int x = 0; x < SCENE_SIZE; ++x) {
+			const unsigned char *pixel = &pixels[(y * SCENE_SIZE + x) * 4];
+			image.insert(image.end(), pixel, pixel + 3);
+		}
+	}
+}
+
+/**
+ * Saves an image to a binary PPM file.
+ * @param filePath Path to the file to write.
+ * @param image Image's RGB components.
+ * @param width Width of the image.
+ * @param height Height of the image.
+ * @return True if the file was written, false if not.
+ */
+static bool savePPM(const std::string &filePath,
+                    const std::vector<unsigned char> &image, int width,
+                    int height) {
+	std::ofstream file(filePath.c_str(), std::ios::out | std::ios::binary);
+	file << "P6\n" << width << " " << height << "\n255\n";
+	file.write(reinterpret_cast<const char *>(&image[0]), image.size());
+	return file.good();
+}
+
+/**
+ * Loads an image saved by savePPM.
+ * @param filePath Path to the file to read.
+ * @param image Set to the image's RGB components.
+ * @param width Set to the width of the image.
+ * @param height Set to the height of the image.
+ * @return True if the file was read, false if not.
+ */
+static bool loadPPM(const std::string &filePath,
+                    std::vector<unsigned char> &image, int &width,
+                    int &height) {
+	std::ifstream file(filePath.c_str(), std::ios::in | std::ios::binary);
+	std::string magic;
+	int maximum = 0;
+	file >> magic >> width >> height >> maximum;
+	file.get();
+
+	if (!file || magic != "P6" || maximum != 255 || width <= 0 || height <= 0) {
+		return false;
+	}
+
+	image.resize(width * height * 3);
+	file.read(reinterpret_cast<char *>(&image[0]), image.size());
+	return file.good();
+}
+
+/**
+ * Compares a scene of the rendered image with the reference.
+ * @param image Rendered image.
+ * @param reference Reference image.
+ * @param scene Index of the scene to compare.
+ * @return True if the scene matches the reference, false if not.
+ */
+static bool compareScene(const std::vector<unsigned char> &image,
+                         const std::vector<unsigned char> &reference,
+                         int scene) {
+	int nbDifferent = 0, largest = 0, firstX = -1, firstY = -1;
+	std::vector<unsigned char>::size_type offset = scene * SCENE_SIZE * SCENE_SIZE * 3;
+
+	for (int y = 0; y < SCENE_SIZE; ++y) {
+		for (int x = 0; x < SCENE_SIZE; ++x) {
+			int pixelLargest = 0;
+
+			for (int k = 0; k < 3; ++k) {
+				std::vector<unsigned char>::size_type i = offset + (y * SCENE_SIZE + x) * 3 + k;
+				pixelLargest = std::max(pixelLargest, std::abs(static_cast<int>(image[i]) - static_cast<int>(reference[i])));
+			}
+
+			largest = std::max(largest, pixelLargest);
+
+			if (pixelLargest > TOLERANCE) {
+				if (nbDifferent == 0) {
+					firstX = x;
+					firstY = y;
+				}
+
+				++nbDifferent;
+			}
+		}
+	}
+
+	bool result = nbDifferent <= static_cast<int>(MAX_DIFFERENT_RATIO * SCENE_SIZE * SCENE_SIZE);
+	std::cout << SCENE_NAMES[scene] << ": " << nbDifferent
+	          << " pixels differ, largest difference " << largest;
+
+	if (nbDifferent > 0) {
+		std::cout << ", first at (" << firstX << ", " << firstY << ")";
+	}
+
+	std::cout << ((result) ? ("") : (" FAILED")) << std::endl;
+	return result;
+}
+
+int main(int argc, char *argv[]) {
+	if (argc < 2) {
+		std::cout << "Usage: " << argv[0] << " output.ppm [reference.ppm]" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	if (!createContext()) {
+		return EXIT_FAILURE;
+	}
+
+#ifdef RB_OPENGL_SHADERS
+	std::cout << "Driver: shaders" << std::endl;
+#else
+	std::cout << "Driver: fixed pipeline" << std::endl;
+#endif
+	// The engine creates the main window, which receives the resolution.
+	Engine::application(argc, argv, "ShaderImageDiff");
+	Engine::initializeEngine(SCENE_SIZE, SCENE_SIZE,
+	                         static_cast<float>(SCENE_SIZE),
+	                         static_cast<float>(SCENE_SIZE));
+
+	TextureInformation *checker = makeCheckerTexture();
+	TextureInformation *disc = makeDiscTexture();
+	std::vector<unsigned char> image;
+
+	for (int scene = 0; scene < NB_SCENES; ++scene) {
+		renderScene(scene, checker, disc);
+		readScene(image);
+	}
+
+	GraphicDriver::getInstance().deleteTexture(checker);
+	GraphicDriver::getInstance().deleteTexture(disc);
+
+	if (!savePPM(argv[1], image, SCENE_SIZE, SCENE_SIZE * NB_SCENES)) {
+		std::cout << "Couldn't write " << argv[1] << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	bool valid = true;
+
+	if (argc > 2) {
+		std::vector<unsigned char> reference;
+		int width = 0, height = 0;
+
+		if (!loadPPM(argv[2], reference, width, height) ||
+		    width != SCENE_SIZE || height != SCENE_SIZE * NB_SCENES) {
+			std::cout << "Couldn't read the reference image " << argv[2] << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		for (int scene = 0; scene < NB_SCENES; ++scene) {
+			valid = compareScene(image, reference, scene) && valid;
+		}
+	}
+
+	return (valid) ? (EXIT_SUCCESS) : (EXIT_FAILURE);
+}
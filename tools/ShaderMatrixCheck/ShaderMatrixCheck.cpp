@@ -0,0 +1,269 @@
+/**
+ * @file
+ * Command line check of the shader driver's transformations against the
+ * fixed pipeline driver. The fixed pipeline's matrices are computed on the
+ * CPU as the OpenGL specification defines glOrtho, glTranslatef,
+ * glRotatef and glScalef, with the same calls as OpenGLDriver's
+ * initializeGraphicDriver, prepareScene and translate. Points are then
+ * projected with both drivers' transformations for every window orientation
+ * and a set of cameras and nested translations. Link it with the BaconBox
+ * library built with RB_OPENGL_SHADERS, no OpenGL context is needed.
+ *
+ * Usage: ShaderMatrixCheck
+ *
+ * Returns EXIT_SUCCESS if the positions match, EXIT_FAILURE otherwise.
+ */
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "BaconBox/PlatformFlagger.h"
+#include "BaconBox/Vector2.h"
+#include "BaconBox/Display/Driver/OpenGL/ShaderDriver.h"
+
+using namespace BaconBox;
+
+/// Largest difference accepted between the clip coordinates of both drivers.
+static const double TOLERANCE = 1.0e-4;
+
+/**
+ * Column-major 4x4 matrix, like OpenGL's.
+ */
+struct Matrix {
+	/**
+	 * Default constructor. Initializes the identity matrix.
+	 */
+	Matrix() {
+		for (int i = 0; i < 16; ++i) {
+			m[i] = (i % 5 == 0) ? (1.0) : (0.0);
+		}
+	}
+
+	/**
+	 * Multiplies two matrices, the right operand is applied first.
+	 */
+	Matrix operator*(const Matrix &other) const {
+		Matrix result;
+
+		for (int column = 0; column < 4; ++column) {
+			for (int row = 0; row < 4; ++row) {
+				double sum = 0.0;
+
+				for (int k = 0; k < 4; ++k) {
+					sum += m[k * 4 + row] * other.m[column * 4 + k];
+				}
+
+				result.m[column * 4 + row] = sum;
+			}
+		}
+
+		return result;
+	}
+
+	/**
+	 * Transforms the point (x, y, 0, 1).
+	 * @param x Horizontal coordinate.
+	 * @param y Vertical coordinate.
+	 * @param result Set to the transformed homogeneous coordinates.
+	 */
+	void apply(double x, double y, double result[4]) const {
+		for (int row = 0; row < 4; ++row) {
+			result[row] = m[row] * x + m[4 + row] * y + m[12 + row];
+		}
+	}
+
+	double m[16];
+};
+
+/**
+ * Matrix glTranslatef multiplies the current matrix with.
+ */
+static Matrix translation(double x, double y, double z) {
+	Matrix result;
+	result.m[12] = x;
+	result.m[13] = y;
+	result.m[14] = z;
+	return result;
+}
+
+/**
+ * Matrix glRotatef multiplies the current matrix with, around the z axis.
+ */
+static Matrix rotation(double angle) {
+	Matrix result;
+	double radians = angle * 3.14159265358979323846 / 180.0;
+	result.m[0] = std::cos(radians);
+	result.m[1] = std::sin(radians);
+	result.m[4] = -std::sin(radians);
+	result.m[5] = std::cos(radians);
+	return result;
+}
+
+/**
+ * Matrix glScalef multiplies the current matrix with.
+ */
+static Matrix scaling(double x, double y, double z) {
+	Matrix result;
+	result.m[0] = x;
+	result.m[5] = y;
+	result.m[10] = z;
+	return result;
+}
+
+/**
+ * Matrix glOrtho multiplies the current matrix with.
+ */
+static Matrix ortho(double left, double right, double bottom, double top,
+                    double nearValue, double farValue) {
+	Matrix result;
+	result.m[0] = 2.0 / (right - left);
+	result.m[5] = 2.0 / (top - bottom);
+	result.m[10] = -2.0 / (farValue - nearValue);
+	result.m[12] = -(right + left) / (right - left);
+	result.m[13] = -(top + bottom) / (top - bottom);
+	result.m[14] = -(farValue + nearValue) / (farValue - nearValue);
+	return result;
+}
+
+/**
+ * Projection set by OpenGLDriver::initializeGraphicDriver.
+ */
+static Matrix getFixedProjection(WindowOrientation orientation, double width,
+                                 double height) {
+	if (orientation == WindowOrientation::NORMAL) {
+		return ortho(0.0, width, height, 0.0, -1.0, 1.0);
+
+	} else if (orientation == WindowOrientation::UPSIDE_DOWN) {
+		return ortho(0.0, width, 0.0, height, -1.0, 1.0);
+
+	} else {
+		return ortho(height, 0.0, 0.0, width, -1.0, 1.0);
+	}
+}
+
+/**
+ * Model view matrix set by OpenGLDriver::prepareScene.
+ */
+static Matrix getFixedModelView(WindowOrientation orientation, double width,
+                                double height, const Vector2 &position,
+                                double angle, const Vector2 &zoom) {
+	Matrix result;
+
+	if (orientation == WindowOrientation::HORIZONTAL_LEFT) {
+		result = result * rotation(-90.0);
+		result = result * translation(-width, 0.0, 0.0);
+
+	} else if (orientation == WindowOrientation::HORIZONTAL_RIGHT) {
+		result = result * rotation(90.0);
+		result = result * translation(0.0, -height, 0.0);
+	}
+
+	result = result * scaling(zoom.x, zoom.y, 1.0);
+	result = result * rotation(angle);
+	return result * translation(-position.x, -position.y, 0.0);
+}
+
+/**
+ * Compares the clip coordinates of a grid of points.
+ * @return Largest difference found.
+ */
+static double compare(const Matrix &fixedProjection, const Matrix &fixedModelView,
+                      const GLfloat shaderProjection[16],
+                      const ShaderDriver::Transform &shaderTransform,
+                      double width, double height) {
+	Matrix shaderMatrix;
+
+	for (int i = 0; i < 16; ++i) {
+		shaderMatrix.m[i] = shaderProjection[i];
+	}
+
+	Matrix fixedMatrix = fixedProjection * fixedModelView;
+	double largest = 0.0;
+
+	for (int i = 0; i <= 4; ++i) {
+		for (int j = 0; j <= 4; ++j) {
+			Vector2 point(static_cast<float>(width * i / 4.0 - 13.0),
+			              static_cast<float>(height * j / 4.0 + 7.0));
+			Vector2 transformed = shaderTransform.apply(point);
+			double fixedResult[4], shaderResult[4];
+			fixedMatrix.apply(point.x, point.y, fixedResult);
+			shaderMatrix.apply(transformed.x, transformed.y, shaderResult);
+
+			for (int k = 0; k < 4; ++k) {
+				double difference = std::fabs(fixedResult[k] - shaderResult[k]);
+
+				if (difference > largest) {
+					largest = difference;
+				}
+			}
+		}
+	}
+
+	return largest;
+}
+
+int main() {
+	static const WindowOrientationDef::type ORIENTATIONS[] = {WindowOrientation::NORMAL, WindowOrientation::UPSIDE_DOWN, WindowOrientation::HORIZONTAL_LEFT, WindowOrientation::HORIZONTAL_RIGHT};
+	static const char *ORIENTATION_NAMES[] = {"normal", "upside down", "horizontal left", "horizontal right"};
+	static const float SIZES[][2] = {{640.0f, 480.0f}, {1024.0f, 768.0f}, {320.0f, 568.0f}};
+	static const float CAMERAS[][5] = {
+		// x, y, angle, zoom x, zoom y
+		{0.0f, 0.0f, 0.0f, 1.0f, 1.0f},
+		{120.0f, -45.0f, 0.0f, 1.0f, 1.0f},
+		{-300.0f, 80.0f, 30.0f, 1.0f, 1.0f},
+		{50.0f, 60.0f, -75.0f, 2.0f, 0.5f},
+		{10.0f, 20.0f, 180.0f, 0.25f, 3.0f}
+	};
+	static const float TRANSLATIONS[][2] = {{0.0f, 0.0f}, {32.0f, 0.0f}, {-17.5f, 48.0f}, {200.0f, -120.0f}};
+	unsigned int nbChecks = 0, nbFailures = 0;
+
+	for (unsigned int orientation = 0; orientation < sizeof(ORIENTATIONS) / sizeof(ORIENTATIONS[0]); ++orientation) {
+		for (unsigned int size = 0; size < sizeof(SIZES) / sizeof(SIZES[0]); ++size) {
+			double width = SIZES[size][0], height = SIZES[size][1];
+			GLfloat shaderProjection[16];
+			ShaderDriver::getProjection(ORIENTATIONS[orientation], SIZES[size][0],
+			                            SIZES[size][1], shaderProjection);
+			Matrix fixedProjection = getFixedProjection(ORIENTATIONS[orientation], width, height);
+
+			for (unsigned int camera = 0; camera < sizeof(CAMERAS) / sizeof(CAMERAS[0]); ++camera) {
+				Vector2 position(CAMERAS[camera][0], CAMERAS[camera][1]);
+				Vector2 zoom(CAMERAS[camera][3], CAMERAS[camera][4]);
+				Matrix fixedModelView = getFixedModelView(ORIENTATIONS[orientation], width, height,
+				                                          position, CAMERAS[camera][2], zoom);
+				ShaderDriver::Transform shaderTransform = ShaderDriver::getSceneTransform(ORIENTATIONS[orientation],
+				                                                                          SIZES[size][0], SIZES[size][1],
+				                                                                          position, CAMERAS[camera][2], zoom);
+
+				// The translations are nested, like the ones State applies
+				// for the scroll factors within pushMatrix and popMatrix.
+				for (unsigned int i = 0; i < sizeof(TRANSLATIONS) / sizeof(TRANSLATIONS[0]); ++i) {
+					Vector2 offset(TRANSLATIONS[i][0], TRANSLATIONS[i][1]);
+
+					// OpenGLDriver::translate.
+					fixedModelView = fixedModelView * translation(-offset.x, -offset.y, 0.0);
+					shaderTransform = shaderTransform * ShaderDriver::getTranslation(offset);
+
+					double difference = compare(fixedProjection, fixedModelView,
+					                            shaderProjection, shaderTransform,
+					                            width, height);
+					++nbChecks;
+
+					if (difference > TOLERANCE) {
+						++nbFailures;
+						std::cout << "Mismatch of " << difference << " with the "
+						          << ORIENTATION_NAMES[orientation] << " orientation, a "
+						          << width << "x" << height << " context, camera "
+						          << camera << " and " << (i + 1) << " translations"
+						          << std::endl;
+					}
+				}
+			}
+		}
+	}
+
+	std::cout << nbChecks - nbFailures << " of " << nbChecks
+	          << " transformations match the fixed pipeline" << std::endl;
+
+	return (nbFailures) ? (EXIT_FAILURE) : (EXIT_SUCCESS);
+}
@@ -0,0 +1,193 @@
+/**
+ * @file
+ * Command line report of the memory used by a graphic tile layer. A tile map
+ * of 1000 by 1000 tiles is filled with random tiles, then the heap memory
+ * allocated by each of these is measured:
+ * - the graphic tile layer, just after being constructed;
+ * - the graphic tile layer once all of its chunks are generated, as if the
+ * whole layer was visible;
+ * - one batched element per tile, grouped in a batch per chunk, like the
+ * graphic tile layers used to keep;
+ * - the bodies created by the deprecated
+ * GraphicTileLayer::addToCollisionGroup().
+ * The allocations are counted by replacing the global new and delete
+ * operators. Link it with the BaconBox library built with HEADLESS, so the
+ * textures and the vertex buffers aren't in graphic memory.
+ *
+ * Usage: TileLayerMemoryReport [widthInTiles] [heightInTiles]
+ *
+ * The map is 1000 by 1000 tiles by default.
+ */
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <vector>
+
+#include "BaconBox/PlatformFlagger.h"
+#include "BaconBox/ResourceManager.h"
+#include "BaconBox/Vector2.h"
+#include "BaconBox/Display/BatchedInanimateGraphicElement.h"
+#include "BaconBox/Display/Collidable.h"
+#include "BaconBox/Display/PixMap.h"
+#include "BaconBox/Display/RenderBatch.h"
+#include "BaconBox/Display/TextureCoordinates.h"
+#include "BaconBox/Display/TileMap/GraphicTileLayer.h"
+#include "BaconBox/Display/TileMap/TileLayer.h"
+#include "BaconBox/Display/TileMap/TileMap.h"
+#include "BaconBox/Display/TileMap/Tileset.h"
+#include "BaconBox/Helper/CollisionGroup.h"
+#include "BaconBox/Helper/ShapeFactory.h"
+
+using namespace BaconBox;
+
+/// Number of bytes currently allocated with the new operators.
+static std::size_t nbAllocatedBytes = 0;
+
+/// Size of the header keeping an allocation's size, keeps the alignment.
+static const std::size_t HEADER_SIZE = 16;
+
+/**
+ * Allocates memory and counts it. The size is kept in front of the memory
+ * returned so the delete operator can uncount it.
+ */
+static void *allocate(std::size_t size) {
+	std::size_t *result = static_cast<std::size_t *>(std::malloc(size + HEADER_SIZE));
+
+	if (!result) {
+		throw std::bad_alloc();
+	}
+
+	*result = size;
+	nbAllocatedBytes += size;
+	return reinterpret_cast<char *>(result) + HEADER_SIZE;
+}
+
+/**
+ * Frees memory allocated by allocate() and uncounts it.
+ */
+static void deallocate(void *pointer) {
+	if (pointer) {
+		// Volatile so the compiler doesn't mistake the block for memory from new.
+		void *volatile block = static_cast<char *>(pointer) - HEADER_SIZE;
+		nbAllocatedBytes -= *static_cast<std::size_t *>(block);
+		std::free(block);
+	}
+}
+
+void *operator new(std::size_t size) throw(std::bad_alloc) {
+	return allocate(size);
+}
+
+void *operator new[](std::size_t size) throw(std::bad_alloc) {
+	return allocate(size);
+}
+
+void operator delete(void *pointer) throw() {
+	deallocate(pointer);
+}
+
+void operator delete[](void *pointer) throw() {
+	deallocate(pointer);
+}
+
+/// Batch of tiles, like the graphic tile layers used to keep for each chunk.
+typedef RenderBatch<BatchedInanimateGraphicElement<Collidable> > TileBatch;
+
+/**
+ * Creates one batched element per tile, in a batch per chunk, like the
+ * graphic tile layers did before only keeping the tile id's.
+ * @param layer Layer to create the tiles of.
+ * @param result Batches in which the tiles are added.
+ */
+static void createTileElements(const TileLayer &layer, std::vector<TileBatch *> &result) {
+	unsigned int widthInTiles = static_cast<unsigned int>(layer.getWidthInTiles());
+	unsigned int nbChunksX = (widthInTiles + GraphicTileLayer::CHUNK_SIZE - 1) / GraphicTileLayer::CHUNK_SIZE;
+	unsigned int nbChunksY = (static_cast<unsigned int>(layer.getHeightInTiles()) + GraphicTileLayer::CHUNK_SIZE - 1) / GraphicTileLayer::CHUNK_SIZE;
+	result.resize(nbChunksX * nbChunksY);
+
+	for (std::vector<TileBatch *>::iterator i = result.begin(); i != result.end(); ++i) {
+		*i = new TileBatch();
+	}
+
+	for (TileLayer::DataContainer::size_type i = 0; i < layer.getTiles().size(); ++i) {
+		const Tileset *tileset = layer.parentMap.getTileset(layer.getTiles()[i]);
+
+		if (tileset) {
+			unsigned int x = static_cast<unsigned int>(i) % widthInTiles;
+			unsigned int y = static_cast<unsigned int>(i) / widthInTiles;
+			BatchedInanimateGraphicElement<Collidable> *tile = new BatchedInanimateGraphicElement<Collidable>();
+			tile->setTextureInformation(tileset->getTextureInformation());
+			tile->setPosition(layer.parentMap.getTileSize().getCoordinatesMultiplication(Vector2(static_cast<float>(x), static_cast<float>(y))));
+			tile->getVertices().resize(4);
+			ShapeFactory::createRectangle(tileset->getTileSize(), tile->getPosition(), &tile->getVertices());
+			tileset->loadTextureCoordinates(layer.getTiles()[i], tile->getTextureCoordinates());
+			tile->setStaticBody(true);
+			result[(y / GraphicTileLayer::CHUNK_SIZE) * nbChunksX + x / GraphicTileLayer::CHUNK_SIZE]->add(tile);
+		}
+	}
+
+	// The batches only take their new bodies in when they're updated.
+	for (std::vector<TileBatch *>::iterator i = result.begin(); i != result.end(); ++i) {
+		(*i)->update();
+	}
+}
+
+/**
+ * Shows a measure.
+ * @param name Name of what was measured.
+ * @param nbBytes Number of bytes measured.
+ * @param nbTiles Number of tiles in the map.
+ */
+static void show(const char *name, std::size_t nbBytes, std::size_t nbTiles) {
+	std::cout << name << ": " << static_cast<double>(nbBytes) / (1024.0 * 1024.0)
+	          << " MiB (" << static_cast<double>(nbBytes) / static_cast<double>(nbTiles)
+	          << " bytes per tile)" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+	int widthInTiles = (argc > 1) ? (std::atoi(argv[1])) : (1000);
+	int heightInTiles = (argc > 2) ? (std::atoi(argv[2])) : (1000);
+	std::size_t nbTiles = static_cast<std::size_t>(widthInTiles) * static_cast<std::size_t>(heightInTiles);
+
+	// The tileset has 256 tiles of 16 by 16 pixels.
+	PixMap tilesetImage(256, 256, 255);
+	TileMap map(std::string(), TileCoordinate(widthInTiles, heightInTiles), Vector2(16.0f, 16.0f));
+	map.addTileset("tiles", ResourceManager::addTexture("tiles", &tilesetImage), Vector2(16.0f, 16.0f));
+	TileLayer *layer = map.pushBackTileLayer("ground");
+	std::vector<unsigned int> tileIds(nbTiles);
+
+	for (std::vector<unsigned int>::iterator i = tileIds.begin(); i != tileIds.end(); ++i) {
+		*i = 1u + static_cast<unsigned int>(std::rand() % 256);
+	}
+
+	layer->setTileIds(&tileIds[0]);
+	std::cout << widthInTiles << " by " << heightInTiles << " tiles" << std::endl;
+	show("Tile layer's tile id's", layer->getTiles().size() * sizeof(unsigned int), nbTiles);
+
+	std::size_t start = nbAllocatedBytes;
+	GraphicTileLayer *graphicLayer = new GraphicTileLayer(*layer);
+	show("Graphic tile layer", nbAllocatedBytes - start, nbTiles);
+
+	// Without a state's camera, the whole layer is visible.
+	graphicLayer->render();
+	show("Graphic tile layer with all chunks generated", nbAllocatedBytes - start, nbTiles);
+
+	start = nbAllocatedBytes;
+	CollisionGroup *group = new CollisionGroup(AxisAlignedBoundingBox(Vector2(), Vector2(16.0f * widthInTiles, 16.0f * heightInTiles)));
+	graphicLayer->addToCollisionGroup(*group);
+	group->update();
+	show("Bodies and collision group of addToCollisionGroup()", nbAllocatedBytes - start, nbTiles);
+	delete group;
+	delete graphicLayer;
+
+	start = nbAllocatedBytes;
+	std::vector<TileBatch *> batches;
+	createTileElements(*layer, batches);
+	show("One batched element per tile", nbAllocatedBytes - start, nbTiles);
+
+	for (std::vector<TileBatch *>::iterator i = batches.begin(); i != batches.end(); ++i) {
+		delete *i;
+	}
+
+	return EXIT_SUCCESS;
+}
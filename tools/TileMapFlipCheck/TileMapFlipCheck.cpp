@@ -0,0 +1,280 @@
+/**
+ * @file
+ * Command line check of the tile map readers with flipped tiles. A small map
+ * is written with its tile layer in each of the TMX encodings (XML, CSV,
+ * base 64, zlib and gzip), then read with the TMX reader, converted to a
+ * binary tile map and read again with the binary reader. The flip flags must
+ * be kept on the valid tile id's and only the tile id's past the last
+ * tileset must be cleared. Layers with too few or too many tile id's must be
+ * refused with the matching error message. Link it with the BaconBox library
+ * and TinyXML.
+ *
+ * Usage: TileMapFlipCheck [folder]
+ *
+ * folder is where the maps and the tileset's image are written, the current
+ * folder by default.
+ *
+ * Returns EXIT_SUCCESS if all the maps are read as expected, EXIT_FAILURE
+ * otherwise.
+ */
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <zlib.h>
+
+#include "BaconBox/PlatformFlagger.h"
+#include "BaconBox/ResourceManager.h"
+#include "BaconBox/Display/PixMap.h"
+#include "BaconBox/Display/TileMap/BinaryTileMapReader.h"
+#include "BaconBox/Display/TileMap/TileLayer.h"
+#include "BaconBox/Display/TileMap/TileMap.h"
+#include "BaconBox/Display/TileMap/TinyXML/TmxTileMapReader.h"
+#include "BaconBox/Helper/Base64.h"
+
+using namespace BaconBox;
+
+/// Flag set on the tile id's flipped horizontally.
+static const unsigned int HORIZONTAL_FLIP = 0x80000000u;
+
+/// Flag set on the tile id's flipped vertically.
+static const unsigned int VERTICAL_FLIP = 0x40000000u;
+
+/// Flag set on the tile id's flipped diagonally.
+static const unsigned int DIAGONAL_FLIP = 0x20000000u;
+
+/// Width and height of the map (in tiles).
+static const int MAP_SIZE = 4;
+
+/// Name of the tileset's image.
+static const char *TILESET_IMAGE = "FlipCheckTiles.png";
+
+/// Tile id's written in the map. The tileset only has tiles 1 and 2.
+static const unsigned int TILE_IDS[MAP_SIZE * MAP_SIZE] = {
+	1u, 2u, 0u, 3u,
+	1u | HORIZONTAL_FLIP, 2u | VERTICAL_FLIP, 1u | DIAGONAL_FLIP, 2u | HORIZONTAL_FLIP | VERTICAL_FLIP | DIAGONAL_FLIP,
+	3u | HORIZONTAL_FLIP, 4u | VERTICAL_FLIP, HORIZONTAL_FLIP, 2u | HORIZONTAL_FLIP | DIAGONAL_FLIP,
+	2u, 1u | VERTICAL_FLIP | DIAGONAL_FLIP, 255u, 1u
+};
+
+/// Tile id's expected once the map is read.
+static const unsigned int EXPECTED_TILE_IDS[MAP_SIZE * MAP_SIZE] = {
+	1u, 2u, 0u, 0u,
+	1u | HORIZONTAL_FLIP, 2u | VERTICAL_FLIP, 1u | DIAGONAL_FLIP, 2u | HORIZONTAL_FLIP | VERTICAL_FLIP | DIAGONAL_FLIP,
+	0u, 0u, HORIZONTAL_FLIP, 2u | HORIZONTAL_FLIP | DIAGONAL_FLIP,
+	2u, 1u | VERTICAL_FLIP | DIAGONAL_FLIP, 0u, 1u
+};
+
+/**
+ * Gets the tile id's as little endian bytes, like they are stored in base 64
+ * tile layers.
+ */
+static std::string toLittleEndian(const std::vector<unsigned int> &tileIds) {
+	std::string result;
+
+	for (std::vector<unsigned int>::const_iterator i = tileIds.begin(); i != tileIds.end(); ++i) {
+		for (int shift = 0; shift < 32; shift += 8) {
+			result.push_back(static_cast<char>((*i >> shift) & 0xffu));
+		}
+	}
+
+	return result;
+}
+
+/**
+ * Compresses bytes.
+ * @param data Bytes to compress.
+ * @param gzip Set to true to write a gzip stream, false for a zlib stream.
+ */
+static std::string compress(const std::string &data, bool gzip) {
+	z_stream stream;
+	stream.zalloc = Z_NULL;
+	stream.zfree = Z_NULL;
+	stream.opaque = Z_NULL;
+	deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, (gzip) ? (31) : (15), 8, Z_DEFAULT_STRATEGY);
+
+	std::vector<Bytef> buffer(deflateBound(&stream, static_cast<uLong>(data.size())) + 32);
+	stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data.data()));
+	stream.avail_in = static_cast<uInt>(data.size());
+	stream.next_out = &buffer[0];
+	stream.avail_out = static_cast<uInt>(buffer.size());
+	deflate(&stream, Z_FINISH);
+	std::string result(reinterpret_cast<char *>(&buffer[0]), stream.total_out);
+	deflateEnd(&stream);
+
+	return result;
+}
+
+/**
+ * Gets a tile layer's data element.
+ * @param encoding Encoding of the data: "xml", "csv", "base64", "zlib" or
+ * "gzip".
+ * @param tileIds Tile id's of the layer.
+ */
+static std::string makeDataElement(const std::string &encoding,
+                                   const std::vector<unsigned int> &tileIds) {
+	std::ostringstream result;
+
+	if (encoding == "xml") {
+		result << "<data>";
+
+		for (std::vector<unsigned int>::const_iterator i = tileIds.begin(); i != tileIds.end(); ++i) {
+			result << "<tile gid=\"" << *i << "\"/>";
+		}
+
+		result << "</data>";
+
+	} else if (encoding == "csv") {
+		result << "<data encoding=\"csv\">\n";
+
+		for (std::vector<unsigned int>::size_type i = 0; i < tileIds.size(); ++i) {
+			result << tileIds[i] << (((i + 1) % MAP_SIZE) ? (",") : (",\n"));
+		}
+
+		result << "</data>";
+
+	} else {
+		std::string bytes(toLittleEndian(tileIds)), encoded;
+
+		if (encoding == "base64") {
+			result << "<data encoding=\"base64\">";
+
+		} else {
+			result << "<data encoding=\"base64\" compression=\"" << encoding << "\">";
+			bytes = compress(bytes, encoding == "gzip");
+		}
+
+		Base64::encode(bytes, encoded);
+		result << encoded << "</data>";
+	}
+
+	return result.str();
+}
+
+/**
+ * Writes a map with one tile layer and one tileset with 2 tiles.
+ * @return True if the file was written, false if not.
+ */
+static bool writeMap(const std::string &fileName, const std::string &dataElement) {
+	std::ofstream file(fileName.c_str());
+
+	file << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+	     << "<map version=\"1.0\" orientation=\"orthogonal\" width=\"" << MAP_SIZE
+	     << "\" height=\"" << MAP_SIZE << "\" tilewidth=\"16\" tileheight=\"16\">\n"
+	     << " <tileset firstgid=\"1\" name=\"tiles\" tilewidth=\"16\" tileheight=\"16\">\n"
+	     << "  <image source=\"" << TILESET_IMAGE << "\" width=\"32\" height=\"16\"/>\n"
+	     << " </tileset>\n"
+	     << " <layer name=\"ground\" width=\"" << MAP_SIZE << "\" height=\"" << MAP_SIZE << "\">\n"
+	     << "  " << dataElement << "\n"
+	     << " </layer>\n"
+	     << "</map>\n";
+
+	return file.good();
+}
+
+/**
+ * Compares a map's tile id's with the expected ones.
+ * @param map Map to check, it is deleted.
+ * @param name Name of the map shown in the messages.
+ * @param errorMessage Reader's error message, shown if the map is NULL.
+ * @return True if the map has the expected tile id's, false if not.
+ */
+static bool checkMap(TileMap *map, const std::string &name,
+                     const std::string &errorMessage) {
+	bool result = false;
+
+	if (!map) {
+		std::cout << name << ": not read (" << errorMessage << ")" << std::endl;
+
+	} else if (!map->getTileLayer("ground")) {
+		std::cout << name << ": tile layer not found" << std::endl;
+
+	} else {
+		const TileLayer::DataContainer &tiles = map->getTileLayer("ground")->getTiles();
+		result = tiles.size() == MAP_SIZE * MAP_SIZE;
+
+		for (TileLayer::DataContainer::size_type i = 0; result && i < tiles.size(); ++i) {
+			if (tiles[i] != EXPECTED_TILE_IDS[i]) {
+				std::cout << name << ": tile " << i << " is " << std::hex << tiles[i]
+				          << " instead of " << EXPECTED_TILE_IDS[i] << std::dec << std::endl;
+				result = false;
+			}
+		}
+
+		if (result) {
+			std::cout << name << ": ok" << std::endl;
+		}
+	}
+
+	delete map;
+	return result;
+}
+
+/**
+ * Makes sure a map with the wrong number of tile id's is refused.
+ * @param fileName Path to the map to write.
+ * @param dataElement Data element of the map's tile layer.
+ * @param expectedMessage Beginning of the expected error message.
+ * @return True if the map is refused with the expected message, false if
+ * not.
+ */
+static bool checkRefused(const std::string &fileName,
+                         const std::string &dataElement,
+                         const std::string &expectedMessage) {
+	TmxTileMapReader reader;
+	TileMap *map = (writeMap(fileName, dataElement)) ? (reader.read(fileName)) : (NULL);
+	bool result = !map && reader.getErrorMessage().compare(0, expectedMessage.size(), expectedMessage) == 0;
+
+	std::cout << fileName << ": " << ((result) ? ("ok") : ("not refused as expected"))
+	          << " (" << reader.getErrorMessage() << ")" << std::endl;
+	delete map;
+	return result;
+}
+
+int main(int argc, char *argv[]) {
+	std::string folder((argc > 1) ? (std::string(argv[1]) + "/") : (std::string()));
+	static const char *ENCODINGS[] = {"xml", "csv", "base64", "zlib", "gzip"};
+	std::vector<unsigned int> tileIds(TILE_IDS, TILE_IDS + MAP_SIZE * MAP_SIZE);
+	bool valid = true;
+
+	// The tileset's image only has to exist, its pixels don't matter.
+	ResourceManager::savePixMap(PixMap(32, 16, 255), folder + TILESET_IMAGE);
+
+	for (unsigned int i = 0; i < sizeof(ENCODINGS) / sizeof(ENCODINGS[0]); ++i) {
+		std::string name(folder + "FlipCheck-" + ENCODINGS[i]);
+		TmxTileMapReader tmxReader;
+
+		if (writeMap(name + ".tmx", makeDataElement(ENCODINGS[i], tileIds))) {
+			TileMap *map = tmxReader.read(name + ".tmx");
+			valid = checkMap(map, name + ".tmx", tmxReader.getErrorMessage()) && valid;
+
+			if (tmxReader.convertToBinary(name + ".tmx", name + ".rbtm")) {
+				BinaryTileMapReader binaryReader;
+				map = binaryReader.read(name + ".rbtm");
+				valid = checkMap(map, name + ".rbtm", binaryReader.getErrorMessage()) && valid;
+
+			} else {
+				std::cout << name << ".tmx: not converted (" << tmxReader.getErrorMessage() << ")" << std::endl;
+				valid = false;
+			}
+
+		} else {
+			std::cout << name << ".tmx: not written" << std::endl;
+			valid = false;
+		}
+
+		// The same layer with a tile id missing, then with one too many.
+		std::vector<unsigned int> shortTileIds(tileIds.begin(), tileIds.end() - 1);
+		std::vector<unsigned int> longTileIds(tileIds);
+		longTileIds.push_back(1u);
+		valid = checkRefused(name + "-short.tmx", makeDataElement(ENCODINGS[i], shortTileIds),
+		                     "TmxTileMapReader: Not enough tile layer data") && valid;
+		valid = checkRefused(name + "-long.tmx", makeDataElement(ENCODINGS[i], longTileIds),
+		                     "TmxTileMapReader: Too much tile layer data") && valid;
+	}
+
+	return (valid) ? (EXIT_SUCCESS) : (EXIT_FAILURE);
+}
@@ -0,0 +1,269 @@
+/**
+ * @file
+ * Command line benchmark of the tile map readers. A synthetic map of 1000 by
+ * 1000 tiles, with random tile id's of which a quarter are flipped, is
+ * written with its tile layer in each of the TMX encodings (XML, CSV, base
+ * 64, zlib and gzip) and converted to a binary tile map. Each file is then
+ * read a few times and the average time of a read is shown with the file's
+ * size. The tile id's read are compared with the ones written, flip flags
+ * included. Link it with the BaconBox library and TinyXML.
+ *
+ * Usage: TileMapLoaderBenchmark [folder] [nbReads]
+ *
+ * folder is where the maps and the tileset's image are written, the current
+ * folder by default. nbReads is the number of times each map is read, 5 by
+ * default.
+ *
+ * Returns EXIT_SUCCESS if all the maps are read with the right tile id's,
+ * EXIT_FAILURE otherwise.
+ */
+#include <algorithm>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <zlib.h>
+
+#include "BaconBox/PlatformFlagger.h"
+#include "BaconBox/ResourceManager.h"
+#include "BaconBox/Display/PixMap.h"
+#include "BaconBox/Display/TileMap/BinaryTileMapReader.h"
+#include "BaconBox/Display/TileMap/TileLayer.h"
+#include "BaconBox/Display/TileMap/TileMap.h"
+#include "BaconBox/Display/TileMap/TinyXML/TmxTileMapReader.h"
+#include "BaconBox/Helper/Base64.h"
+
+using namespace BaconBox;
+
+/// Width and height of the map (in tiles).
+static const int MAP_SIZE = 1000;
+
+/// Number of tiles in the tileset.
+static const unsigned int NB_TILES = 64u;
+
+/// Name of the tileset's image.
+static const char *TILESET_IMAGE = "LoaderBenchmarkTiles.png";
+
+/**
+ * Gets random tile id's for the map. A quarter of them have flip flags and
+ * a few are empty.
+ */
+static std::vector<unsigned int> makeTileIds() {
+	static const unsigned int FLIP_FLAGS[] = {0x80000000u, 0x40000000u, 0x20000000u, 0xe0000000u};
+	std::vector<unsigned int> result(MAP_SIZE * MAP_SIZE);
+
+	for (std::vector<unsigned int>::iterator i = result.begin(); i != result.end(); ++i) {
+		*i = static_cast<unsigned int>(std::rand()) % (NB_TILES + 1u);
+
+		if (*i && std::rand() % 4 == 0) {
+			*i |= FLIP_FLAGS[std::rand() % 4];
+		}
+	}
+
+	return result;
+}
+
+/**
+ * Gets the tile id's as little endian bytes, like they are stored in base 64
+ * tile layers.
+ */
+static std::string toLittleEndian(const std::vector<unsigned int> &tileIds) {
+	std::string result;
+	result.reserve(tileIds.size() * 4);
+
+	for (std::vector<unsigned int>::const_iterator i = tileIds.begin(); i != tileIds.end(); ++i) {
+		for (int shift = 0; shift < 32; shift += 8) {
+			result.push_back(static_cast<char>((*i >> shift) & 0xffu));
+		}
+	}
+
+	return result;
+}
+
+/**
+ * Compresses bytes.
+ * @param data Bytes to compress.
+ * @param gzip Set to true to write a gzip stream, false for a zlib stream.
+ */
+static std::string compress(const std::string &data, bool gzip) {
+	z_stream stream;
+	stream.zalloc = Z_NULL;
+	stream.zfree = Z_NULL;
+	stream.opaque = Z_NULL;
+	deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, (gzip) ? (31) : (15), 8, Z_DEFAULT_STRATEGY);
+
+	std::vector<Bytef> buffer(deflateBound(&stream, static_cast<uLong>(data.size())) + 32);
+	stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data.data()));
+	stream.avail_in = static_cast<uInt>(data.size());
+	stream.next_out = &buffer[0];
+	stream.avail_out = static_cast<uInt>(buffer.size());
+	deflate(&stream, Z_FINISH);
+	std::string result(reinterpret_cast<char *>(&buffer[0]), stream.total_out);
+	deflateEnd(&stream);
+
+	return result;
+}
+
+/**
+ * Writes a map with one tile layer and one tileset.
+ * @param fileName Path to the map to write.
+ * @param encoding Encoding of the tile layer: "xml", "csv", "base64",
+ * "zlib" or "gzip".
+ * @param tileIds Tile id's of the layer.
+ * @return True if the file was written, false if not.
+ */
+static bool writeMap(const std::string &fileName, const std::string &encoding,
+                     const std::vector<unsigned int> &tileIds) {
+	std::ofstream file(fileName.c_str());
+
+	file << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+	     << "<map version=\"1.0\" orientation=\"orthogonal\" width=\"" << MAP_SIZE
+	     << "\" height=\"" << MAP_SIZE << "\" tilewidth=\"16\" tileheight=\"16\">\n"
+	     << " <tileset firstgid=\"1\" name=\"tiles\" tilewidth=\"16\" tileheight=\"16\">\n"
+	     << "  <image source=\"" << TILESET_IMAGE << "\" width=\"128\" height=\"128\"/>\n"
+	     << " </tileset>\n"
+	     << " <layer name=\"ground\" width=\"" << MAP_SIZE << "\" height=\"" << MAP_SIZE << "\">\n";
+
+	if (encoding == "xml") {
+		file << "  <data>\n";
+
+		for (std::vector<unsigned int>::const_iterator i = tileIds.begin(); i != tileIds.end(); ++i) {
+			file << "   <tile gid=\"" << *i << "\"/>\n";
+		}
+
+		file << "  </data>\n";
+
+	} else if (encoding == "csv") {
+		file << "  <data encoding=\"csv\">\n";
+
+		for (std::vector<unsigned int>::size_type i = 0; i < tileIds.size(); ++i) {
+			file << tileIds[i] << (((i + 1) % MAP_SIZE) ? (",") : ((i + 1 < tileIds.size()) ? (",\n") : ("\n")));
+		}
+
+		file << "  </data>\n";
+
+	} else {
+		std::string bytes(toLittleEndian(tileIds)), encoded;
+
+		if (encoding == "base64") {
+			file << "  <data encoding=\"base64\">\n   ";
+
+		} else {
+			file << "  <data encoding=\"base64\" compression=\"" << encoding << "\">\n   ";
+			bytes = compress(bytes, encoding == "gzip");
+		}
+
+		Base64::encode(bytes, encoded);
+		file << encoded << "\n  </data>\n";
+	}
+
+	file << " </layer>\n"
+	     << "</map>\n";
+
+	return file.good();
+}
+
+/**
+ * Gets a file's size (in kilobytes).
+ */
+static long getFileSize(const std::string &fileName) {
+	std::ifstream file(fileName.c_str(), std::ios::binary | std::ios::ate);
+	return static_cast<long>(file.tellg()) / 1024;
+}
+
+/**
+ * Reads a map several times and compares the last one read with the tile id's
+ * written.
+ * @param reader Reader used to read the map.
+ * @param fileName Path to the map to read.
+ * @param nbReads Number of times the map is read.
+ * @param tileIds Tile id's expected in the map.
+ * @param time Set to the average time of a read (in milliseconds).
+ * @return True if the map was read with the expected tile id's, false if
+ * not.
+ */
+static bool measure(TileMapReader &reader, const std::string &fileName,
+                    int nbReads, const std::vector<unsigned int> &tileIds,
+                    double &time) {
+	std::clock_t total = 0;
+	bool result = true;
+
+	for (int i = 0; result && i < nbReads; ++i) {
+		std::clock_t start = std::clock();
+		TileMap *map = reader.read(fileName);
+		total += std::clock() - start;
+
+		if (!map) {
+			std::cout << fileName << ": not read (" << reader.getErrorMessage() << ")" << std::endl;
+			result = false;
+
+		} else if (i == nbReads - 1) {
+			const TileLayer *layer = map->getTileLayer("ground");
+			result = layer && layer->getTiles().size() == tileIds.size() &&
+			         std::equal(tileIds.begin(), tileIds.end(), layer->getTiles().begin());
+
+			if (!result) {
+				std::cout << fileName << ": the tile id's read are not the ones written" << std::endl;
+			}
+		}
+
+		delete map;
+	}
+
+	time = static_cast<double>(total) / CLOCKS_PER_SEC * 1.0e3 /
+	       static_cast<double>(nbReads);
+	return result;
+}
+
+int main(int argc, char *argv[]) {
+	std::string folder((argc > 1) ? (std::string(argv[1]) + "/") : (std::string()));
+	int nbReads = (argc > 2) ? (std::atoi(argv[2])) : (5);
+	static const char *ENCODINGS[] = {"xml", "csv", "base64", "zlib", "gzip"};
+	std::vector<unsigned int> tileIds(makeTileIds());
+	TmxTileMapReader tmxReader;
+	BinaryTileMapReader binaryReader;
+	bool valid = true;
+
+	// The tileset's image only has to exist with room for all the tiles.
+	ResourceManager::savePixMap(PixMap(128, 128, 255), folder + TILESET_IMAGE);
+
+	for (unsigned int i = 0; i < sizeof(ENCODINGS) / sizeof(ENCODINGS[0]); ++i) {
+		std::string name(folder + "LoaderBenchmark-" + ENCODINGS[i]);
+		double time = 0.0;
+
+		if (!writeMap(name + ".tmx", ENCODINGS[i], tileIds)) {
+			std::cout << name << ".tmx: not written" << std::endl;
+			valid = false;
+
+		} else if (measure(tmxReader, name + ".tmx", nbReads, tileIds, time)) {
+			std::cout << ENCODINGS[i] << " (" << getFileSize(name + ".tmx") << " KiB): "
+			          << time << " ms per read" << std::endl;
+
+		} else {
+			valid = false;
+		}
+	}
+
+	// The binary map is converted from the zlib map, the encoding doesn't
+	// matter once it is converted.
+	std::string name(folder + "LoaderBenchmark-zlib");
+	double time = 0.0;
+
+	if (!tmxReader.convertToBinary(name + ".tmx", name + ".rbtm")) {
+		std::cout << name << ".tmx: not converted (" << tmxReader.getErrorMessage() << ")" << std::endl;
+		valid = false;
+
+	} else if (measure(binaryReader, name + ".rbtm", nbReads, tileIds, time)) {
+		std::cout << "binary (" << getFileSize(name + ".rbtm") << " KiB): "
+		          << time << " ms per read" << std::endl;
+
+	} else {
+		valid = false;
+	}
+
+	return (valid) ? (EXIT_SUCCESS) : (EXIT_FAILURE);
+}
@@ -0,0 +1,44 @@
+/**
+ * @file
+ * Command line tool converting TMX tile maps to precompiled binary tile maps
+ * (.rbtm), which load much faster. Link it with the BaconBox library.
+ *
+ * Usage: TmxConverter map.tmx...
+ *
+ * Writes map.rbtm next to each map.tmx, so the tilesets' images are found at
+ * the same relative paths.
+ */
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "BaconBox/Display/TileMap/TinyXML/TmxTileMapReader.h"
+
+using namespace BaconBox;
+
+int main(int argc, char *argv[]) {
+	if (argc < 2) {
+		std::cerr << "Usage: TmxConverter map.tmx..." << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	TmxTileMapReader reader;
+	int result = EXIT_SUCCESS;
+
+	for (int i = 1; i < argc; ++i) {
+		std::string tmxFileName(argv[i]);
+		std::string binaryFileName(tmxFileName.substr(0, tmxFileName.find_last_of('.')) + ".rbtm");
+
+		reader.clearErrorMessage();
+
+		if (reader.convertToBinary(tmxFileName, binaryFileName)) {
+			std::cout << "Converted " << tmxFileName << " to " << binaryFileName << std::endl;
+
+		} else {
+			std::cerr << "Can't convert " << tmxFileName << ": " << reader.getErrorMessage() << std::endl;
+			result = EXIT_FAILURE;
+		}
+	}
+
+	return result;
+}
@@ -0,0 +1,168 @@
+/**
+ * @file
+ * Command line benchmark of the vertex kernels (VertexHelper) against the
+ * per-vertex loops they replaced, on 4 vertex sprites and 64 vertex
+ * polygons. Link it with the BaconBox library and build it once normally
+ * and once with RB_NO_SIMD to compare the SIMD and the plain kernels.
+ *
+ * Usage: VertexBenchmark [nbVertices]
+ *
+ * nbVertices is the total number of vertices transformed per pass, 65536
+ * by default.
+ */
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <vector>
+
+#include "BaconBox/PlatformFlagger.h"
+#include "BaconBox/Vector2.h"
+#include "BaconBox/Helper/VertexHelper.h"
+
+using namespace BaconBox;
+
+/// Number of passes over the vertices for each measure.
+static const int NB_PASSES = 200;
+
+/**
+ * Rotates the shapes with Vector2::rotate, which computes the sine and the
+ * cosine for each vertex.
+ */
+static void rotateEachVertex(std::vector<Vector2> &vertices,
+                             std::size_t shapeSize, float angle) {
+	for (std::size_t shape = 0; shape < vertices.size(); shape += shapeSize) {
+		for (std::size_t i = shape; i < shape + shapeSize; ++i) {
+			vertices[i].rotate(angle);
+		}
+	}
+}
+
+/**
+ * Rotates the shapes with the vertex kernel, one call per shape.
+ */
+static void rotateShapes(std::vector<Vector2> &vertices,
+                         std::size_t shapeSize, float angle) {
+	for (std::size_t shape = 0; shape < vertices.size(); shape += shapeSize) {
+		VertexHelper::rotateFromPoint(&vertices[shape], shapeSize, angle,
+		                              Vector2());
+	}
+}
+
+/**
+ * Moves the shapes one vertex at a time.
+ */
+static void moveEachVertex(std::vector<Vector2> &vertices,
+                           std::size_t shapeSize, float delta) {
+	for (std::size_t shape = 0; shape < vertices.size(); shape += shapeSize) {
+		for (std::size_t i = shape; i < shape + shapeSize; ++i) {
+			vertices[i].x += delta;
+			vertices[i].y -= delta;
+		}
+	}
+}
+
+/**
+ * Moves the shapes with the vertex kernel, one call per shape.
+ */
+static void moveShapes(std::vector<Vector2> &vertices,
+                       std::size_t shapeSize, float delta) {
+	for (std::size_t shape = 0; shape < vertices.size(); shape += shapeSize) {
+		VertexHelper::move(&vertices[shape], shapeSize, Vector2(delta, -delta));
+	}
+}
+
+/**
+ * Computes the bounds of the shapes one vertex at a time.
+ */
+static void boundEachVertex(std::vector<Vector2> &vertices,
+                            std::size_t shapeSize, float) {
+	for (std::size_t shape = 0; shape < vertices.size(); shape += shapeSize) {
+		Vector2 minimum(vertices[shape]), maximum(vertices[shape]);
+
+		for (std::size_t i = shape + 1; i < shape + shapeSize; ++i) {
+			if (vertices[i].x < minimum.x) {
+				minimum.x = vertices[i].x;
+
+			} else if (vertices[i].x > maximum.x) {
+				maximum.x = vertices[i].x;
+			}
+
+			if (vertices[i].y < minimum.y) {
+				minimum.y = vertices[i].y;
+
+			} else if (vertices[i].y > maximum.y) {
+				maximum.y = vertices[i].y;
+			}
+		}
+
+		// We keep the result so the loop isn't optimized away.
+		vertices[shape].x = minimum.x + (maximum.x - minimum.x) * 0.0f;
+	}
+}
+
+/**
+ * Computes the bounds of the shapes with the vertex kernel.
+ */
+static void boundShapes(std::vector<Vector2> &vertices,
+                        std::size_t shapeSize, float) {
+	for (std::size_t shape = 0; shape < vertices.size(); shape += shapeSize) {
+		Vector2 minimum, maximum;
+		VertexHelper::getBounds(&vertices[shape], shapeSize, minimum, maximum);
+		vertices[shape].x = minimum.x + (maximum.x - minimum.x) * 0.0f;
+	}
+}
+
+typedef void (*Operation)(std::vector<Vector2> &, std::size_t, float);
+
+/**
+ * Measures an operation. Its last parameter alternates between 1 and -1 so
+ * the vertices stay in the same range.
+ * @return Average time per vertex (in nanoseconds).
+ */
+static double measure(Operation operation, std::vector<Vector2> &vertices,
+                      std::size_t shapeSize) {
+	std::clock_t start = std::clock();
+
+	for (int i = 0; i < NB_PASSES; ++i) {
+		operation(vertices, shapeSize, (i & 1) ? (1.0f) : (-1.0f));
+	}
+
+	return static_cast<double>(std::clock() - start) / CLOCKS_PER_SEC * 1.0e9 /
+	       (static_cast<double>(NB_PASSES) * static_cast<double>(vertices.size()));
+}
+
+int main(int argc, char *argv[]) {
+	std::size_t nbVertices = (argc > 1) ? (std::strtoul(argv[1], NULL, 10)) : (65536);
+	static const std::size_t SHAPE_SIZES[] = {4, 64};
+	static const char *OPERATION_NAMES[] = {"rotate", "move", "bounds"};
+	static const Operation PER_VERTEX[] = {rotateEachVertex, moveEachVertex, boundEachVertex};
+	static const Operation KERNELS[] = {rotateShapes, moveShapes, boundShapes};
+
+#if defined(RB_SSE2)
+	std::cout << "Kernels: SSE2" << std::endl;
+#elif defined(RB_NEON)
+	std::cout << "Kernels: NEON" << std::endl;
+#else
+	std::cout << "Kernels: plain loops" << std::endl;
+#endif
+
+	for (unsigned int size = 0; size < sizeof(SHAPE_SIZES) / sizeof(SHAPE_SIZES[0]); ++size) {
+		std::size_t shapeSize = SHAPE_SIZES[size];
+		std::vector<Vector2> vertices(nbVertices - nbVertices % shapeSize);
+
+		for (std::size_t i = 0; i < vertices.size(); ++i) {
+			vertices[i] = Vector2(static_cast<float>(std::rand() % 1024),
+			                      static_cast<float>(std::rand() % 1024));
+		}
+
+		for (unsigned int operation = 0; operation < sizeof(KERNELS) / sizeof(KERNELS[0]); ++operation) {
+			double perVertex = measure(PER_VERTEX[operation], vertices, shapeSize);
+			double kernel = measure(KERNELS[operation], vertices, shapeSize);
+			std::cout << shapeSize << " vertex shapes, " << OPERATION_NAMES[operation]
+			          << ": " << perVertex << " ns per vertex with per-vertex loops, "
+			          << kernel << " ns per vertex with the kernel" << std::endl;
+		}
+	}
+
+	return EXIT_SUCCESS;
+}